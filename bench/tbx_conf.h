@@ -0,0 +1,58 @@
+/************************************************************************************//**
+* \file         tbx_conf.h
+* \brief        MicroTBX configuration header file for the host benchmark.
+* \internal
+*----------------------------------------------------------------------------------------
+*                          C O P Y R I G H T
+*----------------------------------------------------------------------------------------
+*   Copyright (c) 2023 by Feaser     www.feaser.com     All rights reserved
+*
+*----------------------------------------------------------------------------------------
+*                            L I C E N S E
+*----------------------------------------------------------------------------------------
+*
+* SPDX-License-Identifier: GPL-3.0-or-later
+*
+* This file is part of MicroTBX-Modbus. MicroTBX-Modbus is free software: you can
+* redistribute it and/or modify it under the terms of the GNU General Public License as
+* published by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* MicroTBX-Modbus is distributed in the hope that it will be useful, but WITHOUT ANY
+* WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+* PARTICULAR PURPOSE. See the GNU General Public License for more details.
+*
+* You have received a copy of the GNU General Public License along with MicroTBX-Modbus.
+* If not, see www.gnu.org/licenses/.
+*
+* \endinternal
+****************************************************************************************/
+#ifndef TBX_CONF_H
+#define TBX_CONF_H
+
+/****************************************************************************************
+*   A S S E R T I O N S   M O D U L E   C O N F I G U R A T I O N
+****************************************************************************************/
+/** \brief Enable/disable run-time assertions. */
+#define TBX_CONF_ASSERTIONS_ENABLE     (1U)
+
+
+/****************************************************************************************
+*   H E A P   M O D U L E   C O N F I G U R A T I O N
+****************************************************************************************/
+/** \brief Configure the size of the heap in bytes. */
+#define TBX_CONF_HEAP_SIZE             (65536U)
+
+
+/****************************************************************************************
+*   M O D B U S   C O N F I G U R A T I O N
+****************************************************************************************/
+/** \brief Let the virtual timer of the loopback port advance by 10 ticks each time the
+ *         stack reads it. The RTU 3.5 character timeout then expires after just a few
+ *         polls, such that the benchmark mostly measures the actual processing.
+ */
+#define TBX_MB_LOOPBACK_TIMER_STEP     (10U)
+
+
+#endif /* TBX_CONF_H */
+/*********************************** end of tbx_conf.h *********************************/
@@ -0,0 +1,1551 @@
+/************************************************************************************//**
+* \file         tbxmb_bench.c
+* \brief        Modbus host benchmark source file.
+* \internal
+*----------------------------------------------------------------------------------------
+*                          C O P Y R I G H T
+*----------------------------------------------------------------------------------------
+*   Copyright (c) 2023 by Feaser     www.feaser.com     All rights reserved
+*
+*----------------------------------------------------------------------------------------
+*                            L I C E N S E
+*----------------------------------------------------------------------------------------
+*
+* SPDX-License-Identifier: GPL-3.0-or-later
+*
+* This file is part of MicroTBX-Modbus. MicroTBX-Modbus is free software: you can
+* redistribute it and/or modify it under the terms of the GNU General Public License as
+* published by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* MicroTBX-Modbus is distributed in the hope that it will be useful, but WITHOUT ANY
+* WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+* PARTICULAR PURPOSE. See the GNU General Public License for more details.
+*
+* You have received a copy of the GNU General Public License along with MicroTBX-Modbus.
+* If not, see www.gnu.org/licenses/.
+*
+* \endinternal
+****************************************************************************************/
+
+/****************************************************************************************
+* Include files
+****************************************************************************************/
+#include "microtbx.h"                            /* MicroTBX module                    */
+#include "microtbxmodbus.h"                      /* MicroTBX-Modbus module             */
+#include "tbxmb_crc_private.h"                   /* MicroTBX-Modbus CRC16 private      */
+#include "tbxmb_timer_private.h"                 /* MicroTBX-Modbus timer private      */
+#include "tbxmb_uart_private.h"                  /* MicroTBX-Modbus UART private       */
+#include "tbxmb_loopback.h"                      /* MicroTBX-Modbus loopback port      */
+#include <stdio.h>                               /* Standard I/O functions             */
+#include <stdlib.h>                              /* Standard library functions         */
+#include <string.h>                              /* String functions                   */
+#include <time.h>                                /* Time functions                     */
+
+
+/****************************************************************************************
+* Macro definitions
+****************************************************************************************/
+#ifndef TBX_MB_BENCH_ITERATIONS
+/** \brief Number of measured operations per benchmark. */
+#define TBX_MB_BENCH_ITERATIONS        (20000U)
+#endif
+
+/** \brief Number of operations to run before measuring, to warm up the caches. */
+#define TBX_MB_BENCH_WARMUP            (100U)
+
+/** \brief Node address of the server. */
+#define TBX_MB_BENCH_NODE              (1U)
+
+/** \brief Number of holding and input registers that the server supports. */
+#define TBX_MB_BENCH_NUM_REGS          (256U)
+
+/** \brief Number of coils and discrete inputs that the server supports. */
+#define TBX_MB_BENCH_NUM_BITS          (2048U)
+
+/** \brief User defined function code, that the server echoes back. */
+#define TBX_MB_BENCH_CUSTOM_FC         (65U)
+
+/** \brief Number of bytes for the CRC16 micro-benchmark. */
+#define TBX_MB_BENCH_CRC_LEN           (256U)
+
+/** \brief Number of CRC16 calculations per measured sample, to rise above the timer
+ *         resolution.
+ */
+#define TBX_MB_BENCH_CRC_CALLS         (64U)
+
+/** \brief Number of timers for the timer wheel micro-benchmark. Comparable to a gateway
+ *         with this many serial ports.
+ */
+#define TBX_MB_BENCH_TIMERS            (256U)
+
+/** \brief Timer period in ticks for the timer wheel micro-benchmark. This is the 3.5
+ *         character time at 9600 bits/sec.
+ */
+#define TBX_MB_BENCH_TIMER_PERIOD      (82U)
+
+/** \brief Number of timer ticks per measured sample, to rise above the timer
+ *         resolution.
+ */
+#define TBX_MB_BENCH_TIMER_TICKS       (64U)
+
+/** \brief Bit-reflected CRC16 polynomial without its x^16 term. */
+#define TBX_MB_BENCH_CRC_POLY          (0xA001U)
+
+/** \brief Check value of the Modbus RTU CRC16, which is the CRC16 of the ASCII string
+ *         "123456789".
+ */
+#define TBX_MB_BENCH_CRC_CHECK_VALUE   (0x4B37U)
+
+/** \brief Number of bytes in the data pattern of the CRC16 self-test. Long enough for
+ *         several blocks of eight bytes at each alignment.
+ */
+#define TBX_MB_BENCH_CRC_PATTERN_LEN   (40U)
+
+/** \brief Node address of the server in the LRC self-test. */
+#define TBX_MB_BENCH_LRC_NODE          (0x11U)
+
+/** \brief First holding register that the frames of the LRC self-test read. */
+#define TBX_MB_BENCH_LRC_ADDR          (0x006BU)
+
+/** \brief Number of holding registers that the frames of the LRC self-test read. */
+#define TBX_MB_BENCH_LRC_NUM_REGS      (3U)
+
+/** \brief Size of the buffer for the response of the LRC self-test. */
+#define TBX_MB_BENCH_LRC_RESP_LEN      (64U)
+
+
+/****************************************************************************************
+* Type definitions
+****************************************************************************************/
+/** \brief Function type for a single benchmarked operation. Returns TBX_OK if
+ *         successful and, for operations that read data, if the read data matches the
+ *         data tables of the server. Returns TBX_ERROR otherwise.
+ */
+typedef uint8_t (* tTbxMbBenchOp)(void);
+
+/** \brief Modbus RTU frame for the CRC16 self-test, including its CRC16. */
+typedef struct
+{
+  uint8_t const * data;                          /**< Frame bytes, CRC16 included.     */
+  uint16_t        len;                           /**< Number of bytes in the frame.    */
+} tTbxMbBenchCrcFrame;
+
+
+/****************************************************************************************
+* Function prototypes
+****************************************************************************************/
+static void               TbxMbBenchRun           (char const     * name,
+                                                   tTbxMbBenchOp    op,
+                                                   uint32_t         divider);
+static uint64_t           TbxMbBenchNow           (void);
+static int                TbxMbBenchCompare       (void const     * a,
+                                                   void const     * b);
+static uint8_t            TbxMbBenchFc01          (void);
+static uint8_t            TbxMbBenchFc01Packed    (void);
+static uint8_t            TbxMbBenchFc02          (void);
+static uint8_t            TbxMbBenchFc03Single    (void);
+static uint8_t            TbxMbBenchFc03          (void);
+static uint8_t            TbxMbBenchFc04          (void);
+static uint8_t            TbxMbBenchFc05          (void);
+static uint8_t            TbxMbBenchFc06          (void);
+static uint8_t            TbxMbBenchFc08          (void);
+static uint8_t            TbxMbBenchFc15          (void);
+static uint8_t            TbxMbBenchFc15Packed    (void);
+static uint8_t            TbxMbBenchFc16          (void);
+static uint8_t            TbxMbBenchFc20          (void);
+static uint8_t            TbxMbBenchFc21          (void);
+static uint8_t            TbxMbBenchFc22          (void);
+static uint8_t            TbxMbBenchFc23          (void);
+static uint8_t            TbxMbBenchFc24          (void);
+static uint8_t            TbxMbBenchFc43          (void);
+static uint8_t            TbxMbBenchCustom        (void);
+static uint8_t            TbxMbBenchCrc           (void);
+static uint8_t            TbxMbBenchTimer         (void);
+static uint8_t            TbxMbBenchSelfTest      (void);
+static uint8_t            TbxMbBenchSelfTestCrc   (void);
+static uint8_t            TbxMbBenchSelfTestLrc   (void);
+static uint16_t           TbxMbBenchCrcBitwise    (uint16_t         crc,
+                                                   uint8_t  const * data,
+                                                   uint16_t         len);
+static tTbxMbServerResult TbxMbBenchReadInput     (tTbxMbServer     channel,
+                                                   uint16_t         addr,
+                                                   uint8_t        * value);
+static tTbxMbServerResult TbxMbBenchReadCoil      (tTbxMbServer     channel,
+                                                   uint16_t         addr,
+                                                   uint8_t        * value);
+static tTbxMbServerResult TbxMbBenchWriteCoil     (tTbxMbServer     channel,
+                                                   uint16_t         addr,
+                                                   uint8_t          value);
+static tTbxMbServerResult TbxMbBenchReadCoils     (tTbxMbServer     channel,
+                                                   uint16_t         addr,
+                                                   uint16_t         num,
+                                                   uint8_t        * bits);
+static tTbxMbServerResult TbxMbBenchWriteCoils    (tTbxMbServer     channel,
+                                                   uint16_t         addr,
+                                                   uint16_t         num,
+                                                   uint8_t  const * bits);
+static tTbxMbServerResult TbxMbBenchReadInputReg  (tTbxMbServer     channel,
+                                                   uint16_t         addr,
+                                                   uint16_t       * value);
+static tTbxMbServerResult TbxMbBenchReadHoldingReg(tTbxMbServer     channel,
+                                                   uint16_t         addr,
+                                                   uint16_t       * value);
+static tTbxMbServerResult TbxMbBenchWriteHoldingReg(tTbxMbServer    channel,
+                                                   uint16_t         addr,
+                                                   uint16_t         value);
+static tTbxMbServerResult TbxMbBenchReadFileRecord(tTbxMbServer     channel,
+                                                   uint16_t         file,
+                                                   uint16_t         record,
+                                                   uint8_t          num,
+                                                   uint16_t       * values);
+static tTbxMbServerResult TbxMbBenchWriteFileRecord(tTbxMbServer    channel,
+                                                   uint16_t         file,
+                                                   uint16_t         record,
+                                                   uint8_t          num,
+                                                   uint16_t const * values);
+static uint8_t            TbxMbBenchCustomFunction(tTbxMbServer     channel,
+                                                   uint8_t  const * rxPdu,
+                                                   uint8_t        * txPdu,
+                                                   uint8_t        * len);
+static tTbxMbServerResult TbxMbBenchSelfTestReadReg(tTbxMbServer    channel,
+                                                   uint16_t         addr,
+                                                   uint16_t       * value);
+static void               TbxMbBenchSelfTestTxDone(tTbxMbUartPort   port);
+static void               TbxMbBenchSelfTestRxData(tTbxMbUartPort   port,
+                                                   uint8_t  const * data,
+                                                   uint8_t          len);
+
+
+/****************************************************************************************
+* Local constant declarations
+****************************************************************************************/
+/** \brief Device identification objects of the server. */
+static const tTbxMbServerDeviceIdObject benchDevIdObjects[] =
+{
+  { TBX_MB_DEVID_OBJ_VENDOR_NAME,          6U, (uint8_t const *)"Feaser"   },
+  { TBX_MB_DEVID_OBJ_PRODUCT_CODE,         8U, (uint8_t const *)"MicroTBX" },
+  { TBX_MB_DEVID_OBJ_MAJOR_MINOR_REVISION, 4U, (uint8_t const *)"V1.0"     }
+};
+
+/** \brief Data of the standard CRC16 check value. */
+static const uint8_t benchCrcCheckString[] =
+{
+  '1', '2', '3', '4', '5', '6', '7', '8', '9'
+};
+
+/** \brief Read holding registers request from the Modbus specification. */
+static const uint8_t benchCrcFrame1[] =
+{
+  0x11U, 0x03U, 0x00U, 0x6BU, 0x00U, 0x03U, 0x76U, 0x87U
+};
+
+/** \brief Write multiple registers request. */
+static const uint8_t benchCrcFrame2[] =
+{
+  0x01U, 0x10U, 0x00U, 0x01U, 0x00U, 0x02U, 0x04U, 0x00U, 0x0AU, 0x01U, 0x02U, 0x92U,
+  0x30U
+};
+
+/** \brief Read holding registers response with ten registers. */
+static const uint8_t benchCrcFrame3[] =
+{
+  0x01U, 0x03U, 0x14U, 0x00U, 0x00U, 0x01U, 0x01U, 0x02U, 0x02U, 0x03U, 0x03U, 0x04U,
+  0x04U, 0x05U, 0x05U, 0x06U, 0x06U, 0x07U, 0x07U, 0x08U, 0x08U, 0x09U, 0x09U, 0x0AU,
+  0x0AU, 0x65U, 0xB6U
+};
+
+/** \brief Modbus RTU frames of the CRC16 self-test. */
+static const tTbxMbBenchCrcFrame benchCrcFrames[] =
+{
+  { benchCrcFrame1, (uint16_t)sizeof(benchCrcFrame1) },
+  { benchCrcFrame2, (uint16_t)sizeof(benchCrcFrame2) },
+  { benchCrcFrame3, (uint16_t)sizeof(benchCrcFrame3) }
+};
+
+/** \brief Read holding registers request from the Modbus specification, as an ASCII
+ *         frame. Its LRC is 0x7E.
+ */
+static const char benchLrcFrame[] = ":1103006B00037E\r\n";
+
+/** \brief The same request as an ASCII frame, but with an incorrect LRC. */
+static const char benchLrcFrameBad[] = ":1103006B00037F\r\n";
+
+/** \brief Response to the request, with each register value set to its address. Its LRC
+ *         is 0xA2.
+ */
+static const char benchLrcResponse[] = ":110306006B006C006DA2\r\n";
+
+
+/****************************************************************************************
+* Local data declarations
+****************************************************************************************/
+/** \brief Handle of the client channel. */
+static tTbxMbClient benchClient;
+
+/** \brief Handle of the server channel. */
+static tTbxMbServer benchServer;
+
+/** \brief Total number of failed operations of all benchmarks, including the warm up. */
+static uint32_t benchFailures;
+
+/** \brief Measured durations in nanoseconds of the individual operations. */
+static uint64_t benchSamples[TBX_MB_BENCH_ITERATIONS];
+
+/** \brief Server side data table with the holding and input registers. */
+static uint16_t benchRegs[TBX_MB_BENCH_NUM_REGS];
+
+/** \brief Server side data table with the coils and discrete inputs. */
+static uint8_t benchBits[TBX_MB_BENCH_NUM_BITS];
+
+/** \brief Server side data table with the coils, packed eight to a byte. */
+static uint8_t benchPackedBits[TBX_MB_BENCH_NUM_BITS / 8U];
+
+/** \brief Client side buffer for register values. */
+static uint16_t benchClientRegs[TBX_MB_BENCH_NUM_REGS];
+
+/** \brief Client side buffer for coil and discrete input values. */
+static uint8_t benchClientBits[TBX_MB_BENCH_NUM_BITS];
+
+/** \brief Client side buffer for coil values, packed eight to a byte. */
+static uint8_t benchClientPackedBits[TBX_MB_BENCH_NUM_BITS / 8U];
+
+/** \brief Server side storage of the FIFO queue. */
+static uint16_t benchFifo[TBX_MB_FIFO_COUNT_MAX + 1U];
+
+/** \brief Data for the CRC16 micro-benchmark. */
+static uint8_t benchCrcData[TBX_MB_BENCH_CRC_LEN];
+
+/** \brief Sink for the CRC16 results, such that the compiler can't optimize the
+ *         calculation away.
+ */
+static volatile uint16_t benchCrcSink;
+
+/** \brief Number of holding register reads of the LRC self-test, that were in range. */
+static uint16_t benchLrcReads;
+
+/** \brief Received response of the LRC self-test. */
+static char benchLrcRespBuf[TBX_MB_BENCH_LRC_RESP_LEN];
+
+/** \brief Number of characters in the received response of the LRC self-test. */
+static uint8_t benchLrcRespLen;
+
+/** \brief Timer wheel for the timer wheel micro-benchmark. */
+static tTbxMbTimerWheel benchTimerWheel;
+
+/** \brief Timers for the timer wheel micro-benchmark. */
+static tTbxMbTimer benchTimers[TBX_MB_BENCH_TIMERS];
+
+/** \brief Current timer tick of the timer wheel micro-benchmark. */
+static uint16_t benchTimerNow;
+
+/** \brief Sink for the next deadline of the timer wheel, such that the compiler can't
+ *         optimize its calculation away.
+ */
+static volatile uint16_t benchTimerSink;
+
+
+/************************************************************************************//**
+** \brief     This is the entry point for the host benchmark. It connects a client and a
+**            server channel over the in-process loopback port and measures the latency
+**            and throughput of each supported function code. The loopback port runs at
+**            infinite speed, so the results reflect the processing time of the stack
+**            itself: client request building, RTU framing and CRC16, event handling,
+**            server dispatch and client response parsing.
+**            With the "--selftest" command line argument, it runs the self-test
+**            instead. This checks the calculations that the transport layers rely on
+**            against their reference implementations.
+** \param     argc Number of command line arguments.
+** \param     argv Array with the command line arguments.
+** \return    Program exit code. Non-zero if one or more operations or checks failed.
+**
+****************************************************************************************/
+int main(int argc, char * argv[])
+{
+  tTbxMbTp     clientTp;
+  tTbxMbTp     serverTp;
+  uint16_t     idx;
+
+  /* Only run the self-test, if requested on the command line. */
+  if ((argc > 1) && (strcmp(argv[1], "--selftest") == 0))
+  {
+    return (TbxMbBenchSelfTest() == TBX_OK) ? EXIT_SUCCESS : EXIT_FAILURE;
+  }
+  /* Initialize the data tables and the CRC16 data with a pattern. */
+  for (idx = 0U; idx < TBX_MB_BENCH_NUM_REGS; idx++)
+  {
+    benchRegs[idx] = (uint16_t)(idx * 257U);
+  }
+  for (idx = 0U; idx < TBX_MB_BENCH_NUM_BITS; idx++)
+  {
+    benchBits[idx] = ((idx % 3U) == 0U) ? TBX_ON : TBX_OFF;
+    benchClientBits[idx] = benchBits[idx];
+    if (benchBits[idx] == TBX_ON)
+    {
+      benchPackedBits[idx / 8U] |= (uint8_t)(1U << (idx % 8U));
+      benchClientPackedBits[idx / 8U] |= (uint8_t)(1U << (idx % 8U));
+    }
+  }
+  for (idx = 0U; idx < TBX_MB_BENCH_CRC_LEN; idx++)
+  {
+    benchCrcData[idx] = (uint8_t)((idx * 31U) + 7U);
+  }
+  /* Arm the timers of the timer wheel micro-benchmark with spread out deadlines. */
+  TbxMbTimerWheelInit(&benchTimerWheel);
+  benchTimerNow = TbxMbPortTimerCount();
+  for (idx = 0U; idx < TBX_MB_BENCH_TIMERS; idx++)
+  {
+    TbxMbTimerInit(&benchTimers[idx], NULL);
+    TbxMbTimerArm(&benchTimerWheel, &benchTimers[idx],
+                  (uint16_t)(benchTimerNow + 1U + (idx % TBX_MB_BENCH_TIMER_PERIOD)));
+  }
+  /* Transfers should not take any time, just the processing of the stack itself. */
+  TbxMbLoopbackSetInfiniteSpeed(TBX_TRUE);
+  /* Connect a client and a server channel over the loopback port pair. */
+  clientTp = TbxMbRtuCreate(0U, TBX_MB_UART_PORT1, TBX_MB_UART_115200BPS,
+                            TBX_MB_UART_1_STOPBITS, TBX_MB_EVEN_PARITY);
+  serverTp = TbxMbRtuCreate(TBX_MB_BENCH_NODE, TBX_MB_UART_PORT2,
+                            TBX_MB_UART_115200BPS, TBX_MB_UART_1_STOPBITS,
+                            TBX_MB_EVEN_PARITY);
+  benchClient = TbxMbClientCreate(clientTp, 1000U, 100U);
+  benchServer = TbxMbServerCreate(serverTp);
+  TbxMbServerSetCallbackReadInput(benchServer, TbxMbBenchReadInput);
+  TbxMbServerSetCallbackReadCoil(benchServer, TbxMbBenchReadCoil);
+  TbxMbServerSetCallbackWriteCoil(benchServer, TbxMbBenchWriteCoil);
+  TbxMbServerSetCallbackReadInputReg(benchServer, TbxMbBenchReadInputReg);
+  TbxMbServerSetCallbackReadHoldingReg(benchServer, TbxMbBenchReadHoldingReg);
+  TbxMbServerSetCallbackWriteHoldingReg(benchServer, TbxMbBenchWriteHoldingReg);
+  TbxMbServerSetCallbackReadFileRecord(benchServer, TbxMbBenchReadFileRecord);
+  TbxMbServerSetCallbackWriteFileRecord(benchServer, TbxMbBenchWriteFileRecord);
+  TbxMbServerSetCallbackCustomFunction(benchServer, TbxMbBenchCustomFunction);
+  TbxMbServerSetFifo(benchServer, 0U, benchFifo,
+                     (uint16_t)(sizeof(benchFifo) / sizeof(benchFifo[0])));
+  TbxMbServerSetDeviceIdObjects(benchServer, benchDevIdObjects,
+                                (uint16_t)(sizeof(benchDevIdObjects) /
+                                           sizeof(benchDevIdObjects[0])));
+  /* Have both channels complete their initialization, before the client transmits its
+   * first request. Otherwise the server, which is created last, might still wait for
+   * the end of its 3.5 character time gap and drop the request. Advancing the virtual
+   * timer by 10 milliseconds, well past this time gap, makes both initializations end
+   * in the same event task run.
+   */
+  TbxMbLoopbackTimerAdvance(200U);
+  TbxMbEventTask();
+
+  /* Run the benchmarks. */
+  (void)printf("%-28s %10s %10s %10s %12s %7s %7s\n", "benchmark", "mean ns/op",
+               "p50 ns", "p99 ns", "ops/s", "errors", "warmup");
+  TbxMbBenchRun("FC01 read 2000 coils", TbxMbBenchFc01, 1U);
+  TbxMbBenchRun("FC02 read 2000 inputs", TbxMbBenchFc02, 1U);
+  TbxMbBenchRun("FC03 read 1 holding reg", TbxMbBenchFc03Single, 1U);
+  TbxMbBenchRun("FC03 read 125 holding regs", TbxMbBenchFc03, 1U);
+  TbxMbBenchRun("FC04 read 125 input regs", TbxMbBenchFc04, 1U);
+  TbxMbBenchRun("FC05 write 1 coil", TbxMbBenchFc05, 1U);
+  TbxMbBenchRun("FC06 write 1 holding reg", TbxMbBenchFc06, 1U);
+  TbxMbBenchRun("FC08 diagnostics", TbxMbBenchFc08, 1U);
+  TbxMbBenchRun("FC15 write 1968 coils", TbxMbBenchFc15, 1U);
+  TbxMbBenchRun("FC16 write 123 holding regs", TbxMbBenchFc16, 1U);
+  TbxMbBenchRun("FC20 read 121 file records", TbxMbBenchFc20, 1U);
+  TbxMbBenchRun("FC21 write 122 file records", TbxMbBenchFc21, 1U);
+  TbxMbBenchRun("FC22 mask write 1 reg", TbxMbBenchFc22, 1U);
+  TbxMbBenchRun("FC23 read/write 125/121 regs", TbxMbBenchFc23, 1U);
+  TbxMbBenchRun("FC24 push and read 31 fifo", TbxMbBenchFc24, 1U);
+  TbxMbBenchRun("FC43 read basic device id", TbxMbBenchFc43, 1U);
+  TbxMbBenchRun("custom function echo", TbxMbBenchCustom, 1U);
+  TbxMbBenchRun("CRC16 256 bytes", TbxMbBenchCrc, TBX_MB_BENCH_CRC_CALLS);
+  TbxMbBenchRun("timer wheel 256 timers tick", TbxMbBenchTimer,
+                TBX_MB_BENCH_TIMER_TICKS);
+  /* Switch the server over to the packed coil callbacks and repeat the coil benchmarks
+   * with the packed client functions, such that the bits are copied a byte at a time
+   * on both ends.
+   */
+  TbxMbServerSetCallbackReadCoils(benchServer, TbxMbBenchReadCoils);
+  TbxMbServerSetCallbackWriteCoils(benchServer, TbxMbBenchWriteCoils);
+  TbxMbBenchRun("FC01 read 2000 coils packed", TbxMbBenchFc01Packed, 1U);
+  TbxMbBenchRun("FC15 write 1968 coils packed", TbxMbBenchFc15Packed, 1U);
+
+  /* Release the objects. */
+  TbxMbServerFree(benchServer);
+  TbxMbClientFree(benchClient);
+  TbxMbRtuFree(serverTp);
+  TbxMbRtuFree(clientTp);
+  return (benchFailures == 0U) ? EXIT_SUCCESS : EXIT_FAILURE;
+} /*** end of main ***/
+
+
+/************************************************************************************//**
+** \brief     Runs a benchmark and prints its results. Each operation is timed
+**            individually, such that the percentiles can be determined. Failed
+**            operations are counted separately for the warm up and the measurement.
+** \param     name Name of the benchmark.
+** \param     op The operation to benchmark.
+** \param     divider Number of operations that one call of op performs.
+**
+****************************************************************************************/
+static void TbxMbBenchRun(char const    * name,
+                          tTbxMbBenchOp   op,
+                          uint32_t        divider)
+{
+  uint32_t idx;
+  uint32_t errors = 0U;
+  uint32_t warmupErrors = 0U;
+  uint64_t total = 0U;
+  uint64_t start;
+
+  /* Warm up the caches and the branch predictors. */
+  for (idx = 0U; idx < TBX_MB_BENCH_WARMUP; idx++)
+  {
+    if (op() != TBX_OK)
+    {
+      warmupErrors++;
+    }
+  }
+  /* Time each operation individually. */
+  for (idx = 0U; idx < TBX_MB_BENCH_ITERATIONS; idx++)
+  {
+    start = TbxMbBenchNow();
+    if (op() != TBX_OK)
+    {
+      errors++;
+    }
+    benchSamples[idx] = (TbxMbBenchNow() - start) / divider;
+    total += benchSamples[idx];
+  }
+  /* Sort the samples to determine the percentiles. */
+  qsort(benchSamples, TBX_MB_BENCH_ITERATIONS, sizeof(benchSamples[0]),
+        TbxMbBenchCompare);
+  /* Print the results. */
+  (void)printf("%-28s %10.1f %10llu %10llu %12.0f %7lu %7lu\n", name,
+               (double)total / TBX_MB_BENCH_ITERATIONS,
+               (unsigned long long)benchSamples[TBX_MB_BENCH_ITERATIONS / 2U],
+               (unsigned long long)benchSamples[(TBX_MB_BENCH_ITERATIONS * 99U) / 100U],
+               (1e9 * TBX_MB_BENCH_ITERATIONS) / (double)total, (unsigned long)errors,
+               (unsigned long)warmupErrors);
+  benchFailures += errors + warmupErrors;
+} /*** end of TbxMbBenchRun ***/
+
+
+/************************************************************************************//**
+** \brief     Obtains the current time of the monotonic clock.
+** \return    Current time in nanoseconds.
+**
+****************************************************************************************/
+static uint64_t TbxMbBenchNow(void)
+{
+  struct timespec now;
+
+  (void)clock_gettime(CLOCK_MONOTONIC, &now);
+  return ((uint64_t)now.tv_sec * 1000000000U) + (uint64_t)now.tv_nsec;
+} /*** end of TbxMbBenchNow ***/
+
+
+/************************************************************************************//**
+** \brief     Sample comparison function for qsort().
+** \param     a Pointer to the first sample.
+** \param     b Pointer to the second sample.
+** \return    Negative, zero or positive if a is less than, equal to or greater than b.
+**
+****************************************************************************************/
+static int TbxMbBenchCompare(void const * a,
+                             void const * b)
+{
+  uint64_t sampleA = *(uint64_t const *)a;
+  uint64_t sampleB = *(uint64_t const *)b;
+
+  return (sampleA > sampleB) - (sampleA < sampleB);
+} /*** end of TbxMbBenchCompare ***/
+
+
+/************************************************************************************//**
+** \brief     Reads the maximum number of coils. Mostly exercises the bit packing and
+**            unpacking of the coil values.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+static uint8_t TbxMbBenchFc01(void)
+{
+  uint8_t result;
+
+  result = TbxMbClientReadCoils(benchClient, TBX_MB_BENCH_NODE, 0U, 2000U,
+                                benchClientBits);
+  if (memcmp(benchClientBits, benchBits, 2000U) != 0)
+  {
+    result = TBX_ERROR;
+  }
+  return result;
+} /*** end of TbxMbBenchFc01 ***/
+
+
+/************************************************************************************//**
+** \brief     Reads the maximum number of coils into a packed bit array.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+static uint8_t TbxMbBenchFc01Packed(void)
+{
+  uint8_t result;
+
+  result = TbxMbClientReadCoilsPacked(benchClient, TBX_MB_BENCH_NODE, 0U, 2000U,
+                                      benchClientPackedBits);
+  if (memcmp(benchClientPackedBits, benchPackedBits, 2000U / 8U) != 0)
+  {
+    result = TBX_ERROR;
+  }
+  return result;
+} /*** end of TbxMbBenchFc01Packed ***/
+
+
+/************************************************************************************//**
+** \brief     Reads the maximum number of discrete inputs.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+static uint8_t TbxMbBenchFc02(void)
+{
+  uint8_t result;
+
+  result = TbxMbClientReadInputs(benchClient, TBX_MB_BENCH_NODE, 0U, 2000U,
+                                 benchClientBits);
+  if (memcmp(benchClientBits, benchBits, 2000U) != 0)
+  {
+    result = TBX_ERROR;
+  }
+  return result;
+} /*** end of TbxMbBenchFc02 ***/
+
+
+/************************************************************************************//**
+** \brief     Reads a single holding register. Shows the fixed overhead of a transaction.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+static uint8_t TbxMbBenchFc03Single(void)
+{
+  uint8_t result;
+
+  result = TbxMbClientReadHoldingRegs(benchClient, TBX_MB_BENCH_NODE, 0U, 1U,
+                                      benchClientRegs);
+  if (benchClientRegs[0] != benchRegs[0])
+  {
+    result = TBX_ERROR;
+  }
+  return result;
+} /*** end of TbxMbBenchFc03Single ***/
+
+
+/************************************************************************************//**
+** \brief     Reads the maximum number of holding registers.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+static uint8_t TbxMbBenchFc03(void)
+{
+  uint8_t result;
+
+  result = TbxMbClientReadHoldingRegs(benchClient, TBX_MB_BENCH_NODE, 0U, 125U,
+                                      benchClientRegs);
+  if (memcmp(benchClientRegs, benchRegs, 125U * sizeof(uint16_t)) != 0)
+  {
+    result = TBX_ERROR;
+  }
+  return result;
+} /*** end of TbxMbBenchFc03 ***/
+
+
+/************************************************************************************//**
+** \brief     Reads the maximum number of input registers.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+static uint8_t TbxMbBenchFc04(void)
+{
+  uint8_t result;
+
+  result = TbxMbClientReadInputRegs(benchClient, TBX_MB_BENCH_NODE, 0U, 125U,
+                                    benchClientRegs);
+  if (memcmp(benchClientRegs, benchRegs, 125U * sizeof(uint16_t)) != 0)
+  {
+    result = TBX_ERROR;
+  }
+  return result;
+} /*** end of TbxMbBenchFc04 ***/
+
+
+/************************************************************************************//**
+** \brief     Writes a single coil.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+static uint8_t TbxMbBenchFc05(void)
+{
+  return TbxMbClientWriteCoils(benchClient, TBX_MB_BENCH_NODE, 0U, 1U,
+                               benchClientBits);
+} /*** end of TbxMbBenchFc05 ***/
+
+
+/************************************************************************************//**
+** \brief     Writes a single holding register.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+static uint8_t TbxMbBenchFc06(void)
+{
+  return TbxMbClientWriteHoldingRegs(benchClient, TBX_MB_BENCH_NODE, 0U, 1U,
+                                     benchClientRegs);
+} /*** end of TbxMbBenchFc06 ***/
+
+
+/************************************************************************************//**
+** \brief     Reads the bus message count with the diagnostics function code.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+static uint8_t TbxMbBenchFc08(void)
+{
+  uint16_t count = 0U;
+
+  return TbxMbClientDiagnostics(benchClient, TBX_MB_BENCH_NODE,
+                                TBX_MB_DIAG_SC_BUS_MESSAGE_COUNT, &count);
+} /*** end of TbxMbBenchFc08 ***/
+
+
+/************************************************************************************//**
+** \brief     Writes the maximum number of coils. Mostly exercises the bit packing and
+**            unpacking of the coil values.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+static uint8_t TbxMbBenchFc15(void)
+{
+  return TbxMbClientWriteCoils(benchClient, TBX_MB_BENCH_NODE, 0U, 1968U,
+                               benchClientBits);
+} /*** end of TbxMbBenchFc15 ***/
+
+
+/************************************************************************************//**
+** \brief     Writes the maximum number of coils from a packed bit array.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+static uint8_t TbxMbBenchFc15Packed(void)
+{
+  return TbxMbClientWriteCoilsPacked(benchClient, TBX_MB_BENCH_NODE, 0U, 1968U,
+                                     benchClientPackedBits);
+} /*** end of TbxMbBenchFc15Packed ***/
+
+
+/************************************************************************************//**
+** \brief     Writes the maximum number of holding registers.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+static uint8_t TbxMbBenchFc16(void)
+{
+  return TbxMbClientWriteHoldingRegs(benchClient, TBX_MB_BENCH_NODE, 0U, 123U,
+                                     benchClientRegs);
+} /*** end of TbxMbBenchFc16 ***/
+
+
+/************************************************************************************//**
+** \brief     Modifies the bits of a single holding register, using an AND and OR mask.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+static uint8_t TbxMbBenchFc22(void)
+{
+  return TbxMbClientMaskWriteReg(benchClient, TBX_MB_BENCH_NODE, 0U, 0xF0F0U, 0x0505U);
+} /*** end of TbxMbBenchFc22 ***/
+
+
+/************************************************************************************//**
+** \brief     Reads the maximum number of file records that fit in a single request.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+static uint8_t TbxMbBenchFc20(void)
+{
+  uint8_t result;
+
+  result = TbxMbClientReadFileRecord(benchClient, TBX_MB_BENCH_NODE, 1U, 0U, 121U,
+                                     benchClientRegs);
+  if (memcmp(benchClientRegs, benchRegs, 121U * sizeof(uint16_t)) != 0)
+  {
+    result = TBX_ERROR;
+  }
+  return result;
+} /*** end of TbxMbBenchFc20 ***/
+
+
+/************************************************************************************//**
+** \brief     Writes the maximum number of file records that fit in a single request.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+static uint8_t TbxMbBenchFc21(void)
+{
+  return TbxMbClientWriteFileRecord(benchClient, TBX_MB_BENCH_NODE, 1U, 0U, 122U,
+                                    benchClientRegs);
+} /*** end of TbxMbBenchFc21 ***/
+
+
+/************************************************************************************//**
+** \brief     Writes and reads the maximum number of holding registers, using a single
+**            request.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+static uint8_t TbxMbBenchFc23(void)
+{
+  uint8_t  result;
+  uint16_t regs[125U];
+
+  result = TbxMbClientReadWriteHoldingRegs(benchClient, TBX_MB_BENCH_NODE, 0U, 125U,
+                                           regs, 0U, 121U, benchClientRegs);
+  /* The server performs the write before the read, so the read registers should match
+   * its data table.
+   */
+  if (memcmp(regs, benchRegs, sizeof(regs)) != 0)
+  {
+    result = TBX_ERROR;
+  }
+  return result;
+} /*** end of TbxMbBenchFc23 ***/
+
+
+/************************************************************************************//**
+** \brief     Fills the FIFO queue of the server and drains it again, using a single
+**            request.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+static uint8_t TbxMbBenchFc24(void)
+{
+  uint8_t result = TBX_OK;
+  uint8_t count  = 0U;
+  uint8_t idx;
+
+  for (idx = 0U; idx < TBX_MB_FIFO_COUNT_MAX; idx++)
+  {
+    if (TbxMbServerFifoPush(benchServer, benchRegs[idx]) != TBX_OK)
+    {
+      result = TBX_ERROR;
+    }
+  }
+  if (TbxMbClientReadFifo(benchClient, TBX_MB_BENCH_NODE, 0U, benchClientRegs,
+                          &count) != TBX_OK)
+  {
+    result = TBX_ERROR;
+  }
+  if ((count != TBX_MB_FIFO_COUNT_MAX) ||
+      (memcmp(benchClientRegs, benchRegs,
+              TBX_MB_FIFO_COUNT_MAX * sizeof(uint16_t)) != 0))
+  {
+    result = TBX_ERROR;
+  }
+  return result;
+} /*** end of TbxMbBenchFc24 ***/
+
+
+/************************************************************************************//**
+** \brief     Reads the basic device identification objects.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+static uint8_t TbxMbBenchFc43(void)
+{
+  uint8_t  result;
+  uint8_t  objects[TBX_MB_TP_PDU_DATA_LEN_MAX];
+  uint16_t len = (uint16_t)sizeof(objects);
+  uint16_t bufIdx = 0U;
+  uint16_t objIdx;
+
+  result = TbxMbClientReadDeviceId(benchClient, TBX_MB_BENCH_NODE,
+                                   TBX_MB_DEVID_CODE_BASIC, 0U, objects, &len);
+  /* Compare the read objects, each stored as its id, length and value, with the ones of
+   * the server.
+   */
+  for (objIdx = 0U; objIdx < (sizeof(benchDevIdObjects) / sizeof(benchDevIdObjects[0]));
+       objIdx++)
+  {
+    tTbxMbServerDeviceIdObject const * object = &benchDevIdObjects[objIdx];
+
+    if (((bufIdx + 2U + object->len) > len) || (objects[bufIdx] != object->id) ||
+        (objects[bufIdx + 1U] != object->len) ||
+        (memcmp(&objects[bufIdx + 2U], object->value, object->len) != 0))
+    {
+      result = TBX_ERROR;
+    }
+    bufIdx += 2U + object->len;
+  }
+  if (bufIdx != len)
+  {
+    result = TBX_ERROR;
+  }
+  return result;
+} /*** end of TbxMbBenchFc43 ***/
+
+
+/************************************************************************************//**
+** \brief     Sends a user defined function code with some data, which the server echoes
+**            back.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+static uint8_t TbxMbBenchCustom(void)
+{
+  uint8_t const txPdu[] = { TBX_MB_BENCH_CUSTOM_FC, 0x12U, 0x34U, 0x56U, 0x78U };
+  uint8_t       rxPdu[TBX_MB_TP_PDU_MAX_LEN];
+  uint8_t       len = (uint8_t)sizeof(txPdu);
+  uint8_t       result;
+
+  result = TbxMbClientCustomFunction(benchClient, TBX_MB_BENCH_NODE, txPdu, rxPdu, &len);
+  if ((len != sizeof(txPdu)) || (memcmp(rxPdu, txPdu, sizeof(txPdu)) != 0))
+  {
+    result = TBX_ERROR;
+  }
+  return result;
+} /*** end of TbxMbBenchCustom ***/
+
+
+/************************************************************************************//**
+** \brief     Micro-benchmark of the CRC16 calculation, as used by the RTU transport
+**            layer.
+** \return    TBX_OK.
+**
+****************************************************************************************/
+static uint8_t TbxMbBenchCrc(void)
+{
+  uint32_t idx;
+
+  for (idx = 0U; idx < TBX_MB_BENCH_CRC_CALLS; idx++)
+  {
+    benchCrcSink = TbxMbCrcUpdate(TBX_MB_CRC_INIT, benchCrcData, TBX_MB_BENCH_CRC_LEN);
+  }
+  return TBX_OK;
+} /*** end of TbxMbBenchCrc ***/
+
+
+/************************************************************************************//**
+** \brief     Timer wheel micro-benchmark. Processes timer ticks the same way as the
+**            event task does, with all timers armed. During each tick, one timer is
+**            restarted, like a transport layer that receives a byte, and the expired
+**            timers are armed again for the next period.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+static uint8_t TbxMbBenchTimer(void)
+{
+  uint32_t      idx;
+  tTbxMbTimer * timer;
+  uint16_t      deadline = 0U;
+
+  for (idx = 0U; idx < TBX_MB_BENCH_TIMER_TICKS; idx++)
+  {
+    benchTimerNow++;
+    TbxMbTimerArm(&benchTimerWheel, &benchTimers[benchTimerNow % TBX_MB_BENCH_TIMERS],
+                  (uint16_t)(benchTimerNow + TBX_MB_BENCH_TIMER_PERIOD));
+    timer = TbxMbTimerExpired(&benchTimerWheel, benchTimerNow);
+    while (timer != NULL)
+    {
+      TbxMbTimerArm(&benchTimerWheel, timer,
+                    (uint16_t)(benchTimerNow + TBX_MB_BENCH_TIMER_PERIOD));
+      timer = TbxMbTimerExpired(&benchTimerWheel, benchTimerNow);
+    }
+    (void)TbxMbTimerNext(&benchTimerWheel, &deadline);
+    benchTimerSink = deadline;
+  }
+  return TBX_OK;
+} /*** end of TbxMbBenchTimer ***/
+
+
+/************************************************************************************//**
+** \brief     Runs the self-test and prints its results.
+** \return    TBX_OK if all checks passed, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+static uint8_t TbxMbBenchSelfTest(void)
+{
+  uint8_t result = TBX_OK;
+
+  if (TbxMbBenchSelfTestCrc() != TBX_OK)
+  {
+    result = TBX_ERROR;
+  }
+  if (TbxMbBenchSelfTestLrc() != TBX_OK)
+  {
+    result = TBX_ERROR;
+  }
+  return result;
+} /*** end of TbxMbBenchSelfTest ***/
+
+
+/************************************************************************************//**
+** \brief     Self-test of the CRC16 calculation with the configured backend. It compares
+**            the results of TbxMbCrcUpdate() with the bitwise reference implementation,
+**            for the standard check string, for a few Modbus RTU frames, for each lookup
+**            table entry and for all lengths of a data pattern at each alignment.
+** \return    TBX_OK if all checks passed, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+static uint8_t TbxMbBenchSelfTestCrc(void)
+{
+  uint8_t  pattern[TBX_MB_BENCH_CRC_PATTERN_LEN];
+  uint8_t  block[8];
+  uint32_t checks = 0U;
+  uint32_t errors = 0U;
+  uint16_t idx;
+  uint16_t len;
+  uint8_t  offset;
+
+  /* Select the kernel of the configured backend. */
+  TbxMbCrcInit();
+  /* Both the reference and the kernel must calculate the standard check value. */
+  checks++;
+  if ( (TbxMbBenchCrcBitwise(TBX_MB_CRC_INIT, benchCrcCheckString,
+                             (uint16_t)sizeof(benchCrcCheckString)) !=
+        TBX_MB_BENCH_CRC_CHECK_VALUE) ||
+       (TbxMbCrcUpdate(TBX_MB_CRC_INIT, benchCrcCheckString,
+                       (uint16_t)sizeof(benchCrcCheckString)) !=
+        TBX_MB_BENCH_CRC_CHECK_VALUE) )
+  {
+    errors++;
+  }
+  /* The CRC16 of the frames must match the one in the frame, which is low byte first.
+   * The CRC16 over the frame, including its CRC16, always adds up to zero.
+   */
+  for (idx = 0U; idx < (sizeof(benchCrcFrames) / sizeof(benchCrcFrames[0])); idx++)
+  {
+    uint8_t  const * data = benchCrcFrames[idx].data;
+    uint16_t         crc;
+
+    len = benchCrcFrames[idx].len;
+    crc = TbxMbCrcUpdate(TBX_MB_CRC_INIT, data, len - 2U);
+    checks++;
+    if ( (crc != TbxMbBenchCrcBitwise(TBX_MB_CRC_INIT, data, len - 2U)) ||
+         (crc != (uint16_t)(data[len - 2U] | ((uint16_t)data[len - 1U] << 8U))) ||
+         (TbxMbCrcUpdate(TBX_MB_CRC_INIT, data, len) != 0U) )
+    {
+      errors++;
+    }
+  }
+  /* Entry n of lookup table t is the CRC16 of byte n, followed by t zero bytes. A block
+   * of eight bytes with just byte n at each position, starting at zero, uses each entry
+   * of each lookup table, regardless of the backend.
+   */
+  for (offset = 0U; offset < 8U; offset++)
+  {
+    for (idx = 0U; idx < 256U; idx++)
+    {
+      (void)memset(block, 0, sizeof(block));
+      block[offset] = (uint8_t)idx;
+      checks++;
+      if (TbxMbCrcUpdate(0U, block, 8U) != TbxMbBenchCrcBitwise(0U, block, 8U))
+      {
+        errors++;
+      }
+    }
+  }
+  /* Check all lengths at each alignment. This exercises both the block processing and
+   * the processing of the remaining bytes.
+   */
+  for (idx = 0U; idx < TBX_MB_BENCH_CRC_PATTERN_LEN; idx++)
+  {
+    pattern[idx] = (uint8_t)((idx * 167U) + 13U);
+  }
+  for (offset = 0U; offset < 8U; offset++)
+  {
+    for (len = 0U; len <= (TBX_MB_BENCH_CRC_PATTERN_LEN - 8U); len++)
+    {
+      checks++;
+      if (TbxMbCrcUpdate(TBX_MB_CRC_INIT, &pattern[offset], len) !=
+          TbxMbBenchCrcBitwise(TBX_MB_CRC_INIT, &pattern[offset], len))
+      {
+        errors++;
+      }
+    }
+  }
+  (void)printf("%-28s %7lu checks %7lu errors\n", "CRC16 self-test",
+               (unsigned long)checks, (unsigned long)errors);
+  return (errors == 0U) ? TBX_OK : TBX_ERROR;
+} /*** end of TbxMbBenchSelfTestCrc ***/
+
+
+/************************************************************************************//**
+** \brief     Self-test of the LRC calculation of the ASCII transport layer. It sends a
+**            request from the Modbus specification to an ASCII server, first with its
+**            correct LRC and then with an incorrect one. The server must only process
+**            and respond to the request with the correct LRC. Its response must match
+**            the one with the known LRC.
+** \return    TBX_OK if all checks passed, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+static uint8_t TbxMbBenchSelfTestLrc(void)
+{
+  tTbxMbTp     serverTp;
+  tTbxMbServer server;
+  uint32_t     checks = 0U;
+  uint32_t     errors = 0U;
+  uint8_t      idx;
+
+  /* Create an ASCII server on one port of a loopback port pair. Send requests and
+   * receive responses directly on the other port.
+   */
+  serverTp = TbxMbAsciiCreate(TBX_MB_BENCH_LRC_NODE, TBX_MB_UART_PORT3,
+                              TBX_MB_UART_19200BPS, TBX_MB_UART_1_STOPBITS,
+                              TBX_MB_EVEN_PARITY);
+  server = TbxMbServerCreate(serverTp);
+  TbxMbServerSetCallbackReadHoldingReg(server, TbxMbBenchSelfTestReadReg);
+  TbxMbUartInit(TBX_MB_UART_PORT4, TBX_MB_UART_19200BPS, TBX_MB_UART_7_DATABITS,
+                TBX_MB_UART_1_STOPBITS, TBX_MB_EVEN_PARITY, TbxMbBenchSelfTestTxDone,
+                TbxMbBenchSelfTestRxData);
+  /* The request with the correct LRC must read all its registers. */
+  benchLrcReads = 0U;
+  benchLrcRespLen = 0U;
+  (void)TbxMbUartTransmit(TBX_MB_UART_PORT4, (uint8_t const *)benchLrcFrame,
+                          (uint16_t)strlen(benchLrcFrame));
+  for (idx = 0U; idx < 10U; idx++)
+  {
+    TbxMbEventTask();
+  }
+  checks++;
+  if ( (benchLrcReads != TBX_MB_BENCH_LRC_NUM_REGS) ||
+       (benchLrcRespLen != strlen(benchLrcResponse)) ||
+       (memcmp(benchLrcRespBuf, benchLrcResponse, benchLrcRespLen) != 0) )
+  {
+    errors++;
+  }
+  /* The request with the incorrect LRC must be discarded. */
+  benchLrcReads = 0U;
+  benchLrcRespLen = 0U;
+  (void)TbxMbUartTransmit(TBX_MB_UART_PORT4, (uint8_t const *)benchLrcFrameBad,
+                          (uint16_t)strlen(benchLrcFrameBad));
+  for (idx = 0U; idx < 10U; idx++)
+  {
+    TbxMbEventTask();
+  }
+  checks++;
+  if ((benchLrcReads != 0U) || (benchLrcRespLen != 0U))
+  {
+    errors++;
+  }
+  /* Release the objects. */
+  TbxMbServerFree(server);
+  TbxMbAsciiFree(serverTp);
+  (void)printf("%-28s %7lu checks %7lu errors\n", "LRC self-test",
+               (unsigned long)checks, (unsigned long)errors);
+  return (errors == 0U) ? TBX_OK : TBX_ERROR;
+} /*** end of TbxMbBenchSelfTestLrc ***/
+
+
+/************************************************************************************//**
+** \brief     Reference CRC16 calculation that processes one bit at a time. Too slow for
+**            actual use, but it directly follows the definition of the Modbus RTU CRC16.
+** \param     crc The CRC16 checksum value calculated so far.
+** \param     data Pointer to the byte array with data.
+** \param     len Number of data bytes to include in the CRC16 calculation.
+** \return    The updated CRC16 checksum value.
+**
+****************************************************************************************/
+static uint16_t TbxMbBenchCrcBitwise(uint16_t         crc,
+                                     uint8_t  const * data,
+                                     uint16_t         len)
+{
+  uint16_t result = crc;
+  uint16_t idx;
+  uint8_t  bitIdx;
+
+  for (idx = 0U; idx < len; idx++)
+  {
+    /* Add the byte to the lower bits of the CRC16. */
+    result ^= data[idx];
+    /* Shift out its bits one at a time, dividing by the polynomial on a carry. */
+    for (bitIdx = 0U; bitIdx < 8U; bitIdx++)
+    {
+      if ((result & 0x0001U) != 0U)
+      {
+        result = (uint16_t)((result >> 1U) ^ TBX_MB_BENCH_CRC_POLY);
+      }
+      else
+      {
+        result >>= 1U;
+      }
+    }
+  }
+  return result;
+} /*** end of TbxMbBenchCrcBitwise ***/
+
+
+/************************************************************************************//**
+** \brief     Server callback for reading a discrete input.
+** \param     channel Handle to the Modbus server channel object that triggered the
+**            callback.
+** \param     addr Element address (0..65535).
+** \param     value Pointer to write the value of the input to.
+** \return    TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR
+**            otherwise.
+**
+****************************************************************************************/
+static tTbxMbServerResult TbxMbBenchReadInput(tTbxMbServer   channel,
+                                              uint16_t       addr,
+                                              uint8_t      * value)
+{
+  tTbxMbServerResult result = TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR;
+
+  TBX_UNUSED_ARG(channel);
+  if (addr < TBX_MB_BENCH_NUM_BITS)
+  {
+    *value = benchBits[addr];
+    result = TBX_MB_SERVER_OK;
+  }
+  return result;
+} /*** end of TbxMbBenchReadInput ***/
+
+
+/************************************************************************************//**
+** \brief     Server callback for reading a coil.
+** \param     channel Handle to the Modbus server channel object that triggered the
+**            callback.
+** \param     addr Element address (0..65535).
+** \param     value Pointer to write the value of the coil to.
+** \return    TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR
+**            otherwise.
+**
+****************************************************************************************/
+static tTbxMbServerResult TbxMbBenchReadCoil(tTbxMbServer   channel,
+                                             uint16_t       addr,
+                                             uint8_t      * value)
+{
+  tTbxMbServerResult result = TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR;
+
+  TBX_UNUSED_ARG(channel);
+  if (addr < TBX_MB_BENCH_NUM_BITS)
+  {
+    *value = benchBits[addr];
+    result = TBX_MB_SERVER_OK;
+  }
+  return result;
+} /*** end of TbxMbBenchReadCoil ***/
+
+
+/************************************************************************************//**
+** \brief     Server callback for writing a coil.
+** \param     channel Handle to the Modbus server channel object that triggered the
+**            callback.
+** \param     addr Element address (0..65535).
+** \param     value Coil value.
+** \return    TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR
+**            otherwise.
+**
+****************************************************************************************/
+static tTbxMbServerResult TbxMbBenchWriteCoil(tTbxMbServer channel,
+                                              uint16_t     addr,
+                                              uint8_t      value)
+{
+  tTbxMbServerResult result = TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR;
+
+  TBX_UNUSED_ARG(channel);
+  if (addr < TBX_MB_BENCH_NUM_BITS)
+  {
+    benchBits[addr] = value;
+    result = TBX_MB_SERVER_OK;
+  }
+  return result;
+} /*** end of TbxMbBenchWriteCoil ***/
+
+
+/************************************************************************************//**
+** \brief     Server callback for reading a range of coils into a packed bit array.
+** \param     channel Handle to the Modbus server channel object that triggered the
+**            callback.
+** \param     addr Address of the first element (0..65535).
+** \param     num Number of elements to read.
+** \param     bits Packed bit array to write the states of the coils to.
+** \return    TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR
+**            otherwise.
+**
+****************************************************************************************/
+static tTbxMbServerResult TbxMbBenchReadCoils(tTbxMbServer   channel,
+                                              uint16_t       addr,
+                                              uint16_t       num,
+                                              uint8_t      * bits)
+{
+  tTbxMbServerResult result = TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR;
+
+  TBX_UNUSED_ARG(channel);
+  if (((uint32_t)addr + num) <= TBX_MB_BENCH_NUM_BITS)
+  {
+    TbxMbCommonCopyBits(bits, 0U, benchPackedBits, addr, num);
+    result = TBX_MB_SERVER_OK;
+  }
+  return result;
+} /*** end of TbxMbBenchReadCoils ***/
+
+
+/************************************************************************************//**
+** \brief     Server callback for writing a range of coils from a packed bit array.
+** \param     channel Handle to the Modbus server channel object that triggered the
+**            callback.
+** \param     addr Address of the first element (0..65535).
+** \param     num Number of elements to write.
+** \param     bits Packed bit array with the states of the coils.
+** \return    TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR
+**            otherwise.
+**
+****************************************************************************************/
+static tTbxMbServerResult TbxMbBenchWriteCoils(tTbxMbServer         channel,
+                                               uint16_t             addr,
+                                               uint16_t             num,
+                                               uint8_t      const * bits)
+{
+  tTbxMbServerResult result = TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR;
+
+  TBX_UNUSED_ARG(channel);
+  if (((uint32_t)addr + num) <= TBX_MB_BENCH_NUM_BITS)
+  {
+    TbxMbCommonCopyBits(benchPackedBits, addr, bits, 0U, num);
+    result = TBX_MB_SERVER_OK;
+  }
+  return result;
+} /*** end of TbxMbBenchWriteCoils ***/
+
+
+/************************************************************************************//**
+** \brief     Server callback for reading an input register.
+** \param     channel Handle to the Modbus server channel object that triggered the
+**            callback.
+** \param     addr Element address (0..65535).
+** \param     value Pointer to write the value of the input register to.
+** \return    TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR
+**            otherwise.
+**
+****************************************************************************************/
+static tTbxMbServerResult TbxMbBenchReadInputReg(tTbxMbServer   channel,
+                                                 uint16_t       addr,
+                                                 uint16_t     * value)
+{
+  tTbxMbServerResult result = TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR;
+
+  TBX_UNUSED_ARG(channel);
+  if (addr < TBX_MB_BENCH_NUM_REGS)
+  {
+    *value = benchRegs[addr];
+    result = TBX_MB_SERVER_OK;
+  }
+  return result;
+} /*** end of TbxMbBenchReadInputReg ***/
+
+
+/************************************************************************************//**
+** \brief     Server callback for reading a holding register.
+** \param     channel Handle to the Modbus server channel object that triggered the
+**            callback.
+** \param     addr Element address (0..65535).
+** \param     value Pointer to write the value of the holding register to.
+** \return    TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR
+**            otherwise.
+**
+****************************************************************************************/
+static tTbxMbServerResult TbxMbBenchReadHoldingReg(tTbxMbServer   channel,
+                                                   uint16_t       addr,
+                                                   uint16_t     * value)
+{
+  tTbxMbServerResult result = TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR;
+
+  TBX_UNUSED_ARG(channel);
+  if (addr < TBX_MB_BENCH_NUM_REGS)
+  {
+    *value = benchRegs[addr];
+    result = TBX_MB_SERVER_OK;
+  }
+  return result;
+} /*** end of TbxMbBenchReadHoldingReg ***/
+
+
+/************************************************************************************//**
+** \brief     Server callback for writing a holding register.
+** \param     channel Handle to the Modbus server channel object that triggered the
+**            callback.
+** \param     addr Element address (0..65535).
+** \param     value Value of the holding register.
+** \return    TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR
+**            otherwise.
+**
+****************************************************************************************/
+static tTbxMbServerResult TbxMbBenchWriteHoldingReg(tTbxMbServer channel,
+                                                    uint16_t     addr,
+                                                    uint16_t     value)
+{
+  tTbxMbServerResult result = TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR;
+
+  TBX_UNUSED_ARG(channel);
+  if (addr < TBX_MB_BENCH_NUM_REGS)
+  {
+    benchRegs[addr] = value;
+    result = TBX_MB_SERVER_OK;
+  }
+  return result;
+} /*** end of TbxMbBenchWriteHoldingReg ***/
+
+
+/************************************************************************************//**
+** \brief     Server callback for reading file records. File 1 maps onto the registers
+**            data table.
+** \param     channel Handle to the Modbus server channel object that triggered the
+**            callback.
+** \param     file Number of the file.
+** \param     record Number of the first record in the file.
+** \param     num Number of records to read.
+** \param     values Array where to store the values of the records.
+** \return    TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR
+**            otherwise.
+**
+****************************************************************************************/
+static tTbxMbServerResult TbxMbBenchReadFileRecord(tTbxMbServer   channel,
+                                                   uint16_t       file,
+                                                   uint16_t       record,
+                                                   uint8_t        num,
+                                                   uint16_t     * values)
+{
+  tTbxMbServerResult result = TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR;
+
+  TBX_UNUSED_ARG(channel);
+  if ((file == 1U) && (((uint32_t)record + num) <= TBX_MB_BENCH_NUM_REGS))
+  {
+    (void)memcpy(values, &benchRegs[record], num * sizeof(uint16_t));
+    result = TBX_MB_SERVER_OK;
+  }
+  return result;
+} /*** end of TbxMbBenchReadFileRecord ***/
+
+
+/************************************************************************************//**
+** \brief     Server callback for writing file records. File 1 maps onto the registers
+**            data table.
+** \param     channel Handle to the Modbus server channel object that triggered the
+**            callback.
+** \param     file Number of the file.
+** \param     record Number of the first record in the file.
+** \param     num Number of records to write.
+** \param     values Array with the values of the records.
+** \return    TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR
+**            otherwise.
+**
+****************************************************************************************/
+static tTbxMbServerResult TbxMbBenchWriteFileRecord(tTbxMbServer         channel,
+                                                    uint16_t             file,
+                                                    uint16_t             record,
+                                                    uint8_t              num,
+                                                    uint16_t     const * values)
+{
+  tTbxMbServerResult result = TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR;
+
+  TBX_UNUSED_ARG(channel);
+  if ((file == 1U) && (((uint32_t)record + num) <= TBX_MB_BENCH_NUM_REGS))
+  {
+    (void)memcpy(&benchRegs[record], values, num * sizeof(uint16_t));
+    result = TBX_MB_SERVER_OK;
+  }
+  return result;
+} /*** end of TbxMbBenchWriteFileRecord ***/
+
+
+/************************************************************************************//**
+** \brief     Server callback for the user defined function code. It echoes the request
+**            back as the response.
+** \param     channel Handle to the Modbus server channel object that triggered the
+**            callback.
+** \param     rxPdu Pointer to a byte array with the PDU of the received request.
+** \param     txPdu Pointer to a byte array to write the response PDU to.
+** \param     len Pointer to the PDU length, including the function code.
+** \return    TBX_TRUE if the callback function handled the received function code,
+**            TBX_FALSE otherwise.
+**
+****************************************************************************************/
+static uint8_t TbxMbBenchCustomFunction(tTbxMbServer         channel,
+                                        uint8_t      const * rxPdu,
+                                        uint8_t            * txPdu,
+                                        uint8_t            * len)
+{
+  uint8_t result = TBX_FALSE;
+  uint8_t idx;
+
+  TBX_UNUSED_ARG(channel);
+  if (rxPdu[0] == TBX_MB_BENCH_CUSTOM_FC)
+  {
+    for (idx = 0U; idx < *len; idx++)
+    {
+      txPdu[idx] = rxPdu[idx];
+    }
+    result = TBX_TRUE;
+  }
+  return result;
+} /*** end of TbxMbBenchCustomFunction ***/
+
+
+/************************************************************************************//**
+** \brief     Server callback for reading a holding register in the LRC self-test. It
+**            counts the reads of the registers that the request reads.
+** \param     channel Handle to the Modbus server channel object that triggered the
+**            callback.
+** \param     addr Element address (0..65535).
+** \param     value Pointer to write the value of the holding register to.
+** \return    TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR
+**            otherwise.
+**
+****************************************************************************************/
+static tTbxMbServerResult TbxMbBenchSelfTestReadReg(tTbxMbServer   channel,
+                                                    uint16_t       addr,
+                                                    uint16_t     * value)
+{
+  tTbxMbServerResult result = TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR;
+
+  TBX_UNUSED_ARG(channel);
+  if ( (addr >= TBX_MB_BENCH_LRC_ADDR) &&
+       (addr < (TBX_MB_BENCH_LRC_ADDR + TBX_MB_BENCH_LRC_NUM_REGS)) )
+  {
+    *value = addr;
+    benchLrcReads++;
+    result = TBX_MB_SERVER_OK;
+  }
+  return result;
+} /*** end of TbxMbBenchSelfTestReadReg ***/
+
+
+/************************************************************************************//**
+** \brief     UART callback for the completion of a transmission in the LRC self-test.
+** \param     port The serial port that the transfer completed on.
+**
+****************************************************************************************/
+static void TbxMbBenchSelfTestTxDone(tTbxMbUartPort port)
+{
+  TBX_UNUSED_ARG(port);
+} /*** end of TbxMbBenchSelfTestTxDone ***/
+
+
+/************************************************************************************//**
+** \brief     UART callback for the reception of new data in the LRC self-test. It
+**            appends the data to the received response.
+** \param     port The serial port that the data was received on.
+** \param     data Byte array with newly received data.
+** \param     len Number of newly received bytes.
+**
+****************************************************************************************/
+static void TbxMbBenchSelfTestRxData(tTbxMbUartPort         port,
+                                     uint8_t        const * data,
+                                     uint8_t                len)
+{
+  uint8_t idx;
+
+  TBX_UNUSED_ARG(port);
+  for (idx = 0U; idx < len; idx++)
+  {
+    if (benchLrcRespLen < TBX_MB_BENCH_LRC_RESP_LEN)
+    {
+      benchLrcRespBuf[benchLrcRespLen] = (char)data[idx];
+      benchLrcRespLen++;
+    }
+  }
+} /*** end of TbxMbBenchSelfTestRxData ***/
+
+
+/*********************************** end of tbxmb_bench.c ******************************/
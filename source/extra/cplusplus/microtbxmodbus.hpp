@@ -34,9 +34,9 @@
 * Include files
 ****************************************************************************************/
 #include "microtbxmodbus.h"                      /* MicroTBX-Modbus library            */
+#include "tbxmbevent.hpp"                        /* MicroTBX-Modbus C++ event handling */
 #include "tbxmbserver.hpp"                       /* MicroTBX-Modbus C++ server         */
 #include "tbxmbclient.hpp"                       /* MicroTBX-Modbus C++ client         */
-#include "tbxmbevent.hpp"                        /* MicroTBX-Modbus C++ event handling */
 #include "tbxmbport.hpp"                         /* MicroTBX-Modbus C++ hardware port  */
 
 
@@ -239,6 +239,276 @@ uint8_t TbxMbClient::writeHoldingRegs(uint8_t         node,
 } /*** end of writeHoldingRegs ***/
 
 
+/************************************************************************************//**
+** \brief     Reads the coil(s) from the server with the specified node address and
+**            stores them in a packed bit array, eight to a byte: bit 0 of bits[0]
+**            holds the coil at address addr, bit 1 of bits[0] the one at address
+**            addr + 1, and so on.
+** \param     node The address of the server. This parameter is transport layer
+**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
+**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
+** \param     addr Starting element address (0..65535) in the Modbus data table for the
+**            coil read operation.
+** \param     num Number of elements to read from the coils data table. Range can be
+**            1..2000
+** \param     bits Packed bit array where the coil states will be written to. It must
+**            have space for at least (num + 7) / 8 bytes.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbClient::readCoilsPacked(uint8_t  node,
+                                     uint16_t addr,
+                                     uint16_t num,
+                                     uint8_t  bits[])
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Only continue with a valid client object. */
+  if (m_Channel != nullptr)
+  {
+    result = TbxMbClientReadCoilsPacked(m_Channel, node, addr, num, bits);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of readCoilsPacked ***/
+
+
+/************************************************************************************//**
+** \brief     Reads the discrete input(s) from the server with the specified node
+**            address and stores them in a packed bit array, eight to a byte: bit 0 of
+**            bits[0] holds the input at address addr, bit 1 of bits[0] the one at
+**            address addr + 1, and so on.
+** \param     node The address of the server. This parameter is transport layer
+**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
+**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
+** \param     addr Starting element address (0..65535) in the Modbus data table for the
+**            discrete input read operation.
+** \param     num Number of elements to read from the discrete inputs data table. Range
+**            can be 1..2000
+** \param     bits Packed bit array where the discrete input states will be written to.
+**            It must have space for at least (num + 7) / 8 bytes.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbClient::readInputsPacked(uint8_t  node,
+                                      uint16_t addr,
+                                      uint16_t num,
+                                      uint8_t  bits[])
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Only continue with a valid client object. */
+  if (m_Channel != nullptr)
+  {
+    result = TbxMbClientReadInputsPacked(m_Channel, node, addr, num, bits);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of readInputsPacked ***/
+
+
+/************************************************************************************//**
+** \brief     Writes the coil(s) from a packed bit array to the server with the specified
+**            node address. The bits are packed eight to a byte: bit 0 of bits[0] holds
+**            the coil at address addr, bit 1 of bits[0] the one at address addr + 1,
+**            and so on.
+** \param     node The address of the server. This parameter is transport layer
+**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
+**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
+** \param     addr Starting element address (0..65535) in the Modbus data table for the
+**            coil write operation.
+** \param     num Number of elements to write to the coils data table. Range can be
+**            1..1968
+** \param     bits Packed bit array with the desired coil states.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbClient::writeCoilsPacked(uint8_t       node,
+                                      uint16_t      addr,
+                                      uint16_t      num,
+                                      uint8_t const bits[])
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Only continue with a valid client object. */
+  if (m_Channel != nullptr)
+  {
+    result = TbxMbClientWriteCoilsPacked(m_Channel, node, addr, num, bits);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of writeCoilsPacked ***/
+
+
+/************************************************************************************//**
+** \brief     Reads a range of records from a file on the server with the specified node
+**            address. Larger ranges are automatically split into multiple requests.
+** \param     node The address of the server. This parameter is transport layer
+**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
+**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
+** \param     file Number of the file (1..65535).
+** \param     record Number of the first record in the file to read (0..9999).
+** \param     num Number of records to read. Range can be 1..10000, with the limitation
+**            that the range cannot extend past record 9999.
+** \param     values Array where the record values will be written to.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbClient::readFileRecord(uint8_t  node,
+                                    uint16_t file,
+                                    uint16_t record,
+                                    uint16_t num,
+                                    uint16_t values[])
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Only continue with a valid client object. */
+  if (m_Channel != nullptr)
+  {
+    result = TbxMbClientReadFileRecord(m_Channel, node, file, record, num, values);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of readFileRecord ***/
+
+
+/************************************************************************************//**
+** \brief     Writes a range of records to a file on the server with the specified node
+**            address. Larger ranges are automatically split into multiple requests.
+** \param     node The address of the server. This parameter is transport layer
+**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
+**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
+** \param     file Number of the file (1..65535).
+** \param     record Number of the first record in the file to write (0..9999).
+** \param     num Number of records to write. Range can be 1..10000, with the limitation
+**            that the range cannot extend past record 9999.
+** \param     values Array with the record values to write.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbClient::writeFileRecord(uint8_t        node,
+                                     uint16_t       file,
+                                     uint16_t       record,
+                                     uint16_t       num,
+                                     uint16_t const values[])
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Only continue with a valid client object. */
+  if (m_Channel != nullptr)
+  {
+    result = TbxMbClientWriteFileRecord(m_Channel, node, file, record, num, values);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of writeFileRecord ***/
+
+
+/************************************************************************************//**
+** \brief     Modifies the contents of a holding register on the server with the
+**            specified node address, using an AND mask and an OR mask. The server
+**            calculates the new register value as:
+**            (current value AND andMask) OR (orMask AND (NOT andMask)).
+** \param     node The address of the server. This parameter is transport layer
+**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
+**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
+** \param     addr Element address (0..65535) in the Modbus data table of the holding
+**            register to modify.
+** \param     andMask Bits to keep from the current register value.
+** \param     orMask Bits to set in the register value, for the bits that are cleared
+**            in andMask.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbClient::maskWriteReg(uint8_t  node,
+                                  uint16_t addr,
+                                  uint16_t andMask,
+                                  uint16_t orMask)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Only continue with a valid client object. */
+  if (m_Channel != nullptr)
+  {
+    result = TbxMbClientMaskWriteReg(m_Channel, node, addr, andMask, orMask);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of maskWriteReg ***/
+
+
+/************************************************************************************//**
+** \brief     Writes holding register(s) to and then reads holding register(s) from the
+**            server with the specified node address, using a single request. The server
+**            performs the write operation before the read operation.
+** \param     node The address of the server. This parameter is transport layer
+**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
+**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
+** \param     readAddr Starting element address (0..65535) in the Modbus data table for
+**            the holding register read operation.
+** \param     readNum Number of elements to read from the holding registers data table.
+**            Range can be 1..125
+** \param     readRegs Array where the read holding register values will be written to.
+** \param     writeAddr Starting element address (0..65535) in the Modbus data table for
+**            the holding register write operation.
+** \param     writeNum Number of elements to write to the holding registers data table.
+**            Range can be 1..121
+** \param     writeRegs Array with the desired holding register values.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbClient::readWriteHoldingRegs(uint8_t         node,
+                                          uint16_t        readAddr,
+                                          uint8_t         readNum,
+                                          uint16_t        readRegs[],
+                                          uint16_t        writeAddr,
+                                          uint8_t         writeNum,
+                                          uint16_t const  writeRegs[])
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Only continue with a valid client object. */
+  if (m_Channel != nullptr)
+  {
+    result = TbxMbClientReadWriteHoldingRegs(m_Channel, node, readAddr, readNum,
+                                             readRegs, writeAddr, writeNum, writeRegs);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of readWriteHoldingRegs ***/
+
+
+/************************************************************************************//**
+** \brief     Reads the values from the FIFO queue of the server with the specified node
+**            address. A single request reads up to TBX_MB_FIFO_COUNT_MAX values.
+** \param     node The address of the server. This parameter is transport layer
+**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
+**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
+** \param     addr FIFO pointer address (0..65535) of the FIFO queue.
+** \param     values Array where the FIFO queue values will be written to. It must have
+**            space for at least TBX_MB_FIFO_COUNT_MAX values.
+** \param     count Reference to where the number of read FIFO queue values will be
+**            written to.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbClient::readFifo(uint8_t   node,
+                              uint16_t  addr,
+                              uint16_t  values[],
+                              uint8_t&  count)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Only continue with a valid client object. */
+  if (m_Channel != nullptr)
+  {
+    result = TbxMbClientReadFifo(m_Channel, node, addr, values, &count);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of readFifo ***/
+
+
 /************************************************************************************//**
 ** \brief     Perform diagnostic operation on the server for checking the communication
 **            system.
@@ -273,6 +543,45 @@ uint8_t TbxMbClient::diagnostics(uint8_t node, uint16_t subcode, uint16_t& count
 } /*** end of diagnostics ***/
 
 
+/************************************************************************************//**
+** \brief     Reads the device identification objects from the server with the
+**            specified node address. If the objects do not fit in a single response,
+**            this method automatically continues with follow-up requests, until all
+**            objects of the requested category are read.
+** \details   The objects are stored in the same format as in the response: one byte
+**            with the object id, one byte with the length of the object value and then
+**            the bytes of the object value.
+** \param     node The address of the server. This parameter is transport layer
+**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
+**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
+** \param     code Read device identification code (TBX_MB_DEVID_CODE_xxx).
+** \param     objectId Id of the object to start reading at. Typically 0 for the stream
+**            access codes. For TBX_MB_DEVID_CODE_SPECIFIC, it is the id of the object to
+**            read.
+** \param     objects Byte array where the objects will be written to.
+** \param     len Size of the objects array. This method overwrites it with the number
+**            of bytes that it actually wrote to the objects array.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbClient::readDeviceId(uint8_t   node,
+                                  uint8_t   code,
+                                  uint8_t   objectId,
+                                  uint8_t   objects[],
+                                  uint16_t& len)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Only continue with a valid client object. */
+  if (m_Channel != nullptr)
+  {
+    result = TbxMbClientReadDeviceId(m_Channel, node, code, objectId, objects, &len);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of readDeviceId ***/
+
+
 /************************************************************************************//**
 ** \brief     Send a custom function code PDU to the server and receive its response PDU.
 **            Thanks to this functionality, the user can support Modbus function codes
@@ -391,4 +700,22 @@ TbxMbClientRtu::~TbxMbClientRtu()
 } /*** end of ~TbxMbClientRtu ***/
 
 
+/************************************************************************************//**
+** \brief     Binds the Modbus RTU client to an event loop. From then on, the task method
+**            of the event loop processes its events, instead of TbxMbEvent::task().
+**            For the best results, call this method right after constructing the object.
+** \param     loop The event loop to bind to.
+**
+****************************************************************************************/
+void TbxMbClientRtu::bind(TbxMbEventLoop & loop)
+{
+  /* Only continue with a valid transport layer and event loop object. */
+  if ((m_Transport != nullptr) && (loop.m_Loop != nullptr))
+  {
+    /* Bind the transport layer object, together with its client object. */
+    TbxMbEventLoopBind(loop.m_Loop, m_Transport);
+  }
+} /*** end of bind ***/
+
+
 /*********************************** end of tbxmbclient.cpp ****************************/
@@ -52,7 +52,22 @@ public:
   uint8_t writeCoils(uint8_t node, uint16_t addr, uint16_t num, uint8_t const coils[]);
   uint8_t writeHoldingRegs(uint8_t node, uint16_t addr, uint8_t num, 
                            uint16_t const holdingRegs[]);
+  uint8_t readCoilsPacked(uint8_t node, uint16_t addr, uint16_t num, uint8_t bits[]);
+  uint8_t readInputsPacked(uint8_t node, uint16_t addr, uint16_t num, uint8_t bits[]);
+  uint8_t writeCoilsPacked(uint8_t node, uint16_t addr, uint16_t num,
+                           uint8_t const bits[]);
+  uint8_t readFileRecord(uint8_t node, uint16_t file, uint16_t record, uint16_t num,
+                         uint16_t values[]);
+  uint8_t writeFileRecord(uint8_t node, uint16_t file, uint16_t record, uint16_t num,
+                          uint16_t const values[]);
+  uint8_t maskWriteReg(uint8_t node, uint16_t addr, uint16_t andMask, uint16_t orMask);
+  uint8_t readWriteHoldingRegs(uint8_t node, uint16_t readAddr, uint8_t readNum,
+                               uint16_t readRegs[], uint16_t writeAddr,
+                               uint8_t writeNum, uint16_t const writeRegs[]);
+  uint8_t readFifo(uint8_t node, uint16_t addr, uint16_t values[], uint8_t& count);
   uint8_t diagnostics(uint8_t node, uint16_t subcode, uint16_t& count);
+  uint8_t readDeviceId(uint8_t node, uint8_t code, uint8_t objectId, uint8_t objects[],
+                       uint16_t& len);
   uint8_t customFunction(uint8_t node, uint8_t const txPdu[], uint8_t rxPdu[],
                          uint8_t& len);
 
@@ -78,6 +93,8 @@ public:
                  tTbxMbUartStopbits stopbits, tTbxMbUartParity parity)
     : TbxMbClientRtu(1000U, 100U, serialPort, baudrate, stopbits, parity) { }
   virtual ~TbxMbClientRtu();
+  /* Methods. */
+  void bind(TbxMbEventLoop & loop);
 
 private:
   /* Members.*/
@@ -64,4 +64,54 @@ void TbxMbEvent::task()
   TbxMbEventTask();
 } /*** end of task ***/
 
+
+/****************************************************************************************
+*                            T B X M B E V E N T L O O P
+****************************************************************************************/
+/************************************************************************************//**
+** \brief     Modbus event loop constructor.
+**
+****************************************************************************************/
+TbxMbEventLoop::TbxMbEventLoop()
+  : m_Loop(nullptr)
+{
+  /* Create the event loop object. */
+  m_Loop = TbxMbEventLoopCreate();
+  /* Make sure the event loop object could be created. */
+  TBX_ASSERT(m_Loop != nullptr);
+} /*** end of TbxMbEventLoop ***/
+
+
+/************************************************************************************//**
+** \brief     Modbus event loop destructor. Make sure its task method is no longer
+**            called and that no server and client objects are still bound to it.
+**
+****************************************************************************************/
+TbxMbEventLoop::~TbxMbEventLoop()
+{
+  /* Event loop object valid? */
+  if (m_Loop != nullptr)
+  {
+    /* Release the event loop object. */
+    TbxMbEventLoopFree(m_Loop);
+  }
+} /*** end of ~TbxMbEventLoop ***/
+
+
+/************************************************************************************//**
+** \brief     Task method that drives the event loop. It processes the events of the
+**            server and client objects that are bound to this event loop. Call it in
+**            the same way as TbxMbEvent::task(). With an RTOS, each event loop
+**            typically gets its own task or thread.
+**
+****************************************************************************************/
+void TbxMbEventLoop::task()
+{
+  /* Event loop object valid? */
+  if (m_Loop != nullptr)
+  {
+    TbxMbEventLoopTask(m_Loop);
+  }
+} /*** end of task ***/
+
 /*********************************** end of tbxmbevent.cpp ******************************/
@@ -44,6 +44,32 @@ public:
   static void task();
 };
 
+
+/****************************************************************************************
+*                            T B X M B E V E N T L O O P
+****************************************************************************************/
+/** \brief Modbus event loop class. Server and client objects bound to it, have their
+ *         events processed by its task method, instead of by TbxMbEvent::task().
+ */
+class TbxMbEventLoop
+{
+public:
+  /* Constructors and destructor. */
+  TbxMbEventLoop();
+  virtual ~TbxMbEventLoop();
+  TbxMbEventLoop(TbxMbEventLoop const &) = delete;
+  TbxMbEventLoop & operator=(TbxMbEventLoop const &) = delete;
+  /* Methods. */
+  void task();
+
+private:
+  /* Friends. */
+  friend class TbxMbServerRtu;
+  friend class TbxMbClientRtu;
+  /* Members. */
+  tTbxMbEventLoop m_Loop;
+};
+
 #endif /* TBXMBEVENT_HPP */
 /*********************************** end of tbxmbevent.hpp *****************************/
 
@@ -168,6 +168,273 @@ tTbxMbServerResult TbxMbServer::writeHoldingReg(uint16_t addr,
 } /*** end of writeHoldingReg ***/
 
 
+/************************************************************************************//**
+** \brief     Reads a range of data elements from the input registers data table.
+** \details   Note that the elements are specified by their zero-based address in the
+**            range 0 - 65535, not their element number (1 - 65536).
+**            The default implementation calls readInputReg() for each element. Override
+**            this method to read all elements at once, for example with a bulk copy.
+** \attention Store the values of the input registers in your CPUs native endianess. The
+**            MicroTBX-Modbus stack will automatically convert them to the big endianess
+**            that the Modbus protocol requires.
+** \param     addr Address of the first element (0..65535).
+** \param     num Number of elements to read.
+** \param     values Array where to store the values of the input registers.
+** \return    TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if one
+**            or more of the data element addresses are not supported by this server, 
+**            TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+**
+****************************************************************************************/
+tTbxMbServerResult TbxMbServer::readInputRegs(uint16_t addr,
+                                              uint8_t  num,
+                                              uint16_t values[])
+{
+  tTbxMbServerResult result = TBX_MB_SERVER_OK;
+
+  /* Read the elements one by one, until an exception is reported. */
+  for (uint8_t idx = 0U; (idx < num) && (result == TBX_MB_SERVER_OK); idx++)
+  {
+    result = readInputReg(addr + idx, values[idx]);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of readInputRegs ***/
+
+
+/************************************************************************************//**
+** \brief     Reads a range of data elements from the holding registers data table.
+** \details   Note that the elements are specified by their zero-based address in the
+**            range 0 - 65535, not their element number (1 - 65536).
+**            The default implementation calls readHoldingReg() for each element.
+**            Override this method to read all elements at once, for example with a bulk
+**            copy.
+** \attention Store the values of the holding registers in your CPUs native endianess.
+**            The MicroTBX-Modbus stack will automatically convert them to the big
+**            endianess that the Modbus protocol requires.
+** \param     addr Address of the first element (0..65535).
+** \param     num Number of elements to read.
+** \param     values Array where to store the values of the holding registers.
+** \return    TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if one
+**            or more of the data element addresses are not supported by this server, 
+**            TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+**
+****************************************************************************************/
+tTbxMbServerResult TbxMbServer::readHoldingRegs(uint16_t addr,
+                                                uint8_t  num,
+                                                uint16_t values[])
+{
+  tTbxMbServerResult result = TBX_MB_SERVER_OK;
+
+  /* Read the elements one by one, until an exception is reported. */
+  for (uint8_t idx = 0U; (idx < num) && (result == TBX_MB_SERVER_OK); idx++)
+  {
+    result = readHoldingReg(addr + idx, values[idx]);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of readHoldingRegs ***/
+
+
+/************************************************************************************//**
+** \brief     Writes a range of data elements to the holding registers data table.
+** \details   Note that the elements are specified by their zero-based address in the
+**            range 0 - 65535, not their element number (1 - 65536).
+**            The default implementation calls writeHoldingReg() for each element.
+**            Override this method to write all elements at once, for example with a
+**            bulk copy.
+** \attention The values of the holding registers are already in your CPUs native
+**            endianess.
+** \param     addr Address of the first element (0..65535).
+** \param     num Number of elements to write.
+** \param     values Array with the values of the holding registers.
+** \return    TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if one
+**            or more of the data element addresses are not supported by this server, 
+**            TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+**
+****************************************************************************************/
+tTbxMbServerResult TbxMbServer::writeHoldingRegs(uint16_t       addr,
+                                                 uint8_t        num,
+                                                 uint16_t const values[])
+{
+  tTbxMbServerResult result = TBX_MB_SERVER_OK;
+
+  /* Write the elements one by one, until an exception is reported. */
+  for (uint8_t idx = 0U; (idx < num) && (result == TBX_MB_SERVER_OK); idx++)
+  {
+    result = writeHoldingReg(addr + idx, values[idx]);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of writeHoldingRegs ***/
+
+
+/************************************************************************************//**
+** \brief     Reads a range of data elements from the discrete inputs data table.
+** \details   Note that the elements are specified by their zero-based address in the
+**            range 0 - 65535, not their element number (1 - 65536).
+**            The states are packed eight to a byte: bit 0 of bits[0] holds the input at
+**            address addr, bit 1 of bits[0] the one at address addr + 1, and so on.
+**            The default implementation calls readInput() for each element. Override
+**            this method to read all elements at once, for example with a bulk copy.
+** \param     addr Address of the first element (0..65535).
+** \param     num Number of elements to read.
+** \param     bits Packed bit array where to store the states of the discrete inputs.
+** \return    TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if one
+**            or more of the data element addresses are not supported by this server,
+**            TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+**
+****************************************************************************************/
+tTbxMbServerResult TbxMbServer::readInputs(uint16_t addr,
+                                           uint16_t num,
+                                           uint8_t  bits[])
+{
+  tTbxMbServerResult result = TBX_MB_SERVER_OK;
+
+  /* Read the elements one by one, until an exception is reported. */
+  for (uint16_t idx = 0U; (idx < num) && (result == TBX_MB_SERVER_OK); idx++)
+  {
+    bool    value = false;
+    uint8_t mask  = static_cast<uint8_t>(1U << (idx % 8U));
+    result = readInput(addr + idx, value);
+    /* Store the state in the packed bit array. */
+    if (value)
+    {
+      bits[idx / 8U] |= mask;
+    }
+    else
+    {
+      bits[idx / 8U] &= static_cast<uint8_t>(~mask);
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of readInputs ***/
+
+
+/************************************************************************************//**
+** \brief     Reads a range of data elements from the coils data table.
+** \details   Note that the elements are specified by their zero-based address in the
+**            range 0 - 65535, not their element number (1 - 65536).
+**            The states are packed eight to a byte: bit 0 of bits[0] holds the coil at
+**            address addr, bit 1 of bits[0] the one at address addr + 1, and so on.
+**            The default implementation calls readCoil() for each element. Override
+**            this method to read all elements at once, for example with a bulk copy.
+** \param     addr Address of the first element (0..65535).
+** \param     num Number of elements to read.
+** \param     bits Packed bit array where to store the states of the coils.
+** \return    TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if one
+**            or more of the data element addresses are not supported by this server,
+**            TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+**
+****************************************************************************************/
+tTbxMbServerResult TbxMbServer::readCoils(uint16_t addr,
+                                          uint16_t num,
+                                          uint8_t  bits[])
+{
+  tTbxMbServerResult result = TBX_MB_SERVER_OK;
+
+  /* Read the elements one by one, until an exception is reported. */
+  for (uint16_t idx = 0U; (idx < num) && (result == TBX_MB_SERVER_OK); idx++)
+  {
+    bool    value = false;
+    uint8_t mask  = static_cast<uint8_t>(1U << (idx % 8U));
+    result = readCoil(addr + idx, value);
+    /* Store the state in the packed bit array. */
+    if (value)
+    {
+      bits[idx / 8U] |= mask;
+    }
+    else
+    {
+      bits[idx / 8U] &= static_cast<uint8_t>(~mask);
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of readCoils ***/
+
+
+/************************************************************************************//**
+** \brief     Writes a range of data elements to the coils data table.
+** \details   Note that the elements are specified by their zero-based address in the
+**            range 0 - 65535, not their element number (1 - 65536).
+**            The states are packed eight to a byte: bit 0 of bits[0] holds the coil at
+**            address addr, bit 1 of bits[0] the one at address addr + 1, and so on.
+**            The default implementation calls writeCoil() for each element. Override
+**            this method to write all elements at once, for example with a bulk copy.
+** \param     addr Address of the first element (0..65535).
+** \param     num Number of elements to write.
+** \param     bits Packed bit array with the new states of the coils.
+** \return    TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if one
+**            or more of the data element addresses are not supported by this server,
+**            TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+**
+****************************************************************************************/
+tTbxMbServerResult TbxMbServer::writeCoils(uint16_t      addr,
+                                           uint16_t      num,
+                                           uint8_t const bits[])
+{
+  tTbxMbServerResult result = TBX_MB_SERVER_OK;
+
+  /* Write the elements one by one, until an exception is reported. */
+  for (uint16_t idx = 0U; (idx < num) && (result == TBX_MB_SERVER_OK); idx++)
+  {
+    bool value = ((bits[idx / 8U] & (1U << (idx % 8U))) != 0U);
+    result = writeCoil(addr + idx, value);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of writeCoils ***/
+
+
+/************************************************************************************//**
+** \brief     Reads a range of records from a file, with function code 20 - Read File
+**            Record. A file is a collection of records, each being a 16-bit register.
+**            Override this method to make files available to clients.
+** \attention Store the values of the records in your CPUs native endianess. The
+**            MicroTBX-Modbus stack will automatically convert them to the big endianess
+**            that the Modbus protocol requires.
+** \param     file Number of the file (1..65535).
+** \param     record Number of the first record in the file (0..9999).
+** \param     num Number of records to read.
+** \param     values Array where to store the values of the records.
+** \return    TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if the
+**            file or one or more of its records are not supported by this server,
+**            TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+**
+****************************************************************************************/
+tTbxMbServerResult TbxMbServer::readFileRecord(uint16_t file,
+                                               uint16_t record,
+                                               uint8_t  num,
+                                               uint16_t values[])
+{
+  return TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR;
+} /*** end of readFileRecord ***/
+
+
+/************************************************************************************//**
+** \brief     Writes a range of records to a file, with function code 21 - Write File
+**            Record. A file is a collection of records, each being a 16-bit register.
+**            Override this method to make files available to clients.
+** \attention The values of the records are already in your CPUs native endianess.
+** \param     file Number of the file (1..65535).
+** \param     record Number of the first record in the file (0..9999).
+** \param     num Number of records to write.
+** \param     values Array with the values of the records.
+** \return    TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if the
+**            file or one or more of its records are not supported by this server,
+**            TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+**
+****************************************************************************************/
+tTbxMbServerResult TbxMbServer::writeFileRecord(uint16_t       file,
+                                                uint16_t       record,
+                                                uint8_t        num,
+                                                uint16_t const values[])
+{
+  return TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR;
+} /*** end of writeFileRecord ***/
+
+
 /************************************************************************************//**
 ** \brief     Implements custom function code handling for supporting Modbus function
 **            codes that are either currently not supported or user defined extensions.
@@ -191,6 +458,251 @@ bool TbxMbServer::customFunction(uint8_t  const rxPdu[],
 } /*** end of customFunction ***/
 
 
+/************************************************************************************//**
+** \brief     Called right after a client wrote to one of the data tables, registered
+**            with setTableCoils() or setTableHoldingRegs(). Override it to act upon the
+**            new values.
+** \details   Note that the elements are specified by their zero-based address in the
+**            range 0 - 65535, not their element number (1 - 65536).
+** \param     table The data table that was written to.
+** \param     addr Address of the first element that was written (0..65535).
+** \param     num Number of elements that were written.
+**
+****************************************************************************************/
+void TbxMbServer::tableWritten(tTbxMbServerTable table,
+                               uint16_t          addr,
+                               uint16_t          num)
+{
+  /* Nothing to do here by default. */
+} /*** end of tableWritten ***/
+
+
+/************************************************************************************//**
+** \brief     Registers a data table with discrete inputs. The server serves requests
+**            for discrete inputs within the address range of the data table directly
+**            from the specified bit array, without calling readInput().
+** \details   The bit array is packed in the same way as in the Modbus packet: bit 0 of
+**            bits[0] holds the discrete input at address "addr", bit 1 of bits[0] the
+**            one at address "addr + 1", and so on.
+** \param     addr Address of the first discrete input in the data table (0..65535).
+** \param     num Number of discrete inputs in the data table.
+** \param     bits Bit array with the discrete input values.
+**
+****************************************************************************************/
+void TbxMbServer::setTableInputs(uint16_t       addr,
+                                 uint16_t       num,
+                                 uint8_t  const bits[])
+{
+  /* Only continue with a valid server channel object. */
+  if (m_Channel != nullptr)
+  {
+    /* Register the data table. */
+    TbxMbServerSetTableInputs(m_Channel, addr, num, bits);
+  }
+} /*** end of setTableInputs ***/
+
+
+/************************************************************************************//**
+** \brief     Registers a data table with coils. The server serves requests for coils
+**            within the address range of the data table directly from and to the
+**            specified bit array, without calling readCoil() and writeCoil().
+** \details   The bit array is packed in the same way as in the Modbus packet: bit 0 of
+**            bits[0] holds the coil at address "addr", bit 1 of bits[0] the one at
+**            address "addr + 1", and so on.
+** \param     addr Address of the first coil in the data table (0..65535).
+** \param     num Number of coils in the data table.
+** \param     bits Bit array with the coil values.
+**
+****************************************************************************************/
+void TbxMbServer::setTableCoils(uint16_t addr,
+                                uint16_t num,
+                                uint8_t  bits[])
+{
+  /* Only continue with a valid server channel object. */
+  if (m_Channel != nullptr)
+  {
+    /* Register the data table. */
+    TbxMbServerSetTableCoils(m_Channel, addr, num, bits);
+  }
+} /*** end of setTableCoils ***/
+
+
+/************************************************************************************//**
+** \brief     Registers a data table with input registers. The server serves requests
+**            for input registers within the address range of the data table directly
+**            from the specified array, without calling readInputReg() or
+**            readInputRegs().
+** \param     addr Address of the first input register in the data table (0..65535).
+** \param     num Number of input registers in the data table.
+** \param     regs Array with the input register values in your CPUs native endianess.
+**
+****************************************************************************************/
+void TbxMbServer::setTableInputRegs(uint16_t       addr,
+                                    uint16_t       num,
+                                    uint16_t const regs[])
+{
+  /* Only continue with a valid server channel object. */
+  if (m_Channel != nullptr)
+  {
+    /* Register the data table. */
+    TbxMbServerSetTableInputRegs(m_Channel, addr, num, regs);
+  }
+} /*** end of setTableInputRegs ***/
+
+
+/************************************************************************************//**
+** \brief     Registers a data table with holding registers. The server serves requests
+**            for holding registers within the address range of the data table directly
+**            from and to the specified array, without calling the holding register
+**            read and write methods.
+** \param     addr Address of the first holding register in the data table (0..65535).
+** \param     num Number of holding registers in the data table.
+** \param     regs Array with the holding register values in your CPUs native endianess.
+**
+****************************************************************************************/
+void TbxMbServer::setTableHoldingRegs(uint16_t addr,
+                                      uint16_t num,
+                                      uint16_t regs[])
+{
+  /* Only continue with a valid server channel object. */
+  if (m_Channel != nullptr)
+  {
+    /* Register the data table. */
+    TbxMbServerSetTableHoldingRegs(m_Channel, addr, num, regs);
+  }
+} /*** end of setTableHoldingRegs ***/
+
+
+/************************************************************************************//**
+** \brief     Registers a register map with input registers. The server looks up the
+**            requested input registers in the map with a binary search and copies
+**            consecutive registers one run at a time, without calling readInputReg() or
+**            readInputRegs().
+** \param     map Array with register map entries, sorted on their address in
+**            ascending order and without overlapping runs.
+** \param     len Number of entries in the register map.
+**
+****************************************************************************************/
+void TbxMbServer::setMapInputRegs(tTbxMbServerRegMapEntry const map[],
+                                  uint16_t                      len)
+{
+  /* Only continue with a valid server channel object. */
+  if (m_Channel != nullptr)
+  {
+    /* Register the register map. */
+    TbxMbServerSetMapInputRegs(m_Channel, map, len);
+  }
+} /*** end of setMapInputRegs ***/
+
+
+/************************************************************************************//**
+** \brief     Registers a register map with holding registers. The server looks up the
+**            requested holding registers in the map with a binary search and copies
+**            consecutive registers one run at a time, without calling the holding
+**            register read and write methods.
+** \param     map Array with register map entries, sorted on their address in
+**            ascending order and without overlapping runs.
+** \param     len Number of entries in the register map.
+**
+****************************************************************************************/
+void TbxMbServer::setMapHoldingRegs(tTbxMbServerRegMapEntry const map[],
+                                    uint16_t                      len)
+{
+  /* Only continue with a valid server channel object. */
+  if (m_Channel != nullptr)
+  {
+    /* Register the register map. */
+    TbxMbServerSetMapHoldingRegs(m_Channel, map, len);
+  }
+} /*** end of setMapHoldingRegs ***/
+
+
+/************************************************************************************//**
+** \brief     Registers a handler for a specific function code. Once registered, the
+**            server dispatches PDUs with this function code directly to the handler.
+**            Specify nullptr as the handler, to remove a previously registered handler.
+** \param     code Function code (1..127).
+** \param     handler Pointer to the handler function or nullptr.
+**
+****************************************************************************************/
+void TbxMbServer::setFunctionHandler(uint8_t                    code,
+                                     tTbxMbServerCustomFunction handler)
+{
+  /* Only continue with a valid server channel object. */
+  if (m_Channel != nullptr)
+  {
+    /* Register the function code handler. */
+    TbxMbServerSetFunctionHandler(m_Channel, code, handler);
+  }
+} /*** end of setFunctionHandler ***/
+
+
+/************************************************************************************//**
+** \brief     Registers the objects of the device identification. A client reads these
+**            with function code 43 / MEI type 14 - Read Device Identification.
+** \param     objects Array with device identification objects, sorted on their id in
+**            ascending order.
+** \param     len Number of objects in the array.
+**
+****************************************************************************************/
+void TbxMbServer::setDeviceIdObjects(tTbxMbServerDeviceIdObject const objects[],
+                                     uint16_t                         len)
+{
+  /* Only continue with a valid server channel object. */
+  if (m_Channel != nullptr)
+  {
+    /* Register the device identification objects. */
+    TbxMbServerSetDeviceIdObjects(m_Channel, objects, len);
+  }
+} /*** end of setDeviceIdObjects ***/
+
+
+/************************************************************************************//**
+** \brief     Registers a FIFO queue, that a client reads with function code 24 - Read
+**            FIFO Queue. Add values to the queue with fifoPush(). The server removes the
+**            values that it sends in a response from the queue.
+** \details   The queue holds up to size - 1 values.
+** \param     addr FIFO pointer address (0..65535), that a client specifies in its
+**            request.
+** \param     buffer Array for storing the queue values.
+** \param     size Number of elements in the buffer array (2..65535).
+**
+****************************************************************************************/
+void TbxMbServer::setFifo(uint16_t addr,
+                          uint16_t buffer[],
+                          uint16_t size)
+{
+  /* Only continue with a valid server channel object. */
+  if (m_Channel != nullptr)
+  {
+    /* Register the FIFO queue. */
+    TbxMbServerSetFifo(m_Channel, addr, buffer, size);
+  }
+} /*** end of setFifo ***/
+
+
+/************************************************************************************//**
+** \brief     Adds a value to the FIFO queue, registered with setFifo(). Safe to call
+**            from any context, including an interrupt service routine, as long as just
+**            one context at a time adds values to the queue.
+** \param     value The value to add to the queue.
+** \return    TBX_OK if successful, TBX_ERROR if the queue is full or not registered.
+**
+****************************************************************************************/
+uint8_t TbxMbServer::fifoPush(uint16_t value)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Only continue with a valid server channel object. */
+  if (m_Channel != nullptr)
+  {
+    result = TbxMbServerFifoPush(m_Channel, value);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of fifoPush ***/
+
+
 /************************************************************************************//**
 ** \brief     Wrapper to connect this callback to the readInput() method of a class
 **            instance.
@@ -453,6 +965,337 @@ tTbxMbServerResult TbxMbServer::callbackWriteHoldingReg(tTbxMbServer channel,
 } /*** end of callbackWriteHoldingReg ***/
 
 
+/************************************************************************************//**
+** \brief     Wrapper to connect this callback to the readInputRegs() method of a class
+**            instance.
+** \param     channel Handle to the Modbus server channel object that triggered the 
+**            callback.
+** \param     addr Address of the first element (0..65535).
+** \param     num Number of elements.
+** \param     values Array to write the values of the input registers to.
+** \return    TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if one
+**            or more of the data element addresses are not supported by this server, 
+**            TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+**
+****************************************************************************************/
+tTbxMbServerResult TbxMbServer::callbackReadInputRegs(tTbxMbServer     channel, 
+                                                      uint16_t         addr, 
+                                                      uint8_t          num,
+                                                      uint16_t       * values)
+{
+  tTbxMbServerResult result = TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR;
+
+  /* Only continue with a valid opaque channel pointer and values pointer. */
+  if ( (channel != nullptr) && (values != nullptr) )
+  {
+    /* Convert the opaque pointer to the channel context structure pointer. */
+    ChannelCtx * channelCtx = reinterpret_cast<ChannelCtx *>(channel);
+    /* Only continue with a valid instance pointer. */
+    if (channelCtx->instancePtr != nullptr)
+    {
+      /* The channel's instance pointer points to an instance of this class. Cast it as
+       * such.
+       */
+      TbxMbServer * serverPtr = static_cast<TbxMbServer *>(channelCtx->instancePtr);
+      /* Call the related instance method. */
+      result = serverPtr->readInputRegs(addr, num, values);
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of callbackReadInputRegs ***/
+
+
+/************************************************************************************//**
+** \brief     Wrapper to connect this callback to the readHoldingRegs() method of a class
+**            instance.
+** \param     channel Handle to the Modbus server channel object that triggered the 
+**            callback.
+** \param     addr Address of the first element (0..65535).
+** \param     num Number of elements.
+** \param     values Array to write the values of the holding registers to.
+** \return    TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if one
+**            or more of the data element addresses are not supported by this server, 
+**            TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+**
+****************************************************************************************/
+tTbxMbServerResult TbxMbServer::callbackReadHoldingRegs(tTbxMbServer     channel, 
+                                                        uint16_t         addr, 
+                                                        uint8_t          num,
+                                                        uint16_t       * values)
+{
+  tTbxMbServerResult result = TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR;
+
+  /* Only continue with a valid opaque channel pointer and values pointer. */
+  if ( (channel != nullptr) && (values != nullptr) )
+  {
+    /* Convert the opaque pointer to the channel context structure pointer. */
+    ChannelCtx * channelCtx = reinterpret_cast<ChannelCtx *>(channel);
+    /* Only continue with a valid instance pointer. */
+    if (channelCtx->instancePtr != nullptr)
+    {
+      /* The channel's instance pointer points to an instance of this class. Cast it as
+       * such.
+       */
+      TbxMbServer * serverPtr = static_cast<TbxMbServer *>(channelCtx->instancePtr);
+      /* Call the related instance method. */
+      result = serverPtr->readHoldingRegs(addr, num, values);
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of callbackReadHoldingRegs ***/
+
+
+/************************************************************************************//**
+** \brief     Wrapper to connect this callback to the writeHoldingRegs() method of a
+**            class instance.
+** \param     channel Handle to the Modbus server channel object that triggered the 
+**            callback.
+** \param     addr Address of the first element (0..65535).
+** \param     num Number of elements.
+** \param     values Array with the new values of the holding registers.
+** \return    TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if one
+**            or more of the data element addresses are not supported by this server, 
+**            TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+**
+****************************************************************************************/
+tTbxMbServerResult TbxMbServer::callbackWriteHoldingRegs(tTbxMbServer     channel, 
+                                                         uint16_t         addr, 
+                                                         uint8_t          num,
+                                                         uint16_t const * values)
+{
+  tTbxMbServerResult result = TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR;
+
+  /* Only continue with a valid opaque channel pointer and values pointer. */
+  if ( (channel != nullptr) && (values != nullptr) )
+  {
+    /* Convert the opaque pointer to the channel context structure pointer. */
+    ChannelCtx * channelCtx = reinterpret_cast<ChannelCtx *>(channel);
+    /* Only continue with a valid instance pointer. */
+    if (channelCtx->instancePtr != nullptr)
+    {
+      /* The channel's instance pointer points to an instance of this class. Cast it as
+       * such.
+       */
+      TbxMbServer * serverPtr = static_cast<TbxMbServer *>(channelCtx->instancePtr);
+      /* Call the related instance method. */
+      result = serverPtr->writeHoldingRegs(addr, num, values);
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of callbackWriteHoldingRegs ***/
+
+
+/************************************************************************************//**
+** \brief     Wrapper to connect this callback to the readInputs() method of a class
+**            instance.
+** \param     channel Handle to the Modbus server channel object that triggered the
+**            callback.
+** \param     addr Address of the first element (0..65535).
+** \param     num Number of elements.
+** \param     bits Packed bit array where to store the states of the discrete inputs.
+** \return    TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if one
+**            or more of the data element addresses are not supported by this server,
+**            TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+**
+****************************************************************************************/
+tTbxMbServerResult TbxMbServer::callbackReadInputs(tTbxMbServer     channel,
+                                                   uint16_t         addr,
+                                                   uint16_t         num,
+                                                   uint8_t        * bits)
+{
+  tTbxMbServerResult result = TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR;
+
+  /* Only continue with a valid opaque channel pointer and bits pointer. */
+  if ( (channel != nullptr) && (bits != nullptr) )
+  {
+    /* Convert the opaque pointer to the channel context structure pointer. */
+    ChannelCtx * channelCtx = reinterpret_cast<ChannelCtx *>(channel);
+    /* Only continue with a valid instance pointer. */
+    if (channelCtx->instancePtr != nullptr)
+    {
+      /* The channel's instance pointer points to an instance of this class. Cast it as
+       * such.
+       */
+      TbxMbServer * serverPtr = static_cast<TbxMbServer *>(channelCtx->instancePtr);
+      /* Call the related instance method. */
+      result = serverPtr->readInputs(addr, num, bits);
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of callbackReadInputs ***/
+
+
+/************************************************************************************//**
+** \brief     Wrapper to connect this callback to the readCoils() method of a class
+**            instance.
+** \param     channel Handle to the Modbus server channel object that triggered the
+**            callback.
+** \param     addr Address of the first element (0..65535).
+** \param     num Number of elements.
+** \param     bits Packed bit array where to store the states of the coils.
+** \return    TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if one
+**            or more of the data element addresses are not supported by this server,
+**            TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+**
+****************************************************************************************/
+tTbxMbServerResult TbxMbServer::callbackReadCoils(tTbxMbServer     channel,
+                                                  uint16_t         addr,
+                                                  uint16_t         num,
+                                                  uint8_t        * bits)
+{
+  tTbxMbServerResult result = TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR;
+
+  /* Only continue with a valid opaque channel pointer and bits pointer. */
+  if ( (channel != nullptr) && (bits != nullptr) )
+  {
+    /* Convert the opaque pointer to the channel context structure pointer. */
+    ChannelCtx * channelCtx = reinterpret_cast<ChannelCtx *>(channel);
+    /* Only continue with a valid instance pointer. */
+    if (channelCtx->instancePtr != nullptr)
+    {
+      /* The channel's instance pointer points to an instance of this class. Cast it as
+       * such.
+       */
+      TbxMbServer * serverPtr = static_cast<TbxMbServer *>(channelCtx->instancePtr);
+      /* Call the related instance method. */
+      result = serverPtr->readCoils(addr, num, bits);
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of callbackReadCoils ***/
+
+
+/************************************************************************************//**
+** \brief     Wrapper to connect this callback to the writeCoils() method of a class
+**            instance.
+** \param     channel Handle to the Modbus server channel object that triggered the
+**            callback.
+** \param     addr Address of the first element (0..65535).
+** \param     num Number of elements.
+** \param     bits Packed bit array with the new states of the coils.
+** \return    TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if one
+**            or more of the data element addresses are not supported by this server,
+**            TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+**
+****************************************************************************************/
+tTbxMbServerResult TbxMbServer::callbackWriteCoils(tTbxMbServer     channel,
+                                                   uint16_t         addr,
+                                                   uint16_t         num,
+                                                   uint8_t  const * bits)
+{
+  tTbxMbServerResult result = TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR;
+
+  /* Only continue with a valid opaque channel pointer and bits pointer. */
+  if ( (channel != nullptr) && (bits != nullptr) )
+  {
+    /* Convert the opaque pointer to the channel context structure pointer. */
+    ChannelCtx * channelCtx = reinterpret_cast<ChannelCtx *>(channel);
+    /* Only continue with a valid instance pointer. */
+    if (channelCtx->instancePtr != nullptr)
+    {
+      /* The channel's instance pointer points to an instance of this class. Cast it as
+       * such.
+       */
+      TbxMbServer * serverPtr = static_cast<TbxMbServer *>(channelCtx->instancePtr);
+      /* Call the related instance method. */
+      result = serverPtr->writeCoils(addr, num, bits);
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of callbackWriteCoils ***/
+
+
+/************************************************************************************//**
+** \brief     Wrapper to connect this callback to the readFileRecord() method of a class
+**            instance.
+** \param     channel Handle to the Modbus server channel object that triggered the
+**            callback.
+** \param     file Number of the file (1..65535).
+** \param     record Number of the first record in the file (0..9999).
+** \param     num Number of records.
+** \param     values Array where to store the values of the records.
+** \return    TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if the
+**            file or one or more of its records are not supported by this server,
+**            TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+**
+****************************************************************************************/
+tTbxMbServerResult TbxMbServer::callbackReadFileRecord(tTbxMbServer     channel,
+                                                       uint16_t         file,
+                                                       uint16_t         record,
+                                                       uint8_t          num,
+                                                       uint16_t       * values)
+{
+  tTbxMbServerResult result = TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR;
+
+  /* Only continue with a valid opaque channel pointer and values pointer. */
+  if ( (channel != nullptr) && (values != nullptr) )
+  {
+    /* Convert the opaque pointer to the channel context structure pointer. */
+    ChannelCtx * channelCtx = reinterpret_cast<ChannelCtx *>(channel);
+    /* Only continue with a valid instance pointer. */
+    if (channelCtx->instancePtr != nullptr)
+    {
+      /* The channel's instance pointer points to an instance of this class. Cast it as
+       * such.
+       */
+      TbxMbServer * serverPtr = static_cast<TbxMbServer *>(channelCtx->instancePtr);
+      /* Call the related instance method. */
+      result = serverPtr->readFileRecord(file, record, num, values);
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of callbackReadFileRecord ***/
+
+/************************************************************************************//**
+** \brief     Wrapper to connect this callback to the writeFileRecord() method of a class
+**            instance.
+** \param     channel Handle to the Modbus server channel object that triggered the
+**            callback.
+** \param     file Number of the file (1..65535).
+** \param     record Number of the first record in the file (0..9999).
+** \param     num Number of records.
+** \param     values Array with the new values of the records.
+** \return    TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if the
+**            file or one or more of its records are not supported by this server,
+**            TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+**
+****************************************************************************************/
+tTbxMbServerResult TbxMbServer::callbackWriteFileRecord(tTbxMbServer     channel,
+                                                        uint16_t         file,
+                                                        uint16_t         record,
+                                                        uint8_t          num,
+                                                        uint16_t const * values)
+{
+  tTbxMbServerResult result = TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR;
+
+  /* Only continue with a valid opaque channel pointer and values pointer. */
+  if ( (channel != nullptr) && (values != nullptr) )
+  {
+    /* Convert the opaque pointer to the channel context structure pointer. */
+    ChannelCtx * channelCtx = reinterpret_cast<ChannelCtx *>(channel);
+    /* Only continue with a valid instance pointer. */
+    if (channelCtx->instancePtr != nullptr)
+    {
+      /* The channel's instance pointer points to an instance of this class. Cast it as
+       * such.
+       */
+      TbxMbServer * serverPtr = static_cast<TbxMbServer *>(channelCtx->instancePtr);
+      /* Call the related instance method. */
+      result = serverPtr->writeFileRecord(file, record, num, values);
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of callbackWriteFileRecord ***/
+
+
 /************************************************************************************//**
 ** \brief     Wrapper to connect this callback to the customFunction() method of a class
 **            instance.
@@ -498,6 +1341,40 @@ uint8_t TbxMbServer::calbackCustomFunction(tTbxMbServer         channel,
 } /*** end of calbackCustomFunction ***/
 
 
+/************************************************************************************//**
+** \brief     Wrapper to connect this callback to the tableWritten() method of a class
+**            instance.
+** \param     channel Handle to the Modbus server channel object that triggered the 
+**            callback.
+** \param     table The data table that was written to.
+** \param     addr Address of the first element that was written (0..65535).
+** \param     num Number of elements that were written.
+**
+****************************************************************************************/
+void TbxMbServer::callbackTableWritten(tTbxMbServer      channel,
+                                       tTbxMbServerTable table,
+                                       uint16_t          addr,
+                                       uint16_t          num)
+{
+  /* Only continue with a valid opaque channel pointer. */
+  if (channel != nullptr)
+  {
+    /* Convert the opaque pointer to the channel context structure pointer. */
+    ChannelCtx * channelCtx = reinterpret_cast<ChannelCtx *>(channel);
+    /* Only continue with a valid instance pointer. */
+    if (channelCtx->instancePtr != nullptr)
+    {
+      /* The channel's instance pointer points to an instance of this class. Cast it as
+       * such.
+       */
+      TbxMbServer * serverPtr = static_cast<TbxMbServer *>(channelCtx->instancePtr);
+      /* Call the related instance method. */
+      serverPtr->tableWritten(table, addr, num);
+    }
+  }
+} /*** end of callbackTableWritten ***/
+
+
 /****************************************************************************************
 *                            T B X M B S E R V E R R T U
 ****************************************************************************************/
@@ -549,7 +1426,16 @@ TbxMbServerRtu::TbxMbServerRtu(uint8_t            nodeAddr,
       TbxMbServerSetCallbackReadInputReg(m_Channel, callbackReadInputReg);
       TbxMbServerSetCallbackReadHoldingReg(m_Channel, callbackReadHoldingReg);
       TbxMbServerSetCallbackWriteHoldingReg(m_Channel, callbackWriteHoldingReg);
+      TbxMbServerSetCallbackReadInputRegs(m_Channel, callbackReadInputRegs);
+      TbxMbServerSetCallbackReadHoldingRegs(m_Channel, callbackReadHoldingRegs);
+      TbxMbServerSetCallbackWriteHoldingRegs(m_Channel, callbackWriteHoldingRegs);
+      TbxMbServerSetCallbackReadInputs(m_Channel, callbackReadInputs);
+      TbxMbServerSetCallbackReadCoils(m_Channel, callbackReadCoils);
+      TbxMbServerSetCallbackWriteCoils(m_Channel, callbackWriteCoils);
+      TbxMbServerSetCallbackReadFileRecord(m_Channel, callbackReadFileRecord);
+      TbxMbServerSetCallbackWriteFileRecord(m_Channel, callbackWriteFileRecord);
       TbxMbServerSetCallbackCustomFunction(m_Channel, calbackCustomFunction);
+      TbxMbServerSetCallbackTableWritten(m_Channel, callbackTableWritten);
     }
   }
 } /*** end of TbxMbServerRtu ***/
@@ -576,4 +1462,22 @@ TbxMbServerRtu::~TbxMbServerRtu()
 } /*** end of ~TbxMbServerRtu ***/
 
 
+/************************************************************************************//**
+** \brief     Binds the Modbus RTU server to an event loop. From then on, the task method
+**            of the event loop processes its events, instead of TbxMbEvent::task().
+**            For the best results, call this method right after constructing the object.
+** \param     loop The event loop to bind to.
+**
+****************************************************************************************/
+void TbxMbServerRtu::bind(TbxMbEventLoop & loop)
+{
+  /* Only continue with a valid transport layer and event loop object. */
+  if ((m_Transport != nullptr) && (loop.m_Loop != nullptr))
+  {
+    /* Bind the transport layer object, together with its server object. */
+    TbxMbEventLoopBind(loop.m_Loop, m_Transport);
+  }
+} /*** end of bind ***/
+
+
 /*********************************** end of tbxmbserver.cpp ****************************/
@@ -43,6 +43,8 @@ public:
   /* Constructors and destructor. */
   TbxMbServer() : m_Channel(nullptr) { }
   virtual ~TbxMbServer() = 0;
+  /* Methods. */
+  uint8_t fifoPush(uint16_t value);
 
 private:
   /* Methods. */
@@ -52,8 +54,24 @@ private:
   virtual tTbxMbServerResult readInputReg(uint16_t addr, uint16_t& value);
   virtual tTbxMbServerResult readHoldingReg(uint16_t addr, uint16_t& value);
   virtual tTbxMbServerResult writeHoldingReg(uint16_t addr, uint16_t value);
+  virtual tTbxMbServerResult readInputRegs(uint16_t addr, uint8_t num, 
+                                           uint16_t values[]);
+  virtual tTbxMbServerResult readHoldingRegs(uint16_t addr, uint8_t num, 
+                                             uint16_t values[]);
+  virtual tTbxMbServerResult writeHoldingRegs(uint16_t addr, uint8_t num, 
+                                              uint16_t const values[]);
+  virtual tTbxMbServerResult readInputs(uint16_t addr, uint16_t num, uint8_t bits[]);
+  virtual tTbxMbServerResult readCoils(uint16_t addr, uint16_t num, uint8_t bits[]);
+  virtual tTbxMbServerResult writeCoils(uint16_t addr, uint16_t num,
+                                        uint8_t const bits[]);
+  virtual tTbxMbServerResult readFileRecord(uint16_t file, uint16_t record, uint8_t num,
+                                            uint16_t values[]);
+  virtual tTbxMbServerResult writeFileRecord(uint16_t file, uint16_t record,
+                                             uint8_t num, uint16_t const values[]);
   virtual bool               customFunction(uint8_t const rxPdu[], uint8_t txPdu[], 
                                             uint8_t& len);
+  virtual void               tableWritten(tTbxMbServerTable table, uint16_t addr,
+                                          uint16_t num);
 
 protected:
   /* Types. */
@@ -63,6 +81,16 @@ protected:
   };
   /* Members. */
   tTbxMbServer m_Channel;
+  /* Methods. */
+  void setTableInputs(uint16_t addr, uint16_t num, uint8_t const bits[]);
+  void setTableCoils(uint16_t addr, uint16_t num, uint8_t bits[]);
+  void setTableInputRegs(uint16_t addr, uint16_t num, uint16_t const regs[]);
+  void setTableHoldingRegs(uint16_t addr, uint16_t num, uint16_t regs[]);
+  void setMapInputRegs(tTbxMbServerRegMapEntry const map[], uint16_t len);
+  void setMapHoldingRegs(tTbxMbServerRegMapEntry const map[], uint16_t len);
+  void setFunctionHandler(uint8_t code, tTbxMbServerCustomFunction handler);
+  void setFifo(uint16_t addr, uint16_t buffer[], uint16_t size);
+  void setDeviceIdObjects(tTbxMbServerDeviceIdObject const objects[], uint16_t len);
   /* Callbacks. */
   static tTbxMbServerResult callbackReadInput(tTbxMbServer channel, uint16_t addr, 
                                                uint8_t * value);
@@ -76,9 +104,31 @@ protected:
                                                    uint16_t * value);
   static tTbxMbServerResult callbackWriteHoldingReg(tTbxMbServer channel, uint16_t addr, 
                                                     uint16_t value);
+  static tTbxMbServerResult callbackReadInputRegs(tTbxMbServer channel, uint16_t addr, 
+                                                  uint8_t num, uint16_t * values);
+  static tTbxMbServerResult callbackReadHoldingRegs(tTbxMbServer channel, uint16_t addr, 
+                                                    uint8_t num, uint16_t * values);
+  static tTbxMbServerResult callbackWriteHoldingRegs(tTbxMbServer channel, 
+                                                     uint16_t addr, uint8_t num, 
+                                                     uint16_t const * values);
+  static tTbxMbServerResult callbackReadInputs(tTbxMbServer channel, uint16_t addr,
+                                               uint16_t num, uint8_t * bits);
+  static tTbxMbServerResult callbackReadCoils(tTbxMbServer channel, uint16_t addr,
+                                              uint16_t num, uint8_t * bits);
+  static tTbxMbServerResult callbackWriteCoils(tTbxMbServer channel, uint16_t addr,
+                                               uint16_t num, uint8_t const * bits);
+  static tTbxMbServerResult callbackReadFileRecord(tTbxMbServer channel, uint16_t file,
+                                                   uint16_t record, uint8_t num,
+                                                   uint16_t * values);
+  static tTbxMbServerResult callbackWriteFileRecord(tTbxMbServer channel, uint16_t file,
+                                                    uint16_t record, uint8_t num,
+                                                    uint16_t const * values);
   static  uint8_t           calbackCustomFunction(tTbxMbServer channel,
                                                   uint8_t const * rxPdu, uint8_t * txPdu,
                                                   uint8_t * len);
+  static void               callbackTableWritten(tTbxMbServer channel, 
+                                                 tTbxMbServerTable table, uint16_t addr,
+                                                 uint16_t num);
 };
 
 
@@ -94,6 +144,8 @@ public:
                  tTbxMbUartBaudrate baudrate, tTbxMbUartStopbits stopbits,
                  tTbxMbUartParity parity);
   virtual ~TbxMbServerRtu();
+  /* Methods. */
+  void bind(TbxMbEventLoop & loop);
 
 private:
   /* Members.*/
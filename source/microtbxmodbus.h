@@ -39,6 +39,8 @@
 #include "tbxmb_tp.h"                            /* MicroTBX-Modbus transport layer    */
 #include "tbxmb_uart.h"                          /* MicroTBX-Modbus UART               */
 #include "tbxmb_rtu.h"                           /* MicroTBX-Modbus RTU                */
+#include "tbxmb_ascii.h"                         /* MicroTBX-Modbus ASCII              */
+#include "tbxmb_tcp.h"                           /* MicroTBX-Modbus TCP                */
 #include "tbxmb_event.h"                         /* MicroTBX-Modbus event handling     */
 #include "tbxmb_server.h"                        /* MicroTBX-Modbus server             */
 #include "tbxmb_client.h"                        /* MicroTBX-Modbus client             */
@@ -41,51 +41,64 @@
 #include <semphr.h>                              /* FreeRTOS semaphores                */
 
 
-/****************************************************************************************
-* Local data declarations
+/************************************************************************************//**
+** \brief     Creates a new event queue object.
+** \return    Handle to the newly created event queue object if successful, NULL
+**            otherwise.
+**
 ****************************************************************************************/
-/** \brief Queue handle for storing events. */
-static QueueHandle_t eventQueue;
+tTbxMbOsalEventQueue TbxMbOsalEventQueueCreate(void)
+{
+  tTbxMbOsalEventQueue result;
+
+  /* Create the event queue. */
+  result = xQueueCreate(TBX_MB_EVENT_QUEUE_SIZE, sizeof(tTbxMbEvent));
+  /* Check that the queue creation was successful. If this assertion fails, increase
+   * the FreeRTOS heap size.
+   */
+  TBX_ASSERT(result != NULL);
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbOsalEventQueueCreate ***/
 
 
 /************************************************************************************//**
-** \brief     Initialization function for the OSAL event module. 
-** \attention This function has a built-in protection to make sure it only runs once.
+** \brief     Releases an event queue object, previously created with
+**            TbxMbOsalEventQueueCreate().
+** \param     queue Handle to the event queue object to release.
 **
 ****************************************************************************************/
-void TbxMbOsalEventInit(void)
+void TbxMbOsalEventQueueFree(tTbxMbOsalEventQueue queue)
 {
-  static uint8_t osalInitialized = TBX_FALSE;
+  /* Verify parameters. */
+  TBX_ASSERT(queue != NULL);
 
-  /* Only run this function once, */
-  if (osalInitialized == TBX_FALSE)
+  /* Only continue with valid parameters. */
+  if (queue != NULL)
   {
-    osalInitialized = TBX_TRUE;
-    /* Create the event queue. */
-    eventQueue = xQueueCreate(TBX_MB_EVENT_QUEUE_SIZE, sizeof(tTbxMbEvent));
-    /* Check that the queue creation was successful. If this assertion fails, increase
-     * the FreeRTOS heap size.
-     */
-    TBX_ASSERT(eventQueue != NULL);
+    /* Delete the event queue. */
+    vQueueDelete(queue);
   }
-} /*** end of TbxMbOsalEventInit ***/
+} /*** end of TbxMbOsalEventQueueFree ***/
 
 
 /************************************************************************************//**
 ** \brief     Signals the occurrence of an event.
+** \param     queue Handle to the event queue object to post the event to.
 ** \param     event Pointer to the event to signal.
 ** \param     fromIsr TBX_TRUE when calling this function from an interrupt service
 **            routine, TBX_FALSE otherwise.
 **
 ****************************************************************************************/
-void TbxMbOsalEventPost(tTbxMbEvent const * event, 
-                        uint8_t             fromIsr)
+void TbxMbOsalEventPost(tTbxMbOsalEventQueue   queue,
+                        tTbxMbEvent    const * event, 
+                        uint8_t                fromIsr)
 {
   /* Verify parameters. */
-  TBX_ASSERT(event != NULL);
+  TBX_ASSERT((queue != NULL) && (event != NULL));
 
   /* Only continue with valid parameters. */
-  if (event != NULL)
+  if ((queue != NULL) && (event != NULL))
   {
     /* Not calling from an ISR? */
     if (fromIsr == TBX_FALSE)
@@ -93,7 +106,7 @@ void TbxMbOsalEventPost(tTbxMbEvent const * event,
       /* Add the event to the queue. There should be space in the queue so no need to
        * wait for a spot to become available in the queue.
        */
-      BaseType_t queueResult = xQueueSend(eventQueue, (void const *)event, 0U);
+      BaseType_t queueResult = xQueueSend(queue, (void const *)event, 0U);
       /* Make sure the event could be added. If not, then the event queue size is set
        * too small. In this case increase the event queue size using configuration
        * macro TBX_MB_EVENT_QUEUE_SIZE.
@@ -108,7 +121,7 @@ void TbxMbOsalEventPost(tTbxMbEvent const * event,
       /* Add the event to the queue. There should be space in the queue, so this should
        * always succeed.
        */
-      BaseType_t queueResult = xQueueSendFromISR(eventQueue, event, 
+      BaseType_t queueResult = xQueueSendFromISR(queue, event, 
                                                  &xHigherPriorityTaskWoken);
       /* Make sure the event could be added. If not, then the event queue size is set
        * too small. In this case increase the event queue size using configuration
@@ -130,28 +143,60 @@ void TbxMbOsalEventPost(tTbxMbEvent const * event,
 
 
 /************************************************************************************//**
-** \brief     Wait for an event to occur.
-** \param     event Pointer where the occurred event is written to.
-** \param     timeoutMs Maximum time in milliseconds to block while waiting for an
+** \brief     Signals the occurrence of an event from an interrupt service routine.
+** \param     queue Handle to the event queue object to post the event to.
+** \param     event Pointer to the event to signal.
+** \param     source Interrupt source that posts the event. Not needed by this OSAL,
+**            because its event queue already serializes concurrent posts.
+**
+****************************************************************************************/
+void TbxMbOsalEventPostFromIsr(tTbxMbOsalEventQueue   queue,
+                               tTbxMbEvent    const * event,
+                               uint8_t                source)
+{
+  TBX_UNUSED_ARG(source);
+
+  /* Post the event to the queue from interrupt level. */
+  TbxMbOsalEventPost(queue, event, TBX_TRUE);
+} /*** end of TbxMbOsalEventPostFromIsr ***/
+
+
+/************************************************************************************//**
+** \brief     Wait for events to occur. Once the first event arrived, the events that are
+**            already queued behind it are retrieved as well, without blocking again.
+** \param     queue Handle to the event queue object to wait on.
+** \param     events Array where the occurred events are written to, in the order that
+**            they were posted.
+** \param     maxEvents Maximum number of events to write to the array.
+** \param     timeoutMs Maximum time in milliseconds to block while waiting for the first
 **            event.
-** \return    TBX_TRUE if an event occurred, TBX_FALSE otherwise (typically a timeout).
+** \return    Number of events written to the array. Zero if no event occurred (typically
+**            a timeout).
 **
 ****************************************************************************************/
-uint8_t TbxMbOsalEventWait(tTbxMbEvent * event,
-                           uint16_t      timeoutMs)
+uint8_t TbxMbOsalEventWait(tTbxMbOsalEventQueue   queue,
+                           tTbxMbEvent            events[],
+                           uint8_t                maxEvents,
+                           uint16_t               timeoutMs)
 {
-  uint8_t result = TBX_FALSE;
+  uint8_t result = 0U;
 
   /* Verify parameters. */
-  TBX_ASSERT(event != NULL);
+  TBX_ASSERT((queue != NULL) && (events != NULL) && (maxEvents > 0U));
 
   /* Only continue with valid parameters. */
-  if (event != NULL)
+  if ((queue != NULL) && (events != NULL) && (maxEvents > 0U))
   {
     /* Wait for a new event to arrive in the queue. */
-    if (xQueueReceive(eventQueue, event, pdMS_TO_TICKS(timeoutMs)) == pdTRUE)
+    if (xQueueReceive(queue, &events[0], pdMS_TO_TICKS(timeoutMs)) == pdTRUE)
     {
-      result = TBX_TRUE;
+      result = 1U;
+      /* Retrieve the events that are already queued behind it, without waiting. */
+      while ((result < maxEvents) &&
+             (xQueueReceive(queue, &events[result], 0U) == pdTRUE))
+      {
+        result++;
+      }
     }
   }
   /* Give the result back to the caller. */
@@ -159,6 +204,20 @@ uint8_t TbxMbOsalEventWait(tTbxMbEvent * event,
 } /*** end of TbxMbOsalEventWait ***/
 
 
+/************************************************************************************//**
+** \brief     Informs the caller whether TbxMbOsalEventPost() can be called from a task
+**            other than the one that runs the event task. This is the case for this
+**            OSAL, because a FreeRTOS queue holds the events.
+** \return    TBX_TRUE.
+**
+****************************************************************************************/
+uint8_t TbxMbOsalEventPostIsThreadSafe(void)
+{
+  /* Give the result back to the caller. */
+  return TBX_TRUE;
+} /*** end of TbxMbOsalEventPostIsThreadSafe ***/
+
+
 /************************************************************************************//**
 ** \brief     Creates a new binary semaphore object with an initial count of 0, meaning
 **            that it's taken.
@@ -0,0 +1,527 @@
+/************************************************************************************//**
+* \file         tbxmb_posix.c
+* \brief        Modbus OSAL source file for POSIX threads (e.g. Linux).
+* \internal
+*----------------------------------------------------------------------------------------
+*                          C O P Y R I G H T
+*----------------------------------------------------------------------------------------
+*   Copyright (c) 2023 by Feaser     www.feaser.com     All rights reserved
+*
+*----------------------------------------------------------------------------------------
+*                            L I C E N S E
+*----------------------------------------------------------------------------------------
+*
+* SPDX-License-Identifier: GPL-3.0-or-later
+*
+* This file is part of MicroTBX-Modbus. MicroTBX-Modbus is free software: you can
+* redistribute it and/or modify it under the terms of the GNU General Public License as
+* published by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* MicroTBX-Modbus is distributed in the hope that it will be useful, but WITHOUT ANY
+* WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+* PARTICULAR PURPOSE. See the GNU General Public License for more details.
+*
+* You have received a copy of the GNU General Public License along with MicroTBX-Modbus.
+* If not, see www.gnu.org/licenses/.
+*
+* \endinternal
+****************************************************************************************/
+
+/****************************************************************************************
+* Include files
+****************************************************************************************/
+#include "microtbx.h"                            /* MicroTBX module                    */
+#include "microtbxmodbus.h"                      /* MicroTBX-Modbus module             */
+#include "tbxmb_event_private.h"                 /* MicroTBX-Modbus event private      */
+#include "tbxmb_osal_private.h"                  /* MicroTBX-Modbus OSAL private       */
+#include <pthread.h>                             /* POSIX threads                      */
+#include <time.h>                                /* Time functions                     */
+#include <errno.h>                               /* Error numbers                      */
+
+
+/****************************************************************************************
+* Macro definitions
+****************************************************************************************/
+/** \brief Unique context type to identify a context as being a semaphore. */
+#define TBX_MB_OSAL_SEM_CONTEXT_TYPE   (76U)
+
+/** \brief Unique context type to identify a context as being an event queue. */
+#define TBX_MB_OSAL_QUEUE_CONTEXT_TYPE (58U)
+
+
+/****************************************************************************************
+* Type definitions
+****************************************************************************************/
+/** \brief Data type that groups semaphore related information. It's what the
+ *         tTbxMbOsalSem opaque pointer points to.
+ */
+typedef struct
+{
+  uint8_t         type;                /**< Context type.                              */
+  uint8_t         count;               /**< Semaphore count. 0 = taken, 1 = available. */
+  pthread_mutex_t mutex;               /**< Mutex that protects the count.             */
+  pthread_cond_t  cond;                /**< Signals that the count became available.   */
+} tTbxMbOsalSemCtx;
+
+
+/** \brief Data type that groups event queue related information. It's what the
+ *         tTbxMbOsalEventQueue opaque pointer points to. It's a ring buffer based
+ *         First-In-First-Out (FIFO) queue for storing events.
+ */
+typedef struct
+{
+  uint8_t         type;                               /**< Context type.               */
+  tTbxMbEvent     entries[TBX_MB_EVENT_QUEUE_SIZE];   /**< Preallocated event storage. */
+  uint16_t        count;                              /**< Number of stored entries.   */
+  uint16_t        readIdx;                            /**< Read index into entries[].  */
+  uint16_t        writeIdx;                           /**< Write index into entries[]. */
+  pthread_mutex_t mutex;                              /**< Queue access mutex.         */
+  pthread_cond_t  cond;                               /**< Signals a newly added event.*/
+} tTbxMbOsalQueueCtx;
+
+
+/****************************************************************************************
+* Function prototypes
+****************************************************************************************/
+static void TbxMbOsalPosixCondInit(pthread_cond_t  * cond);
+
+static void TbxMbOsalPosixDeadline(struct timespec * deadline,
+                                   uint16_t          timeoutMs);
+
+
+/************************************************************************************//**
+** \brief     Creates a new event queue object.
+** \return    Handle to the newly created event queue object if successful, NULL
+**            otherwise.
+**
+****************************************************************************************/
+tTbxMbOsalEventQueue TbxMbOsalEventQueueCreate(void)
+{
+  tTbxMbOsalEventQueue result = NULL;
+
+  /* Allocate memory for the new event queue context. */
+  tTbxMbOsalQueueCtx * newQueueCtx = TbxMemPoolAllocate(sizeof(tTbxMbOsalQueueCtx));
+  /* Automatically increase the memory pool, if it was too small. */
+  if (newQueueCtx == NULL)
+  {
+    /* No need to check the return value, because if it failed, the following
+     * allocation fails too, which is verified later on.
+     */
+    (void)TbxMemPoolCreate(1U, sizeof(tTbxMbOsalQueueCtx));
+    newQueueCtx = TbxMemPoolAllocate(sizeof(tTbxMbOsalQueueCtx));
+  }
+  /* Verify memory allocation of the event queue context. */
+  TBX_ASSERT(newQueueCtx != NULL);
+  /* Only continue if the memory allocation succeeded. */
+  if (newQueueCtx != NULL)
+  {
+    /* Initialize the queue. */
+    newQueueCtx->type = TBX_MB_OSAL_QUEUE_CONTEXT_TYPE;
+    newQueueCtx->count = 0U;
+    newQueueCtx->readIdx = 0U;
+    newQueueCtx->writeIdx = 0U;
+    (void)pthread_mutex_init(&newQueueCtx->mutex, NULL);
+    TbxMbOsalPosixCondInit(&newQueueCtx->cond);
+    /* Update the result. */
+    result = newQueueCtx;
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbOsalEventQueueCreate ***/
+
+
+/************************************************************************************//**
+** \brief     Releases an event queue object, previously created with
+**            TbxMbOsalEventQueueCreate().
+** \param     queue Handle to the event queue object to release.
+**
+****************************************************************************************/
+void TbxMbOsalEventQueueFree(tTbxMbOsalEventQueue queue)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(queue != NULL);
+
+  /* Only continue with valid parameters. */
+  if (queue != NULL)
+  {
+    /* Convert the event queue pointer to the context structure. */
+    tTbxMbOsalQueueCtx * queueCtx = (tTbxMbOsalQueueCtx *)queue;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(queueCtx->type == TBX_MB_OSAL_QUEUE_CONTEXT_TYPE);
+    /* Release the POSIX synchronization objects. */
+    (void)pthread_cond_destroy(&queueCtx->cond);
+    (void)pthread_mutex_destroy(&queueCtx->mutex);
+    /* Invalidate the context to protect it from accidentally being used afterwards. */
+    queueCtx->type = 0U;
+    /* Give the event queue context back to the memory pool. */
+    TbxMemPoolRelease(queueCtx);
+  }
+} /*** end of TbxMbOsalEventQueueFree ***/
+
+
+/************************************************************************************//**
+** \brief     Signals the occurrence of an event.
+** \details   There are no interrupts on a POSIX system. The hardware port typically
+**            calls the UART event functions from a separate thread, so the fromIsr
+**            parameter makes no difference. Note that this function is not async-signal
+**            safe, so it should not be called from a signal handler.
+** \param     queue Handle to the event queue object to post the event to.
+** \param     event Pointer to the event to signal.
+** \param     fromIsr TBX_TRUE when calling this function from an interrupt service
+**            routine, TBX_FALSE otherwise.
+**
+****************************************************************************************/
+void TbxMbOsalEventPost(tTbxMbOsalEventQueue   queue,
+                        tTbxMbEvent    const * event,
+                        uint8_t                fromIsr)
+{
+  TBX_UNUSED_ARG(fromIsr);
+
+  /* Verify parameters. */
+  TBX_ASSERT((queue != NULL) && (event != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((queue != NULL) && (event != NULL))
+  {
+    /* Convert the event queue pointer to the context structure. */
+    tTbxMbOsalQueueCtx * queueCtx = (tTbxMbOsalQueueCtx *)queue;
+    (void)pthread_mutex_lock(&queueCtx->mutex);
+    /* Make sure there is still space in the queue. If not, then the event queue size is
+     * set too small. In this case increase the event queue size using configuration
+     * macro TBX_MB_EVENT_QUEUE_SIZE.
+     */
+    TBX_ASSERT(queueCtx->count < TBX_MB_EVENT_QUEUE_SIZE);
+
+    /* Only continue with enough space. */
+    if (queueCtx->count < TBX_MB_EVENT_QUEUE_SIZE)
+    {
+      /* Store the new event in the queue at the current write index. */
+      queueCtx->entries[queueCtx->writeIdx] = *event;
+      /* Update the total count. */
+      queueCtx->count++;
+      /* Increment the write index to point to the next entry. */
+      queueCtx->writeIdx++;
+      /* Time to wrap around to the start? */
+      if (queueCtx->writeIdx == TBX_MB_EVENT_QUEUE_SIZE)
+      {
+        queueCtx->writeIdx = 0U;
+      }
+      /* Wake up the thread that waits for an event, if any. */
+      (void)pthread_cond_signal(&queueCtx->cond);
+    }
+    (void)pthread_mutex_unlock(&queueCtx->mutex);
+  }
+} /*** end of TbxMbOsalEventPost ***/
+
+
+/************************************************************************************//**
+** \brief     Signals the occurrence of an event from an interrupt service routine.
+** \param     queue Handle to the event queue object to post the event to.
+** \param     event Pointer to the event to signal.
+** \param     source Interrupt source that posts the event. Not needed by this OSAL,
+**            because its event queue already serializes concurrent posts.
+**
+****************************************************************************************/
+void TbxMbOsalEventPostFromIsr(tTbxMbOsalEventQueue   queue,
+                               tTbxMbEvent    const * event,
+                               uint8_t                source)
+{
+  TBX_UNUSED_ARG(source);
+
+  /* Post the event to the queue from interrupt level. */
+  TbxMbOsalEventPost(queue, event, TBX_TRUE);
+} /*** end of TbxMbOsalEventPostFromIsr ***/
+
+
+/************************************************************************************//**
+** \brief     Wait for events to occur. The calling thread sleeps until an event is
+**            posted or the timeout expires. All events that are queued at that point are
+**            retrieved while locking the queue just once.
+** \param     queue Handle to the event queue object to wait on.
+** \param     events Array where the occurred events are written to, in the order that
+**            they were posted.
+** \param     maxEvents Maximum number of events to write to the array.
+** \param     timeoutMs Maximum time in milliseconds to block while waiting for the first
+**            event.
+** \return    Number of events written to the array. Zero if no event occurred (typically
+**            a timeout).
+**
+****************************************************************************************/
+uint8_t TbxMbOsalEventWait(tTbxMbOsalEventQueue   queue,
+                           tTbxMbEvent            events[],
+                           uint8_t                maxEvents,
+                           uint16_t               timeoutMs)
+{
+  uint8_t result = 0U;
+
+  /* Verify parameters. */
+  TBX_ASSERT((queue != NULL) && (events != NULL) && (maxEvents > 0U));
+
+  /* Only continue with valid parameters. */
+  if ((queue != NULL) && (events != NULL) && (maxEvents > 0U))
+  {
+    /* Convert the event queue pointer to the context structure. */
+    tTbxMbOsalQueueCtx * queueCtx = (tTbxMbOsalQueueCtx *)queue;
+    struct timespec deadline;
+    int             waitResult = 0;
+
+    /* Determine the point in time at which the wait should end. */
+    TbxMbOsalPosixDeadline(&deadline, timeoutMs);
+    (void)pthread_mutex_lock(&queueCtx->mutex);
+    /* Wait for an event to arrive in the queue. The loop protects against spurious
+     * wake ups.
+     */
+    while ((queueCtx->count == 0U) && (waitResult != ETIMEDOUT))
+    {
+      waitResult = pthread_cond_timedwait(&queueCtx->cond, &queueCtx->mutex,
+                                          &deadline);
+    }
+    /* Retrieve the queued events, oldest first, until the array is full. */
+    while ((queueCtx->count > 0U) && (result < maxEvents))
+    {
+      /* Retrieve the event at the current read index. */
+      events[result] = queueCtx->entries[queueCtx->readIdx];
+      /* Update the total count. */
+      queueCtx->count--;
+      /* Increment the read index to point to the next entry. */
+      queueCtx->readIdx++;
+      /* Time to wrap around to the start? */
+      if (queueCtx->readIdx == TBX_MB_EVENT_QUEUE_SIZE)
+      {
+        queueCtx->readIdx = 0U;
+      }
+      /* Update the result. */
+      result++;
+    }
+    (void)pthread_mutex_unlock(&queueCtx->mutex);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbOsalEventWait ***/
+
+
+/************************************************************************************//**
+** \brief     Informs the caller whether TbxMbOsalEventPost() can be called from a thread
+**            other than the one that runs the event task. This is the case for this
+**            OSAL, because a mutex protects the event queue.
+** \return    TBX_TRUE.
+**
+****************************************************************************************/
+uint8_t TbxMbOsalEventPostIsThreadSafe(void)
+{
+  /* Give the result back to the caller. */
+  return TBX_TRUE;
+} /*** end of TbxMbOsalEventPostIsThreadSafe ***/
+
+
+/************************************************************************************//**
+** \brief     Creates a new binary semaphore object with an initial count of 0, meaning
+**            that it's taken.
+** \return    Handle to the newly created binary semaphore object if successful, NULL
+**            otherwise.
+**
+****************************************************************************************/
+tTbxMbOsalSem TbxMbOsalSemCreate(void)
+{
+  tTbxMbOsalSem result = NULL;
+
+  /* Allocate memory for the new semaphore context. */
+  tTbxMbOsalSemCtx * newSemCtx = TbxMemPoolAllocate(sizeof(tTbxMbOsalSemCtx));
+  /* Automatically increase the memory pool, if it was too small. */
+  if (newSemCtx == NULL)
+  {
+    /* No need to check the return value, because if it failed, the following
+     * allocation fails too, which is verified later on.
+     */
+    (void)TbxMemPoolCreate(1U, sizeof(tTbxMbOsalSemCtx));
+    newSemCtx = TbxMemPoolAllocate(sizeof(tTbxMbOsalSemCtx));
+  }
+  /* Verify memory allocation of the semaphore context. */
+  TBX_ASSERT(newSemCtx != NULL);
+  /* Only continue if the memory allocation succeeded. */
+  if (newSemCtx != NULL)
+  {
+    /* Initialize the semaphore in a taken state. */
+    newSemCtx->type = TBX_MB_OSAL_SEM_CONTEXT_TYPE;
+    newSemCtx->count = 0U;
+    (void)pthread_mutex_init(&newSemCtx->mutex, NULL);
+    TbxMbOsalPosixCondInit(&newSemCtx->cond);
+    /* Update the result. */
+    result = newSemCtx;
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbOsalSemCreate ***/
+
+
+/************************************************************************************//**
+** \brief     Releases a binary semaphore object, previously created with
+**            TbxMbOsalSemCreate().
+** \param     sem Handle to the binary semaphore object to release.
+**
+****************************************************************************************/
+void TbxMbOsalSemFree(tTbxMbOsalSem sem)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(sem != NULL);
+
+  /* Only continue with valid parameters. */
+  if (sem != NULL)
+  {
+    /* Convert the semaphore pointer to the context structure. */
+    tTbxMbOsalSemCtx * semCtx = (tTbxMbOsalSemCtx *)sem;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(semCtx->type == TBX_MB_OSAL_SEM_CONTEXT_TYPE);
+    /* Release the POSIX synchronization objects. */
+    (void)pthread_cond_destroy(&semCtx->cond);
+    (void)pthread_mutex_destroy(&semCtx->mutex);
+    /* Invalidate the context to protect it from accidentally being used afterwards. */
+    semCtx->type = 0U;
+    /* Give the semaphore context back to the memory pool. */
+    TbxMemPoolRelease(semCtx);
+  }
+} /*** end of TbxMbOsalSemFree ***/
+
+
+/************************************************************************************//**
+** \brief     Give the semaphore, setting its count to 1, meaning that it's available.
+** \param     sem Handle to the binary semaphore object.
+** \param     fromIsr TBX_TRUE when calling this function from an interrupt service
+**            routine, TBX_FALSE otherwise.
+**
+****************************************************************************************/
+void TbxMbOsalSemGive(tTbxMbOsalSem sem,
+                      uint8_t       fromIsr)
+{
+  TBX_UNUSED_ARG(fromIsr);
+
+  /* Verify parameters. */
+  TBX_ASSERT(sem != NULL);
+
+  /* Only continue with valid parameters. */
+  if (sem != NULL)
+  {
+    /* Convert the semaphore pointer to the context structure. */
+    tTbxMbOsalSemCtx * semCtx = (tTbxMbOsalSemCtx *)sem;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(semCtx->type == TBX_MB_OSAL_SEM_CONTEXT_TYPE);
+    /* Give the semaphore by setting its count to 1 and wake up a waiting thread. */
+    (void)pthread_mutex_lock(&semCtx->mutex);
+    semCtx->count = 1U;
+    (void)pthread_cond_signal(&semCtx->cond);
+    (void)pthread_mutex_unlock(&semCtx->mutex);
+  }
+} /*** end of TbxMbOsalSemGive ***/
+
+
+/************************************************************************************//**
+** \brief     Take the semaphore when available (count > 0) or wait a finite amount of
+**            time for it to become available. The take operation decrements to count.
+**            The calling thread sleeps while waiting. This means that a separate thread
+**            must call TbxMbEventTask(), as is the case with an RTOS.
+** \param     sem Handle to the binary semaphore object.
+** \param     timeoutMs Maximum time in milliseconds to block while waiting for the
+**            semaphore to become available.
+** \return    TBX_TRUE if the semaphore could be taken, TBX_FALSE otherwise (typically a
+**            timeout).
+**
+****************************************************************************************/
+uint8_t TbxMbOsalSemTake(tTbxMbOsalSem sem,
+                         uint16_t      timeoutMs)
+{
+  uint8_t result = TBX_FALSE;
+
+  /* Verify parameters. */
+  TBX_ASSERT(sem != NULL);
+
+  /* Only continue with valid parameters. */
+  if (sem != NULL)
+  {
+    /* Convert the semaphore pointer to the context structure. */
+    tTbxMbOsalSemCtx * semCtx = (tTbxMbOsalSemCtx *)sem;
+    struct timespec    deadline;
+    int                waitResult = 0;
+
+    /* Sanity check on the context type. */
+    TBX_ASSERT(semCtx->type == TBX_MB_OSAL_SEM_CONTEXT_TYPE);
+    /* Determine the point in time at which the wait should end. */
+    TbxMbOsalPosixDeadline(&deadline, timeoutMs);
+    (void)pthread_mutex_lock(&semCtx->mutex);
+    /* Wait for the semaphore to become available. The loop protects against spurious
+     * wake ups.
+     */
+    while ((semCtx->count == 0U) && (waitResult != ETIMEDOUT))
+    {
+      waitResult = pthread_cond_timedwait(&semCtx->cond, &semCtx->mutex, &deadline);
+    }
+    /* Is the semaphore available? */
+    if (semCtx->count > 0U)
+    {
+      /* Take the semaphore and update the result for success. */
+      semCtx->count = 0U;
+      result = TBX_TRUE;
+    }
+    (void)pthread_mutex_unlock(&semCtx->mutex);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbOsalSemTake ****/
+
+
+/************************************************************************************//**
+** \brief     Initializes a condition variable such that its timed wait operates on the
+**            monotonic clock. This way, changes to the system time (e.g. by NTP) do not
+**            affect the timeouts.
+** \param     cond Pointer to the condition variable to initialize.
+**
+****************************************************************************************/
+static void TbxMbOsalPosixCondInit(pthread_cond_t * cond)
+{
+  pthread_condattr_t condAttr;
+
+  /* Verify parameters. */
+  TBX_ASSERT(cond != NULL);
+
+  /* Only continue with valid parameters. */
+  if (cond != NULL)
+  {
+    (void)pthread_condattr_init(&condAttr);
+    (void)pthread_condattr_setclock(&condAttr, CLOCK_MONOTONIC);
+    (void)pthread_cond_init(cond, &condAttr);
+    (void)pthread_condattr_destroy(&condAttr);
+  }
+} /*** end of TbxMbOsalPosixCondInit ***/
+
+
+/************************************************************************************//**
+** \brief     Determines the absolute point in time on the monotonic clock, at which a
+**            wait operation with the specified timeout ends.
+** \param     deadline Pointer to where the point in time is written to.
+** \param     timeoutMs Timeout in milliseconds, relative to now.
+**
+****************************************************************************************/
+static void TbxMbOsalPosixDeadline(struct timespec * deadline,
+                                   uint16_t          timeoutMs)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(deadline != NULL);
+
+  /* Only continue with valid parameters. */
+  if (deadline != NULL)
+  {
+    /* Get the current time and add the timeout to it. */
+    (void)clock_gettime(CLOCK_MONOTONIC, deadline);
+    deadline->tv_sec += (time_t)(timeoutMs / 1000U);
+    deadline->tv_nsec += (long)(timeoutMs % 1000U) * 1000000L;
+    /* Normalize the nanoseconds. */
+    if (deadline->tv_nsec >= 1000000000L)
+    {
+      deadline->tv_sec++;
+      deadline->tv_nsec -= 1000000000L;
+    }
+  }
+} /*** end of TbxMbOsalPosixDeadline ***/
+
+
+/*********************************** end of tbxmb_posix.c ******************************/
@@ -43,6 +43,19 @@
 /** \brief Unique context type to identify a context as being a semaphore. */
 #define TBX_MB_OSAL_SEM_CONTEXT_TYPE   (76U)
 
+/** \brief Unique context type to identify a context as being an event queue. */
+#define TBX_MB_OSAL_QUEUE_CONTEXT_TYPE (58U)
+
+#ifndef TBX_MB_EVENT_ISR_QUEUE_SIZE
+/** \brief Configure the number of events that each interrupt source can have pending in
+ *         its own queue. A UART interrupt source posts at most one event per Modbus
+ *         packet, which the event task consumes before the next packet completes. If for
+ *         some reason a different size is desired, you can override this configuration
+ *         by adding a macro with the same name, but a different value, to "tbx_conf.h".
+ */
+#define TBX_MB_EVENT_ISR_QUEUE_SIZE    (2U)
+#endif
+
 
 /****************************************************************************************
 * Type definitions
@@ -57,131 +70,310 @@ typedef struct
 } tTbxMbOsalSemCtx;
 
 
-/****************************************************************************************
-* Local data declarations
+/** \brief Single producer single consumer ring buffer for the events of one interrupt
+ *         source. The interrupt only writes the write index and the event task only
+ *         writes the read index. Both indices fit in a single byte, so reading and
+ *         writing them is atomic on any microcontroller. One entry always stays unused,
+ *         to tell a full ring buffer apart from an empty one.
+ */
+typedef struct
+{
+  tTbxMbEvent entries[TBX_MB_EVENT_ISR_QUEUE_SIZE + 1U]; /**< Event storage.           */
+  uint8_t     writeIdx;                                  /**< Write index (producer).  */
+  uint8_t     readIdx;                                   /**< Read index (consumer).   */
+} tTbxMbOsalIsrQueue;
+
+
+/** \brief Data type that groups event queue related information. It's what the
+ *         tTbxMbOsalEventQueue opaque pointer points to.
+ */
+typedef struct
+{
+  /** \brief Context type. */
+  uint8_t                     type;
+  /** \brief Ring buffer based First-In-First-Out (FIFO) queue for storing the events
+   *         that are posted at task level. Without an RTOS, there is only one task, so
+   *         this queue needs no protection against concurrent access.
+   */
+  struct
+  {
+    tTbxMbEvent entries[TBX_MB_EVENT_QUEUE_SIZE];     /**< Preallocated event storage. */
+    uint16_t    count;                                /**< Number of stored entries.   */
+    uint16_t    readIdx;                              /**< Read index into entries[].  */
+    uint16_t    writeIdx;                             /**< Write index into entries[]. */
+  } task;
+  /** \brief Lock-free queues for storing the events that are posted at interrupt level,
+   *         one per interrupt source. Volatile such that the compiler keeps the write
+   *         of an entry ahead of the index update that publishes it.
+   */
+  volatile tTbxMbOsalIsrQueue isr[TBX_MB_OSAL_ISR_SOURCE_NUM];
+} tTbxMbOsalQueueCtx;
+
+
+/************************************************************************************//**
+** \brief     Creates a new event queue object.
+** \return    Handle to the newly created event queue object if successful, NULL
+**            otherwise.
+**
 ****************************************************************************************/
-/** \brief Ring buffer based First-In-First-Out (FIFO) queue for storing events. */
-static struct 
+tTbxMbOsalEventQueue TbxMbOsalEventQueueCreate(void)
 {
-  tTbxMbEvent entries[TBX_MB_EVENT_QUEUE_SIZE];       /**< Preallocated event storage. */
-  uint16_t    count;                                  /**< Number of stored entries.   */
-  uint16_t    readIdx;                                /**< Read index into entries[].  */
-  uint16_t    writeIdx;                               /**< Write index into entries[]. */
-} eventQueue;
+  tTbxMbOsalEventQueue result = NULL;
+
+  /* Allocate memory for the new event queue context. */
+  tTbxMbOsalQueueCtx * newQueueCtx = TbxMemPoolAllocate(sizeof(tTbxMbOsalQueueCtx));
+  /* Automatically increase the memory pool, if it was too small. */
+  if (newQueueCtx == NULL)
+  {
+    /* No need to check the return value, because if it failed, the following
+     * allocation fails too, which is verified later on.
+     */
+    (void)TbxMemPoolCreate(1U, sizeof(tTbxMbOsalQueueCtx));
+    newQueueCtx = TbxMemPoolAllocate(sizeof(tTbxMbOsalQueueCtx));
+  }
+  /* Verify memory allocation of the event queue context. */
+  TBX_ASSERT(newQueueCtx != NULL);
+  /* Only continue if the memory allocation succeeded. */
+  if (newQueueCtx != NULL)
+  {
+    /* Initialize the task level queue. */
+    newQueueCtx->type = TBX_MB_OSAL_QUEUE_CONTEXT_TYPE;
+    newQueueCtx->task.count = 0U;
+    newQueueCtx->task.readIdx = 0U;
+    newQueueCtx->task.writeIdx = 0U;
+    /* Initialize the interrupt level queues. */
+    for (uint8_t srcIdx = 0U; srcIdx < TBX_MB_OSAL_ISR_SOURCE_NUM; srcIdx++)
+    {
+      newQueueCtx->isr[srcIdx].writeIdx = 0U;
+      newQueueCtx->isr[srcIdx].readIdx = 0U;
+    }
+    /* Update the result. */
+    result = newQueueCtx;
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbOsalEventQueueCreate ***/
 
 
 /************************************************************************************//**
-** \brief     Initialization function for the OSAL module. 
-** \attention This function has a built-in protection to make sure it only runs once.
+** \brief     Releases an event queue object, previously created with
+**            TbxMbOsalEventQueueCreate().
+** \param     queue Handle to the event queue object to release.
 **
 ****************************************************************************************/
-void TbxMbOsalEventInit(void)
+void TbxMbOsalEventQueueFree(tTbxMbOsalEventQueue queue)
 {
-  static uint8_t osalInitialized = TBX_FALSE;
+  /* Verify parameters. */
+  TBX_ASSERT(queue != NULL);
 
-  /* Only run this function once, */
-  if (osalInitialized == TBX_FALSE)
+  /* Only continue with valid parameters. */
+  if (queue != NULL)
   {
-    osalInitialized = TBX_TRUE;
-    /* Initialize the queue. */
-    eventQueue.count = 0U;
-    eventQueue.readIdx = 0U;
-    eventQueue.writeIdx = 0U;
+    /* Convert the event queue pointer to the context structure. */
+    tTbxMbOsalQueueCtx * queueCtx = (tTbxMbOsalQueueCtx *)queue;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(queueCtx->type == TBX_MB_OSAL_QUEUE_CONTEXT_TYPE);
+    /* Invalidate the context to protect it from accidentally being used afterwards. */
+    queueCtx->type = 0U;
+    /* Give the event queue context back to the memory pool. */
+    TbxMemPoolRelease(queueCtx);
   }
-} /*** end of TbxMbOsalEventInit ***/
+} /*** end of TbxMbOsalEventQueueFree ***/
 
 
 /************************************************************************************//**
 ** \brief     Signals the occurrence of an event.
+** \param     queue Handle to the event queue object to post the event to.
 ** \param     event Pointer to the event to signal.
 ** \param     fromIsr TBX_TRUE when calling this function from an interrupt service
-**            routine, TBX_FALSE otherwise.
+**            routine, TBX_FALSE otherwise. Must be TBX_FALSE for this OSAL, because
+**            interrupts post their events with TbxMbOsalEventPostFromIsr().
 **
 ****************************************************************************************/
-void TbxMbOsalEventPost(tTbxMbEvent const * event, 
-                        uint8_t             fromIsr)
+void TbxMbOsalEventPost(tTbxMbOsalEventQueue   queue,
+                        tTbxMbEvent    const * event, 
+                        uint8_t                fromIsr)
 {
-  TBX_UNUSED_ARG(fromIsr);
-
   /* Verify parameters. */
-  TBX_ASSERT(event != NULL);
+  TBX_ASSERT((queue != NULL) && (event != NULL) && (fromIsr == TBX_FALSE));
 
   /* Only continue with valid parameters. */
-  if (event != NULL)
+  if ((queue != NULL) && (event != NULL) && (fromIsr == TBX_FALSE))
   {
-    TbxCriticalSectionEnter();
+    /* Convert the event queue pointer to the context structure. */
+    tTbxMbOsalQueueCtx * queueCtx = (tTbxMbOsalQueueCtx *)queue;
     /* Make sure there is still space in the queue. If not, then the event queue size is
      * set too small. In this case increase the event queue size using configuration
      * macro TBX_MB_EVENT_QUEUE_SIZE.
      */
-    TBX_ASSERT(eventQueue.count < TBX_MB_EVENT_QUEUE_SIZE);
+    TBX_ASSERT(queueCtx->task.count < TBX_MB_EVENT_QUEUE_SIZE);
 
     /* Only continue with enough space. */
-    if (eventQueue.count < TBX_MB_EVENT_QUEUE_SIZE)
+    if (queueCtx->task.count < TBX_MB_EVENT_QUEUE_SIZE)
     {
       /* Store the new event in the queue at the current write index. */
-      eventQueue.entries[eventQueue.writeIdx] = *event;
+      queueCtx->task.entries[queueCtx->task.writeIdx] = *event;
       /* Update the total count. */
-      eventQueue.count++;
+      queueCtx->task.count++;
       /* Increment the write index to point to the next entry. */
-      eventQueue.writeIdx++;
+      queueCtx->task.writeIdx++;
       /* Time to wrap around to the start? */
-      if (eventQueue.writeIdx == TBX_MB_EVENT_QUEUE_SIZE)
+      if (queueCtx->task.writeIdx == TBX_MB_EVENT_QUEUE_SIZE)
       {
-        eventQueue.writeIdx = 0U;
+        queueCtx->task.writeIdx = 0U;
       }
     }
-    TbxCriticalSectionExit();
   }
 } /*** end of TbxMbOsalEventPost ***/
 
 
 /************************************************************************************//**
-** \brief     Wait for an event to occur.
-** \param     event Pointer where the occurred event is written to.
+** \brief     Signals the occurrence of an event from an interrupt service routine. Each
+**            interrupt source has its own lock-free queue, so this function does not
+**            need to disable interrupts. It assumes a single core microcontroller and
+**            that an interrupt source does not interrupt itself.
+** \param     queue Handle to the event queue object to post the event to.
+** \param     event Pointer to the event to signal.
+** \param     source Interrupt source that posts the event.
+**
+****************************************************************************************/
+void TbxMbOsalEventPostFromIsr(tTbxMbOsalEventQueue   queue,
+                               tTbxMbEvent    const * event,
+                               uint8_t                source)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((queue != NULL) && (event != NULL) && 
+             (source < TBX_MB_OSAL_ISR_SOURCE_NUM));
+
+  /* Only continue with valid parameters. */
+  if ((queue != NULL) && (event != NULL) && (source < TBX_MB_OSAL_ISR_SOURCE_NUM))
+  {
+    /* Convert the event queue pointer to the context structure. */
+    tTbxMbOsalQueueCtx           * queueCtx = (tTbxMbOsalQueueCtx *)queue;
+    volatile tTbxMbOsalIsrQueue  * isrQueue = &queueCtx->isr[source];
+    /* Determine the write index that follows the current one. */
+    uint8_t writeIdx = isrQueue->writeIdx;
+    uint8_t nextWriteIdx = writeIdx + 1U;
+    /* Time to wrap around to the start? */
+    if (nextWriteIdx > TBX_MB_EVENT_ISR_QUEUE_SIZE)
+    {
+      nextWriteIdx = 0U;
+    }
+    /* Make sure there is still space in the queue. If not, then the queue size is set
+     * too small. In this case increase the queue size using configuration macro
+     * TBX_MB_EVENT_ISR_QUEUE_SIZE.
+     */
+    TBX_ASSERT(nextWriteIdx != isrQueue->readIdx);
+
+    /* Only continue with enough space. */
+    if (nextWriteIdx != isrQueue->readIdx)
+    {
+      /* Store the new event in the queue at the current write index. */
+      isrQueue->entries[writeIdx].id = event->id;
+      isrQueue->entries[writeIdx].context = event->context;
+      /* Publish the new event to the event task, by updating the write index. */
+      isrQueue->writeIdx = nextWriteIdx;
+    }
+  }
+} /*** end of TbxMbOsalEventPostFromIsr ***/
+
+
+/************************************************************************************//**
+** \brief     Wait for events to occur. Events posted at task level are handed out
+**            before the ones posted at interrupt level. This keeps the order of a
+**            STOP_POLLING event, which a polling function posts right after leaving its
+**            state, and a START_POLLING event that an interrupt posts after that.
+** \param     queue Handle to the event queue object to wait on.
+** \param     events Array where the occurred events are written to.
+** \param     maxEvents Maximum number of events to write to the array.
 ** \param     timeoutMs Maximum time in milliseconds to block while waiting for an
 **            event.
-** \return    TBX_TRUE if an event occurred, TBX_FALSE otherwise (typically a timeout).
+** \return    Number of events written to the array. Zero if no event occurred.
 **
 ****************************************************************************************/
-uint8_t TbxMbOsalEventWait(tTbxMbEvent * event,
-                           uint16_t      timeoutMs)
+uint8_t TbxMbOsalEventWait(tTbxMbOsalEventQueue   queue,
+                           tTbxMbEvent            events[],
+                           uint8_t                maxEvents,
+                           uint16_t               timeoutMs)
 {
-  uint8_t result = TBX_FALSE;
+  uint8_t result = 0U;
 
   TBX_UNUSED_ARG(timeoutMs);
 
   /* Verify parameters. */
-  TBX_ASSERT(event != NULL);
+  TBX_ASSERT((queue != NULL) && (events != NULL) && (maxEvents > 0U));
 
   /* Only continue with valid parameters. */
-  if (event != NULL)
+  if ((queue != NULL) && (events != NULL) && (maxEvents > 0U))
   {
-    TbxCriticalSectionEnter();
-    /* Is there an event available in the queue? */
-    if (eventQueue.count > 0U)
+    /* Convert the event queue pointer to the context structure. */
+    tTbxMbOsalQueueCtx * queueCtx = (tTbxMbOsalQueueCtx *)queue;
+    /* Retrieve the events from the task level queue, oldest first, until the array is
+     * full.
+     */
+    while ((queueCtx->task.count > 0U) && (result < maxEvents))
     {
       /* Retrieve the event from the queue at the read index (oldest).  */
-      *event = eventQueue.entries[eventQueue.readIdx];
+      events[result] = queueCtx->task.entries[queueCtx->task.readIdx];
       /* Update the total count. */
-      eventQueue.count--;
+      queueCtx->task.count--;
       /* Increment the read index to point to the next entry. */
-      eventQueue.readIdx++;
+      queueCtx->task.readIdx++;
       /* Time to wrap around to the start? */
-      if (eventQueue.readIdx == TBX_MB_EVENT_QUEUE_SIZE)
+      if (queueCtx->task.readIdx == TBX_MB_EVENT_QUEUE_SIZE)
       {
-        eventQueue.readIdx = 0U;
+        queueCtx->task.readIdx = 0U;
       }
       /* Update the result. */
-      result = TBX_TRUE;
+      result++;
+    }
+    /* Retrieve the events from the interrupt level queues, until the array is full. */
+    for (uint8_t srcIdx = 0U; 
+         (srcIdx < TBX_MB_OSAL_ISR_SOURCE_NUM) && (result < maxEvents); 
+         srcIdx++)
+    {
+      volatile tTbxMbOsalIsrQueue * isrQueue = &queueCtx->isr[srcIdx];
+      uint8_t readIdx = isrQueue->readIdx;
+      /* Iterate over the events that the interrupt published, but were not yet read. */
+      while ((readIdx != isrQueue->writeIdx) && (result < maxEvents))
+      {
+        /* Retrieve the event from the queue at the read index (oldest). */
+        events[result].id = isrQueue->entries[readIdx].id;
+        events[result].context = isrQueue->entries[readIdx].context;
+        /* Increment the read index to point to the next entry. */
+        readIdx++;
+        /* Time to wrap around to the start? */
+        if (readIdx > TBX_MB_EVENT_ISR_QUEUE_SIZE)
+        {
+          readIdx = 0U;
+        }
+        /* Release the entry to the interrupt, by updating the read index. */
+        isrQueue->readIdx = readIdx;
+        /* Update the result. */
+        result++;
+      }
     }
-    TbxCriticalSectionExit();
   }
   /* Give the result back to the caller. */
   return result;
 } /*** end of TbxMbOsalEventWait ***/
 
 
+/************************************************************************************//**
+** \brief     Informs the caller whether TbxMbOsalEventPost() can be called from a thread
+**            other than the one that runs the event task. Not the case for this OSAL,
+**            because a superloop has only one thread of execution. Task level posting
+**            therefore does not protect the event queue against concurrent access.
+** \return    TBX_FALSE.
+**
+****************************************************************************************/
+uint8_t TbxMbOsalEventPostIsThreadSafe(void)
+{
+  /* Give the result back to the caller. */
+  return TBX_FALSE;
+} /*** end of TbxMbOsalEventPostIsThreadSafe ***/
+
+
 /************************************************************************************//**
 ** \brief     Creates a new binary semaphore object with an initial count of 0, meaning
 **            that it's taken.
@@ -321,10 +513,10 @@ uint8_t TbxMbOsalSemTake(tTbxMbOsalSem sem,
       {
         /* Temporarily leave the critical section. */
         TbxCriticalSectionExit();
-        /* Run the event task to make sure that whatever is supposed to give the
-         * semaphore can actually do so.
+        /* Run the event task of all event loops to make sure that whatever is
+         * supposed to give the semaphore can actually do so.
          */
-        TbxMbEventTask();
+        TbxMbEventTaskAll();
         /* Get the number of ticks that elapsed since the last millisecond detection. 
          * Note that this calculation works, even if the 20 kHz timer counter
          * overflowed.
@@ -0,0 +1,501 @@
+/************************************************************************************//**
+* \file         tbxmb_port.c
+* \brief        Modbus hardware specific port source file for Linux.
+* \internal
+*----------------------------------------------------------------------------------------
+*                          C O P Y R I G H T
+*----------------------------------------------------------------------------------------
+*   Copyright (c) 2023 by Feaser     www.feaser.com     All rights reserved
+*
+*----------------------------------------------------------------------------------------
+*                            L I C E N S E
+*----------------------------------------------------------------------------------------
+*
+* SPDX-License-Identifier: MIT
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* \endinternal
+****************************************************************************************/
+
+
+/****************************************************************************************
+* Include files
+****************************************************************************************/
+#include "microtbx.h"                            /* MicroTBX library                   */
+#include "microtbxmodbus.h"                      /* MicroTBX-Modbus library            */
+#include "tbxmb_linux.h"                         /* MicroTBX-Modbus Linux port         */
+#include <errno.h>                               /* Error numbers                      */
+#include <fcntl.h>                               /* File control options               */
+#include <poll.h>                                /* Wait for events on descriptors     */
+#include <pthread.h>                             /* POSIX threads                      */
+#include <stdio.h>                               /* Standard I/O functions             */
+#include <string.h>                              /* String functions                   */
+#include <termios.h>                             /* Terminal I/O interfaces            */
+#include <time.h>                                /* Time functions                     */
+#include <unistd.h>                              /* POSIX standard definitions         */
+
+
+/****************************************************************************************
+* Configuration macros
+****************************************************************************************/
+#ifndef TBX_MB_LINUX_DEVICE_FMT
+/** \brief Format string for building the default serial device name of a port. The
+ *         zero based port index is the only argument. By default, TBX_MB_UART_PORT1
+ *         maps to "/dev/ttyUSB0", TBX_MB_UART_PORT2 to "/dev/ttyUSB1", etc. Call
+ *         TbxMbLinuxSetDevice() to select a different device at run-time.
+ */
+#define TBX_MB_LINUX_DEVICE_FMT        "/dev/ttyUSB%u"
+#endif
+
+#ifndef TBX_MB_LINUX_DEVICE_LEN_MAX
+/** \brief Maximum length of a serial device name, including the string terminator. */
+#define TBX_MB_LINUX_DEVICE_LEN_MAX    (64U)
+#endif
+
+
+/****************************************************************************************
+* Macro definitions
+****************************************************************************************/
+/** \brief Value of an invalid file descriptor. */
+#define TBX_MB_LINUX_INVALID_FD        (-1)
+
+/** \brief Size of the buffer that the reader thread reads the serial data into. It
+ *         matches the maximum data length of TbxMbUartDataReceived().
+ */
+#define TBX_MB_LINUX_RX_BUF_LEN        (255U)
+
+
+/****************************************************************************************
+* Function prototypes
+****************************************************************************************/
+static void * TbxMbLinuxRxThread   (void             * arg);
+
+static void * TbxMbLinuxTxThread   (void             * arg);
+
+static void   TbxMbLinuxConfigure  (tTbxMbUartPort     port,
+                                    tTbxMbUartBaudrate baudrate,
+                                    tTbxMbUartDatabits databits,
+                                    tTbxMbUartStopbits stopbits,
+                                    tTbxMbUartParity   parity);
+
+
+/****************************************************************************************
+* Local data declarations
+****************************************************************************************/
+/** \brief Variable that groups together information to control each serial port. */
+static struct
+{
+  int32_t          fd;                   /**< File descriptor of the serial device.    */
+  uint8_t          opened;               /**< TBX_TRUE once the device is opened.      */
+  pthread_t        rxThread;             /**< Handle of the reader thread.             */
+  pthread_t        txThread;             /**< Handle of the writer thread.             */
+  pthread_mutex_t  txMutex;              /**< Protects the transmit information.       */
+  pthread_cond_t   txCond;               /**< Signals a new transmit request.          */
+  uint8_t  const * txData;               /**< Pointer of the transmit data byte array. */
+  uint16_t         txLen;                /**< Number of bytes to transmit, 0 if idle.  */
+  char             device[TBX_MB_LINUX_DEVICE_LEN_MAX]; /**< Serial device name.      */
+} portInfo[TBX_MB_UART_NUM_PORT];
+
+
+/************************************************************************************//**
+** \brief     Selects the serial device to use for a serial port. For example
+**            "/dev/ttyS1" or "/dev/ttyAMA0". Call this function before creating the
+**            transport layer object that uses the serial port.
+** \param     port The serial port to select the device for.
+** \param     device Name of the serial device.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbLinuxSetDevice(tTbxMbUartPort         port,
+                            char           const * device)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify parameters. */
+  TBX_ASSERT((port < TBX_MB_UART_NUM_PORT) && (device != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((port < TBX_MB_UART_NUM_PORT) && (device != NULL))
+  {
+    /* Only continue if the device name fits and the device is not yet opened. */
+    if ((strlen(device) < TBX_MB_LINUX_DEVICE_LEN_MAX) &&
+        (portInfo[port].opened == TBX_FALSE))
+    {
+      /* Store the device name. */
+      (void)strcpy(portInfo[port].device, device);
+      /* Update the result. */
+      result = TBX_OK;
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbLinuxSetDevice ***/
+
+
+/************************************************************************************//**
+** \brief     Initializes the UART channel.
+** \details   Opens the serial device upon the first call and starts a reader thread
+**            and a writer thread for it. A reader thread waits for newly received data
+**            and passes it on to TbxMbUartDataReceived() in one chunk. The writer thread
+**            writes the data of a transmit request, waits until the serial driver
+**            transmitted all of it and then calls TbxMbUartTransmitComplete().
+** \param     port The serial port to use. The serial device that it maps to is
+**            configured with TbxMbLinuxSetDevice().
+** \param     baudrate The desired communication speed.
+** \param     databits Number of databits for a character.
+** \param     stopbits Number of stop bits at the end of a character.
+** \param     parity Parity bit type to use.
+**
+****************************************************************************************/
+void TbxMbPortUartInit(tTbxMbUartPort     port,
+                       tTbxMbUartBaudrate baudrate,
+                       tTbxMbUartDatabits databits,
+                       tTbxMbUartStopbits stopbits,
+                       tTbxMbUartParity   parity)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(port < TBX_MB_UART_NUM_PORT);
+
+  /* Only continue with valid parameters. */
+  if (port < TBX_MB_UART_NUM_PORT)
+  {
+    /* Not yet opened? */
+    if (portInfo[port].opened == TBX_FALSE)
+    {
+      /* Build the default device name, if none was set. */
+      if (portInfo[port].device[0] == '\0')
+      {
+        (void)snprintf(portInfo[port].device, TBX_MB_LINUX_DEVICE_LEN_MAX,
+                       TBX_MB_LINUX_DEVICE_FMT, (unsigned int)port);
+      }
+      /* Open the serial device. */
+      portInfo[port].fd = open(portInfo[port].device, O_RDWR | O_NOCTTY);
+      /* Verify that the device could be opened. Most likely causes of a failure are a
+       * device name that does not exist or insufficient access rights.
+       */
+      TBX_ASSERT(portInfo[port].fd != TBX_MB_LINUX_INVALID_FD);
+      /* Only continue if the device could be opened. */
+      if (portInfo[port].fd != TBX_MB_LINUX_INVALID_FD)
+      {
+        /* Configure the serial device, before the threads start using it. */
+        TbxMbLinuxConfigure(port, baudrate, databits, stopbits, parity);
+        /* Initialize the transmit information. */
+        portInfo[port].txData = NULL;
+        portInfo[port].txLen = 0U;
+        (void)pthread_mutex_init(&portInfo[port].txMutex, NULL);
+        (void)pthread_cond_init(&portInfo[port].txCond, NULL);
+        portInfo[port].opened = TBX_TRUE;
+        /* Start the reader and writer threads. The serial port value is passed as the
+         * thread argument.
+         */
+        (void)pthread_create(&portInfo[port].rxThread, NULL, TbxMbLinuxRxThread,
+                             (void *)(uintptr_t)port);
+        (void)pthread_create(&portInfo[port].txThread, NULL, TbxMbLinuxTxThread,
+                             (void *)(uintptr_t)port);
+      }
+    }
+    /* Already opened, so just reconfigure the communication settings. */
+    else
+    {
+      TbxMbLinuxConfigure(port, baudrate, databits, stopbits, parity);
+    }
+  }
+} /*** end of TbxMbPortUartInit ***/
+
+
+/************************************************************************************//**
+** \brief     Starts the transfer of len bytes from the data array on the specified
+**            serial port.
+** \attention This function has mutual exclusive access to the bytes in the data[] array,
+**            until this port module calls TbxMbUartTransmitComplete(). This means that
+**            you do not need to copy the data bytes to a local buffer. This approach
+**            keeps RAM requirements low and benefits the run-time performance. Just make
+**            sure to call TbxMbUartTransmitComplete() once all bytes are transmitted or
+**            an error was detected, to release access to the data[] array.
+** \param     port The serial port to start the data transfer on.
+** \param     data Byte array with data to transmit.
+** \param     len Number of bytes to transmit.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbPortUartTransmit(tTbxMbUartPort         port,
+                              uint8_t        const * data,
+                              uint16_t               len)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify parameters. */
+  TBX_ASSERT(port < TBX_MB_UART_NUM_PORT);
+
+  /* Only continue with valid parameters and if the serial device was successfully
+   * opened.
+   */
+  if ((port < TBX_MB_UART_NUM_PORT) && (portInfo[port].opened == TBX_TRUE))
+  {
+    (void)pthread_mutex_lock(&portInfo[port].txMutex);
+    /* Only continue if no other transfer is in progress. */
+    if (portInfo[port].txLen == 0U)
+    {
+      /* Hand the transmit request over to the writer thread. */
+      portInfo[port].txData = data;
+      portInfo[port].txLen = len;
+      (void)pthread_cond_signal(&portInfo[port].txCond);
+      /* Update the result. */
+      result = TBX_OK;
+    }
+    (void)pthread_mutex_unlock(&portInfo[port].txMutex);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbPortUartTransmit ***/
+
+
+/************************************************************************************//**
+** \brief     Obtains the free running counter value of a timer that runs at 20 kHz.
+** \details   Derived from the monotonic clock, such that changes to the system time do
+**            not affect it.
+** \return    Free running counter value.
+**
+****************************************************************************************/
+uint16_t TbxMbPortTimerCount(void)
+{
+  struct timespec now;
+  uint64_t        ticks;
+
+  /* Read the monotonic clock and convert it to 50 microsecond ticks. */
+  (void)clock_gettime(CLOCK_MONOTONIC, &now);
+  ticks = ((uint64_t)now.tv_sec * 20000U) + ((uint64_t)now.tv_nsec / 50000U);
+  /* Only the lower 16 bits are needed for a free running counter. */
+  return (uint16_t)ticks;
+} /*** end of TbxMbPortTimerCount ***/
+
+
+/************************************************************************************//**
+** \brief     Configures the communication settings of the serial device.
+** \param     port The serial port to configure.
+** \param     baudrate The desired communication speed.
+** \param     databits Number of databits for a character.
+** \param     stopbits Number of stop bits at the end of a character.
+** \param     parity Parity bit type to use.
+**
+****************************************************************************************/
+static void TbxMbLinuxConfigure(tTbxMbUartPort     port,
+                                tTbxMbUartBaudrate baudrate,
+                                tTbxMbUartDatabits databits,
+                                tTbxMbUartStopbits stopbits,
+                                tTbxMbUartParity   parity)
+{
+  static const speed_t baudrateLookup[TBX_MB_UART_NUM_BAUDRATE] =
+  {
+    B1200, B2400, B4800, B9600, B19200, B38400, B57600, B115200
+  };
+  struct termios options;
+
+  /* Verify parameters. */
+  TBX_ASSERT((port < TBX_MB_UART_NUM_PORT) &&
+             (baudrate < TBX_MB_UART_NUM_BAUDRATE) &&
+             (databits < TBX_MB_UART_NUM_DATABITS) &&
+             (stopbits < TBX_MB_UART_NUM_STOPBITS) &&
+             (parity < TBX_MB_UART_NUM_PARITY));
+
+  /* Only continue with valid parameters and a readable configuration. */
+  if ((port < TBX_MB_UART_NUM_PORT) &&
+      (baudrate < TBX_MB_UART_NUM_BAUDRATE) &&
+      (databits < TBX_MB_UART_NUM_DATABITS) &&
+      (stopbits < TBX_MB_UART_NUM_STOPBITS) &&
+      (parity < TBX_MB_UART_NUM_PARITY) &&
+      (tcgetattr(portInfo[port].fd, &options) == 0))
+  {
+    /* Configure raw mode: no line editing, echo, signals or character translation. */
+    cfmakeraw(&options);
+    /* Enable the receiver and ignore the modem control lines. */
+    options.c_cflag |= (CREAD | CLOCAL);
+    /* Configure the number of databits. */
+    options.c_cflag &= ~CSIZE;
+    options.c_cflag |= (databits == TBX_MB_UART_7_DATABITS) ? CS7 : CS8;
+    /* Configure the number of stopbits. */
+    if (stopbits == TBX_MB_UART_2_STOPBITS)
+    {
+      options.c_cflag |= CSTOPB;
+    }
+    else
+    {
+      options.c_cflag &= ~CSTOPB;
+    }
+    /* Configure the parity mode. Characters with a parity error are dropped by the
+     * driver. A higher module detects the missing data. For example due to a data
+     * stream being shorter than expected or an incorrect checksum.
+     */
+    options.c_cflag &= ~(PARENB | PARODD);
+    options.c_iflag &= ~(INPCK | IGNPAR);
+    if (parity != TBX_MB_NO_PARITY)
+    {
+      options.c_cflag |= PARENB;
+      options.c_iflag |= (INPCK | IGNPAR);
+      if (parity == TBX_MB_ODD_PARITY)
+      {
+        options.c_cflag |= PARODD;
+      }
+    }
+    /* A read returns as soon as at least one character is available. */
+    options.c_cc[VMIN] = 1U;
+    options.c_cc[VTIME] = 0U;
+    /* Configure the baudrate. */
+    (void)cfsetispeed(&options, baudrateLookup[baudrate]);
+    (void)cfsetospeed(&options, baudrateLookup[baudrate]);
+    /* Discard pending data and apply the new configuration. */
+    (void)tcflush(portInfo[port].fd, TCIOFLUSH);
+    (void)tcsetattr(portInfo[port].fd, TCSANOW, &options);
+  }
+} /*** end of TbxMbLinuxConfigure ***/
+
+
+/************************************************************************************//**
+** \brief     Reader thread of a serial port. Takes on the role of the UART reception
+**            interrupt. It sleeps until new data is available and then passes all
+**            available data on to the UART module in one chunk.
+** \details   The thread ends when the serial device fails or disappears, for example
+**            when a USB serial adapter is unplugged. Otherwise the poll and read calls
+**            would keep on returning right away, which hogs the CPU.
+** \param     arg The serial port, casted to a void pointer.
+** \return    Not used.
+**
+****************************************************************************************/
+static void * TbxMbLinuxRxThread(void * arg)
+{
+  tTbxMbUartPort port = (tTbxMbUartPort)(uintptr_t)arg;
+  uint8_t        rxBuf[TBX_MB_LINUX_RX_BUF_LEN];
+  struct pollfd  pollInfo;
+  uint8_t        deviceOkay = TBX_TRUE;
+
+  /* Prepare the poll information. */
+  pollInfo.fd = portInfo[port].fd;
+  pollInfo.events = POLLIN;
+  /* Enter thread loop. */
+  while (deviceOkay == TBX_TRUE)
+  {
+    /* Wait for new data to become available. */
+    int pollResult = poll(&pollInfo, 1U, -1);
+    /* Did the device report an error or a hang up? */
+    if ((pollResult > 0) &&
+        ((pollInfo.revents & (POLLERR | POLLHUP | POLLNVAL)) != 0))
+    {
+      deviceOkay = TBX_FALSE;
+    }
+    /* New data available? */
+    else if (pollResult > 0)
+    {
+      /* Read all available data, up to the size of the buffer. */
+      ssize_t rxLen = read(portInfo[port].fd, rxBuf, sizeof(rxBuf));
+      /* Pass newly received data on to the UART module. */
+      if (rxLen > 0)
+      {
+        TbxMbUartDataReceived(port, rxBuf, (uint8_t)rxLen);
+      }
+      /* End of file or a read error that cannot be recovered from by retrying? */
+      else if ((rxLen == 0) || ((errno != EINTR) && (errno != EAGAIN)))
+      {
+        deviceOkay = TBX_FALSE;
+      }
+      else
+      {
+        /* Nothing left to do, but MISRA requires this terminating else statement. */
+      }
+    }
+    /* Poll error that cannot be recovered from by retrying? */
+    else if ((pollResult < 0) && (errno != EINTR))
+    {
+      deviceOkay = TBX_FALSE;
+    }
+    else
+    {
+      /* Nothing left to do, but MISRA requires this terminating else statement. */
+    }
+  }
+  /* The device failed, so no more data can be received. */
+  return NULL;
+} /*** end of TbxMbLinuxRxThread ***/
+
+
+/************************************************************************************//**
+** \brief     Writer thread of a serial port. Takes on the role of the UART transmit
+**            complete interrupt. It sleeps until a new transmit request is available,
+**            writes its data and waits for the serial driver to transmit all of it.
+** \param     arg The serial port, casted to a void pointer.
+** \return    Not used. The thread runs as long as the process does.
+**
+****************************************************************************************/
+static void * TbxMbLinuxTxThread(void * arg)
+{
+  tTbxMbUartPort   port = (tTbxMbUartPort)(uintptr_t)arg;
+  uint8_t  const * txData;
+  uint16_t         txLen;
+  uint16_t         txIdx;
+  ssize_t          txResult;
+
+  /* Enter thread loop. */
+  for (;;)
+  {
+    /* Wait for a new transmit request. */
+    (void)pthread_mutex_lock(&portInfo[port].txMutex);
+    while (portInfo[port].txLen == 0U)
+    {
+      (void)pthread_cond_wait(&portInfo[port].txCond, &portInfo[port].txMutex);
+    }
+    txData = portInfo[port].txData;
+    txLen = portInfo[port].txLen;
+    (void)pthread_mutex_unlock(&portInfo[port].txMutex);
+    /* Write all data to the serial device. */
+    txIdx = 0U;
+    while (txIdx < txLen)
+    {
+      txResult = write(portInfo[port].fd, &txData[txIdx], (size_t)(txLen - txIdx));
+      /* Update the index for the next write, if successful. */
+      if (txResult > 0)
+      {
+        txIdx += (uint16_t)txResult;
+      }
+      /* Interrupted by a signal, before any data was written? */
+      else if ((txResult < 0) && (errno == EINTR))
+      {
+        /* Nothing left to do, because the next loop iteration retries the write. */
+      }
+      /* Write error that cannot be recovered from by retrying. */
+      else
+      {
+        /* Abort the transfer. A higher module detects the missing data. */
+        txIdx = txLen;
+      }
+    }
+    /* Wait for the serial driver to actually transmit all the data. */
+    (void)tcdrain(portInfo[port].fd);
+    /* Mark the transfer as done, such that a new one can be started. */
+    (void)pthread_mutex_lock(&portInfo[port].txMutex);
+    portInfo[port].txLen = 0U;
+    (void)pthread_mutex_unlock(&portInfo[port].txMutex);
+    /* Inform the Modbus UART module about the transmission completed event. */
+    TbxMbUartTransmitComplete(port);
+  }
+  /* Not reached, but a thread function needs a return value. */
+  return NULL;
+} /*** end of TbxMbLinuxTxThread ***/
+
+
+/*********************************** end of tbxmb_port.c *******************************/
@@ -0,0 +1,276 @@
+/************************************************************************************//**
+* \file         tbxmb_port.c
+* \brief        Modbus in-process loopback port source file.
+* \internal
+*----------------------------------------------------------------------------------------
+*                          C O P Y R I G H T
+*----------------------------------------------------------------------------------------
+*   Copyright (c) 2023 by Feaser     www.feaser.com     All rights reserved
+*
+*----------------------------------------------------------------------------------------
+*                            L I C E N S E
+*----------------------------------------------------------------------------------------
+*
+* SPDX-License-Identifier: MIT
+*
+* Permission is hereby granted, free of charge, to any person obtaining a copy
+* of this software and associated documentation files (the "Software"), to deal
+* in the Software without restriction, including without limitation the rights
+* to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+* copies of the Software, and to permit persons to whom the Software is
+* furnished to do so, subject to the following conditions:
+*
+* The above copyright notice and this permission notice shall be included in all
+* copies or substantial portions of the Software.
+*
+* THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+* IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+* FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+* AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+* LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+* OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+* SOFTWARE.
+*
+* \endinternal
+****************************************************************************************/
+
+
+/****************************************************************************************
+* Include files
+****************************************************************************************/
+#include "microtbx.h"                            /* MicroTBX library                   */
+#include "microtbxmodbus.h"                      /* MicroTBX-Modbus library            */
+#include "tbxmb_loopback.h"                      /* MicroTBX-Modbus loopback port      */
+
+
+/****************************************************************************************
+* Configuration macros
+****************************************************************************************/
+#ifndef TBX_MB_LOOPBACK_TIMER_STEP
+/** \brief Number of 50 microsecond ticks that the virtual timer advances each time the
+ *         stack reads it. Without this, the virtual time would stand still while the
+ *         stack waits for a character timeout. Larger values make the RTU character
+ *         timeouts expire after fewer polls, at the cost of timing accuracy.
+ */
+#define TBX_MB_LOOPBACK_TIMER_STEP     (1U)
+#endif
+
+
+/****************************************************************************************
+* Macro definitions
+****************************************************************************************/
+/** \brief Frequency of the virtual timer in Hz. */
+#define TBX_MB_LOOPBACK_TIMER_FREQ     (20000UL)
+
+/** \brief Maximum number of bytes that TbxMbUartDataReceived() accepts at once. */
+#define TBX_MB_LOOPBACK_CHUNK_LEN_MAX  (255U)
+
+
+/****************************************************************************************
+* Local data declarations
+****************************************************************************************/
+/** \brief Variable that groups together information about each serial port. */
+static struct
+{
+  uint8_t  initialized;                  /**< TBX_TRUE once the port is initialized.   */
+  uint32_t bitsPerSec;                   /**< Simulated communication speed.           */
+  uint8_t  bitsPerChar;                  /**< Start, data, parity and stop bits.       */
+  uint32_t timeRemainder;                /**< Fraction of a tick, times bitsPerSec.    */
+} portInfo[TBX_MB_UART_NUM_PORT];
+
+/** \brief Current value of the virtual timer, in 50 microsecond ticks. */
+static uint32_t loopbackTime;
+
+/** \brief TBX_TRUE to transfer data without advancing the virtual timer, TBX_FALSE to
+ *         advance the virtual timer by the time needed at the simulated baudrate.
+ */
+static uint8_t loopbackInfiniteSpeed = TBX_FALSE;
+
+
+/************************************************************************************//**
+** \brief     Selects whether data transfers take time on the virtual timer. By default,
+**            a transfer advances the virtual timer by the time it takes to transmit the
+**            data at the configured baudrate. With infinite speed enabled, transfers
+**            take no time at all. This is useful for measuring just the processing time
+**            of the stack itself.
+** \param     enable TBX_TRUE to enable infinite speed, TBX_FALSE to simulate the
+**            baudrate.
+**
+****************************************************************************************/
+void TbxMbLoopbackSetInfiniteSpeed(uint8_t enable)
+{
+  TbxCriticalSectionEnter();
+  loopbackInfiniteSpeed = (enable == TBX_FALSE) ? TBX_FALSE : TBX_TRUE;
+  TbxCriticalSectionExit();
+} /*** end of TbxMbLoopbackSetInfiniteSpeed ***/
+
+
+/************************************************************************************//**
+** \brief     Advances the virtual timer. Can be used to simulate the passing of time,
+**            for example to reproduce a delay between two characters.
+** \param     ticks Number of 50 microsecond ticks to advance the virtual timer by.
+**
+****************************************************************************************/
+void TbxMbLoopbackTimerAdvance(uint16_t ticks)
+{
+  TbxCriticalSectionEnter();
+  loopbackTime += ticks;
+  TbxCriticalSectionExit();
+} /*** end of TbxMbLoopbackTimerAdvance ***/
+
+
+/************************************************************************************//**
+** \brief     Obtains the current value of the virtual timer, without advancing it. The
+**            difference between two values gives the elapsed virtual time, for example
+**            to calculate the number of transactions per second at the simulated
+**            baudrate.
+** \return    Virtual timer value in 50 microsecond ticks.
+**
+****************************************************************************************/
+uint32_t TbxMbLoopbackTimerTicks(void)
+{
+  uint32_t result;
+
+  TbxCriticalSectionEnter();
+  result = loopbackTime;
+  TbxCriticalSectionExit();
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbLoopbackTimerTicks ***/
+
+
+/************************************************************************************//**
+** \brief     Initializes the UART channel.
+** \details   The serial ports are connected in pairs: TBX_MB_UART_PORT1 with
+**            TBX_MB_UART_PORT2, TBX_MB_UART_PORT3 with TBX_MB_UART_PORT4, etc. Data
+**            transmitted on one port of a pair, is received on the other port.
+** \param     port The serial port to use.
+** \param     baudrate The desired communication speed.
+** \param     databits Number of databits for a character.
+** \param     stopbits Number of stop bits at the end of a character.
+** \param     parity Parity bit type to use.
+**
+****************************************************************************************/
+void TbxMbPortUartInit(tTbxMbUartPort     port,
+                       tTbxMbUartBaudrate baudrate,
+                       tTbxMbUartDatabits databits,
+                       tTbxMbUartStopbits stopbits,
+                       tTbxMbUartParity   parity)
+{
+  static const uint32_t baudrateLookup[TBX_MB_UART_NUM_BAUDRATE] =
+  {
+    1200UL, 2400UL, 4800UL, 9600UL, 19200UL, 38400UL, 57600UL, 115200UL
+  };
+
+  /* Verify parameters. */
+  TBX_ASSERT((port < TBX_MB_UART_NUM_PORT) &&
+             (baudrate < TBX_MB_UART_NUM_BAUDRATE));
+
+  /* Only continue with valid parameters. */
+  if ((port < TBX_MB_UART_NUM_PORT) &&
+      (baudrate < TBX_MB_UART_NUM_BAUDRATE))
+  {
+    /* Store the simulated communication speed. */
+    portInfo[port].bitsPerSec = baudrateLookup[baudrate];
+    /* A character consists of a start bit, the data bits, an optional parity bit and
+     * the stop bits.
+     */
+    portInfo[port].bitsPerChar = (databits == TBX_MB_UART_7_DATABITS) ? 8U : 9U;
+    portInfo[port].bitsPerChar += (parity == TBX_MB_NO_PARITY) ? 0U : 1U;
+    portInfo[port].bitsPerChar += (stopbits == TBX_MB_UART_2_STOPBITS) ? 2U : 1U;
+    portInfo[port].timeRemainder = 0U;
+    portInfo[port].initialized = TBX_TRUE;
+  }
+} /*** end of TbxMbPortUartInit ***/
+
+
+/************************************************************************************//**
+** \brief     Starts the transfer of len bytes from the data array on the specified
+**            serial port.
+** \details   The transfer completes right away: The data is passed on to the other
+**            port of the pair and the transmit complete event is signalled, before this
+**            function returns. Unless infinite speed is enabled, the virtual timer
+**            advances by the time it takes to transmit the data at the configured
+**            baudrate.
+** \param     port The serial port to start the data transfer on.
+** \param     data Byte array with data to transmit.
+** \param     len Number of bytes to transmit.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbPortUartTransmit(tTbxMbUartPort         port,
+                              uint8_t        const * data,
+                              uint16_t               len)
+{
+  uint8_t        result = TBX_ERROR;
+  tTbxMbUartPort peerPort = (tTbxMbUartPort)((uint8_t)port ^ 1U);
+
+  /* Verify parameters. */
+  TBX_ASSERT(port < TBX_MB_UART_NUM_PORT);
+
+  /* Only continue with valid parameters, if the port is initialized and it has a peer
+   * port.
+   */
+  if ((port < TBX_MB_UART_NUM_PORT) && (portInfo[port].initialized == TBX_TRUE) &&
+      (peerPort < TBX_MB_UART_NUM_PORT))
+  {
+    /* Advance the virtual timer by the transmit time of the data, if needed. The time
+     * is calculated in 1 / bitsPerSec fractions of a tick, to not lose accuracy.
+     */
+    TbxCriticalSectionEnter();
+    if (loopbackInfiniteSpeed == TBX_FALSE)
+    {
+      uint32_t txTime = ((uint32_t)len * portInfo[port].bitsPerChar *
+                         TBX_MB_LOOPBACK_TIMER_FREQ) + portInfo[port].timeRemainder;
+      loopbackTime += txTime / portInfo[port].bitsPerSec;
+      portInfo[port].timeRemainder = txTime % portInfo[port].bitsPerSec;
+    }
+    TbxCriticalSectionExit();
+    /* Only pass the data on if the peer port is initialized. Otherwise the data gets
+     * lost, just like on a real serial bus without a receiver.
+     */
+    if (portInfo[peerPort].initialized == TBX_TRUE)
+    {
+      uint16_t idx = 0U;
+      /* Pass the data on in chunks, because the reception data length is limited. */
+      while (idx < len)
+      {
+        uint16_t chunkLen = len - idx;
+        if (chunkLen > TBX_MB_LOOPBACK_CHUNK_LEN_MAX)
+        {
+          chunkLen = TBX_MB_LOOPBACK_CHUNK_LEN_MAX;
+        }
+        TbxMbUartDataReceived(peerPort, &data[idx], (uint8_t)chunkLen);
+        idx += chunkLen;
+      }
+    }
+    /* Inform the Modbus UART module about the transmission completed event. */
+    TbxMbUartTransmitComplete(port);
+    /* Update the result. */
+    result = TBX_OK;
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbPortUartTransmit ***/
+
+
+/************************************************************************************//**
+** \brief     Obtains the free running counter value of the virtual 20 kHz timer. Each
+**            call advances the virtual timer by TBX_MB_LOOPBACK_TIMER_STEP ticks.
+** \return    Free running counter value.
+**
+****************************************************************************************/
+uint16_t TbxMbPortTimerCount(void)
+{
+  uint16_t result;
+
+  TbxCriticalSectionEnter();
+  result = (uint16_t)loopbackTime;
+  loopbackTime += TBX_MB_LOOPBACK_TIMER_STEP;
+  TbxCriticalSectionExit();
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbPortTimerCount ***/
+
+
+/*********************************** end of tbxmb_port.c *******************************/
@@ -0,0 +1,1194 @@
+/************************************************************************************//**
+* \file         tbxmb_ascii.c
+* \brief        Modbus ASCII transport layer source file.
+* \internal
+*----------------------------------------------------------------------------------------
+*                          C O P Y R I G H T
+*----------------------------------------------------------------------------------------
+*   Copyright (c) 2023 by Feaser     www.feaser.com     All rights reserved
+*
+*----------------------------------------------------------------------------------------
+*                            L I C E N S E
+*----------------------------------------------------------------------------------------
+*
+* SPDX-License-Identifier: GPL-3.0-or-later
+*
+* This file is part of MicroTBX-Modbus. MicroTBX-Modbus is free software: you can
+* redistribute it and/or modify it under the terms of the GNU General Public License as
+* published by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* MicroTBX-Modbus is distributed in the hope that it will be useful, but WITHOUT ANY
+* WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+* PARTICULAR PURPOSE. See the GNU General Public License for more details.
+*
+* You have received a copy of the GNU General Public License along with MicroTBX-Modbus.
+* If not, see www.gnu.org/licenses/.
+*
+* \endinternal
+****************************************************************************************/
+
+/****************************************************************************************
+* Include files
+****************************************************************************************/
+#include "microtbx.h"                            /* MicroTBX module                    */
+#include "microtbxmodbus.h"                      /* MicroTBX-Modbus module             */
+#include "tbxmb_event_private.h"                 /* MicroTBX-Modbus event private      */
+#include "tbxmb_osal_private.h"                  /* MicroTBX-Modbus OSAL private       */
+#include "tbxmb_timer_private.h"                 /* MicroTBX-Modbus timer private      */
+#include "tbxmb_tp_private.h"                    /* MicroTBX-Modbus TP private         */
+#include "tbxmb_uart_private.h"                  /* MicroTBX-Modbus UART private       */
+
+
+/****************************************************************************************
+* Macro definitions
+****************************************************************************************/
+/** \brief Unique context type to identify a context as being an ASCII transport. */
+#define TBX_MB_ASCII_CONTEXT_TYPE           (41U)
+
+/** \brief Idle state. Ready to receive or transmit. */
+#define TBX_MB_ASCII_STATE_IDLE             (0U)
+
+/** \brief Transmitting a PDU state. */
+#define TBX_MB_ASCII_STATE_TRANSMISSION     (1U)
+
+/** \brief Receiving a PDU state. */
+#define TBX_MB_ASCII_STATE_RECEPTION        (2U)
+
+/** \brief Validating a newly received PDU state. */
+#define TBX_MB_ASCII_STATE_VALIDATION       (3U)
+
+/** \brief Character that marks the start of an ASCII frame (':'). */
+#define TBX_MB_ASCII_CHAR_START             (0x3AU)
+
+/** \brief First character of the end of an ASCII frame (carriage return). */
+#define TBX_MB_ASCII_CHAR_CR                (0x0DU)
+
+/** \brief Second character of the end of an ASCII frame (line feed). */
+#define TBX_MB_ASCII_CHAR_LF                (0x0AU)
+
+/** \brief Value of the pending reception nibble, when no nibble is pending. Also the
+ *         value that TbxMbAsciiHexToNibble() returns for an invalid hex character.
+ */
+#define TBX_MB_ASCII_NIBBLE_NONE            (0xFFU)
+
+/** \brief Maximum number of decoded bytes in an ASCII ADU:
+ *         - Node address (1 byte)
+ *         - Function code (1 byte)
+ *         - Packet data (max 252 bytes)
+ *         - LRC (1 byte)
+ */
+#define TBX_MB_ASCII_ADU_LEN_MAX            (255U)
+
+#ifndef TBX_MB_ASCII_CHAR_TIMEOUT_MS
+/** \brief Maximum time in milliseconds between two characters of a frame. When it
+ *         elapses, the partially received frame is discarded, such that a truncated
+ *         frame or a stray start character does not block the reception of the next
+ *         frame. The Modbus specification defaults to one second. If for some reason a
+ *         different timeout is desired, you can override this configuration by adding a
+ *         macro with the same name, but a different value, to "tbx_conf.h".
+ */
+#define TBX_MB_ASCII_CHAR_TIMEOUT_MS        (1000U)
+#endif
+
+/* The poll timer deadline is a 16-bit timer tick count. Make sure the inter-character
+ * timeout is in range.
+ */
+#if ((TBX_MB_ASCII_CHAR_TIMEOUT_MS < 1U) || \
+     ((TBX_MB_ASCII_CHAR_TIMEOUT_MS * TBX_MB_EVENT_TICKS_PER_MS) > 32767U))
+#error "Invalid TBX_MB_ASCII_CHAR_TIMEOUT_MS configuration in tbx_conf.h."
+#endif
+
+
+/****************************************************************************************
+* Function prototypes
+****************************************************************************************/
+static uint16_t         TbxMbAsciiPoll            (tTbxMbTp               transport);
+
+static uint8_t          TbxMbAsciiTransmit        (tTbxMbTp               transport);
+
+static void             TbxMbAsciiReceptionDone   (tTbxMbTp               transport);
+
+static tTbxMbTpPacket * TbxMbAsciiGetRxPacket     (tTbxMbTp               transport);
+
+static tTbxMbTpPacket * TbxMbAsciiGetTxPacket     (tTbxMbTp               transport);
+
+static uint8_t          TbxMbAsciiValidate        (tTbxMbTp               transport);
+
+static void             TbxMbAsciiTransmitComplete(tTbxMbUartPort         port);
+
+static void             TbxMbAsciiDataReceived    (tTbxMbUartPort         port,
+                                                   uint8_t        const * data,
+                                                   uint8_t                len);
+
+static uint8_t          TbxMbAsciiReceiveChar     (tTbxMbTpCtx   volatile * tpCtx,
+                                                   uint8_t                character);
+
+static uint8_t          TbxMbAsciiEncodeChunk     (tTbxMbTpCtx   volatile * tpCtx);
+
+static uint8_t          TbxMbAsciiHexToNibble     (uint8_t                character);
+
+static uint8_t          TbxMbAsciiNibbleToHex     (uint8_t                nibble);
+
+static uint8_t          TbxMbAsciiCalculateLrc    (uint8_t        const * data,
+                                                   uint16_t               len);
+
+
+/****************************************************************************************
+* Local data declarations
+****************************************************************************************/
+/** \brief ASCII transport layer handle lookup table by UART port. Uses for finding the
+ *         transport layer handle that uses a specific serial port, in a run-time
+ *         efficient way.
+ */
+static volatile tTbxMbTpCtx * tbxMbAsciiCtx[TBX_MB_UART_NUM_PORT] = { 0 };
+
+
+/************************************************************************************//**
+** \brief     Creates a Modbus ASCII transport layer object.
+** \details   Each ASCII character is transferred with 7 databits, as specified by the
+**            Modbus protocol. The received characters are decoded and the LRC is updated
+**            on the fly, directly from the UART reception event. This means that no
+**            additional pass over the frame is needed once its end is detected.
+** \param     nodeAddr The address of the node. Can be in the range 1..247 for a server
+**            node. Set it to 0 for the client.
+** \param     port The serial port to use. The actual meaning of the serial port is
+**            hardware dependent. It typically maps to the UART peripheral number. E.g.
+**            TBX_MB_UART_PORT1 = USART1 on an STM32.
+** \param     baudrate The desired communication speed.
+** \param     stopbits Number of stop bits at the end of a character.
+** \param     parity Parity bit type to use.
+** \return    Handle to the newly created ASCII transport layer object if successful,
+**            NULL otherwise.
+**
+****************************************************************************************/
+tTbxMbTp TbxMbAsciiCreate(uint8_t            nodeAddr,
+                          tTbxMbUartPort     port,
+                          tTbxMbUartBaudrate baudrate,
+                          tTbxMbUartStopbits stopbits,
+                          tTbxMbUartParity   parity)
+{
+  tTbxMbTp result = NULL;
+
+  /* Verify parameters. */
+  TBX_ASSERT((nodeAddr <= TBX_MB_TP_NODE_ADDR_MAX) &&
+             (port < TBX_MB_UART_NUM_PORT) &&
+             (baudrate < TBX_MB_UART_NUM_BAUDRATE) &&
+             (stopbits < TBX_MB_UART_NUM_STOPBITS) &&
+             (parity < TBX_MB_UART_NUM_PARITY));
+
+  /* Only continue with valid parameters. */
+  if ((nodeAddr <= TBX_MB_TP_NODE_ADDR_MAX) &&
+      (port < TBX_MB_UART_NUM_PORT) &&
+      (baudrate < TBX_MB_UART_NUM_BAUDRATE) &&
+      (stopbits < TBX_MB_UART_NUM_STOPBITS) &&
+      (parity < TBX_MB_UART_NUM_PARITY))
+  {
+    /* Allocate memory for the new transport context. */
+    tTbxMbTpCtx * newTpCtx = TbxMemPoolAllocate(sizeof(tTbxMbTpCtx));
+    /* Automatically increase the memory pool, if it was too small. */
+    if (newTpCtx == NULL)
+    {
+      /* No need to check the return value, because if it failed, the following
+       * allocation fails too, which is verified later on.
+       */
+      (void)TbxMemPoolCreate(1U, sizeof(tTbxMbTpCtx));
+      newTpCtx = TbxMemPoolAllocate(sizeof(tTbxMbTpCtx));
+    }
+    /* Verify memory allocation of the transport context. */
+    TBX_ASSERT(newTpCtx != NULL);
+    /* Only continue if the memory allocation succeeded. */
+    if (newTpCtx != NULL)
+    {
+      /* Initialize the transport context. Note that the start and end of a frame are
+       * marked by characters. The event poll function is only activated during the
+       * reception of a frame, to detect the inter-character timeout.
+       */
+      newTpCtx->type = TBX_MB_ASCII_CONTEXT_TYPE;
+      newTpCtx->instancePtr = NULL;
+      newTpCtx->pollFcn = TbxMbAsciiPoll;
+      newTpCtx->processFcn = NULL;
+      TbxMbTimerInit(&newTpCtx->pollTimer, newTpCtx);
+      newTpCtx->eventLoop = TbxMbEventLoopDefault();
+      newTpCtx->transmitFcn = TbxMbAsciiTransmit;
+      newTpCtx->receptionDoneFcn = TbxMbAsciiReceptionDone;
+      newTpCtx->getRxPacketFcn = TbxMbAsciiGetRxPacket;
+      newTpCtx->getTxPacketFcn = TbxMbAsciiGetTxPacket;
+      newTpCtx->nodeAddr = nodeAddr;
+      newTpCtx->port = port;
+      newTpCtx->state = TBX_MB_ASCII_STATE_IDLE;
+      newTpCtx->rxTime = 0U;
+      newTpCtx->rxAduWrIdx = 0U;
+      newTpCtx->rxAduOkay = TBX_FALSE;
+      newTpCtx->asciiRxNibble = TBX_MB_ASCII_NIBBLE_NONE;
+      newTpCtx->asciiRxLrc = 0U;
+      newTpCtx->asciiRxEol = TBX_FALSE;
+      newTpCtx->asciiRxPolling = TBX_FALSE;
+      newTpCtx->asciiTxIdx = 0U;
+      newTpCtx->asciiTxLen = 0U;
+      newTpCtx->diagInfo.busMsgCnt = 0U;
+      newTpCtx->diagInfo.busCommErrCnt = 0U;
+      newTpCtx->diagInfo.busExcpErrCnt = 0U;
+      newTpCtx->diagInfo.srvMsgCnt = 0U;
+      newTpCtx->diagInfo.srvNoRespCnt = 0U;
+      /* Store the transport context in the lookup table. */
+      tbxMbAsciiCtx[port] = newTpCtx;
+      /* Initialize the port. Note the ASCII always uses 7 databits. */
+      TbxMbUartInit(port, baudrate, TBX_MB_UART_7_DATABITS, stopbits, parity,
+                    TbxMbAsciiTransmitComplete, TbxMbAsciiDataReceived);
+      /* Update the result. */
+      result = newTpCtx;
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbAsciiCreate ***/
+
+
+/************************************************************************************//**
+** \brief     Releases a Modbus ASCII transport layer object, previously created with
+**            TbxMbAsciiCreate().
+** \param     transport Handle to ASCII transport layer object to release.
+**
+****************************************************************************************/
+void TbxMbAsciiFree(tTbxMbTp transport)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(transport != NULL);
+
+  /* Only continue with valid parameters. */
+  if (transport != NULL)
+  {
+    /* Convert the TP channel pointer to the context structure. */
+    tTbxMbTpCtx * tpCtx = (tTbxMbTpCtx *)transport;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(tpCtx->type == TBX_MB_ASCII_CONTEXT_TYPE);
+    /* Make sure the event task no longer calls our polling function. */
+    TbxMbEventCancelPolling(tpCtx);
+    TbxCriticalSectionEnter();
+    /* Remove the channel from the lookup table. */
+    tbxMbAsciiCtx[tpCtx->port] = NULL;
+    /* Invalidate the context to protect it from accidentally being used afterwards. */
+    tpCtx->type = 0U;
+    tpCtx->pollFcn = NULL;
+    tpCtx->processFcn = NULL;
+    TbxCriticalSectionExit();
+    /* Give the transport layer context back to the memory pool. */
+    TbxMemPoolRelease(tpCtx);
+  }
+} /*** end of TbxMbAsciiFree ***/
+
+
+/************************************************************************************//**
+** \brief     Event polling function that is automatically called during each call of
+**            TbxMbEventTask(), if activated. The reception of a frame activates it with
+**            the TBX_MB_EVENT_ID_START_POLLING event. It discards the partially received
+**            frame, once the inter-character timeout elapsed. It deactivates itself with
+**            the TBX_MB_EVENT_ID_STOP_POLLING event, when no frame is being received.
+** \param     transport Handle to ASCII transport layer object.
+** \return    Free running timer tick count at which this function should be called
+**            again. That's when the inter-character timeout elapses.
+**
+****************************************************************************************/
+static uint16_t TbxMbAsciiPoll(tTbxMbTp transport)
+{
+  uint16_t result = TbxMbPortTimerCount();
+
+  /* Verify parameters. */
+  TBX_ASSERT(transport != NULL);
+
+  /* Only continue with valid parameters. */
+  if (transport != NULL)
+  {
+    /* Convert the TP channel pointer to the context structure. */
+    tTbxMbTpCtx * tpCtx = (tTbxMbTpCtx *)transport;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(tpCtx->type == TBX_MB_ASCII_CONTEXT_TYPE);
+    uint8_t stopPolling = TBX_TRUE;
+    /* Calculate the number of time ticks that elapsed since the reception of the last
+     * character. Note that this calculation works, even if the timer counter overflowed.
+     */
+    TbxCriticalSectionEnter();
+    uint16_t deltaTicks = result - tpCtx->rxTime;
+    /* Still receiving a frame? */
+    if (tpCtx->state == TBX_MB_ASCII_STATE_RECEPTION)
+    {
+      /* Did the inter-character timeout elapse? */
+      if (deltaTicks >= (TBX_MB_ASCII_CHAR_TIMEOUT_MS * TBX_MB_EVENT_TICKS_PER_MS))
+      {
+        /* Discard the partially received frame by transitioning back to IDLE. */
+        tpCtx->state = TBX_MB_ASCII_STATE_IDLE;
+        tpCtx->diagInfo.busCommErrCnt++;
+      }
+      /* Frame reception still in progress. */
+      else
+      {
+        /* Ask to be called again once the inter-character timeout elapses. */
+        result = tpCtx->rxTime +
+                 (uint16_t)(TBX_MB_ASCII_CHAR_TIMEOUT_MS * TBX_MB_EVENT_TICKS_PER_MS);
+        stopPolling = TBX_FALSE;
+      }
+    }
+    /* Allow the reception of the next frame to activate polling again. */
+    if (stopPolling == TBX_TRUE)
+    {
+      tpCtx->asciiRxPolling = TBX_FALSE;
+    }
+    TbxCriticalSectionExit();
+
+    /* Should polling be deactivated? */
+    if (stopPolling == TBX_TRUE)
+    {
+      /* Instruct the event task to stop calling our polling function. */
+      tTbxMbEvent newEvent;
+      newEvent.context = tpCtx;
+      newEvent.id = TBX_MB_EVENT_ID_STOP_POLLING;
+      TbxMbEventPost(&newEvent, TBX_FALSE);
+      /* The reception of a new frame might have started right before posting the stop
+       * event, in which case its start event was possibly processed first. Activate
+       * polling again in this case, such that its timeout is still detected.
+       */
+      TbxCriticalSectionEnter();
+      uint8_t restartPolling = TBX_FALSE;
+      if (tpCtx->state == TBX_MB_ASCII_STATE_RECEPTION)
+      {
+        tpCtx->asciiRxPolling = TBX_TRUE;
+        restartPolling = TBX_TRUE;
+      }
+      TbxCriticalSectionExit();
+      if (restartPolling == TBX_TRUE)
+      {
+        newEvent.id = TBX_MB_EVENT_ID_START_POLLING;
+        TbxMbEventPost(&newEvent, TBX_FALSE);
+      }
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbAsciiPoll ***/
+
+
+/************************************************************************************//**
+** \brief     Starts the transmission of a communication packet, stored in the transport
+**            layer object.
+** \param     transport Handle to ASCII transport layer object.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+static uint8_t TbxMbAsciiTransmit(tTbxMbTp transport)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify parameters. */
+  TBX_ASSERT(transport != NULL);
+
+  /* Only continue with valid parameters. */
+  if (transport != NULL)
+  {
+    /* Convert the TP channel pointer to the context structure. */
+    tTbxMbTpCtx * tpCtx = (tTbxMbTpCtx *)transport;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(tpCtx->type == TBX_MB_ASCII_CONTEXT_TYPE);
+    /* Are we requested to transmit an exception response? */
+    TbxCriticalSectionEnter();
+    uint8_t codeCopy = tpCtx->txPacket.pdu.code;
+    TbxCriticalSectionExit();
+    if ((codeCopy & TBX_MB_FC_EXCEPTION_MASK) == TBX_MB_FC_EXCEPTION_MASK)
+    {
+      /* Increment the total number of exception responses. */
+      tpCtx->diagInfo.busExcpErrCnt++;
+    }
+    TbxCriticalSectionEnter();
+    /* New transmissions are only possible from the IDLE state. */
+    uint8_t okayToTransmit = TBX_FALSE;
+    if (tpCtx->state == TBX_MB_ASCII_STATE_IDLE)
+    {
+      /* Should a response actually be transmitted? If we are a server, then upon
+       * reception packet validation, txPacket.node was already set to
+       * TBX_MB_TP_NODE_ADDR_BROADCAST for us, in case of a broadcast request, which
+       * does not require a response.
+       */
+      if ( (tpCtx->isClient == TBX_FALSE) &&
+           (tpCtx->txPacket.node == TBX_MB_TP_NODE_ADDR_BROADCAST) )
+      {
+        /* To bypass the actual response transmission, simply update the result to
+         * indicate success and keep the okayToTransmit set to its default TBX_FALSE.
+         */
+        result = TBX_OK;
+      }
+      /* Okay to transmit the response. */
+      else
+      {
+        okayToTransmit = TBX_TRUE;
+        /* Transition to the TRANSMISSION state to lock access to the txPacket for the
+         * duration of the transmission. Note that the unlock happens once the state
+         * transitions back to IDLE. This happens once the last chunk of the frame was
+         * transmitted.
+         */
+        tpCtx->state = TBX_MB_ASCII_STATE_TRANSMISSION;
+      }
+    }
+    TbxCriticalSectionExit();
+    /* Only continue if no other packet transmission is already in progress. */
+    if (okayToTransmit == TBX_TRUE)
+    {
+      /* Determine ADU specific properties. The ADU starts at one byte before the PDU,
+       * which is the last byte of head[]. The ADU's length, before hex encoding, is:
+       * - Node address (1 byte)
+       * - Function code (1 byte)
+       * - Packet data (dataLen bytes)
+       * - LRC (1 byte)
+       */
+      uint8_t * aduPtr = &tpCtx->txPacket.head[TBX_MB_TP_ADU_HEAD_LEN_MAX-1U];
+      uint16_t  aduLen = tpCtx->txPacket.dataLen + 3U;
+      /* Populate the ADU head. For ASCII it is the address field right in front of the
+       * PDU. For client->server transfers the address field is the servers's node
+       * address (unicast) or 0 (broadcast) and the client channel will have stored it in
+       * the txPacket.node element. For server-client transfers it always the servers's
+       * node address as stored when creating the ASCII transport layer context.
+       */
+      aduPtr[0] = (tpCtx->isClient == TBX_TRUE) ? tpCtx->txPacket.node : tpCtx->nodeAddr;
+      /* Populate the ADU tail. For ASCII it is the LRC right after the PDU's data. */
+      aduPtr[aduLen - 1U] = TbxMbAsciiCalculateLrc(aduPtr, aduLen - 1U);
+      /* Reset the transmit encoder. The binary ADU is hex encoded in chunks, each time
+       * right before handing the chunk over to the UART module. No critical section is
+       * needed, because the TRANSMISSION state locks the transmit path.
+       */
+      tpCtx->asciiTxLen = aduLen;
+      tpCtx->asciiTxIdx = 0U;
+      uint8_t chunkLen = TbxMbAsciiEncodeChunk(tpCtx);
+      /* Pass the first chunk's transmit request on to the UART module. */
+      result = TbxMbUartTransmit(tpCtx->port, tpCtx->asciiTxBuf, chunkLen);
+      /* Transition back to the IDLE state, because the transmission could not be
+       * started. The unlocks access to txPacket for a possible future transmission.
+       */
+      if (result != TBX_OK)
+      {
+        TbxCriticalSectionEnter();
+        tpCtx->state = TBX_MB_ASCII_STATE_IDLE;
+        TbxCriticalSectionExit();
+      }
+    }
+    /* Problem detected that prevented the response from being sent? */
+    if (result == TBX_ERROR)
+    {
+      /* Increment the total number of not sent responses. */
+      tpCtx->diagInfo.srvNoRespCnt++;
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbAsciiTransmit ***/
+
+
+/************************************************************************************//**
+** \brief     Signals that the caller is done with processing a reception PDU. Should be
+**            called by a channel after receiving the TBX_MB_EVENT_ID_PDU_RECEIVED event
+**            and no longer needing access to the PDU stored in the transport layer
+**            context.
+** \param     transport Handle to ASCII transport layer object.
+**
+****************************************************************************************/
+static void TbxMbAsciiReceptionDone(tTbxMbTp transport)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(transport != NULL);
+
+  /* Only continue with valid parameters. */
+  if (transport != NULL)
+  {
+    /* Convert the TP channel pointer to the context structure. */
+    tTbxMbTpCtx * tpCtx = (tTbxMbTpCtx *)transport;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(tpCtx->type == TBX_MB_ASCII_CONTEXT_TYPE);
+    /* This function should only be called in the VALIDATION state. Verify this. */
+    TbxCriticalSectionEnter();
+    uint8_t currentState = tpCtx->state;
+    TbxCriticalSectionExit();
+    TBX_ASSERT(currentState == TBX_MB_ASCII_STATE_VALIDATION);
+    /* Only continue in the VALIDATION state. Note that in the VALIDATION state, the data
+     * reception path is locked until a transition back to IDLE state is made, which is
+     * handled by this function.
+     */
+    if (currentState == TBX_MB_ASCII_STATE_VALIDATION)
+    {
+      /* Transistion back to the IDLE state to unlock the data reception path, allowing
+       * the reception of new packets.
+       */
+      TbxCriticalSectionEnter();
+      tpCtx->state = TBX_MB_ASCII_STATE_IDLE;
+      TbxCriticalSectionExit();
+    }
+  }
+} /*** end of TbxMbAsciiReceptionDone ****/
+
+
+/************************************************************************************//**
+** \brief     Interface function to be called by a channel to obtain read access to the
+**            reception packet. Returns NULL is the packet is currently not accessible.
+**            Can be called when processing the TBX_MB_EVENT_ID_PDU_RECEIVED event.
+** \param     transport Handle to ASCII transport layer object.
+** \return    Pointer to the packet or NULL if currently not accessible.
+**
+****************************************************************************************/
+static tTbxMbTpPacket * TbxMbAsciiGetRxPacket(tTbxMbTp transport)
+{
+  tTbxMbTpPacket * result = NULL;
+
+  /* Verify parameters. */
+  TBX_ASSERT(transport != NULL);
+
+  /* Only continue with valid parameters. */
+  if (transport != NULL)
+  {
+    /* Convert the TP channel pointer to the context structure. */
+    tTbxMbTpCtx * tpCtx = (tTbxMbTpCtx *)transport;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(tpCtx->type == TBX_MB_ASCII_CONTEXT_TYPE);
+    /* Access to the reception packet by a channel is only allowed in the VALIDATION
+     * state. In this state the reception path is locked until a transition back to IDLE
+     * state is made. This happens once the channel called receptionDoneFcn().
+     */
+    TbxCriticalSectionEnter();
+    uint8_t currentState = tpCtx->state;
+    TbxCriticalSectionExit();
+    if (currentState == TBX_MB_ASCII_STATE_VALIDATION)
+    {
+      /* Update the result. */
+      result = &tpCtx->rxPacket;
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbAsciiGetRxPacket ***/
+
+
+/************************************************************************************//**
+** \brief     Interface function to be called by a channel to obtain write access to the
+**            transmission packet. Returns NULL is the packet is currently not
+**            accessible. Can by called to prepare the transmit packet before calling the
+**            transport layer's transmitFcn().
+** \param     transport Handle to ASCII transport layer object.
+** \return    Pointer to the packet or NULL if currently not accessible.
+**
+****************************************************************************************/
+static tTbxMbTpPacket * TbxMbAsciiGetTxPacket(tTbxMbTp transport)
+{
+  tTbxMbTpPacket * result = NULL;
+
+  /* Verify parameters. */
+  TBX_ASSERT(transport != NULL);
+
+  /* Only continue with valid parameters. */
+  if (transport != NULL)
+  {
+    /* Convert the TP channel pointer to the context structure. */
+    tTbxMbTpCtx * tpCtx = (tTbxMbTpCtx *)transport;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(tpCtx->type == TBX_MB_ASCII_CONTEXT_TYPE);
+    /* Access to the transmission packet by a channel is only allowed outside the
+     * TRANSMISSION state. In this state the transmission path is locked until a
+     * transition back to IDLE state is made. This happens once the transport layer
+     * completed the packet transmission.
+     */
+    TbxCriticalSectionEnter();
+    uint8_t currentState = tpCtx->state;
+    TbxCriticalSectionExit();
+    if (currentState != TBX_MB_ASCII_STATE_TRANSMISSION)
+    {
+      /* Update the result. */
+      result = &tpCtx->txPacket;
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbAsciiGetTxPacket ***/
+
+
+/************************************************************************************//**
+** \brief     Validates a newly received communication packet, stored in the transport
+**            layer object.
+** \details   The LRC was already accumulated while decoding the received characters.
+**            The LRC over all ADU bytes, including the LRC byte itself, adds up to zero
+**            for a valid packet. The LRC check is therefore just a single compare.
+** \param     transport Handle to ASCII transport layer object.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+static uint8_t TbxMbAsciiValidate(tTbxMbTp transport)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify parameters. */
+  TBX_ASSERT(transport != NULL);
+
+  /* Only continue with valid parameters. */
+  if (transport != NULL)
+  {
+    /* Convert the TP channel pointer to the context structure. */
+    tTbxMbTpCtx * tpCtx = (tTbxMbTpCtx *)transport;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(tpCtx->type == TBX_MB_ASCII_CONTEXT_TYPE);
+    /* This function should only be called in the VALIDATION state. Verify this. */
+    TbxCriticalSectionEnter();
+    uint8_t currentState = tpCtx->state;
+    TbxCriticalSectionExit();
+    TBX_ASSERT(currentState == TBX_MB_ASCII_STATE_VALIDATION);
+    /* Only continue in the VALIDATION state. Note that in the VALIDATION state, the data
+     * reception path is locked until a transition back to IDLE state is made.
+     * Consequenty, there is no need for critical sections when accessing the .rxXyz
+     * elements of the TP context.
+     */
+    if (currentState == TBX_MB_ASCII_STATE_VALIDATION)
+    {
+      /* Increment the total number of received packets, regardless of addressing or
+       * LRC.
+       */
+      tpCtx->diagInfo.busMsgCnt++;
+      /* Does the LRC not add up to zero? */
+      if (tpCtx->asciiRxLrc != 0U)
+      {
+        /* Increment the total number of received packets with an incorrect LRC. */
+        tpCtx->diagInfo.busCommErrCnt++;
+      }
+      /* LRC check passed. */
+      else
+      {
+        /* Packet reception complete. Set the PDU data length field. At this point
+         * rxAduWrIdx holds to total decoded bytes in the ADU. The PDU data length is
+         * that one, minus:
+         * - Node address (1 byte)
+         * - Function code (1 byte)
+         * - LRC (1 byte)
+         */
+        tpCtx->rxPacket.dataLen = (uint8_t)(tpCtx->rxAduWrIdx - 3U);
+        /* Also store the node address in the packet's node element. That's were
+         * channels expect it. It's in the first byte of the ADU and the ADU starts
+         * at one byte before the PDU, which is the last byte of head[].
+         */
+        tpCtx->rxPacket.node = tpCtx->rxPacket.head[TBX_MB_TP_ADU_HEAD_LEN_MAX-1U];
+        /* Continue checking if the ADU is addressed to us. This check is different for a
+         * server and a client. Start with the server case.
+         */
+        if (tpCtx->isClient == TBX_FALSE)
+        {
+          /* Only process frames that are addressed to us (unicast or broadcast). */
+          if ((tpCtx->rxPacket.node == tpCtx->nodeAddr) ||
+              (tpCtx->rxPacket.node == TBX_MB_TP_NODE_ADDR_BROADCAST))
+          {
+            /* Increment the total number of received packets with a correct LRC, that
+             * were addressed to us. Either via unicast of broadcast.
+             */
+            tpCtx->diagInfo.srvMsgCnt++;
+            /* Set the node address in the txPacket node element. It is used during
+             * transmission to decide if the actual sending of the response should be
+             * suppressed, which is the case for TBX_MB_TP_NODE_ADDR_BROADCAST. No need
+             * for a critical section, because we are guaranteed not in the IDLE or
+             * TRANSMISSION states.
+             */
+            tpCtx->txPacket.node = tpCtx->rxPacket.node;
+            /* Packet is valid. Update the result accordingly. */
+            result = TBX_OK;
+          }
+        }
+        /* Linked to a client channel. */
+        else
+        {
+          /* Only process frames that are send from a valid server. */
+          if ( (tpCtx->rxPacket.node >= TBX_MB_TP_NODE_ADDR_MIN) &&
+               (tpCtx->rxPacket.node <= TBX_MB_TP_NODE_ADDR_MAX) )
+          {
+            /* Packet is valid. Update the result accordingly. */
+            result = TBX_OK;
+          }
+        }
+      }
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbAsciiValidate ***/
+
+
+/************************************************************************************//**
+** \brief     Event function to signal to this module that the entire transfer completed.
+** \attention This function should be called by the UART module.
+** \details   This function accesses the transport layer context, which is a shared
+**            resource. Even though this function is called at UART Tx interrupt level,
+**            it is still necessary to access the transport layer context through a
+**            critical section. On a multicore target, the event thread might run on
+**            one core, while this interrupt runs on another core. A critical section
+**            for such a target manages a spin lock, needed to have mutual exclusive
+**            access to the shared resource.
+** \param     port The serial port that the transfer completed on.
+**
+****************************************************************************************/
+static void TbxMbAsciiTransmitComplete(tTbxMbUartPort port)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(port < TBX_MB_UART_NUM_PORT);
+
+  /* Only continue with valid parameters. */
+  if (port < TBX_MB_UART_NUM_PORT)
+  {
+    /* Obtain transport layer context linked to UART port of this event. */
+    tTbxMbTpCtx volatile * tpCtx = tbxMbAsciiCtx[port];
+    /* Verify transport layer context. */
+    TBX_ASSERT(tpCtx != NULL);
+    /* Only continue with a valid transport layer context. Note that there is no need
+     * to also check the transport layer type, because only ASCII types are stored in
+     * the tbxMbAsciiCtx[] array.
+     */
+    if (tpCtx != NULL)
+    {
+      TbxCriticalSectionEnter();
+      uint8_t stateCopy = tpCtx->state;
+      TbxCriticalSectionExit();
+      /* This function should only be called when in the TRANSMISSION state. Verify
+       * this.
+       */
+      TBX_ASSERT(stateCopy == TBX_MB_ASCII_STATE_TRANSMISSION);
+      /* Only continue in the TRANSMISSION state. */
+      if (stateCopy == TBX_MB_ASCII_STATE_TRANSMISSION)
+      {
+        /* Still characters left to transmit? Note that the encoder sets asciiTxIdx to
+         * one more than asciiTxLen, once it added the CR/LF end of frame characters.
+         */
+        if (tpCtx->asciiTxIdx <= tpCtx->asciiTxLen)
+        {
+          /* Encode the next chunk and pass it on to the UART module. */
+          uint8_t chunkLen = TbxMbAsciiEncodeChunk(tpCtx);
+          uint8_t const * chunkPtr = (uint8_t const *)tpCtx->asciiTxBuf;
+          if (TbxMbUartTransmit(tpCtx->port, chunkPtr, chunkLen) != TBX_OK)
+          {
+            /* Abort the frame by transitioning back to the IDLE state. */
+            TbxCriticalSectionEnter();
+            tpCtx->state = TBX_MB_ASCII_STATE_IDLE;
+            tpCtx->diagInfo.srvNoRespCnt++;
+            TbxCriticalSectionExit();
+          }
+        }
+        /* Complete frame transmitted. */
+        else
+        {
+          /* Transition back to the IDLE state. ASCII does not require an idle time on
+           * the bus after a frame, so this can happen right away.
+           */
+          TbxCriticalSectionEnter();
+          tpCtx->state = TBX_MB_ASCII_STATE_IDLE;
+          TbxCriticalSectionExit();
+          /* Post an event to the linked channel for inform them that the PDU
+           * transmission completed.
+           */
+          tTbxMbEvent newEvent;
+          newEvent.context = tpCtx->channelCtx;
+          newEvent.id = TBX_MB_EVENT_ID_PDU_TRANSMITTED;
+          TbxMbEventPostFromIsr(&newEvent, TBX_MB_OSAL_ISR_SOURCE_UART_TX(port));
+        }
+      }
+    }
+  }
+} /*** end of TbxMbAsciiTransmitComplete ***/
+
+
+/************************************************************************************//**
+** \brief     Event function to signal the reception of new data to this module. Each
+**            character is decoded right away. Hex character pairs go straight into the
+**            ADU of the reception packet and the LRC is updated on the fly.
+** \attention This function should be called by the UART module.
+** \details   This function accesses the transport layer context, which is a shared
+**            resource. Even though this function is called at UART Rx interrupt level,
+**            it is still necessary to access the transport layer context through a
+**            critical section. On a multicore target, the event thread might run on
+**            one core, while this interrupt runs on another core. A critical section
+**            for such a target manages a spin lock, needed to have mutual exclusive
+**            access to the shared resource.
+** \param     port The serial port that the transfer completed on.
+** \param     data Byte array with newly received data.
+** \param     len Number of newly received bytes.
+**
+****************************************************************************************/
+static void TbxMbAsciiDataReceived(tTbxMbUartPort         port,
+                                   uint8_t        const * data,
+                                   uint8_t                len)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((port < TBX_MB_UART_NUM_PORT) &&
+             (data != NULL) &&
+             (len > 0U));
+
+  /* Only continue with valid parameters. */
+  if ((port < TBX_MB_UART_NUM_PORT) &&
+      (data != NULL) &&
+      (len > 0U))
+  {
+    /* Obtain transport layer context linked to UART port of this event. */
+    tTbxMbTpCtx volatile * tpCtx = tbxMbAsciiCtx[port];
+    /* Verify transport layer context. */
+    TBX_ASSERT(tpCtx != NULL);
+    /* Only continue with a valid transport layer context. Note that there is no need
+     * to also check the transport layer type, because only ASCII types are stored in
+     * the tbxMbAsciiCtx[] array.
+     */
+    if (tpCtx != NULL)
+    {
+      uint8_t  idx = 0U;
+      uint8_t  startPolling = TBX_FALSE;
+      /* Get current time in timer ticks. */
+      uint16_t currentTime = TbxMbPortTimerCount();
+
+      /* Feed all newly received characters to the frame decoder. A chunk can hold more
+       * than one frame, for example when the UART driver reads in bursts. Therefore,
+       * continue with the remaining characters after the end of a frame.
+       */
+      while (idx < len)
+      {
+        uint8_t frameEnded = TBX_FALSE;
+        uint8_t frameOkay = TBX_FALSE;
+
+        TbxCriticalSectionEnter();
+        /* Feed the characters one-by-one to the frame decoder, until it detects the end
+         * of a frame.
+         */
+        while ((idx < len) && (frameEnded == TBX_FALSE))
+        {
+          frameEnded = TbxMbAsciiReceiveChar(tpCtx, data[idx]);
+          idx++;
+        }
+        /* Store the reception timestamp, which restarts the inter-character timeout. */
+        tpCtx->rxTime = currentTime;
+        /* Is a frame reception still in progress that needs the poll function to
+         * detect its inter-character timeout?
+         */
+        if ( (frameEnded == TBX_FALSE) &&
+             (tpCtx->state == TBX_MB_ASCII_STATE_RECEPTION) &&
+             (tpCtx->asciiRxPolling == TBX_FALSE) )
+        {
+          tpCtx->asciiRxPolling = TBX_TRUE;
+          startPolling = TBX_TRUE;
+        }
+        /* Did the frame end? */
+        if (frameEnded == TBX_TRUE)
+        {
+          /* Transition to the VALIDATION state. This locks the data reception path,
+           * until a transition back to IDLE state is made.
+           */
+          tpCtx->state = TBX_MB_ASCII_STATE_VALIDATION;
+          /* The frame is only okay, if no invalid characters were received, the CR came
+           * right before the LF, all hex pairs were complete and at least the node
+           * address, function code and LRC were received.
+           */
+          if ( (tpCtx->rxAduOkay == TBX_TRUE) &&
+               (tpCtx->asciiRxEol == TBX_TRUE) &&
+               (tpCtx->asciiRxNibble == TBX_MB_ASCII_NIBBLE_NONE) &&
+               (tpCtx->rxAduWrIdx >= 3U) )
+          {
+            frameOkay = TBX_TRUE;
+          }
+        }
+        TbxCriticalSectionExit();
+
+        /* Only continue if a complete frame was received. */
+        if (frameEnded == TBX_TRUE)
+        {
+          /* Validate the newly received packet, if it was properly framed. */
+          if ( (frameOkay == TBX_FALSE) ||
+               (TbxMbAsciiValidate((void *)tpCtx) != TBX_OK) )
+          {
+            /* Discard the newly received frame by transitioning back to IDLE. The
+             * remaining characters can then start a new frame.
+             */
+            TbxCriticalSectionEnter();
+            tpCtx->state = TBX_MB_ASCII_STATE_IDLE;
+            TbxCriticalSectionExit();
+          }
+          /* Newly received packet is valid. */
+          else
+          {
+            /* Post an event to the linked channel for further processing of the PDU.
+             * The reception path stays locked until then, so the decoder ignores the
+             * remaining characters, just like the ones received after this call.
+             */
+            tTbxMbEvent pduRxEvent;
+            pduRxEvent.context = tpCtx->channelCtx;
+            pduRxEvent.id = TBX_MB_EVENT_ID_PDU_RECEIVED;
+            TbxMbEventPostFromIsr(&pduRxEvent, TBX_MB_OSAL_ISR_SOURCE_UART_RX(port));
+          }
+        }
+      }
+      /* Instruct the event task to call our polling function, to be able to detect the
+       * inter-character timeout. Once activated, it stays activated until no frame is
+       * being received, so this happens at most once per frame.
+       */
+      if (startPolling == TBX_TRUE)
+      {
+        tTbxMbEvent newEvent;
+        newEvent.context = (void *)tpCtx;
+        newEvent.id = TBX_MB_EVENT_ID_START_POLLING;
+        TbxMbEventPostFromIsr(&newEvent, TBX_MB_OSAL_ISR_SOURCE_UART_RX(port));
+      }
+    }
+  }
+} /*** end of TbxMbAsciiDataReceived ***/
+
+
+/************************************************************************************//**
+** \brief     Processes one newly received character. A start character (':') always
+**            (re)starts the reception of a frame. Hex character pairs are decoded and
+**            stored directly in the ADU of the reception packet, while updating the
+**            running LRC. A line feed ends the frame.
+** \attention Should be called from within a critical section.
+** \param     tpCtx Pointer to the ASCII transport layer context.
+** \param     character The newly received character.
+** \return    TBX_TRUE if the character ended a frame, TBX_FALSE otherwise.
+**
+****************************************************************************************/
+static uint8_t TbxMbAsciiReceiveChar(tTbxMbTpCtx volatile * tpCtx,
+                                     uint8_t                character)
+{
+  uint8_t result = TBX_FALSE;
+
+  /* Verify parameters. */
+  TBX_ASSERT(tpCtx != NULL);
+
+  /* Only continue with valid parameters. */
+  if (tpCtx != NULL)
+  {
+    /* Start of a new frame? This also resynchronizes on the next frame if a previous
+     * frame was never completed. Only possible if the reception path is not locked.
+     */
+    if (character == TBX_MB_ASCII_CHAR_START)
+    {
+      if ( (tpCtx->state == TBX_MB_ASCII_STATE_IDLE) ||
+           (tpCtx->state == TBX_MB_ASCII_STATE_RECEPTION) )
+      {
+        /* Transition to the RECEPTION state and reset the frame decoder. */
+        tpCtx->state = TBX_MB_ASCII_STATE_RECEPTION;
+        tpCtx->rxAduWrIdx = 0U;
+        tpCtx->rxAduOkay = TBX_TRUE;
+        tpCtx->asciiRxNibble = TBX_MB_ASCII_NIBBLE_NONE;
+        tpCtx->asciiRxLrc = 0U;
+        tpCtx->asciiRxEol = TBX_FALSE;
+      }
+    }
+    /* All other characters are only of interest while receiving a frame. */
+    else if (tpCtx->state == TBX_MB_ASCII_STATE_RECEPTION)
+    {
+      /* End of the frame? */
+      if (character == TBX_MB_ASCII_CHAR_LF)
+      {
+        /* Update the result. */
+        result = TBX_TRUE;
+      }
+      /* First character of the end of frame sequence? */
+      else if (character == TBX_MB_ASCII_CHAR_CR)
+      {
+        tpCtx->asciiRxEol = TBX_TRUE;
+      }
+      /* Only an LF is allowed after the CR. */
+      else if (tpCtx->asciiRxEol == TBX_TRUE)
+      {
+        /* Flag frame as not okay (NOK). */
+        tpCtx->rxAduOkay = TBX_FALSE;
+      }
+      /* Should be a hex character. */
+      else
+      {
+        uint8_t nibble = TbxMbAsciiHexToNibble(character);
+        /* Not a valid hex character? */
+        if (nibble == TBX_MB_ASCII_NIBBLE_NONE)
+        {
+          /* Flag frame as not okay (NOK). */
+          tpCtx->rxAduOkay = TBX_FALSE;
+        }
+        /* Is this the high nibble of the byte? */
+        else if (tpCtx->asciiRxNibble == TBX_MB_ASCII_NIBBLE_NONE)
+        {
+          /* Store it until the low nibble arrives. */
+          tpCtx->asciiRxNibble = nibble;
+        }
+        /* Low nibble, so the byte is complete. Does it still fit in the ADU? */
+        else if (tpCtx->rxAduWrIdx < TBX_MB_ASCII_ADU_LEN_MAX)
+        {
+          /* The ADU for an ASCII packet starts at one byte before the PDU, which is the
+           * last byte of head[]. Get the pointer of where the ADU starts in rxPacket.
+           */
+          uint8_t volatile * aduPtr;
+          aduPtr = &tpCtx->rxPacket.head[TBX_MB_TP_ADU_HEAD_LEN_MAX-1U];
+          /* Store the decoded byte and add it to the running LRC. */
+          uint8_t decoded = (uint8_t)(tpCtx->asciiRxNibble << 4U) | nibble;
+          aduPtr[tpCtx->rxAduWrIdx] = decoded;
+          tpCtx->rxAduWrIdx++;
+          tpCtx->asciiRxLrc += decoded;
+          tpCtx->asciiRxNibble = TBX_MB_ASCII_NIBBLE_NONE;
+        }
+        /* ADU too long. */
+        else
+        {
+          /* Flag frame as not okay (NOK). */
+          tpCtx->rxAduOkay = TBX_FALSE;
+        }
+      }
+    }
+    else
+    {
+      /* Nothing left to do, but MISRA requires this terminating else statement. */
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbAsciiReceiveChar ***/
+
+
+/************************************************************************************//**
+** \brief     Hex encodes the next part of the ADU in the transmit packet into the
+**            transmit character buffer. The first chunk starts with the ':' character
+**            and the last chunk ends with the CR/LF characters.
+** \attention Should only be called in the TRANSMISSION state, which locks the transmit
+**            path.
+** \param     tpCtx Pointer to the ASCII transport layer context.
+** \return    Number of characters stored in the transmit character buffer.
+**
+****************************************************************************************/
+static uint8_t TbxMbAsciiEncodeChunk(tTbxMbTpCtx volatile * tpCtx)
+{
+  uint8_t result = 0U;
+
+  /* Verify parameters. */
+  TBX_ASSERT(tpCtx != NULL);
+
+  /* Only continue with valid parameters. */
+  if (tpCtx != NULL)
+  {
+    /* The ADU for an ASCII packet starts at one byte before the PDU, which is the last
+     * byte of head[]. Get the pointer of where the ADU starts in the txPacket.
+     */
+    uint8_t volatile const * aduPtr;
+    aduPtr = &tpCtx->txPacket.head[TBX_MB_TP_ADU_HEAD_LEN_MAX-1U];
+    uint8_t  charCnt = 0U;
+    uint16_t aduIdx = tpCtx->asciiTxIdx;
+
+    /* Start of the frame? */
+    if (aduIdx == 0U)
+    {
+      tpCtx->asciiTxBuf[charCnt] = TBX_MB_ASCII_CHAR_START;
+      charCnt++;
+    }
+    /* Encode as many ADU bytes as fit in the transmit character buffer. */
+    while ( (aduIdx < tpCtx->asciiTxLen) &&
+            ((charCnt + 2U) <= TBX_MB_TP_ASCII_TX_BUF_LEN) )
+    {
+      tpCtx->asciiTxBuf[charCnt] = TbxMbAsciiNibbleToHex(aduPtr[aduIdx] >> 4U);
+      tpCtx->asciiTxBuf[charCnt + 1U] = TbxMbAsciiNibbleToHex(aduPtr[aduIdx] & 0x0FU);
+      charCnt += 2U;
+      aduIdx++;
+    }
+    /* All ADU bytes encoded and still room for the end of frame characters? */
+    if ( (aduIdx == tpCtx->asciiTxLen) &&
+         ((charCnt + 2U) <= TBX_MB_TP_ASCII_TX_BUF_LEN) )
+    {
+      tpCtx->asciiTxBuf[charCnt] = TBX_MB_ASCII_CHAR_CR;
+      tpCtx->asciiTxBuf[charCnt + 1U] = TBX_MB_ASCII_CHAR_LF;
+      charCnt += 2U;
+      /* Move the index past the end to flag that the complete frame is encoded. */
+      aduIdx++;
+    }
+    /* Store the encoder progress. */
+    tpCtx->asciiTxIdx = aduIdx;
+    /* Update the result. */
+    result = charCnt;
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbAsciiEncodeChunk ***/
+
+
+/************************************************************************************//**
+** \brief     Converts a hex character to its 4-bit value. Both upper and lower case
+**            characters are accepted.
+** \param     character The hex character ('0'..'9', 'A'..'F', 'a'..'f').
+** \return    The 4-bit value or TBX_MB_ASCII_NIBBLE_NONE if not a hex character.
+**
+****************************************************************************************/
+static uint8_t TbxMbAsciiHexToNibble(uint8_t character)
+{
+  uint8_t result = TBX_MB_ASCII_NIBBLE_NONE;
+
+  /* Decimal digit? */
+  if ((character >= (uint8_t)'0') && (character <= (uint8_t)'9'))
+  {
+    result = character - (uint8_t)'0';
+  }
+  /* Upper case hex letter? */
+  else if ((character >= (uint8_t)'A') && (character <= (uint8_t)'F'))
+  {
+    result = (character - (uint8_t)'A') + 10U;
+  }
+  /* Lower case hex letter? */
+  else if ((character >= (uint8_t)'a') && (character <= (uint8_t)'f'))
+  {
+    result = (character - (uint8_t)'a') + 10U;
+  }
+  else
+  {
+    /* Nothing left to do, but MISRA requires this terminating else statement. */
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbAsciiHexToNibble ***/
+
+
+/************************************************************************************//**
+** \brief     Converts a 4-bit value to its upper case hex character.
+** \param     nibble The 4-bit value.
+** \return    The hex character.
+**
+****************************************************************************************/
+static uint8_t TbxMbAsciiNibbleToHex(uint8_t nibble)
+{
+  /* Lookup table for the hex characters. */
+  static const uint8_t tbxMbAsciiHexTable[] =
+  {
+    (uint8_t)'0', (uint8_t)'1', (uint8_t)'2', (uint8_t)'3',
+    (uint8_t)'4', (uint8_t)'5', (uint8_t)'6', (uint8_t)'7',
+    (uint8_t)'8', (uint8_t)'9', (uint8_t)'A', (uint8_t)'B',
+    (uint8_t)'C', (uint8_t)'D', (uint8_t)'E', (uint8_t)'F'
+  };
+  uint8_t result;
+
+  /* Look up the hex character. */
+  result = tbxMbAsciiHexTable[nibble & 0x0FU];
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbAsciiNibbleToHex ***/
+
+
+/************************************************************************************//**
+** \brief     Calculates the Modbus ASCII defined LRC checksum over the bytes in the
+**            specified data array. It's the two's complement of the 8-bit sum of all
+**            data bytes.
+** \param     data Pointer to the byte array with data.
+** \param     len Number of data bytes to include in the LRC calculation.
+** \return    The calculated LRC checksum value.
+**
+****************************************************************************************/
+static uint8_t TbxMbAsciiCalculateLrc(uint8_t  const * data,
+                                      uint16_t         len)
+{
+  uint8_t result = 0U;
+  uint8_t sum = 0U;
+
+  /* Loop over all the data bytes. */
+  for (uint16_t byteIdx = 0; byteIdx < len; byteIdx++)
+  {
+    /* Add the byte to the sum, ignoring carries. */
+    sum += data[byteIdx];
+  }
+  /* Update the result with the two's complement of the sum. */
+  result = (uint8_t)(0U - sum);
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbAsciiCalculateLrc ***/
+
+
+/*********************************** end of tbxmb_ascii.c ******************************/
@@ -35,6 +35,7 @@
 #include "microtbxmodbus.h"                      /* MicroTBX-Modbus module             */
 #include "tbxmb_event_private.h"                 /* MicroTBX-Modbus event private      */
 #include "tbxmb_osal_private.h"                  /* MicroTBX-Modbus OSAL private       */
+#include "tbxmb_timer_private.h"                 /* MicroTBX-Modbus timer private      */
 #include "tbxmb_tp_private.h"                    /* MicroTBX-Modbus TP private         */
 #include "tbxmb_client_private.h"                /* MicroTBX-Modbus client private     */
 
@@ -107,9 +108,12 @@ tTbxMbClient TbxMbClientCreate(tTbxMbTp transport,
       newClientCtx->instancePtr = NULL;
       newClientCtx->pollFcn = NULL;
       newClientCtx->processFcn = TbxMbClientProcessEvent;
+      TbxMbTimerInit(&newClientCtx->pollTimer, newClientCtx);
+      newClientCtx->eventLoop = tpCtx->eventLoop;
       newClientCtx->responseTimeout = responseTimeout;
       newClientCtx->turnaroundDelay = turnaroundDelay;
-      newClientCtx->transceiveSem = TbxMbOsalSemCreate();
+      newClientCtx->txSem = TbxMbOsalSemCreate();
+      newClientCtx->rxSem = TbxMbOsalSemCreate();
       newClientCtx->tpCtx = tpCtx;
       newClientCtx->tpCtx->channelCtx = newClientCtx;
       newClientCtx->tpCtx->isClient = TBX_TRUE;
@@ -140,8 +144,9 @@ void TbxMbClientFree(tTbxMbClient channel)
     tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
     /* Sanity check on the context type. */
     TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
-    /* Release the semaphore used for syncing to PDU transmit and reception events. */
-    TbxMbOsalSemFree(clientCtx->transceiveSem);
+    /* Release the semaphores used for syncing to PDU transmit and reception events. */
+    TbxMbOsalSemFree(clientCtx->txSem);
+    TbxMbOsalSemFree(clientCtx->rxSem);
     /* Remove crosslink between the channel and the transport layer. */
     TbxCriticalSectionEnter();
     clientCtx->tpCtx->channelCtx = NULL;
@@ -150,7 +155,8 @@ void TbxMbClientFree(tTbxMbClient channel)
     clientCtx->type = 0U;
     clientCtx->pollFcn = NULL;
     clientCtx->processFcn = NULL;
-    clientCtx->transceiveSem = NULL;
+    clientCtx->txSem = NULL;
+    clientCtx->rxSem = NULL;
     TbxCriticalSectionExit();
     /* Give the channel context back to the memory pool. */
     TbxMemPoolRelease(clientCtx);
@@ -190,9 +196,11 @@ static void TbxMbClientProcessEvent(tTbxMbEvent * event)
         case TBX_MB_EVENT_ID_PDU_RECEIVED:
         {
           /* Give the PDU received semaphore to synchronize whatever task is waiting
-           * for this event.
+           * for this event. This is a separate semaphore, because with a fast transport
+           * layer, the response might already be received before the waiting task got
+           * the chance to take the PDU transmitted semaphore.
            */
-          TbxMbOsalSemGive(clientCtx->transceiveSem, TBX_FALSE);
+          TbxMbOsalSemGive(clientCtx->rxSem, TBX_FALSE);
         }
         break;
 
@@ -201,7 +209,7 @@ static void TbxMbClientProcessEvent(tTbxMbEvent * event)
           /* Give the PDU transmitted semaphore to synchronize whatever task is waiting
            * for this event.
            */
-          TbxMbOsalSemGive(clientCtx->transceiveSem, TBX_FALSE);
+          TbxMbOsalSemGive(clientCtx->txSem, TBX_FALSE);
         }
         break;
 
@@ -251,7 +259,7 @@ static uint8_t TbxMbClientTransceive(tTbxMbClientCtx * clientCtx,
      * timeout can be re-used for this because a packet transmission won't take longer
      * than a packet reception, since it uses the same communication interface.
      */
-    if (TbxMbOsalSemTake(clientCtx->transceiveSem, clientCtx->responseTimeout)
+    if (TbxMbOsalSemTake(clientCtx->txSem, clientCtx->responseTimeout)
         == TBX_FALSE)
     {
       /* For some reason the packet transmission did not complete within the expected
@@ -264,7 +272,7 @@ static uint8_t TbxMbClientTransceive(tTbxMbClientCtx * clientCtx,
     if (result == TBX_OK)
     {
       /* Wait for the reception of the response from the server, with a timeout. */
-      if (TbxMbOsalSemTake(clientCtx->transceiveSem, waitTimeout) == TBX_FALSE)
+      if (TbxMbOsalSemTake(clientCtx->rxSem, waitTimeout) == TBX_FALSE)
       {
         /* Semaphore timeout occured. Either because no response was received, which
          * is an error. Or because the turnaround time after the broadcast request
@@ -283,6 +291,114 @@ static uint8_t TbxMbClientTransceive(tTbxMbClientCtx * clientCtx,
 } /*** end of TbxMbClientTransceive ***/
 
 
+/************************************************************************************//**
+** \brief     Reads a range of coils or discrete inputs from the server with the
+**            specified node address and stores them in a packed bit array. The packed
+**            bit array has the same format as the response, so the bits are copied a
+**            byte at a time.
+** \param     clientCtx Pointer to the Modbus client channel context.
+** \param     node The address of the server.
+** \param     code Function code. Either TBX_MB_FC01_READ_COILS or
+**            TBX_MB_FC02_READ_DISCRETE_INPUTS.
+** \param     addr Starting element address (0..65535) in the Modbus data table.
+** \param     num Number of elements to read. Range can be 1..2000.
+** \param     bits Pointer to the packed bit array where the element states will be
+**            written to.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+static uint8_t TbxMbClientReadBits(tTbxMbClientCtx * clientCtx,
+                                   uint8_t           node,
+                                   uint8_t           code,
+                                   uint16_t          addr,
+                                   uint16_t          num,
+                                   uint8_t         * bits)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify parameters. */
+  TBX_ASSERT((clientCtx != NULL) && (bits != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((clientCtx != NULL) && (bits != NULL))
+  {
+    /* Obtain write access to the request packet. */
+    tTbxMbTpPacket * txPacket = clientCtx->tpCtx->getTxPacketFcn(clientCtx->tpCtx);
+    /* Should always work, unless this function is being called recursively. Only
+     * continue with access for preparing the request packet.
+     */
+    if (txPacket != NULL)
+    {
+      /* Prepare the request packet. */
+      txPacket->node = node;
+      txPacket->pdu.code = code;
+      txPacket->dataLen = 4U;
+      /* Starting address. */
+      TbxMbCommonStoreUInt16BE(addr, &txPacket->pdu.data[0]);
+      /* Number of elements. */
+      TbxMbCommonStoreUInt16BE(num, &txPacket->pdu.data[2]);
+      /* Transmit the request and wait for the response to come in. */
+      result = TbxMbClientTransceive(clientCtx, TBX_FALSE);
+
+      /* Only continue with processing the response if all is okay so far. */
+      if (result == TBX_OK)
+      {
+        /* Obtain read access to the response packet. */
+        tTbxMbTpPacket * rxPacket = clientCtx->tpCtx->getRxPacketFcn(clientCtx->tpCtx);
+        /* Since we just received a response packet, the packet access should always
+         * succeed. Sanity check anyways, just in case.
+         */
+        TBX_ASSERT(rxPacket != NULL);
+        /* Only continue with packet access. */
+        if (rxPacket != NULL)
+        {
+          /* Determine the number of bytes needed to hold all the bits. The cast to U8
+           * is okay, because the caller made sure that num is <= 2000.
+           */
+          uint8_t numBytes = (uint8_t)(num / 8U);
+          if ((num % 8U) != 0U)
+          {
+            numBytes++;
+          }
+          /* Check that the response came from the expected node, that it's a response
+           * with the same function code (not an exception response) and that the data
+           * length and the byte count are as expected.
+           */
+          uint8_t byteCount = rxPacket->pdu.data[0];
+          if ((rxPacket->node != node) ||
+              (rxPacket->pdu.code != code) ||
+              (byteCount != numBytes) ||
+              (rxPacket->dataLen != (byteCount + 1U)))
+          {
+            result = TBX_ERROR;
+          }
+          /* Response content valid. Process its data. */
+          else
+          {
+            /* Copy the packed bits a byte at a time. */
+            for (uint8_t idx = 0U; idx < numBytes; idx++)
+            {
+              bits[idx] = rxPacket->pdu.data[1U + idx];
+            }
+          }
+        }
+        /* Could not access the response packet. */
+        else
+        {
+          result = TBX_ERROR;
+        }
+        /* Inform the transport layer that were done with the rx packet and no longer
+         * need access to it.
+         */
+        clientCtx->tpCtx->receptionDoneFcn(clientCtx->tpCtx);
+      }
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientReadBits ***/
+
+
 /************************************************************************************//**
 ** \brief     Reads the coil(s) from the server with the specified node address.
 ** \param     channel Handle to the Modbus client channel for the requested operation.
@@ -1156,53 +1272,139 @@ uint8_t TbxMbClientWriteHoldingRegs(tTbxMbClient         channel,
 
 
 /************************************************************************************//**
-** \brief     Perform diagnostic operation on the server for checking the communication
-**            system.
+** \brief     Reads the coil(s) from the server with the specified node address and
+**            stores them in a packed bit array. Packed bit arrays store their bits in
+**            the same way as Modbus packets do: bit 0 of bits[0] holds the coil at
+**            address addr, bit 1 of bits[0] the one at address addr + 1, and so on. This
+**            avoids the processing of the coils one at a time and needs just one byte
+**            for every eight coils. Unused bits in the last byte are zero.
 ** \param     channel Handle to the Modbus client channel for the requested operation.
 ** \param     node The address of the server. This parameter is transport layer
 **            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
 **            a gateway to an RTU network. If it's don't care, set it to a value of 1.
-** \param     subcode Sub-function code for specifying the diagnostic operation to
-**            perform. Currently supported values:
-**              - TBX_MB_DIAG_SC_QUERY_DATA
-**              - TBX_MB_DIAG_SC_CLEAR_COUNTERS
-**              - TBX_MB_DIAG_SC_BUS_MESSAGE_COUNT
-**              - TBX_MB_DIAG_SC_BUS_COMM_ERROR_COUNT
-**              - TBX_MB_DIAG_SC_BUS_EXCEPTION_ERROR_COUNT
-**              - TBX_MB_DIAG_SC_SERVER_MESSAGE_COUNT
-**              - TBX_MB_DIAG_SC_SERVER_NO_RESPONSE_COUNT
-** \param     count Location where the retrieved count value will be written to. Only
-**            applicable for the subcodes that end with _COUNT.
+** \param     addr Starting element address (0..65535) in the Modbus data table for the
+**            coil read operation.
+** \param     num Number of elements to read from the coils data table. Range can be
+**            1..2000.
+** \param     bits Pointer to the packed bit array where the coil states will be written
+**            to. It must have space for at least (num + 7) / 8 bytes.
 ** \return    TBX_OK if successful, TBX_ERROR otherwise.
 **
 ****************************************************************************************/
-uint8_t TbxMbClientDiagnostics(tTbxMbClient   channel,
-                               uint8_t        node,
-                               uint16_t       subcode,
-                               uint16_t     * count)
+uint8_t TbxMbClientReadCoilsPacked(tTbxMbClient   channel,
+                                   uint8_t        node,
+                                   uint16_t       addr,
+                                   uint16_t       num,
+                                   uint8_t      * bits)
 {
-  uint8_t        result      = TBX_ERROR;
-  uint16_t const queryData[] = { 0xFFFFU, 0x0000U, 0xAA55U, 0x55AAU, 0x3723U };
+  uint8_t result = TBX_ERROR;
 
   /* Verify the parameters. */
-  TBX_ASSERT((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && 
-             ((subcode == TBX_MB_DIAG_SC_QUERY_DATA) || 
-              (subcode == TBX_MB_DIAG_SC_CLEAR_COUNTERS) ||
-              (subcode == TBX_MB_DIAG_SC_BUS_MESSAGE_COUNT) ||
-              (subcode == TBX_MB_DIAG_SC_BUS_COMM_ERROR_COUNT) ||
-              (subcode == TBX_MB_DIAG_SC_BUS_EXCEPTION_ERROR_COUNT) ||
-              (subcode == TBX_MB_DIAG_SC_SERVER_MESSAGE_COUNT) ||
-              (subcode == TBX_MB_DIAG_SC_SERVER_NO_RESPONSE_COUNT)));
+  TBX_ASSERT((channel != NULL) && (node >= TBX_MB_TP_NODE_ADDR_MIN) &&
+             (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) && (num <= 2000U) &&
+             (bits != NULL));
 
   /* Only continue with valid parameters. */
-  if ((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && 
-      ((subcode == TBX_MB_DIAG_SC_QUERY_DATA) || 
-       (subcode == TBX_MB_DIAG_SC_CLEAR_COUNTERS) ||
-       (subcode == TBX_MB_DIAG_SC_BUS_MESSAGE_COUNT) ||
-       (subcode == TBX_MB_DIAG_SC_BUS_COMM_ERROR_COUNT) ||
-       (subcode == TBX_MB_DIAG_SC_BUS_EXCEPTION_ERROR_COUNT) ||
-       (subcode == TBX_MB_DIAG_SC_SERVER_MESSAGE_COUNT) ||
-       (subcode == TBX_MB_DIAG_SC_SERVER_NO_RESPONSE_COUNT)))
+  if ((channel != NULL) && (node >= TBX_MB_TP_NODE_ADDR_MIN) &&
+      (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) && (num <= 2000U) &&
+      (bits != NULL))
+  {
+    /* Convert the client channel pointer to the context structure. */
+    tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
+    /* Read the coils. */
+    result = TbxMbClientReadBits(clientCtx, node, TBX_MB_FC01_READ_COILS, addr, num,
+                                 bits);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientReadCoilsPacked ***/
+
+
+/************************************************************************************//**
+** \brief     Reads the discrete input(s) from the server with the specified node address
+**            and stores them in a packed bit array. Packed bit arrays store their bits
+**            in the same way as Modbus packets do: bit 0 of bits[0] holds the input at
+**            address addr, bit 1 of bits[0] the one at address addr + 1, and so on.
+**            Unused bits in the last byte are zero.
+** \param     channel Handle to the Modbus client channel for the requested operation.
+** \param     node The address of the server. This parameter is transport layer
+**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
+**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
+** \param     addr Starting element address (0..65535) in the Modbus data table for the
+**            discrete input read operation.
+** \param     num Number of elements to read from the discrete inputs data table. Range
+**            can be 1..2000.
+** \param     bits Pointer to the packed bit array where the discrete input states will
+**            be written to. It must have space for at least (num + 7) / 8 bytes.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbClientReadInputsPacked(tTbxMbClient   channel,
+                                    uint8_t        node,
+                                    uint16_t       addr,
+                                    uint16_t       num,
+                                    uint8_t      * bits)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify the parameters. */
+  TBX_ASSERT((channel != NULL) && (node >= TBX_MB_TP_NODE_ADDR_MIN) &&
+             (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) && (num <= 2000U) &&
+             (bits != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (node >= TBX_MB_TP_NODE_ADDR_MIN) &&
+      (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) && (num <= 2000U) &&
+      (bits != NULL))
+  {
+    /* Convert the client channel pointer to the context structure. */
+    tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
+    /* Read the discrete inputs. */
+    result = TbxMbClientReadBits(clientCtx, node, TBX_MB_FC02_READ_DISCRETE_INPUTS, addr,
+                                 num, bits);
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientReadInputsPacked ***/
+
+
+/************************************************************************************//**
+** \brief     Writes the coil(s) from a packed bit array to the server with the specified
+**            node address. Packed bit arrays store their bits in the same way as Modbus
+**            packets do: bit 0 of bits[0] holds the coil at address addr, bit 1 of
+**            bits[0] the one at address addr + 1, and so on. The bits are copied to the
+**            request a byte at a time. Unused bits in the last byte are don't care.
+** \param     channel Handle to the Modbus client channel for the requested operation.
+** \param     node The address of the server. This parameter is transport layer
+**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
+**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
+** \param     addr Starting element address (0..65535) in the Modbus data table for the
+**            coil write operation.
+** \param     num Number of elements to write to the coils data table. Range can be
+**            1..1968.
+** \param     bits Pointer to the packed bit array with the desired coil states.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbClientWriteCoilsPacked(tTbxMbClient         channel,
+                                    uint8_t              node,
+                                    uint16_t             addr,
+                                    uint16_t             num,
+                                    uint8_t      const * bits)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify the parameters. */
+  TBX_ASSERT((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
+             (num <= 1968U) && (bits != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (num >= 1U) &&
+      (num <= 1968U) && (bits != NULL))
   {
     /* Convert the client channel pointer to the context structure. */
     tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
@@ -1216,26 +1418,34 @@ uint8_t TbxMbClientDiagnostics(tTbxMbClient   channel,
      */
     if (txPacket != NULL)
     {
+      /* Determine the number of bytes needed to hold all the coil bits. The cast to U8
+       * is okay, because we know that num is <= 1968.
+       */
+      uint8_t numBytes = (uint8_t)(num / 8U);
+      if ((num % 8U) != 0U)
+      {
+        numBytes++;
+      }
       /* Prepare the request packet. */
       txPacket->node = node;
-      txPacket->pdu.code = TBX_MB_FC08_DIAGNOSTICS;
-      TbxMbCommonStoreUInt16BE(subcode, &txPacket->pdu.data[0]);
-      /* Requested to perform a query data diagnostic operation? */
-      if (subcode == TBX_MB_DIAG_SC_QUERY_DATA)
+      txPacket->pdu.code = TBX_MB_FC15_WRITE_MULTIPLE_COILS;
+      txPacket->dataLen = numBytes + 5U;
+      /* Start address. */
+      TbxMbCommonStoreUInt16BE(addr, &txPacket->pdu.data[0]);
+      /* Number of coils. */
+      TbxMbCommonStoreUInt16BE(num, &txPacket->pdu.data[2]);
+      /* Byte count. */
+      txPacket->pdu.data[4] = numBytes;
+      /* Copy the packed bits a byte at a time. */
+      uint8_t * coilData = &txPacket->pdu.data[5];
+      for (uint8_t idx = 0U; idx < numBytes; idx++)
       {
-        /* Write the query data for loopback testing. */
-        for (uint8_t idx = 0U; idx < (sizeof(queryData)/sizeof(queryData[0])); idx++)
-        {
-          TbxMbCommonStoreUInt16BE(queryData[idx], &txPacket->pdu.data[2U + (idx * 2U)]);
-        }
-        txPacket->dataLen = ((sizeof(queryData) / sizeof(queryData[0])) * 2U) + 2U;
+        coilData[idx] = bits[idx];
       }
-      /* All other supported subcodes require a 16-bit zero value data field. */
-      else
+      /* The Modbus protocol requires the unused bits in the last byte to be zero. */
+      if ((num % 8U) != 0U)
       {
-        /* Store the data field as per the protocol. */
-        TbxMbCommonStoreUInt16BE(0x0000U, &txPacket->pdu.data[2U]);
-        txPacket->dataLen = 4U;
+        coilData[numBytes - 1U] &= (uint8_t)((1U << (num % 8U)) - 1U);
       }
 
       /* Determine the request type (broadcast / unicast). */
@@ -1256,7 +1466,7 @@ uint8_t TbxMbClientDiagnostics(tTbxMbClient   channel,
       {
         /* Obtain read access to the response packet. */
         tTbxMbTpPacket * rxPacket = clientCtx->tpCtx->getRxPacketFcn(clientCtx->tpCtx);
-        /* Since we just received a response packet, the packet access should always 
+        /* Since we just received a response packet, the packet access should always
          * succeed. Sanity check anyways, just in case.
          */
         TBX_ASSERT(rxPacket != NULL);
@@ -1264,21 +1474,812 @@ uint8_t TbxMbClientDiagnostics(tTbxMbClient   channel,
         if (rxPacket != NULL)
         {
           /* Check that the response came from the expected node, that it's a response
-           * with the same function code (not an exception response) and that it's a
-           * response with the same function sub-code.
+           * with the same function code (not an exception response), that it echoes
+           * the start address and number of coils and that the data length is as
+           * expected.
            */
           if ((rxPacket->node != node) ||
-              (rxPacket->pdu.code != TBX_MB_FC08_DIAGNOSTICS) ||
-              (TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]) != subcode))
+              (rxPacket->pdu.code != TBX_MB_FC15_WRITE_MULTIPLE_COILS) ||
+              (TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]) != addr) ||
+              (TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[2]) != num) ||
+              (rxPacket->dataLen != 4U))
           {
             result = TBX_ERROR;
           }
-          /* Response looks valid so far. Continue with processing its data.*/
-          else
+        }
+        /* Could not access the response packet. */
+        else
+        {
+          result = TBX_ERROR;
+        }
+        /* Inform the transport layer that were done with the rx packet and no longer
+         * need access to it.
+         */
+        clientCtx->tpCtx->receptionDoneFcn(clientCtx->tpCtx);
+      }
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientWriteCoilsPacked ***/
+
+
+/************************************************************************************//**
+** \brief     Reads a range of records from a file on the server with the specified node
+**            address. A file is a collection of records, each being a 16-bit register.
+**            The Modbus protocol limits a single request to 121 records. This function
+**            automatically splits larger ranges into multiple requests, each one packed
+**            with as many records as fit in a response.
+** \param     channel Handle to the Modbus client channel for the requested operation.
+** \param     node The address of the server. This parameter is transport layer
+**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
+**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
+** \param     file Number of the file (1..65535).
+** \param     record Number of the first record in the file to read (0..9999).
+** \param     num Number of records to read. Range can be 1..10000, with the limitation
+**            that the range cannot extend past record 9999.
+** \param     values Pointer to array where the record values will be written to.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbClientReadFileRecord(tTbxMbClient   channel,
+                                  uint8_t        node,
+                                  uint16_t       file,
+                                  uint16_t       record,
+                                  uint16_t       num,
+                                  uint16_t     * values)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify the parameters. */
+  TBX_ASSERT((channel != NULL) && (node >= TBX_MB_TP_NODE_ADDR_MIN) &&
+             (node <= TBX_MB_TP_NODE_ADDR_MAX) && (file >= 1U) &&
+             (record <= TBX_MB_FILE_RECORD_NUM_MAX) && (num >= 1U) &&
+             (num <= ((TBX_MB_FILE_RECORD_NUM_MAX + 1U) - record)) && (values != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (node >= TBX_MB_TP_NODE_ADDR_MIN) &&
+      (node <= TBX_MB_TP_NODE_ADDR_MAX) && (file >= 1U) &&
+      (record <= TBX_MB_FILE_RECORD_NUM_MAX) && (num >= 1U) &&
+      (num <= ((TBX_MB_FILE_RECORD_NUM_MAX + 1U) - record)) && (values != NULL))
+  {
+    /* Convert the client channel pointer to the context structure. */
+    tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
+
+    uint16_t done = 0U;
+    /* Assume success until proven otherwise. */
+    result = TBX_OK;
+    /* Keep sending requests, until all records are read or an error was detected. */
+    while ((done < num) && (result == TBX_OK))
+    {
+      /* Determine the number of records for this request. A single sub-request carries
+       * the most records, because each additional one adds a header to the response.
+       */
+      uint8_t chunk = 121U;
+      if ((num - done) < chunk)
+      {
+        chunk = (uint8_t)(num - done);
+      }
+      /* Obtain write access to the request packet. */
+      tTbxMbTpPacket * txPacket = clientCtx->tpCtx->getTxPacketFcn(clientCtx->tpCtx);
+      /* Should always work, unless this function is being called recursively. */
+      if (txPacket == NULL)
+      {
+        result = TBX_ERROR;
+      }
+      else
+      {
+        /* Prepare the request packet. */
+        txPacket->node = node;
+        txPacket->pdu.code = TBX_MB_FC20_READ_FILE_RECORD;
+        txPacket->dataLen = 8U;
+        /* Byte count. */
+        txPacket->pdu.data[0] = 7U;
+        /* Sub-request with the reference type, file, record and number of records. */
+        txPacket->pdu.data[1] = TBX_MB_FILE_REF_TYPE;
+        TbxMbCommonStoreUInt16BE(file, &txPacket->pdu.data[2]);
+        TbxMbCommonStoreUInt16BE((uint16_t)(record + done), &txPacket->pdu.data[4]);
+        TbxMbCommonStoreUInt16BE(chunk, &txPacket->pdu.data[6]);
+        /* Transmit the request and wait for the response to come in. */
+        result = TbxMbClientTransceive(clientCtx, TBX_FALSE);
+
+        /* Only continue with processing the response if all is okay so far. */
+        if (result == TBX_OK)
+        {
+          /* Obtain read access to the response packet. */
+          tTbxMbTpPacket * rxPacket = clientCtx->tpCtx->getRxPacketFcn(clientCtx->tpCtx);
+          /* Since we just received a response packet, the packet access should always
+           * succeed. Sanity check anyways, just in case.
+           */
+          TBX_ASSERT(rxPacket != NULL);
+          /* Only continue with packet access. */
+          if (rxPacket != NULL)
           {
-            if (subcode == TBX_MB_DIAG_SC_QUERY_DATA)
-            {
-              const uint8_t queryDataLen = sizeof(queryData) / sizeof(queryData[0]);
+            /* Check that the response came from the expected node, that it's a
+             * response with the same function code (not an exception response) and
+             * that the data length, sub-response length and reference type are as
+             * expected.
+             */
+            uint8_t byteCount = rxPacket->pdu.data[0];
+            if ((rxPacket->node != node) ||
+                (rxPacket->pdu.code != TBX_MB_FC20_READ_FILE_RECORD) ||
+                (byteCount != ((chunk * 2U) + 2U)) ||
+                (rxPacket->dataLen != (byteCount + 1U)) ||
+                (rxPacket->pdu.data[1] != ((chunk * 2U) + 1U)) ||
+                (rxPacket->pdu.data[2] != TBX_MB_FILE_REF_TYPE))
+            {
+              result = TBX_ERROR;
+            }
+            /* Response content valid. Process its data. */
+            else
+            {
+              /* Set pointer to where the record values start in the response. */
+              uint8_t const * regValPtr = &rxPacket->pdu.data[3];
+              /* Read out and store the record values. */
+              for (uint8_t idx = 0U; idx < chunk; idx++)
+              {
+                values[done + idx] = TbxMbCommonExtractUInt16BE(&regValPtr[idx * 2U]);
+              }
+              done += chunk;
+            }
+          }
+          /* Could not access the response packet. */
+          else
+          {
+            result = TBX_ERROR;
+          }
+          /* Inform the transport layer that were done with the rx packet and no longer
+           * need access to it.
+           */
+          clientCtx->tpCtx->receptionDoneFcn(clientCtx->tpCtx);
+        }
+      }
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientReadFileRecord ***/
+
+
+/************************************************************************************//**
+** \brief     Writes a range of records to a file on the server with the specified node
+**            address. A file is a collection of records, each being a 16-bit register.
+**            The Modbus protocol limits a single request to 122 records. This function
+**            automatically splits larger ranges into multiple requests, each one packed
+**            with as many records as fit in a request.
+** \param     channel Handle to the Modbus client channel for the requested operation.
+** \param     node The address of the server. This parameter is transport layer
+**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
+**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
+** \param     file Number of the file (1..65535).
+** \param     record Number of the first record in the file to write (0..9999).
+** \param     num Number of records to write. Range can be 1..10000, with the limitation
+**            that the range cannot extend past record 9999.
+** \param     values Pointer to array with the record values to write.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbClientWriteFileRecord(tTbxMbClient         channel,
+                                   uint8_t              node,
+                                   uint16_t             file,
+                                   uint16_t             record,
+                                   uint16_t             num,
+                                   uint16_t     const * values)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify the parameters. */
+  TBX_ASSERT((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (file >= 1U) &&
+             (record <= TBX_MB_FILE_RECORD_NUM_MAX) && (num >= 1U) &&
+             (num <= ((TBX_MB_FILE_RECORD_NUM_MAX + 1U) - record)) && (values != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && (file >= 1U) &&
+      (record <= TBX_MB_FILE_RECORD_NUM_MAX) && (num >= 1U) &&
+      (num <= ((TBX_MB_FILE_RECORD_NUM_MAX + 1U) - record)) && (values != NULL))
+  {
+    /* Convert the client channel pointer to the context structure. */
+    tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
+
+    /* Determine the request type (broadcast / unicast). */
+    uint8_t isBroadcast = TBX_FALSE;
+    if (node == TBX_MB_TP_NODE_ADDR_BROADCAST)
+    {
+      isBroadcast = TBX_TRUE;
+    }
+    uint16_t done = 0U;
+    /* Assume success until proven otherwise. */
+    result = TBX_OK;
+    /* Keep sending requests, until all records are written or an error was detected. */
+    while ((done < num) && (result == TBX_OK))
+    {
+      /* Determine the number of records for this request. A single sub-request carries
+       * the most records, because each additional one adds a header to the request.
+       */
+      uint8_t chunk = 122U;
+      if ((num - done) < chunk)
+      {
+        chunk = (uint8_t)(num - done);
+      }
+      uint8_t  byteCount   = (chunk * 2U) + 7U;
+      uint16_t chunkRecord = record + done;
+      /* Obtain write access to the request packet. */
+      tTbxMbTpPacket * txPacket = clientCtx->tpCtx->getTxPacketFcn(clientCtx->tpCtx);
+      /* Should always work, unless this function is being called recursively. */
+      if (txPacket == NULL)
+      {
+        result = TBX_ERROR;
+      }
+      else
+      {
+        /* Prepare the request packet. */
+        txPacket->node = node;
+        txPacket->pdu.code = TBX_MB_FC21_WRITE_FILE_RECORD;
+        txPacket->dataLen = byteCount + 1U;
+        /* Byte count. */
+        txPacket->pdu.data[0] = byteCount;
+        /* Sub-request with the reference type, file, record and number of records. */
+        txPacket->pdu.data[1] = TBX_MB_FILE_REF_TYPE;
+        TbxMbCommonStoreUInt16BE(file, &txPacket->pdu.data[2]);
+        TbxMbCommonStoreUInt16BE(chunkRecord, &txPacket->pdu.data[4]);
+        TbxMbCommonStoreUInt16BE(chunk, &txPacket->pdu.data[6]);
+        /* Record values. */
+        uint8_t * regValPtr = &txPacket->pdu.data[8];
+        for (uint8_t idx = 0U; idx < chunk; idx++)
+        {
+          TbxMbCommonStoreUInt16BE(values[done + idx], &regValPtr[idx * 2U]);
+        }
+        /* Transmit the request and wait for the response to a unicast request to come
+         * in or the turnaround time to pass for a broadcast request.
+         */
+        result = TbxMbClientTransceive(clientCtx, isBroadcast);
+
+        /* Only continue with processing the response if all is okay so far and the
+         * request was unicast.
+         */
+        if ((result == TBX_OK) && (isBroadcast == TBX_FALSE))
+        {
+          /* Obtain read access to the response packet. */
+          tTbxMbTpPacket * rxPacket = clientCtx->tpCtx->getRxPacketFcn(clientCtx->tpCtx);
+          /* Since we just received a response packet, the packet access should always
+           * succeed. Sanity check anyways, just in case.
+           */
+          TBX_ASSERT(rxPacket != NULL);
+          /* Only continue with packet access. */
+          if (rxPacket != NULL)
+          {
+            /* Check that the response came from the expected node, that it's a
+             * response with the same function code (not an exception response), that
+             * the data length is as expected and that it echoes the sub-request.
+             */
+            if ((rxPacket->node != node) ||
+                (rxPacket->pdu.code != TBX_MB_FC21_WRITE_FILE_RECORD) ||
+                (rxPacket->dataLen != (byteCount + 1U)) ||
+                (rxPacket->pdu.data[0] != byteCount) ||
+                (rxPacket->pdu.data[1] != TBX_MB_FILE_REF_TYPE) ||
+                (TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[2]) != file) ||
+                (TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[4]) != chunkRecord) ||
+                (TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[6]) != chunk))
+            {
+              result = TBX_ERROR;
+            }
+          }
+          /* Could not access the response packet. */
+          else
+          {
+            result = TBX_ERROR;
+          }
+          /* Inform the transport layer that were done with the rx packet and no longer
+           * need access to it.
+           */
+          clientCtx->tpCtx->receptionDoneFcn(clientCtx->tpCtx);
+        }
+      }
+      /* Continue with the next range of records. */
+      done += chunk;
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientWriteFileRecord ***/
+
+
+/************************************************************************************//**
+** \brief     Modifies the contents of a holding register on the server with the
+**            specified node address, using an AND mask and an OR mask. The server
+**            calculates the new register value as:
+**            (current value AND andMask) OR (orMask AND (NOT andMask)).
+**            This way individual bits are set or cleared with a single request, instead
+**            of a separate read and write request.
+** \param     channel Handle to the Modbus client channel for the requested operation.
+** \param     node The address of the server. This parameter is transport layer
+**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
+**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
+** \param     addr Element address (0..65535) in the Modbus data table of the holding
+**            register to modify.
+** \param     andMask Bits to keep from the current register value.
+** \param     orMask Bits to set in the register value, for the bits that are cleared
+**            in andMask.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbClientMaskWriteReg(tTbxMbClient channel,
+                                uint8_t      node,
+                                uint16_t     addr,
+                                uint16_t     andMask,
+                                uint16_t     orMask)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify the parameters. */
+  TBX_ASSERT((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX))
+  {
+    /* Convert the client channel pointer to the context structure. */
+    tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
+
+    /* Obtain write access to the request packet. */
+    tTbxMbTpPacket * txPacket = clientCtx->tpCtx->getTxPacketFcn(clientCtx->tpCtx);
+    /* Should always work, unless this function is being called recursively. Only
+     * continue with access for preparing the request packet.
+     */
+    if (txPacket != NULL)
+    {
+      /* Prepare the request packet. */
+      txPacket->node = node;
+      txPacket->pdu.code = TBX_MB_FC22_MASK_WRITE_REGISTER;
+      txPacket->dataLen = 6U;
+      /* Holding register address. */
+      TbxMbCommonStoreUInt16BE(addr, &txPacket->pdu.data[0]);
+      /* AND mask. */
+      TbxMbCommonStoreUInt16BE(andMask, &txPacket->pdu.data[2]);
+      /* OR mask. */
+      TbxMbCommonStoreUInt16BE(orMask, &txPacket->pdu.data[4]);
+
+      /* Determine the request type (broadcast / unicast). */
+      uint8_t isBroadcast = TBX_FALSE;
+      if (node == TBX_MB_TP_NODE_ADDR_BROADCAST)
+      {
+        isBroadcast = TBX_TRUE;
+      }
+      /* Transmit the request and wait for the response to a unicast request to come in
+       * or the turnaround time to pass for a broadcast request.
+       */
+      result = TbxMbClientTransceive(clientCtx, isBroadcast);
+
+      /* Only continue with processing the response if all is okay so far and the request
+       * was unicast.
+       */
+      if ((result == TBX_OK) && (isBroadcast == TBX_FALSE))
+      {
+        /* Obtain read access to the response packet. */
+        tTbxMbTpPacket * rxPacket = clientCtx->tpCtx->getRxPacketFcn(clientCtx->tpCtx);
+        /* Since we just received a response packet, the packet access should always 
+         * succeed. Sanity check anyways, just in case.
+         */
+        TBX_ASSERT(rxPacket != NULL);
+        /* Only continue with packet access. */
+        if (rxPacket != NULL)
+        {
+          /* Check that the response came from the expected node, that it's a response
+           * with the same function code (not an exception response), that it echoes
+           * the register address and masks and that the data length is as expected.
+           */
+          if ((rxPacket->node != node) ||
+              (rxPacket->pdu.code != TBX_MB_FC22_MASK_WRITE_REGISTER) ||
+              (TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]) != addr) ||
+              (TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[2]) != andMask) ||
+              (TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[4]) != orMask) ||
+              (rxPacket->dataLen != 6U))
+          {
+            result = TBX_ERROR;
+          }
+        }
+        /* Could not access the response packet. */
+        else
+        {
+          result = TBX_ERROR;
+        }
+        /* Inform the transport layer that were done with the rx packet and no longer
+         * need access to it.
+         */
+        clientCtx->tpCtx->receptionDoneFcn(clientCtx->tpCtx);
+      }
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientMaskWriteReg ***/
+
+
+/************************************************************************************//**
+** \brief     Writes holding register(s) to and then reads holding register(s) from the
+**            server with the specified node address, using a single request. The server
+**            performs the write operation before the read operation.
+** \param     channel Handle to the Modbus client channel for the requested operation.
+** \param     node The address of the server. This parameter is transport layer
+**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
+**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
+** \param     readAddr Starting element address (0..65535) in the Modbus data table for
+**            the holding register read operation.
+** \param     readNum Number of elements to read from the holding registers data table.
+**            Range can be 1..125
+** \param     readRegs Pointer to array where the read holding register values will be
+**            written to.
+** \param     writeAddr Starting element address (0..65535) in the Modbus data table for
+**            the holding register write operation.
+** \param     writeNum Number of elements to write to the holding registers data table.
+**            Range can be 1..121
+** \param     writeRegs Pointer to array with the desired holding register values.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbClientReadWriteHoldingRegs(tTbxMbClient         channel,
+                                        uint8_t              node,
+                                        uint16_t             readAddr,
+                                        uint8_t              readNum,
+                                        uint16_t           * readRegs,
+                                        uint16_t             writeAddr,
+                                        uint8_t              writeNum,
+                                        uint16_t     const * writeRegs)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify the parameters. */
+  TBX_ASSERT((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) &&
+             (readNum >= 1U) && (readNum <= 125U) && (readRegs != NULL) &&
+             (writeNum >= 1U) && (writeNum <= 121U) && (writeRegs != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) &&
+      (readNum >= 1U) && (readNum <= 125U) && (readRegs != NULL) &&
+      (writeNum >= 1U) && (writeNum <= 121U) && (writeRegs != NULL))
+  {
+    /* Convert the client channel pointer to the context structure. */
+    tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
+
+    /* Obtain write access to the request packet. */
+    tTbxMbTpPacket * txPacket = clientCtx->tpCtx->getTxPacketFcn(clientCtx->tpCtx);
+    /* Should always work, unless this function is being called recursively. Only
+     * continue with access for preparing the request packet.
+     */
+    if (txPacket != NULL)
+    {
+      /* Determine byte count needed for storing the holding register values. */
+      uint8_t byteCount = writeNum * 2U;
+      /* Prepare the request packet. */
+      txPacket->node = node;
+      txPacket->pdu.code = TBX_MB_FC23_READ_WRITE_MULTIPLE_REGISTERS;
+      txPacket->dataLen = byteCount + 9U;
+      /* Read starting address. */
+      TbxMbCommonStoreUInt16BE(readAddr, &txPacket->pdu.data[0]);
+      /* Number of registers to read. */
+      TbxMbCommonStoreUInt16BE(readNum, &txPacket->pdu.data[2]);
+      /* Write starting address. */
+      TbxMbCommonStoreUInt16BE(writeAddr, &txPacket->pdu.data[4]);
+      /* Number of registers to write. */
+      TbxMbCommonStoreUInt16BE(writeNum, &txPacket->pdu.data[6]);
+      /* Byte count. */
+      txPacket->pdu.data[8] = byteCount;
+      /* Set pointer to where the holding registers start in the request. */
+      uint8_t * wrRegValPtr = &txPacket->pdu.data[9];
+      /* Store the holding register values. */
+      for (uint8_t idx = 0U; idx < writeNum; idx++)
+      {
+        TbxMbCommonStoreUInt16BE(writeRegs[idx], &wrRegValPtr[idx * 2U]);
+      }
+
+      /* Determine the request type (broadcast / unicast). */
+      uint8_t isBroadcast = TBX_FALSE;
+      if (node == TBX_MB_TP_NODE_ADDR_BROADCAST)
+      {
+        isBroadcast = TBX_TRUE;
+      }
+      /* Transmit the request and wait for the response to a unicast request to come in
+       * or the turnaround time to pass for a broadcast request.
+       */
+      result = TbxMbClientTransceive(clientCtx, isBroadcast);
+
+      /* Only continue with processing the response if all is okay so far and the request
+       * was unicast.
+       */
+      if ((result == TBX_OK) && (isBroadcast == TBX_FALSE))
+      {
+        /* Obtain read access to the response packet. */
+        tTbxMbTpPacket * rxPacket = clientCtx->tpCtx->getRxPacketFcn(clientCtx->tpCtx);
+        /* Since we just received a response packet, the packet access should always 
+         * succeed. Sanity check anyways, just in case.
+         */
+        TBX_ASSERT(rxPacket != NULL);
+        /* Only continue with packet access. */
+        if (rxPacket != NULL)
+        {
+          /* Check that the response came from the expected node, that it's a response
+           * with the same function code (not an exception response) and that the data
+           * length and the byte count are as expected.
+           */
+          uint8_t rdByteCount = rxPacket->pdu.data[0];
+          if ((rxPacket->node != node) ||
+              (rxPacket->pdu.code != TBX_MB_FC23_READ_WRITE_MULTIPLE_REGISTERS) ||
+              (rdByteCount != (readNum * 2U)) ||
+              (rxPacket->dataLen != (rdByteCount + 1U)) )
+          {
+            result = TBX_ERROR;
+          }
+          /* Response content valid. Process its data. */
+          else
+          {
+            /* Set pointer to where the holding registers start in the response. */
+            uint8_t const * rdRegValPtr = &rxPacket->pdu.data[1];
+            /* Read out and store the holding register values. */
+            for (uint8_t idx = 0U; idx < readNum; idx++)
+            {
+              readRegs[idx] = TbxMbCommonExtractUInt16BE(&rdRegValPtr[idx * 2U]);
+            }
+          }
+        }
+        /* Could not access the response packet. */
+        else
+        {
+          result = TBX_ERROR;
+        }
+        /* Inform the transport layer that were done with the rx packet and no longer
+         * need access to it.
+         */
+        clientCtx->tpCtx->receptionDoneFcn(clientCtx->tpCtx);
+      }
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientReadWriteHoldingRegs ***/
+
+
+/************************************************************************************//**
+** \brief     Reads the values from the FIFO queue of the server with the specified node
+**            address. A single request reads up to TBX_MB_FIFO_COUNT_MAX values. A
+**            MicroTBX-Modbus server removes the values that it sends from its queue,
+**            such that you drain the queue by calling this function until count is zero.
+** \param     channel Handle to the Modbus client channel for the requested operation.
+** \param     node The address of the server. This parameter is transport layer
+**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
+**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
+** \param     addr FIFO pointer address (0..65535) of the FIFO queue.
+** \param     values Pointer to array where the FIFO queue values will be written to. It
+**            must have space for at least TBX_MB_FIFO_COUNT_MAX values.
+** \param     count Pointer to where the number of read FIFO queue values will be written
+**            to.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbClientReadFifo(tTbxMbClient   channel,
+                            uint8_t        node,
+                            uint16_t       addr,
+                            uint16_t     * values,
+                            uint8_t      * count)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify the parameters. */
+  TBX_ASSERT((channel != NULL) && (node >= TBX_MB_TP_NODE_ADDR_MIN) &&
+             (node <= TBX_MB_TP_NODE_ADDR_MAX) && (values != NULL) && (count != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (node >= TBX_MB_TP_NODE_ADDR_MIN) &&
+      (node <= TBX_MB_TP_NODE_ADDR_MAX) && (values != NULL) && (count != NULL))
+  {
+    /* Convert the client channel pointer to the context structure. */
+    tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
+
+    /* Obtain write access to the request packet. */
+    tTbxMbTpPacket * txPacket = clientCtx->tpCtx->getTxPacketFcn(clientCtx->tpCtx);
+    /* Should always work, unless this function is being called recursively. Only
+     * continue with access for preparing the request packet.
+     */
+    if (txPacket != NULL)
+    {
+      /* Prepare the request packet. */
+      txPacket->node = node;
+      txPacket->pdu.code = TBX_MB_FC24_READ_FIFO_QUEUE;
+      txPacket->dataLen = 2U;
+      /* FIFO pointer address. */
+      TbxMbCommonStoreUInt16BE(addr, &txPacket->pdu.data[0]);
+      /* Transmit the request and wait for the response to come in. */
+      result = TbxMbClientTransceive(clientCtx, TBX_FALSE);
+
+      /* Only continue with processing the response if all is okay so far. */
+      if (result == TBX_OK)
+      {
+        /* Obtain read access to the response packet. */
+        tTbxMbTpPacket * rxPacket = clientCtx->tpCtx->getRxPacketFcn(clientCtx->tpCtx);
+        /* Since we just received a response packet, the packet access should always 
+         * succeed. Sanity check anyways, just in case.
+         */
+        TBX_ASSERT(rxPacket != NULL);
+        /* Only continue with packet access. */
+        if (rxPacket != NULL)
+        {
+          /* Check that the response came from the expected node, that it's a response
+           * with the same function code (not an exception response) and that the FIFO
+           * count, the byte count and the data length are as expected.
+           */
+          uint16_t byteCount = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]);
+          uint16_t fifoCount = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[2]);
+          if ((rxPacket->node != node) ||
+              (rxPacket->pdu.code != TBX_MB_FC24_READ_FIFO_QUEUE) ||
+              (rxPacket->dataLen < 4U) ||
+              (fifoCount > TBX_MB_FIFO_COUNT_MAX) ||
+              (byteCount != ((fifoCount * 2U) + 2U)) ||
+              (rxPacket->dataLen != (byteCount + 2U)))
+          {
+            result = TBX_ERROR;
+          }
+          /* Response content valid. Process its data. */
+          else
+          {
+            /* Set pointer to where the FIFO queue values start in the response. */
+            uint8_t const * fifoValPtr = &rxPacket->pdu.data[4];
+            /* Read out and store the FIFO queue values. */
+            for (uint8_t idx = 0U; idx < fifoCount; idx++)
+            {
+              values[idx] = TbxMbCommonExtractUInt16BE(&fifoValPtr[idx * 2U]);
+            }
+            *count = (uint8_t)fifoCount;
+          }
+        }
+        /* Could not access the response packet. */
+        else
+        {
+          result = TBX_ERROR;
+        }
+        /* Inform the transport layer that were done with the rx packet and no longer
+         * need access to it.
+         */
+        clientCtx->tpCtx->receptionDoneFcn(clientCtx->tpCtx);
+      }
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientReadFifo ***/
+
+
+/************************************************************************************//**
+** \brief     Perform diagnostic operation on the server for checking the communication
+**            system.
+** \param     channel Handle to the Modbus client channel for the requested operation.
+** \param     node The address of the server. This parameter is transport layer
+**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
+**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
+** \param     subcode Sub-function code for specifying the diagnostic operation to
+**            perform. Currently supported values:
+**              - TBX_MB_DIAG_SC_QUERY_DATA
+**              - TBX_MB_DIAG_SC_CLEAR_COUNTERS
+**              - TBX_MB_DIAG_SC_BUS_MESSAGE_COUNT
+**              - TBX_MB_DIAG_SC_BUS_COMM_ERROR_COUNT
+**              - TBX_MB_DIAG_SC_BUS_EXCEPTION_ERROR_COUNT
+**              - TBX_MB_DIAG_SC_SERVER_MESSAGE_COUNT
+**              - TBX_MB_DIAG_SC_SERVER_NO_RESPONSE_COUNT
+** \param     count Location where the retrieved count value will be written to. Only
+**            applicable for the subcodes that end with _COUNT.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbClientDiagnostics(tTbxMbClient   channel,
+                               uint8_t        node,
+                               uint16_t       subcode,
+                               uint16_t     * count)
+{
+  uint8_t        result      = TBX_ERROR;
+  uint16_t const queryData[] = { 0xFFFFU, 0x0000U, 0xAA55U, 0x55AAU, 0x3723U };
+
+  /* Verify the parameters. */
+  TBX_ASSERT((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && 
+             ((subcode == TBX_MB_DIAG_SC_QUERY_DATA) || 
+              (subcode == TBX_MB_DIAG_SC_CLEAR_COUNTERS) ||
+              (subcode == TBX_MB_DIAG_SC_BUS_MESSAGE_COUNT) ||
+              (subcode == TBX_MB_DIAG_SC_BUS_COMM_ERROR_COUNT) ||
+              (subcode == TBX_MB_DIAG_SC_BUS_EXCEPTION_ERROR_COUNT) ||
+              (subcode == TBX_MB_DIAG_SC_SERVER_MESSAGE_COUNT) ||
+              (subcode == TBX_MB_DIAG_SC_SERVER_NO_RESPONSE_COUNT)));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (node <= TBX_MB_TP_NODE_ADDR_MAX) && 
+      ((subcode == TBX_MB_DIAG_SC_QUERY_DATA) || 
+       (subcode == TBX_MB_DIAG_SC_CLEAR_COUNTERS) ||
+       (subcode == TBX_MB_DIAG_SC_BUS_MESSAGE_COUNT) ||
+       (subcode == TBX_MB_DIAG_SC_BUS_COMM_ERROR_COUNT) ||
+       (subcode == TBX_MB_DIAG_SC_BUS_EXCEPTION_ERROR_COUNT) ||
+       (subcode == TBX_MB_DIAG_SC_SERVER_MESSAGE_COUNT) ||
+       (subcode == TBX_MB_DIAG_SC_SERVER_NO_RESPONSE_COUNT)))
+  {
+    /* Convert the client channel pointer to the context structure. */
+    tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
+
+    /* Obtain write access to the request packet. */
+    tTbxMbTpPacket * txPacket = clientCtx->tpCtx->getTxPacketFcn(clientCtx->tpCtx);
+    /* Should always work, unless this function is being called recursively. Only
+     * continue with access for preparing the request packet.
+     */
+    if (txPacket != NULL)
+    {
+      /* Prepare the request packet. */
+      txPacket->node = node;
+      txPacket->pdu.code = TBX_MB_FC08_DIAGNOSTICS;
+      TbxMbCommonStoreUInt16BE(subcode, &txPacket->pdu.data[0]);
+      /* Requested to perform a query data diagnostic operation? */
+      if (subcode == TBX_MB_DIAG_SC_QUERY_DATA)
+      {
+        /* Write the query data for loopback testing. */
+        for (uint8_t idx = 0U; idx < (sizeof(queryData)/sizeof(queryData[0])); idx++)
+        {
+          TbxMbCommonStoreUInt16BE(queryData[idx], &txPacket->pdu.data[2U + (idx * 2U)]);
+        }
+        txPacket->dataLen = ((sizeof(queryData) / sizeof(queryData[0])) * 2U) + 2U;
+      }
+      /* All other supported subcodes require a 16-bit zero value data field. */
+      else
+      {
+        /* Store the data field as per the protocol. */
+        TbxMbCommonStoreUInt16BE(0x0000U, &txPacket->pdu.data[2U]);
+        txPacket->dataLen = 4U;
+      }
+
+      /* Determine the request type (broadcast / unicast). */
+      uint8_t isBroadcast = TBX_FALSE;
+      if (node == TBX_MB_TP_NODE_ADDR_BROADCAST)
+      {
+        isBroadcast = TBX_TRUE;
+      }
+      /* Transmit the request and wait for the response to a unicast request to come in
+       * or the turnaround time to pass for a broadcast request.
+       */
+      result = TbxMbClientTransceive(clientCtx, isBroadcast);
+
+      /* Only continue with processing the response if all is okay so far and the request
+       * was unicast.
+       */
+      if ((result == TBX_OK) && (isBroadcast == TBX_FALSE))
+      {
+        /* Obtain read access to the response packet. */
+        tTbxMbTpPacket * rxPacket = clientCtx->tpCtx->getRxPacketFcn(clientCtx->tpCtx);
+        /* Since we just received a response packet, the packet access should always 
+         * succeed. Sanity check anyways, just in case.
+         */
+        TBX_ASSERT(rxPacket != NULL);
+        /* Only continue with packet access. */
+        if (rxPacket != NULL)
+        {
+          /* Check that the response came from the expected node, that it's a response
+           * with the same function code (not an exception response) and that it's a
+           * response with the same function sub-code.
+           */
+          if ((rxPacket->node != node) ||
+              (rxPacket->pdu.code != TBX_MB_FC08_DIAGNOSTICS) ||
+              (TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]) != subcode))
+          {
+            result = TBX_ERROR;
+          }
+          /* Response looks valid so far. Continue with processing its data.*/
+          else
+          {
+            if (subcode == TBX_MB_DIAG_SC_QUERY_DATA)
+            {
+              const uint8_t queryDataLen = sizeof(queryData) / sizeof(queryData[0]);
               /* Check the data length. */
               if (rxPacket->dataLen != ((queryDataLen * 2U) + 2U))
               {
@@ -1368,6 +2369,181 @@ uint8_t TbxMbClientDiagnostics(tTbxMbClient   channel,
 } /*** end of TbxMbClientDiagnostics ***/
 
 
+/************************************************************************************//**
+** \brief     Reads the device identification objects from the server with the
+**            specified node address. If the objects do not fit in a single response, the
+**            server flags that more follows. This function then automatically continues
+**            with follow-up requests, until all objects of the requested category are
+**            read.
+** \details   The objects are stored in the same format as in the response: one byte
+**            with the object id, one byte with the length of the object value and then
+**            the bytes of the object value.
+** \param     channel Handle to the Modbus client channel for the requested operation.
+** \param     node The address of the server. This parameter is transport layer
+**            dependent. It is needed on RTU/ASCII, yet don't care for TCP unless it is
+**            a gateway to an RTU network. If it's don't care, set it to a value of 1.
+** \param     code Read device identification code (TBX_MB_DEVID_CODE_xxx).
+** \param     objectId Id of the object to start reading at. Typically 0 for the stream
+**            access codes. For TBX_MB_DEVID_CODE_SPECIFIC, it is the id of the object to
+**            read.
+** \param     objects Pointer to the byte array where the objects will be written to.
+** \param     len Pointer to the size of the objects array. This function overwrites it
+**            with the number of bytes that it actually wrote to the objects array.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbClientReadDeviceId(tTbxMbClient   channel,
+                                uint8_t        node,
+                                uint8_t        code,
+                                uint8_t        objectId,
+                                uint8_t      * objects,
+                                uint16_t     * len)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify the parameters. */
+  TBX_ASSERT((channel != NULL) && (node >= TBX_MB_TP_NODE_ADDR_MIN) &&
+             (node <= TBX_MB_TP_NODE_ADDR_MAX) && (code >= TBX_MB_DEVID_CODE_BASIC) &&
+             (code <= TBX_MB_DEVID_CODE_SPECIFIC) && (objects != NULL) && (len != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (node >= TBX_MB_TP_NODE_ADDR_MIN) &&
+      (node <= TBX_MB_TP_NODE_ADDR_MAX) && (code >= TBX_MB_DEVID_CODE_BASIC) &&
+      (code <= TBX_MB_DEVID_CODE_SPECIFIC) && (objects != NULL) && (len != NULL))
+  {
+    /* Convert the client channel pointer to the context structure. */
+    tTbxMbClientCtx * clientCtx = (tTbxMbClientCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(clientCtx->type == TBX_MB_CLIENT_CONTEXT_TYPE);
+
+    uint16_t bufSize     = *len;
+    uint16_t bufIdx      = 0U;
+    uint8_t  moreFollows = TBX_TRUE;
+    uint8_t  nextId      = objectId;
+    /* Assume success until proven otherwise. */
+    result = TBX_OK;
+    /* Keep sending requests, as long as the server reports that more follows. */
+    while ((moreFollows == TBX_TRUE) && (result == TBX_OK))
+    {
+      /* Obtain write access to the request packet. */
+      tTbxMbTpPacket * txPacket = clientCtx->tpCtx->getTxPacketFcn(clientCtx->tpCtx);
+      /* Should always work, unless this function is being called recursively. */
+      if (txPacket == NULL)
+      {
+        result = TBX_ERROR;
+      }
+      else
+      {
+        uint8_t requestedId = nextId;
+        /* Prepare the request packet. */
+        txPacket->node = node;
+        txPacket->pdu.code = TBX_MB_FC43_ENCAPSULATED_INTERFACE;
+        txPacket->dataLen = 3U;
+        txPacket->pdu.data[0] = TBX_MB_MEI_READ_DEVICE_ID;
+        txPacket->pdu.data[1] = code;
+        txPacket->pdu.data[2] = requestedId;
+        /* Transmit the request and wait for the response to come in. */
+        result = TbxMbClientTransceive(clientCtx, TBX_FALSE);
+
+        /* Only continue with processing the response if all is okay so far. */
+        if (result == TBX_OK)
+        {
+          /* Obtain read access to the response packet. */
+          tTbxMbTpPacket * rxPacket = clientCtx->tpCtx->getRxPacketFcn(clientCtx->tpCtx);
+          /* Since we just received a response packet, the packet access should always
+           * succeed. Sanity check anyways, just in case.
+           */
+          TBX_ASSERT(rxPacket != NULL);
+          /* Only continue with packet access. */
+          if (rxPacket != NULL)
+          {
+            /* Check that the response came from the expected node, that it's a
+             * response with the same function code (not an exception response), MEI
+             * type and read device identification code and that it holds at least the
+             * response header.
+             */
+            if ((rxPacket->node != node) ||
+                (rxPacket->pdu.code != TBX_MB_FC43_ENCAPSULATED_INTERFACE) ||
+                (rxPacket->dataLen < 6U) ||
+                (rxPacket->pdu.data[0] != TBX_MB_MEI_READ_DEVICE_ID) ||
+                (rxPacket->pdu.data[1] != code))
+            {
+              result = TBX_ERROR;
+            }
+            /* Response header valid. Process its objects. */
+            else
+            {
+              uint8_t numObjects = rxPacket->pdu.data[5];
+              uint8_t dataIdx    = 6U;
+              /* Copy the objects, until all are processed or an error is detected. */
+              for (uint8_t objIdx = 0U; (objIdx < numObjects) && (result == TBX_OK);
+                   objIdx++)
+              {
+                /* Determine the total object size, including its id and length. */
+                uint16_t objSize = 2U;
+                if ((dataIdx + 1U) < rxPacket->dataLen)
+                {
+                  objSize += rxPacket->pdu.data[dataIdx + 1U];
+                }
+                /* Object must be completely in the response and fit in the buffer. */
+                if (((dataIdx + objSize) > rxPacket->dataLen) ||
+                    ((bufIdx + objSize) > bufSize))
+                {
+                  result = TBX_ERROR;
+                }
+                else
+                {
+                  /* Copy the object. */
+                  for (uint16_t byteIdx = 0U; byteIdx < objSize; byteIdx++)
+                  {
+                    objects[bufIdx + byteIdx] = rxPacket->pdu.data[dataIdx + byteIdx];
+                  }
+                  bufIdx += objSize;
+                  dataIdx += (uint8_t)objSize;
+                }
+              }
+              /* Determine if more follows and where to continue. Only possible for the
+               * stream access codes.
+               */
+              moreFollows = TBX_FALSE;
+              if ((rxPacket->pdu.data[3] == 0xFFU) &&
+                  (code != TBX_MB_DEVID_CODE_SPECIFIC))
+              {
+                moreFollows = TBX_TRUE;
+                nextId = rxPacket->pdu.data[4];
+                /* The next object must come after the one just requested. Otherwise
+                 * the server would make us loop forever.
+                 */
+                if (nextId <= requestedId)
+                {
+                  result = TBX_ERROR;
+                }
+              }
+            }
+          }
+          /* Could not access the response packet. */
+          else
+          {
+            result = TBX_ERROR;
+          }
+          /* Inform the transport layer that were done with the rx packet and no longer
+           * need access to it.
+           */
+          clientCtx->tpCtx->receptionDoneFcn(clientCtx->tpCtx);
+        }
+      }
+    }
+    /* Store the number of bytes written to the objects array. */
+    if (result == TBX_OK)
+    {
+      *len = bufIdx;
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbClientReadDeviceId ***/
+
+
 /************************************************************************************//**
 ** \brief     Send a custom function code PDU to the server and receive its response PDU.
 **            Thanks to this functionality, the user can support Modbus function codes
@@ -46,58 +46,118 @@ typedef void * tTbxMbClient;
 /****************************************************************************************
 * Function prototypes
 ****************************************************************************************/
-tTbxMbClient TbxMbClientCreate          (tTbxMbTp             transport,
-                                         uint16_t             responseTimeout,
-                                         uint16_t             turnaroundDelay);
-
-void         TbxMbClientFree            (tTbxMbClient         channel);
-
-uint8_t      TbxMbClientReadCoils       (tTbxMbClient         channel,
-                                         uint8_t              node,
-                                         uint16_t             addr,
-                                         uint16_t             num,
-                                         uint8_t            * coils);
-
-uint8_t      TbxMbClientReadInputs      (tTbxMbClient         channel,
-                                         uint8_t              node,
-                                         uint16_t             addr,
-                                         uint16_t             num,
-                                         uint8_t            * inputs);
-
-uint8_t      TbxMbClientReadInputRegs   (tTbxMbClient         channel,
-                                         uint8_t              node,
-                                         uint16_t             addr,
-                                         uint8_t              num,
-                                         uint16_t           * inputRegs);
-
-uint8_t      TbxMbClientReadHoldingRegs (tTbxMbClient         channel,
-                                         uint8_t              node,
-                                         uint16_t             addr,
-                                         uint8_t              num,
-                                         uint16_t           * holdingRegs);
-
-uint8_t      TbxMbClientWriteCoils      (tTbxMbClient         channel,
-                                         uint8_t              node,
-                                         uint16_t             addr,
-                                         uint16_t             num,
-                                         uint8_t      const * coils);
-
-uint8_t      TbxMbClientWriteHoldingRegs(tTbxMbClient         channel,
-                                         uint8_t              node,
-                                         uint16_t             addr,
-                                         uint8_t              num,
-                                         uint16_t     const * holdingRegs);
-
-uint8_t      TbxMbClientDiagnostics     (tTbxMbClient         channel,
-                                         uint8_t              node,
-                                         uint16_t             subcode,
-                                         uint16_t           * count);
-
-uint8_t      TbxMbClientCustomFunction  (tTbxMbClient         channel,
-                                         uint8_t              node,
-                                         uint8_t      const * txPdu,
-                                         uint8_t            * rxPdu,
-                                         uint8_t            * len);
+tTbxMbClient TbxMbClientCreate              (tTbxMbTp             transport,
+                                             uint16_t             responseTimeout,
+                                             uint16_t             turnaroundDelay);
+
+void         TbxMbClientFree                (tTbxMbClient         channel);
+
+uint8_t      TbxMbClientReadCoils           (tTbxMbClient         channel,
+                                             uint8_t              node,
+                                             uint16_t             addr,
+                                             uint16_t             num,
+                                             uint8_t            * coils);
+
+uint8_t      TbxMbClientReadInputs          (tTbxMbClient         channel,
+                                             uint8_t              node,
+                                             uint16_t             addr,
+                                             uint16_t             num,
+                                             uint8_t            * inputs);
+
+uint8_t      TbxMbClientReadInputRegs       (tTbxMbClient         channel,
+                                             uint8_t              node,
+                                             uint16_t             addr,
+                                             uint8_t              num,
+                                             uint16_t           * inputRegs);
+
+uint8_t      TbxMbClientReadHoldingRegs     (tTbxMbClient         channel,
+                                             uint8_t              node,
+                                             uint16_t             addr,
+                                             uint8_t              num,
+                                             uint16_t           * holdingRegs);
+
+uint8_t      TbxMbClientWriteCoils          (tTbxMbClient         channel,
+                                             uint8_t              node,
+                                             uint16_t             addr,
+                                             uint16_t             num,
+                                             uint8_t      const * coils);
+
+uint8_t      TbxMbClientWriteHoldingRegs    (tTbxMbClient         channel,
+                                             uint8_t              node,
+                                             uint16_t             addr,
+                                             uint8_t              num,
+                                             uint16_t     const * holdingRegs);
+
+uint8_t      TbxMbClientReadCoilsPacked     (tTbxMbClient         channel,
+                                             uint8_t              node,
+                                             uint16_t             addr,
+                                             uint16_t             num,
+                                             uint8_t            * bits);
+
+uint8_t      TbxMbClientReadInputsPacked    (tTbxMbClient         channel,
+                                             uint8_t              node,
+                                             uint16_t             addr,
+                                             uint16_t             num,
+                                             uint8_t            * bits);
+
+uint8_t      TbxMbClientWriteCoilsPacked    (tTbxMbClient         channel,
+                                             uint8_t              node,
+                                             uint16_t             addr,
+                                             uint16_t             num,
+                                             uint8_t      const * bits);
+
+uint8_t      TbxMbClientReadFileRecord      (tTbxMbClient         channel,
+                                             uint8_t              node,
+                                             uint16_t             file,
+                                             uint16_t             record,
+                                             uint16_t             num,
+                                             uint16_t           * values);
+
+uint8_t      TbxMbClientWriteFileRecord     (tTbxMbClient         channel,
+                                             uint8_t              node,
+                                             uint16_t             file,
+                                             uint16_t             record,
+                                             uint16_t             num,
+                                             uint16_t     const * values);
+
+uint8_t      TbxMbClientMaskWriteReg        (tTbxMbClient         channel,
+                                             uint8_t              node,
+                                             uint16_t             addr,
+                                             uint16_t             andMask,
+                                             uint16_t             orMask);
+
+uint8_t      TbxMbClientReadWriteHoldingRegs(tTbxMbClient         channel,
+                                             uint8_t              node,
+                                             uint16_t             readAddr,
+                                             uint8_t              readNum,
+                                             uint16_t           * readRegs,
+                                             uint16_t             writeAddr,
+                                             uint8_t              writeNum,
+                                             uint16_t     const * writeRegs);
+
+uint8_t      TbxMbClientReadFifo            (tTbxMbClient         channel,
+                                             uint8_t              node,
+                                             uint16_t             addr,
+                                             uint16_t           * values,
+                                             uint8_t            * count);
+
+uint8_t      TbxMbClientDiagnostics         (tTbxMbClient         channel,
+                                             uint8_t              node,
+                                             uint16_t             subcode,
+                                             uint16_t           * count);
+
+uint8_t      TbxMbClientReadDeviceId        (tTbxMbClient         channel,
+                                             uint8_t              node,
+                                             uint8_t              code,
+                                             uint8_t              objectId,
+                                             uint8_t            * objects,
+                                             uint16_t           * len);
+
+uint8_t      TbxMbClientCustomFunction      (tTbxMbClient         channel,
+                                             uint8_t              node,
+                                             uint8_t      const * txPdu,
+                                             uint8_t            * rxPdu,
+                                             uint8_t            * len);
 
 
 #ifdef __cplusplus
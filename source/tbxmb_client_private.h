@@ -38,13 +38,14 @@ extern "C" {
 * Type definitions
 ****************************************************************************************/
 /** \brief Modbus client channel interface function to detect events in a polling
- *         manner.
+ *         manner. It returns the free running timer tick count at which it wants to be
+ *         called again.
  */
-typedef void (* tTbxMbClientPoll)   (void        * context);
+typedef uint16_t (* tTbxMbClientPoll)   (void        * context);
 
 
 /** \brief Modbus client channel  interface function for processing events. */
-typedef void (* tTbxMbClientProcess)(tTbxMbEvent * event);
+typedef void     (* tTbxMbClientProcess)(tTbxMbEvent * event);
 
 
 /** \brief Modbus client channel layer context that groups all channel specific data. 
@@ -52,19 +53,22 @@ typedef void (* tTbxMbClientProcess)(tTbxMbEvent * event);
  */
 typedef struct
 {
-  /* Event interface methods. The following three entries must always be at the start
+  /* Event interface methods. The following five entries must always be at the start
    * and exactly match those in tTbxMbEventCtx. Think of it as the base that this struct
    * derives from. 
    */
   void               * instancePtr;              /**< Reserved for C++ wrapper.        */
   tTbxMbClientPoll     pollFcn;                  /**< Event poll function.             */
   tTbxMbClientProcess  processFcn;               /**< Event process function.          */
+  tTbxMbTimer          pollTimer;                /**< Event poll function timer.       */
+  tTbxMbEventLoop      eventLoop;                /**< Event loop it is bound to.       */
   /* Private members. */
   uint8_t              type;                     /**< Context type.                    */
   tTbxMbTpCtx        * tpCtx;                    /**< Assigned transport layer context.*/
   uint16_t             responseTimeout;          /**< Maximum response wait time (ms). */
   uint16_t             turnaroundDelay;          /**< Delay (ms) after broadcast PDU.  */
-  tTbxMbOsalSem        transceiveSem;            /**< PDU transmit/receive semaphore.  */
+  tTbxMbOsalSem        txSem;                    /**< PDU transmitted semaphore.       */
+  tTbxMbOsalSem        rxSem;                    /**< PDU received semaphore.          */
 } tTbxMbClientCtx;
 
 
@@ -65,6 +65,24 @@ extern "C" {
 /** \brief Modbus function code 16 - Write Multiple Registers. */
 #define TBX_MB_FC16_WRITE_MULTIPLE_REGISTERS          (16U)
 
+/** \brief Modbus function code 20 - Read File Record. */
+#define TBX_MB_FC20_READ_FILE_RECORD                  (20U)
+
+/** \brief Modbus function code 21 - Write File Record. */
+#define TBX_MB_FC21_WRITE_FILE_RECORD                 (21U)
+
+/** \brief Modbus function code 22 - Mask Write Register. */
+#define TBX_MB_FC22_MASK_WRITE_REGISTER               (22U)
+
+/** \brief Modbus function code 23 - Read/Write Multiple Registers. */
+#define TBX_MB_FC23_READ_WRITE_MULTIPLE_REGISTERS     (23U)
+
+/** \brief Modbus function code 24 - Read FIFO Queue. */
+#define TBX_MB_FC24_READ_FIFO_QUEUE                   (24U)
+
+
+/** \brief Modbus function code 43 - Encapsulated Interface Transport. */
+#define TBX_MB_FC43_ENCAPSULATED_INTERFACE            (43U)
 
 /* ------------------------- Exception codes ----------------------------------------- */
 /** \brief Modbus exception code 01 - Illegal function. */
@@ -103,6 +121,62 @@ extern "C" {
 #define TBX_MB_DIAG_SC_SERVER_NO_RESPONSE_COUNT       (15U)
 
 
+
+/* ------------------------- Encapsulated interface MEI types ------------------------ */
+/** \brief MEI type for function code 43 - Read Device Identification. */
+#define TBX_MB_MEI_READ_DEVICE_ID                     (14U)
+
+
+/* ------------------------- File record access -------------------------------------- */
+/** \brief Reference type of a file record sub-request. Always 6. */
+#define TBX_MB_FILE_REF_TYPE                          (6U)
+
+/** \brief Highest record number that a file record sub-request can address. */
+#define TBX_MB_FILE_RECORD_NUM_MAX                    (9999U)
+
+
+/* ------------------------- FIFO queue ---------------------------------------------- */
+/** \brief Maximum number of FIFO queue values in a single read FIFO queue response. */
+#define TBX_MB_FIFO_COUNT_MAX                         (31U)
+
+
+/* ------------------------- Read device identification codes ----------------------- */
+/** \brief Read device identification code - Basic device identification (stream). */
+#define TBX_MB_DEVID_CODE_BASIC                       (1U)
+
+/** \brief Read device identification code - Regular device identification (stream). */
+#define TBX_MB_DEVID_CODE_REGULAR                     (2U)
+
+/** \brief Read device identification code - Extended device identification (stream). */
+#define TBX_MB_DEVID_CODE_EXTENDED                    (3U)
+
+/** \brief Read device identification code - One specific identification object. */
+#define TBX_MB_DEVID_CODE_SPECIFIC                    (4U)
+
+
+/* ------------------------- Device identification object ids ----------------------- */
+/** \brief Device identification object id - Vendor name (basic, mandatory). */
+#define TBX_MB_DEVID_OBJ_VENDOR_NAME                  (0x00U)
+
+/** \brief Device identification object id - Product code (basic, mandatory). */
+#define TBX_MB_DEVID_OBJ_PRODUCT_CODE                 (0x01U)
+
+/** \brief Device identification object id - Major minor revision (basic, mandatory). */
+#define TBX_MB_DEVID_OBJ_MAJOR_MINOR_REVISION         (0x02U)
+
+/** \brief Device identification object id - Vendor URL (regular, optional). */
+#define TBX_MB_DEVID_OBJ_VENDOR_URL                   (0x03U)
+
+/** \brief Device identification object id - Product name (regular, optional). */
+#define TBX_MB_DEVID_OBJ_PRODUCT_NAME                 (0x04U)
+
+/** \brief Device identification object id - Model name (regular, optional). */
+#define TBX_MB_DEVID_OBJ_MODEL_NAME                   (0x05U)
+
+/** \brief Device identification object id - User application name (regular, optional).
+ */
+#define TBX_MB_DEVID_OBJ_USER_APP_NAME                (0x06U)
+
 /* ------------------------- Bit masks ----------------------------------------------- */
 /** \brief Bit mask to OR to the function code to flag it as an exception response. */
 #define TBX_MB_FC_EXCEPTION_MASK                      (0x80U)
@@ -147,6 +221,63 @@ static inline void TbxMbCommonStoreUInt16BE(uint16_t   value,
 } /*** end of TbxMbCommonExtractUInt16BE ***/
 
 
+/************************************************************************************//**
+** \brief     Helper function to copy a range of bits from one packed bit array to
+**            another one. Packed bit arrays store their bits in the same way as Modbus
+**            packets do: bit 0 of byte 0 holds the first element, bit 1 of byte 0 the
+**            second one, and so on. The copy operates on complete chunks of bits, with
+**            the help of shift operations. This avoids looping over the bits one at a
+**            time, also when the start bits are not byte aligned. Bits in the
+**            destination that are outside of the range stay unchanged.
+** \param     dst Pointer to the destination bit array.
+** \param     dstBit Index of the first bit in the destination bit array.
+** \param     src Pointer to the source bit array.
+** \param     srcBit Index of the first bit in the source bit array.
+** \param     num Number of bits to copy.
+**
+****************************************************************************************/
+static inline void TbxMbCommonCopyBits(uint8_t       * dst,
+                                       uint32_t        dstBit,
+                                       uint8_t const * src,
+                                       uint32_t        srcBit,
+                                       uint32_t        num)
+{
+  uint32_t dstIdx = dstBit;
+  uint32_t srcIdx = srcBit;
+  uint32_t remain = num;
+
+  /* Copy one chunk of bits at a time, such that it fits in a destination byte. */
+  while (remain > 0U)
+  {
+    uint8_t  dstOffset = (uint8_t)(dstIdx % 8U);
+    uint8_t  srcOffset = (uint8_t)(srcIdx % 8U);
+    uint32_t srcByte   = srcIdx / 8U;
+    /* Determine the number of bits until the end of the current destination byte. */
+    uint8_t  chunkLen  = 8U - dstOffset;
+    if (chunkLen > remain)
+    {
+      chunkLen = (uint8_t)remain;
+    }
+    /* Collect the bits of this chunk from the source, shifted down to bit 0. Only read
+     * the next source byte if the chunk actually continues in there.
+     */
+    uint16_t bits = (uint16_t)src[srcByte] >> srcOffset;
+    if ((srcOffset + chunkLen) > 8U)
+    {
+      bits |= (uint16_t)src[srcByte + 1U] << (8U - srcOffset);
+    }
+    /* Merge the chunk into the destination byte. */
+    uint8_t mask = (uint8_t)(((1U << chunkLen) - 1U) << dstOffset);
+    dst[dstIdx / 8U] = (uint8_t)((dst[dstIdx / 8U] & (uint8_t)~mask) |
+                                 ((uint8_t)(bits << dstOffset) & mask));
+    /* Move on to the next chunk. */
+    dstIdx += chunkLen;
+    srcIdx += chunkLen;
+    remain -= chunkLen;
+  }
+} /*** end of TbxMbCommonCopyBits ***/
+
+
 
 
 #ifdef __cplusplus
@@ -35,17 +35,44 @@
 #include "microtbxmodbus.h"                      /* MicroTBX-Modbus module             */
 #include "tbxmb_event_private.h"                 /* MicroTBX-Modbus event private      */
 #include "tbxmb_osal_private.h"                  /* MicroTBX-Modbus OSAL private       */
+#include "tbxmb_timer_private.h"                 /* MicroTBX-Modbus timer private      */
+#include "tbxmb_tp_private.h"                    /* MicroTBX-Modbus TP private         */
+
+
+/****************************************************************************************
+* Macro definitions
+****************************************************************************************/
+/** \brief Time in milliseconds to wait for a new event, when no polling function has a
+ *         pending deadline.
+ */
+#define TBX_MB_EVENT_WAIT_DEFAULT_MS   (5000U)
+
+/** \brief Unique context type to identify a context as being an event loop. */
+#define TBX_MB_EVENT_LOOP_CONTEXT_TYPE (93U)
+
+#ifndef TBX_MB_EVENT_BATCH_SIZE
+/** \brief Configure the maximum number of events that the task function of an event loop
+ *         retrieves and processes per call. A larger value drains a burst of events in
+ *         fewer calls, at the cost of some extra stack space for the retrieved events.
+ *         Set it to 1 to process just one event per call. If a different batch size is
+ *         desired, you can override this configuration by adding a macro with the same
+ *         name, but a different value, to "tbx_conf.h".
+ */
+#define TBX_MB_EVENT_BATCH_SIZE        (4U)
+#endif
 
 
 /****************************************************************************************
 * Type definitions
 ****************************************************************************************/
-/** \brief Event task interface function to detect events in a polling manner. */
-typedef void (* tTbxMbEventPoll)   (void        * context);
+/** \brief Event task interface function to detect events in a polling manner. It returns
+ *         the free running timer tick count at which it wants to be called again.
+ */
+typedef uint16_t (* tTbxMbEventPoll)   (void        * context);
 
 
 /** \brief Event processor interface function for processing events. */
-typedef void (* tTbxMbEventProcess)(tTbxMbEvent * event);
+typedef void     (* tTbxMbEventProcess)(tTbxMbEvent * event);
 
 
 /** \brief Minimal context for accessing the event poll and process functions. Think of
@@ -55,15 +82,58 @@ typedef void (* tTbxMbEventProcess)(tTbxMbEvent * event);
  */
 typedef struct
 {
-  /* The following three entries must always be at the start and not change order. They
+  /* The following five entries must always be at the start and not change order. They
    * form the base that other context derive from.
    */
   void               * instancePtr;              /**< Reserved for C++ wrapper.        */
   tTbxMbEventPoll      pollFcn;                  /**< Event poll function.             */
   tTbxMbEventProcess   processFcn;               /**< Event process function.          */
+  tTbxMbTimer          pollTimer;                /**< Event poll function timer.       */
+  tTbxMbEventLoop      eventLoop;                /**< Event loop it is bound to.       */
 } tTbxMbEventCtx;
 
 
+/** \brief Event loop context that groups all event loop specific data. It's what the
+ *         tTbxMbEventLoop opaque pointer points to. Each event loop has its own event
+ *         queue and its own timer wheel with the poll timers of the contexts that are
+ *         bound to it.
+ */
+typedef struct t_tbx_mb_event_loop_ctx
+{
+  uint8_t                          type;         /**< Context type.                    */
+  tTbxMbOsalEventQueue             queue;        /**< Queue with the posted events.    */
+  tTbxMbTimerWheel                 timerWheel;   /**< Poll timers of bound contexts.   */
+  uint16_t                         waitTimeout;  /**< Event wait time (ms) of the task.*/
+  struct t_tbx_mb_event_loop_ctx * next;         /**< Next event loop in the list.     */
+} tTbxMbEventLoopCtx;
+
+
+/****************************************************************************************
+* Function prototypes
+****************************************************************************************/
+static void TbxMbEventLoopInit   (tTbxMbEventLoopCtx   * loopCtx,
+                                  tTbxMbOsalEventQueue   queue);
+
+static void TbxMbEventProcess    (tTbxMbEventLoopCtx   * loopCtx,
+                                  tTbxMbEvent          * event);
+
+static void TbxMbEventPollExpired(tTbxMbEventLoopCtx   * loopCtx);
+
+
+/****************************************************************************************
+* Local data declarations
+****************************************************************************************/
+/** \brief Default event loop. All newly created transport layer objects are bound to it
+ *         and TbxMbEventTask() drives it.
+ */
+static tTbxMbEventLoopCtx eventDefaultLoop;
+
+/** \brief Flag to keep track of the default event loop initialization. Only access it
+ *         inside a critical section.
+ */
+static uint8_t eventDefaultLoopInitialized = TBX_FALSE;
+
+
 /************************************************************************************//**
 ** \brief     Task function that drives the entire Modbus stack. It processes internally
 **            generated events. 
@@ -83,106 +153,613 @@ typedef struct
 **            For this reason it is recommended to use an RTOS in combination with a
 **            Modbus client.
 **
+**            This function drives the default event loop, to which all transport layer
+**            objects are bound, unless bound to another event loop with
+**            TbxMbEventLoopBind().
+**
 ****************************************************************************************/
 void TbxMbEventTask(void)
 {
-  static tTbxList * pollerList = NULL;
-  static uint8_t    pollerListInitialized = TBX_FALSE;
-  const  uint16_t   defaultWaitTimeoutMs = 5000U;
-  static uint16_t   waitTimeoutMS = 5000U;
-  tTbxMbEvent       newEvent = { 0 };
+  /* Run the task function of the default event loop. */
+  TbxMbEventLoopTask(TbxMbEventLoopDefault());
+} /*** end of TbxMbEventTask ***/
+
 
-  /* Only initialize the event poller once, */
-  if (pollerListInitialized == TBX_FALSE)
+/************************************************************************************//**
+** \brief     Creates a new event loop object. Each event loop has its own event queue
+**            and its own set of polled contexts. Bind transport layer objects to it
+**            with TbxMbEventLoopBind() and call TbxMbEventLoopTask() for it, for example
+**            from a dedicated thread. This way, a slow callback of one Modbus channel
+**            does not delay the event processing of the channels on other event loops.
+** \return    Handle to the newly created event loop object if successful, NULL
+**            otherwise.
+**
+****************************************************************************************/
+tTbxMbEventLoop TbxMbEventLoopCreate(void)
+{
+  tTbxMbEventLoop result = NULL;
+
+  /* Make sure the default event loop is initialized, because it is the head of the
+   * list with all event loops.
+   */
+  tTbxMbEventLoopCtx * defaultLoopCtx = (tTbxMbEventLoopCtx *)TbxMbEventLoopDefault();
+  /* Allocate memory for the new event loop context. */
+  tTbxMbEventLoopCtx * newLoopCtx = TbxMemPoolAllocate(sizeof(tTbxMbEventLoopCtx));
+  /* Automatically increase the memory pool, if it was too small. */
+  if (newLoopCtx == NULL)
   {
-    pollerListInitialized = TBX_TRUE;
-    /* Ceate the queue for storing context of which the pollFcn should be called. */
-    pollerList = TbxListCreate();
-    /* Verify that the queue creation succeeded. If this assertion fails, increase the
-     * heap size using configuration macro TBX_CONF_HEAP_SIZE.
+    /* No need to check the return value, because if it failed, the following
+     * allocation fails too, which is verified later on.
      */
-    TBX_ASSERT(pollerList != NULL);
+    (void)TbxMemPoolCreate(1U, sizeof(tTbxMbEventLoopCtx));
+    newLoopCtx = TbxMemPoolAllocate(sizeof(tTbxMbEventLoopCtx));
   }
+  /* Verify memory allocation of the event loop context. */
+  TBX_ASSERT(newLoopCtx != NULL);
+  /* Only continue if the memory allocation succeeded. */
+  if (newLoopCtx != NULL)
+  {
+    /* Initialize the event loop context, together with its new event queue. */
+    TbxMbEventLoopInit(newLoopCtx, TbxMbOsalEventQueueCreate());
+    /* Only continue if its event queue could be created. */
+    if (newLoopCtx->queue != NULL)
+    {
+      /* Add it to the list with all event loops, right after the default one. */
+      TbxCriticalSectionEnter();
+      newLoopCtx->next = defaultLoopCtx->next;
+      defaultLoopCtx->next = newLoopCtx;
+      TbxCriticalSectionExit();
+      /* Update the result. */
+      result = newLoopCtx;
+    }
+    /* Event queue creation failed. */
+    else
+    {
+      /* Give the event loop context back to the memory pool. */
+      newLoopCtx->type = 0U;
+      TbxMemPoolRelease(newLoopCtx);
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbEventLoopCreate ***/
 
-  /* Wait for a new event to be posted to the event queue. Note that that wait time only
-   * applies in case an RTOS is configured for the OSAL. Otherwise (TBX_MB_OPT_OSAL_NONE)
-   * this function returns immediately.
-   */
-  if (TbxMbOsalEventWait(&newEvent, waitTimeoutMS) == TBX_TRUE)
+
+/************************************************************************************//**
+** \brief     Releases an event loop object, previously created with
+**            TbxMbEventLoopCreate(). Make sure its task function is no longer called and
+**            that no transport layer objects are still bound to it.
+** \param     loop Handle to the event loop object to release.
+**
+****************************************************************************************/
+void TbxMbEventLoopFree(tTbxMbEventLoop loop)
+{
+  /* Verify parameters. Note that the default event loop cannot be released. */
+  TBX_ASSERT((loop != NULL) && (loop != (tTbxMbEventLoop)&eventDefaultLoop));
+
+  /* Only continue with valid parameters. */
+  if ((loop != NULL) && (loop != (tTbxMbEventLoop)&eventDefaultLoop))
+  {
+    /* Convert the event loop pointer to the context structure. */
+    tTbxMbEventLoopCtx * loopCtx = (tTbxMbEventLoopCtx *)loop;
+    /* Sanity check on the context type and that no poll timers are still armed. */
+    TBX_ASSERT((loopCtx->type == TBX_MB_EVENT_LOOP_CONTEXT_TYPE) &&
+               (loopCtx->timerWheel.count == 0U));
+    /* Remove it from the list with all event loops. */
+    TbxCriticalSectionEnter();
+    tTbxMbEventLoopCtx * prevLoopCtx = &eventDefaultLoop;
+    while ((prevLoopCtx->next != NULL) && (prevLoopCtx->next != loopCtx))
+    {
+      prevLoopCtx = prevLoopCtx->next;
+    }
+    if (prevLoopCtx->next == loopCtx)
+    {
+      prevLoopCtx->next = loopCtx->next;
+    }
+    /* Invalidate the context to protect it from accidentally being used afterwards. */
+    loopCtx->type = 0U;
+    loopCtx->next = NULL;
+    TbxCriticalSectionExit();
+    /* Release its event queue. */
+    TbxMbOsalEventQueueFree(loopCtx->queue);
+    loopCtx->queue = NULL;
+    /* Give the event loop context back to the memory pool. */
+    TbxMemPoolRelease(loopCtx);
+  }
+} /*** end of TbxMbEventLoopFree ***/
+
+
+/************************************************************************************//**
+** \brief     Task function that drives the event loop. It processes the events of the
+**            contexts that are bound to this event loop and calls their poll functions.
+**            Call it in the same way as TbxMbEventTask(). With an RTOS, each event loop
+**            typically gets its own task or thread.
+** \details   Contexts that need to detect events in a polling manner, such as the end of
+**            the 3.5 character time gap on RTU, don't get polled continuously. Their
+**            poll function returns the timer tick deadline at which it needs attention
+**            again. When an RTOS is used, this task sleeps until the earliest deadline
+**            or until a new event is posted, whichever one comes first. The deadlines
+**            are kept in a timer wheel. This way the work per call does not grow with
+**            the number of contexts that are polled.
+**            Each call processes all events that are already queued, up to
+**            TBX_MB_EVENT_BATCH_SIZE of them, instead of just one.
+** \param     loop Handle to the event loop object.
+**
+****************************************************************************************/
+void TbxMbEventLoopTask(tTbxMbEventLoop loop)
+{
+  tTbxMbEvent newEvents[TBX_MB_EVENT_BATCH_SIZE] = { 0 };
+
+  /* Verify parameters. */
+  TBX_ASSERT(loop != NULL);
+
+  /* Only continue with valid parameters. */
+  if (loop != NULL)
+  {
+    /* Convert the event loop pointer to the context structure. */
+    tTbxMbEventLoopCtx * loopCtx = (tTbxMbEventLoopCtx *)loop;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(loopCtx->type == TBX_MB_EVENT_LOOP_CONTEXT_TYPE);
+    /* Wait for new events to be posted to the event queue. Note that that wait time
+     * only applies in case an RTOS is configured for the OSAL. Otherwise
+     * (TBX_MB_OPT_OSAL_NONE) this function returns immediately. All events that are
+     * already queued are retrieved at once, up to the configured batch size, such that
+     * a burst of events does not get drained just one event per call.
+     */
+    uint8_t eventCnt = TbxMbOsalEventWait(loopCtx->queue, newEvents,
+                                          (uint8_t)TBX_MB_EVENT_BATCH_SIZE,
+                                          loopCtx->waitTimeout);
+    /* Process the retrieved events in the order that they were posted. */
+    for (uint8_t eventIdx = 0U; eventIdx < eventCnt; eventIdx++)
+    {
+      TbxMbEventProcess(loopCtx, &newEvents[eventIdx]);
+    }
+    /* Call the poll functions whose deadline passed, just once for the entire batch.
+     * Also when no event was retrieved.
+     */
+    TbxMbEventPollExpired(loopCtx);
+  }
+} /*** end of TbxMbEventLoopTask ***/
+
+
+/************************************************************************************//**
+** \brief     Binds a transport layer object, together with the channel object that is
+**            linked to it, to an event loop. From then on, the task function of this
+**            event loop processes their events and calls their poll functions. Events
+**            that are still pending in the event queue of the previous event loop, are
+**            forwarded. For the best results, bind the transport layer object right
+**            after creating it, before linking it to a channel object.
+** \param     loop Handle to the event loop object.
+** \param     transport Handle to the transport layer object.
+**
+****************************************************************************************/
+void TbxMbEventLoopBind(tTbxMbEventLoop loop,
+                        tTbxMbTp        transport)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((loop != NULL) && (transport != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((loop != NULL) && (transport != NULL))
+  {
+    /* Convert the pointers to the context structures. */
+    tTbxMbEventLoopCtx * loopCtx = (tTbxMbEventLoopCtx *)loop;
+    tTbxMbTpCtx        * tpCtx = (tTbxMbTpCtx *)transport;
+    tTbxMbEventCtx     * eventCtx = (tTbxMbEventCtx *)transport;
+    uint8_t              wasPolled = TBX_FALSE;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(loopCtx->type == TBX_MB_EVENT_LOOP_CONTEXT_TYPE);
+    TbxCriticalSectionEnter();
+    /* Only continue if it's bound to another event loop. */
+    if (eventCtx->eventLoop != loop)
+    {
+      /* Remove its poll timer from the timer wheel of the previous event loop. */
+      tTbxMbEventLoopCtx * prevLoopCtx = (tTbxMbEventLoopCtx *)eventCtx->eventLoop;
+      wasPolled = TbxMbTimerIsArmed(&eventCtx->pollTimer);
+      TbxMbTimerCancel(&prevLoopCtx->timerWheel, &eventCtx->pollTimer);
+      /* Bind the transport layer context and its channel context to the event loop. */
+      eventCtx->eventLoop = loop;
+      if (tpCtx->channelCtx != NULL)
+      {
+        ((tTbxMbEventCtx *)tpCtx->channelCtx)->eventLoop = loop;
+      }
+    }
+    TbxCriticalSectionExit();
+    /* Have the new event loop continue calling its poll function, if needed. */
+    if (wasPolled == TBX_TRUE)
+    {
+      tTbxMbEvent newEvent = {.context = eventCtx, .id = TBX_MB_EVENT_ID_START_POLLING};
+      TbxMbEventPost(&newEvent, TBX_FALSE);
+    }
+  }
+} /*** end of TbxMbEventLoopBind ***/
+
+
+/************************************************************************************//**
+** \brief     Obtains the default event loop. All newly created transport layer objects
+**            are bound to it.
+** \attention This function initializes the default event loop, the first time it is
+**            called. The application will always first create a transport layer object
+**            before a channel object. Consequently, this happens when the first
+**            transport layer object is created. It is safe to do this from several
+**            threads at the same time.
+** \return    Handle to the default event loop object.
+**
+****************************************************************************************/
+tTbxMbEventLoop TbxMbEventLoopDefault(void)
+{
+  uint8_t initialized;
+
+  /* Check if the default event loop still needs to be initialized. */
+  TbxCriticalSectionEnter();
+  initialized = eventDefaultLoopInitialized;
+  TbxCriticalSectionExit();
+  /* Only initialize the default event loop once. */
+  if (initialized == TBX_FALSE)
+  {
+    /* Create its event queue outside of the critical section, because with an RTOS this
+     * allocates memory with the help of the RTOS.
+     */
+    tTbxMbOsalEventQueue newQueue = TbxMbOsalEventQueueCreate();
+    /* Initialize the default event loop, unless another thread beat us to it. */
+    TbxCriticalSectionEnter();
+    if (eventDefaultLoopInitialized == TBX_FALSE)
+    {
+      TbxMbEventLoopInit(&eventDefaultLoop, newQueue);
+      eventDefaultLoopInitialized = TBX_TRUE;
+      newQueue = NULL;
+    }
+    TbxCriticalSectionExit();
+    /* Release the event queue, if another thread initialized the default event loop. */
+    if (newQueue != NULL)
+    {
+      TbxMbOsalEventQueueFree(newQueue);
+    }
+  }
+  /* Give the result back to the caller. */
+  return (tTbxMbEventLoop)&eventDefaultLoop;
+} /*** end of TbxMbEventLoopDefault ***/
+
+
+/************************************************************************************//**
+** \brief     Runs the task function of all event loops once. Meant for the superloop
+**            OSAL, which calls it while blocking on a semaphore. There is only one
+**            thread in this case, so it must drive the event loops of all channels.
+**
+****************************************************************************************/
+void TbxMbEventTaskAll(void)
+{
+  /* Start with the default event loop, which is the head of the list. */
+  tTbxMbEventLoopCtx * loopCtx = (tTbxMbEventLoopCtx *)TbxMbEventLoopDefault();
+  /* Run the task function of each event loop in the list. */
+  while (loopCtx != NULL)
+  {
+    TbxMbEventLoopTask(loopCtx);
+    loopCtx = loopCtx->next;
+  }
+} /*** end of TbxMbEventTaskAll ***/
+
+
+/************************************************************************************//**
+** \brief     Signals the occurrence of an event. The event is posted to the event queue
+**            of the event loop that the event's context is bound to.
+** \param     event Pointer to the event to signal.
+** \param     fromIsr TBX_TRUE when calling this function from an interrupt service
+**            routine, TBX_FALSE otherwise.
+**
+****************************************************************************************/
+void TbxMbEventPost(tTbxMbEvent const * event,
+                    uint8_t             fromIsr)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((event != NULL) && (event->context != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((event != NULL) && (event->context != NULL))
+  {
+    /* Convert the opaque pointers to the context structures. */
+    tTbxMbEventCtx     * eventCtx = (tTbxMbEventCtx *)event->context;
+    tTbxMbEventLoopCtx * loopCtx = (tTbxMbEventLoopCtx *)eventCtx->eventLoop;
+    /* Post the event to the queue of the event loop that the context is bound to. */
+    TbxMbOsalEventPost(loopCtx->queue, event, fromIsr);
+  }
+} /*** end of TbxMbEventPost ***/
+
+
+/************************************************************************************//**
+** \brief     Signals the occurrence of an event from an interrupt service routine. The
+**            event is posted to the event queue of the event loop that the event's
+**            context is bound to.
+** \param     event Pointer to the event to signal.
+** \param     source Interrupt source that posts the event.
+**
+****************************************************************************************/
+void TbxMbEventPostFromIsr(tTbxMbEvent const * event,
+                           uint8_t             source)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((event != NULL) && (event->context != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((event != NULL) && (event->context != NULL))
+  {
+    /* Convert the opaque pointers to the context structures. */
+    tTbxMbEventCtx     * eventCtx = (tTbxMbEventCtx *)event->context;
+    tTbxMbEventLoopCtx * loopCtx = (tTbxMbEventLoopCtx *)eventCtx->eventLoop;
+    /* Post the event to the queue of the event loop that the context is bound to. */
+    TbxMbOsalEventPostFromIsr(loopCtx->queue, event, source);
+  }
+} /*** end of TbxMbEventPostFromIsr ***/
+
+
+/************************************************************************************//**
+** \brief     Starts calling the poll function of the context right away. Meant for when
+**            the context was just created. Unlike with posting a
+**            TBX_MB_EVENT_ID_START_POLLING event, its poll timer is already armed when
+**            this function returns. This way TbxMbEventLoopBind() moves it along, also
+**            when the event loop it was bound to never gets to process the event.
+** \param     context Opaque pointer to the context.
+**
+****************************************************************************************/
+void TbxMbEventStartPolling(void * context)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(context != NULL);
+
+  /* Only continue with valid parameters. */
+  if (context != NULL)
+  {
+    /* Convert the opaque pointer to the event context structure. */
+    tTbxMbEventCtx * eventCtx = (tTbxMbEventCtx *)context;
+    /* Arm its poll timer in the timer wheel of the event loop it is bound to. */
+    TbxCriticalSectionEnter();
+    tTbxMbEventLoopCtx * loopCtx = (tTbxMbEventLoopCtx *)eventCtx->eventLoop;
+    TbxMbTimerArm(&loopCtx->timerWheel, &eventCtx->pollTimer, TbxMbPortTimerCount());
+    TbxCriticalSectionExit();
+    /* Wake up the event loop, such that it no longer waits longer than its poll timer
+     * allows. Processing this event just arms the poll timer once more.
+     */
+    tTbxMbEvent newEvent = {.context = eventCtx, .id = TBX_MB_EVENT_ID_START_POLLING};
+    TbxMbEventPost(&newEvent, TBX_FALSE);
+  }
+} /*** end of TbxMbEventStartPolling ***/
+
+
+/************************************************************************************//**
+** \brief     Stops calling the poll function of the context right away. Meant for when
+**            the context is about to be released. Posting a TBX_MB_EVENT_ID_STOP_POLLING
+**            event is not an option then, because the event task would process it after
+**            the context was already released.
+** \param     context Opaque pointer to the context.
+**
+****************************************************************************************/
+void TbxMbEventCancelPolling(void * context)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(context != NULL);
+
+  /* Only continue with valid parameters. */
+  if (context != NULL)
+  {
+    /* Convert the opaque pointer to the event context structure. */
+    tTbxMbEventCtx * eventCtx = (tTbxMbEventCtx *)context;
+    /* Remove its poll timer from the timer wheel of the event loop it is bound to. */
+    TbxCriticalSectionEnter();
+    tTbxMbEventLoopCtx * loopCtx = (tTbxMbEventLoopCtx *)eventCtx->eventLoop;
+    TbxMbTimerCancel(&loopCtx->timerWheel, &eventCtx->pollTimer);
+    TbxCriticalSectionExit();
+  }
+} /*** end of TbxMbEventCancelPolling ***/
+
+
+/************************************************************************************//**
+** \brief     Initializes an event loop context. The caller makes sure that no other
+**            thread accesses the event loop context at the same time.
+** \param     loopCtx Pointer to the event loop context.
+** \param     queue Handle to the event queue object of the event loop.
+**
+****************************************************************************************/
+static void TbxMbEventLoopInit(tTbxMbEventLoopCtx   * loopCtx,
+                               tTbxMbOsalEventQueue   queue)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(loopCtx != NULL);
+
+  /* Only continue with valid parameters. */
+  if (loopCtx != NULL)
+  {
+    /* Initialize the event loop context. */
+    loopCtx->type = TBX_MB_EVENT_LOOP_CONTEXT_TYPE;
+    loopCtx->waitTimeout = TBX_MB_EVENT_WAIT_DEFAULT_MS;
+    loopCtx->next = NULL;
+    loopCtx->queue = queue;
+    TbxMbTimerWheelInit(&loopCtx->timerWheel);
+  }
+} /*** end of TbxMbEventLoopInit ***/
+
+
+/************************************************************************************//**
+** \brief     Processes an event, retrieved from the event queue of an event loop. The
+**            event is forwarded to the event loop that the event's context is bound
+**            to, if that changed after the event was posted.
+** \param     loopCtx Pointer to the event loop context.
+** \param     event Pointer to the event to process.
+**
+****************************************************************************************/
+static void TbxMbEventProcess(tTbxMbEventLoopCtx * loopCtx,
+                              tTbxMbEvent        * event)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((loopCtx != NULL) && (event != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((loopCtx != NULL) && (event != NULL))
   {
     /* Check the opaque context pointer. */
-    TBX_ASSERT(newEvent.context != NULL);
+    TBX_ASSERT(event->context != NULL);
     /* Only continue with a valid opaque context pointer. */
-    if (newEvent.context != NULL)
+    if (event->context != NULL)
     {
+      /* Convert the opaque pointer to the event context structure. */
+      tTbxMbEventCtx * eventCtx = (tTbxMbEventCtx *)event->context;
+      uint8_t          forward = TBX_FALSE;
       /* Filter on the event identifier. */
-      switch (newEvent.id)
+      switch (event->id)
       {
         case TBX_MB_EVENT_ID_START_POLLING:
         {
-          /* Poller list entries are allocated from a memory pool. This means that there
-           * is no need to worry about heap fragmentation. Just make sure to cap the
-           * maximum number of entries to prevent heap exhaustion.
+          /* Make its poll function due right away, by arming its poll timer with the
+           * current timer tick. The timer wheel is also accessed by
+           * TbxMbEventStartPolling(), TbxMbEventCancelPolling() and
+           * TbxMbEventLoopBind(), so protect it with a critical section. Forward the
+           * event instead, if the context is bound to another event loop by now.
            */
-          TBX_ASSERT(TbxListGetSize(pollerList) <= TBX_MB_EVENT_QUEUE_SIZE);
-          /* Only continue if the current poller list size is not yet maxed out. */
-          if (TbxListGetSize(pollerList) <= TBX_MB_EVENT_QUEUE_SIZE)
+          TbxCriticalSectionEnter();
+          if (eventCtx->eventLoop == (tTbxMbEventLoop)loopCtx)
           {
-            /* Add the context at the end of the event poller list. */
-            uint8_t insertResult = TbxListInsertItemBack(pollerList, newEvent.context);
-            /* Check that the item could be added to the queue. If not, then the heaps size
-             * is configured too small. In this case increase the heap size using
-            * configuration macro TBX_CONF_HEAP_SIZE. 
-            */
-            TBX_ASSERT(insertResult == TBX_OK);
+            TbxMbTimerArm(&loopCtx->timerWheel, &eventCtx->pollTimer,
+                          TbxMbPortTimerCount());
           }
+          else
+          {
+            forward = TBX_TRUE;
+          }
+          TbxCriticalSectionExit();
         }
         break;
       
         case TBX_MB_EVENT_ID_STOP_POLLING:
         {
-          /* Remove the context from the event poller list. */
-          TbxListRemoveItem(pollerList, newEvent.context);
+          /* Cancel its poll timer, such that its poll function is no longer called. */
+          TbxMbEventCancelPolling(eventCtx);
         }
         break;
 
         default:
         {
-          /* Convert the opaque pointer to the event context structure. */
-          tTbxMbEventCtx * eventCtx = (tTbxMbEventCtx *)newEvent.context;
-          /* Pass the event on to the context's event processor. */
-          if (eventCtx->processFcn != NULL)
+          /* Forward the event, if the context is bound to another event loop by now.
+           * Otherwise pass the event on to the context's event processor.
+           */
+          if (eventCtx->eventLoop != (tTbxMbEventLoop)loopCtx)
+          {
+            forward = TBX_TRUE;
+          }
+          else if (eventCtx->processFcn != NULL)
+          {
+            eventCtx->processFcn(event);
+          }
+          else
           {
-            eventCtx->processFcn(&newEvent);
+            /* Nothing left to do, but MISRA requires this terminating else
+             * statement.
+             */
           }
         }
         break;
       }
+      /* Post the event to the event loop that the context is bound to, if needed. */
+      if (forward == TBX_TRUE)
+      {
+        TbxMbEventPost(event, TBX_FALSE);
+      }
     }
   }
+} /*** end of TbxMbEventProcess ***/
+
 
-  /* Iterate over the event poller list. */
-  void * listItem = TbxListGetFirstItem(pollerList);
-  while (listItem != NULL)
+/************************************************************************************//**
+** \brief     Calls the poll functions of the contexts, whose poll timer expired. Also
+**            updates the event wait timeout for the next call of the event loop's task
+**            function, such that it wakes up at the earliest pending deadline.
+** \param     loopCtx Pointer to the event loop context.
+**
+****************************************************************************************/
+static void TbxMbEventPollExpired(tTbxMbEventLoopCtx * loopCtx)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(loopCtx != NULL);
+
+  /* Only continue with valid parameters. */
+  if (loopCtx != NULL)
   {
-    /* Convert the opaque pointer to the event context structure. */
-    tTbxMbEventCtx * eventPollCtx = (tTbxMbEventCtx *)listItem;
-    /* Call its poll function if configured. */
-    if (eventPollCtx->pollFcn != NULL)
+    /* Obtain the first poll timer that expired, if any. The timer wheel is also
+     * accessed by TbxMbEventStartPolling(), TbxMbEventCancelPolling() and
+     * TbxMbEventLoopBind(), so protect it with a critical section. Only the poll
+     * function calls themselves are made outside of the critical section.
+     */
+    uint16_t      now = TbxMbPortTimerCount();
+    uint16_t      nextDeadline = 0U;
+    TbxCriticalSectionEnter();
+    tTbxMbTimer * expiredTimer = TbxMbTimerExpired(&loopCtx->timerWheel, now);
+    /* Iterate over the expired poll timers. */
+    while (expiredTimer != NULL)
+    {
+      /* Convert the timer's opaque context pointer to the event context structure. */
+      tTbxMbEventCtx * eventPollCtx = (tTbxMbEventCtx *)expiredTimer->context;
+      tTbxMbEventPoll  pollFcn = eventPollCtx->pollFcn;
+      /* Call its poll function if configured. */
+      if (pollFcn != NULL)
+      {
+        TbxCriticalSectionExit();
+        uint16_t deadline = pollFcn(eventPollCtx);
+        TbxCriticalSectionEnter();
+        /* Arm its poll timer again with the deadline for the next call. Unless polling
+         * was cancelled in the meantime.
+         */
+        if (eventPollCtx->pollFcn != NULL)
+        {
+          /* Still bound to this event loop? */
+          if (eventPollCtx->eventLoop == (tTbxMbEventLoop)loopCtx)
+          {
+            TbxMbTimerArm(&loopCtx->timerWheel, &eventPollCtx->pollTimer, deadline);
+          }
+          /* Bound to another event loop in the meantime. Have that one continue
+           * calling its poll function.
+           */
+          else
+          {
+            tTbxMbEvent moveEvent = {.context = eventPollCtx,
+                                     .id = TBX_MB_EVENT_ID_START_POLLING};
+            TbxCriticalSectionExit();
+            TbxMbEventPost(&moveEvent, TBX_FALSE);
+            TbxCriticalSectionEnter();
+          }
+        }
+      }
+      /* Move on to the next expired poll timer. */
+      expiredTimer = TbxMbTimerExpired(&loopCtx->timerWheel, now);
+    }
+    /* Determine when the next poll timer expires. */
+    uint8_t       timerArmed = TbxMbTimerNext(&loopCtx->timerWheel, &nextDeadline);
+    TbxCriticalSectionExit();
+
+    /* Go back to the default wait time, unless a poll timer is armed. This prevents
+     * hogging up CPU time unnecessarily.
+     */
+    loopCtx->waitTimeout = TBX_MB_EVENT_WAIT_DEFAULT_MS;
+    if (timerArmed == TBX_TRUE)
     {
-      eventPollCtx->pollFcn(listItem);
+      /* Calculate the number of ticks until the deadline. Note that this calculation
+       * works, even if the timer counter overflowed. A value <= 0 means that the
+       * deadline passed.
+       */
+      int16_t remainingTicks = (int16_t)(uint16_t)(nextDeadline - now);
+      /* Set the event wait timeout for the next call to this task function, such that
+       * it wakes up at the deadline. Round up to not wake up too early.
+       */
+      if (remainingTicks <= 0)
+      {
+        loopCtx->waitTimeout = 0U;
+      }
+      else
+      {
+        loopCtx->waitTimeout = (uint16_t)(((uint16_t)remainingTicks +
+                                           (TBX_MB_EVENT_TICKS_PER_MS - 1U)) /
+                                          TBX_MB_EVENT_TICKS_PER_MS);
+      }
     }
-    /* Move on to the next item in the list. */
-    listItem = TbxListGetNextItem(pollerList, listItem);
   }
-
-  /* Set the event wait timeout for the next call to this task function. If the event
-   * poller list is not empty, keep the wait time short to make sure the poll functions
-   * get continuously called. Otherwise go back to the default wait time to not hog up
-   * CPU time unnecessarily.
-   */
-  waitTimeoutMS = (TbxListGetSize(pollerList) > 0U) ? 1U : defaultWaitTimeoutMs;
-} /*** end of TbxMbEventTask ***/
+} /*** end of TbxMbEventPollExpired ***/
 
 
 /*********************************** end of tbxmb_event.c ******************************/
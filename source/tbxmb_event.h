@@ -34,10 +34,26 @@
 extern "C" {
 #endif
 
+/****************************************************************************************
+* Type definitions
+****************************************************************************************/
+/** \brief Handle to a Modbus event loop object, in the format of an opaque pointer. */
+typedef void * tTbxMbEventLoop;
+
+
 /****************************************************************************************
 * Function prototypes
 ****************************************************************************************/
-void TbxMbEventTask(void);
+void            TbxMbEventTask      (void);
+
+tTbxMbEventLoop TbxMbEventLoopCreate(void);
+
+void            TbxMbEventLoopFree  (tTbxMbEventLoop loop);
+
+void            TbxMbEventLoopTask  (tTbxMbEventLoop loop);
+
+void            TbxMbEventLoopBind  (tTbxMbEventLoop loop,
+                                     tTbxMbTp        transport);
 
 
 #ifdef __cplusplus
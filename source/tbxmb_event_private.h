@@ -34,13 +34,22 @@
 extern "C" {
 #endif
 
+/****************************************************************************************
+* Macro definitions
+****************************************************************************************/
+/** \brief Number of ticks of the free running 20 kHz port timer in one millisecond. */
+#define TBX_MB_EVENT_TICKS_PER_MS      (20U)
+
+
 /****************************************************************************************
 * Type definitions
 ****************************************************************************************/
 /** \brief Enumerated type with all supported events. */
 typedef enum
 {
-  /* Start calling the context's polling function each time TbxMbEventTask() runs. */
+  /* Start calling the context's polling function. TbxMbEventTask() calls it right away
+   * and after that at the timer tick deadline that the polling function returns.
+   */
   TBX_MB_EVENT_ID_START_POLLING = 0U,
   /* Stop calling the context's polling function. */
   TBX_MB_EVENT_ID_STOP_POLLING,
@@ -61,6 +70,24 @@ typedef struct
 } tTbxMbEvent;
 
 
+/****************************************************************************************
+* Function prototypes
+****************************************************************************************/
+tTbxMbEventLoop TbxMbEventLoopDefault  (void);
+
+void            TbxMbEventTaskAll      (void);
+
+void            TbxMbEventPost         (tTbxMbEvent const * event,
+                                        uint8_t             fromIsr);
+
+void            TbxMbEventPostFromIsr  (tTbxMbEvent const * event,
+                                        uint8_t             source);
+
+void            TbxMbEventStartPolling (void              * context);
+
+void            TbxMbEventCancelPolling(void              * context);
+
+
 #ifdef __cplusplus
 }
 #endif
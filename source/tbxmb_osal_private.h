@@ -47,6 +47,19 @@ extern "C" {
                                    (uint8_t)TBX_MB_UART_NUM_PORT)
 #endif
 
+/** \brief Interrupt source of an event, posted by the transmit complete interrupt of a
+ *         UART port.
+ */
+#define TBX_MB_OSAL_ISR_SOURCE_UART_TX(port)   ((uint8_t)((uint8_t)(port) * 2U))
+
+/** \brief Interrupt source of an event, posted by the data reception interrupt of a
+ *         UART port.
+ */
+#define TBX_MB_OSAL_ISR_SOURCE_UART_RX(port)   ((uint8_t)(((uint8_t)(port) * 2U) + 1U))
+
+/** \brief Total number of interrupt sources that can post events. */
+#define TBX_MB_OSAL_ISR_SOURCE_NUM             ((uint8_t)TBX_MB_UART_NUM_PORT * 2U)
+
 
 /****************************************************************************************
 * Type definitions
@@ -57,28 +70,45 @@ extern "C" {
 typedef void * tTbxMbOsalSem;
 
 
+/** \brief Handle to a Modbus OSAL event queue object, in the format of an opaque
+ *         pointer.
+ */
+typedef void * tTbxMbOsalEventQueue;
+
+
 /****************************************************************************************
 * Function prototypes
 ****************************************************************************************/
 /* Modbus OSAL event queue API. */
-void          TbxMbOsalEventInit(void);
+tTbxMbOsalEventQueue TbxMbOsalEventQueueCreate(void);
+
+void                 TbxMbOsalEventQueueFree  (tTbxMbOsalEventQueue   queue);
+
+void                 TbxMbOsalEventPost       (tTbxMbOsalEventQueue   queue,
+                                               tTbxMbEvent    const * event,
+                                               uint8_t                fromIsr);
+
+void                 TbxMbOsalEventPostFromIsr(tTbxMbOsalEventQueue   queue,
+                                               tTbxMbEvent    const * event,
+                                               uint8_t                source);
 
-void          TbxMbOsalEventPost(tTbxMbEvent const * event, 
-                                 uint8_t             fromIsr);
+uint8_t              TbxMbOsalEventWait       (tTbxMbOsalEventQueue   queue,
+                                               tTbxMbEvent            events[],
+                                               uint8_t                maxEvents,
+                                               uint16_t               timeoutMs);
 
-uint8_t       TbxMbOsalEventWait(tTbxMbEvent       * event, 
-                                 uint16_t            timeoutMs);
+uint8_t              TbxMbOsalEventPostIsThreadSafe(void);
 
 /* Modbus OSAL semaphore API. */
-tTbxMbOsalSem TbxMbOsalSemCreate(void);
+tTbxMbOsalSem        TbxMbOsalSemCreate       (void);
 
-void          TbxMbOsalSemFree  (tTbxMbOsalSem       sem);
+void                 TbxMbOsalSemFree         (tTbxMbOsalSem          sem);
 
-void          TbxMbOsalSemGive  (tTbxMbOsalSem       sem,
-                                 uint8_t             fromIsr);
+void                 TbxMbOsalSemGive         (tTbxMbOsalSem          sem,
+                                               uint8_t                fromIsr);
 
-uint8_t       TbxMbOsalSemTake  (tTbxMbOsalSem       sem,
-                                 uint16_t            timeoutMs);
+uint8_t              TbxMbOsalSemTake         (tTbxMbOsalSem          sem,
+                                               uint16_t               timeoutMs);
 
 
 #ifdef __cplusplus
@@ -33,8 +33,10 @@
 ****************************************************************************************/
 #include "microtbx.h"                            /* MicroTBX module                    */
 #include "microtbxmodbus.h"                      /* MicroTBX-Modbus module             */
+#include "tbxmb_crc_private.h"                   /* MicroTBX-Modbus CRC private        */
 #include "tbxmb_event_private.h"                 /* MicroTBX-Modbus event private      */
 #include "tbxmb_osal_private.h"                  /* MicroTBX-Modbus OSAL private       */
+#include "tbxmb_timer_private.h"                 /* MicroTBX-Modbus timer private      */
 #include "tbxmb_tp_private.h"                    /* MicroTBX-Modbus TP private         */
 #include "tbxmb_uart_private.h"                  /* MicroTBX-Modbus UART private       */
 
@@ -83,7 +85,7 @@
 /****************************************************************************************
 * Function prototypes
 ****************************************************************************************/
-static void             TbxMbRtuPoll            (tTbxMbTp               transport);
+static uint16_t         TbxMbRtuPoll            (tTbxMbTp               transport);
 
 static uint8_t          TbxMbRtuTransmit        (tTbxMbTp               transport);
 
@@ -100,9 +102,6 @@ static void             TbxMbRtuTransmitComplete(tTbxMbUartPort         port);
 static void             TbxMbRtuDataReceived    (tTbxMbUartPort         port, 
                                                  uint8_t        const * data, 
                                                  uint8_t                len);
-                                                 
-static uint16_t         TbxMbRtuCalculatCrc     (uint8_t        const * data, 
-                                                 uint16_t               len);
 
 
 /****************************************************************************************
@@ -137,12 +136,6 @@ tTbxMbTp TbxMbRtuCreate(uint8_t            nodeAddr,
 {
   tTbxMbTp result = NULL;
 
-  /* Make sure the OSAL event module is initialized. The application will always first
-   * create a transport layer object before a channel object. Consequently, this is the
-   * best place to do the OSAL module initialization.
-   */
-  TbxMbOsalEventInit();
-
   /* Verify parameters. */
   TBX_ASSERT((nodeAddr <= TBX_MB_TP_NODE_ADDR_MAX) &&
              (port < TBX_MB_UART_NUM_PORT) && 
@@ -178,6 +171,8 @@ tTbxMbTp TbxMbRtuCreate(uint8_t            nodeAddr,
       newTpCtx->instancePtr = NULL;
       newTpCtx->pollFcn = TbxMbRtuPoll;
       newTpCtx->processFcn = NULL;
+      TbxMbTimerInit(&newTpCtx->pollTimer, newTpCtx);
+      newTpCtx->eventLoop = TbxMbEventLoopDefault();
       newTpCtx->transmitFcn = TbxMbRtuTransmit;
       newTpCtx->receptionDoneFcn = TbxMbRtuReceptionDone;
       newTpCtx->getRxPacketFcn = TbxMbRtuGetRxPacket;
@@ -194,6 +189,8 @@ tTbxMbTp TbxMbRtuCreate(uint8_t            nodeAddr,
       newTpCtx->diagInfo.srvNoRespCnt = 0U;
       /* Store the transport context in the lookup table. */
       tbxMbRtuCtx[port] = newTpCtx;
+      /* Select the CRC16 calculation kernel. */
+      TbxMbCrcInit();
       /* Initialize the port. Note the RTU always uses 8 databits. */
       TbxMbUartInit(port, baudrate, TBX_MB_UART_8_DATABITS, stopbits, parity,
                     TbxMbRtuTransmitComplete, TbxMbRtuDataReceived);
@@ -247,8 +244,7 @@ tTbxMbTp TbxMbRtuCreate(uint8_t            nodeAddr,
       /* Instruct the event task to call our polling function to be able to determine
        * when it's time to transition from INIT to IDLE.
        */
-      tTbxMbEvent newEvent = {.context = newTpCtx, .id = TBX_MB_EVENT_ID_START_POLLING};
-      TbxMbOsalEventPost(&newEvent, TBX_FALSE);
+      TbxMbEventStartPolling(newTpCtx);
       /* Update the result. */
       result = newTpCtx;
     }
@@ -278,6 +274,8 @@ void TbxMbRtuFree(tTbxMbTp transport)
     TBX_ASSERT(tpCtx->type == TBX_MB_RTU_CONTEXT_TYPE);
     /* Release the semaphore used for syncing to the INIT to IDLE state transition. */
     TbxMbOsalSemFree(tpCtx->initStateExitSem);
+    /* Make sure the event task no longer calls our polling function. */
+    TbxMbEventCancelPolling(tpCtx);
     TbxCriticalSectionEnter();
     /* Remove the channel from the lookup table. */
     tbxMbRtuCtx[tpCtx->port] = NULL;
@@ -297,10 +295,15 @@ void TbxMbRtuFree(tTbxMbTp transport)
 **            TbxMbEventTask(), if activated. Use the TBX_MB_EVENT_ID_START_POLLING and
 **            TBX_MB_EVENT_ID_STOP_POLLING events to activate and deactivate.
 ** \param     transport Handle to RTU transport layer object.
+** \return    Free running timer tick count at which this function should be called
+**            again. For a pending 3.5 character time gap, that's the end of the gap.
 **
 ****************************************************************************************/
-static void TbxMbRtuPoll(tTbxMbTp transport)
+static uint16_t TbxMbRtuPoll(tTbxMbTp transport)
 {
+  /* Unless a state needs attention sooner, ask to be called again in a millisecond. */
+  uint16_t result = TbxMbPortTimerCount() + TBX_MB_EVENT_TICKS_PER_MS;
+
   /* Verify parameters. */
   TBX_ASSERT(transport != NULL);
 
@@ -334,7 +337,7 @@ static void TbxMbRtuPoll(tTbxMbTp transport)
           tTbxMbEvent newEvent;
           newEvent.context = tpCtx;
           newEvent.id = TBX_MB_EVENT_ID_STOP_POLLING;
-          TbxMbOsalEventPost(&newEvent, TBX_FALSE);
+          TbxMbEventPost(&newEvent, TBX_FALSE);
           /* Is the newly received frame still in the OK state? */
           TbxCriticalSectionEnter();
           uint8_t rxAduOkayCpy = tpCtx->rxAduOkay;
@@ -380,7 +383,7 @@ static void TbxMbRtuPoll(tTbxMbTp transport)
               tTbxMbEvent pduRxEvent;
               pduRxEvent.context = tpCtx->channelCtx;
               pduRxEvent.id = TBX_MB_EVENT_ID_PDU_RECEIVED;
-              TbxMbOsalEventPost(&pduRxEvent, TBX_FALSE);
+              TbxMbEventPost(&pduRxEvent, TBX_FALSE);
             }
           }
           /* Frame was marked as not okay (NOK) during its reception. Most likely a
@@ -394,6 +397,11 @@ static void TbxMbRtuPoll(tTbxMbTp transport)
             TbxCriticalSectionExit();
           }
         }
+        /* Still receiving. Come back at the end of the 3.5 character time gap. */
+        else
+        {
+          result = rxTimeCopy + tpCtx->t3_5Ticks;
+        }
       }
       break;
 
@@ -410,21 +418,38 @@ static void TbxMbRtuPoll(tTbxMbTp transport)
         /* After t3_5 it's time to transition to the IDLE state. */
         if (deltaTicks >= tpCtx->t3_5Ticks)
         {
-          /* Transition back to the IDLE state. */
+          /* Transition back to the IDLE state. Unless TbxMbRtuDataReceived() already
+           * completed the transmission, upon receiving the first byte of the next
+           * packet. The polling then continues for the reception of this packet.
+           */
           TbxCriticalSectionEnter();
-          tpCtx->state = TBX_MB_RTU_STATE_IDLE;
+          uint8_t txCompleted = TBX_FALSE;
+          if (tpCtx->state == TBX_MB_RTU_STATE_TRANSMISSION)
+          {
+            tpCtx->state = TBX_MB_RTU_STATE_IDLE;
+            txCompleted = TBX_TRUE;
+          }
           TbxCriticalSectionExit();
-          /* Instruct the event task to stop calling our polling function. */
-          tTbxMbEvent newEvent;
-          newEvent.context = tpCtx;
-          newEvent.id = TBX_MB_EVENT_ID_STOP_POLLING;
-          TbxMbOsalEventPost(&newEvent, TBX_FALSE);
-          /* Post an event to the linked channel for inform them that the PDU
-           * transmission completed. Note that it's okay to reuse the event local.
-           */
-          newEvent.context = tpCtx->channelCtx;
-          newEvent.id = TBX_MB_EVENT_ID_PDU_TRANSMITTED;
-          TbxMbOsalEventPost(&newEvent, TBX_FALSE);
+          /* Only continue if the transmission was completed here. */
+          if (txCompleted == TBX_TRUE)
+          {
+            /* Instruct the event task to stop calling our polling function. */
+            tTbxMbEvent newEvent;
+            newEvent.context = tpCtx;
+            newEvent.id = TBX_MB_EVENT_ID_STOP_POLLING;
+            TbxMbEventPost(&newEvent, TBX_FALSE);
+            /* Post an event to the linked channel for inform them that the PDU
+             * transmission completed. Note that it's okay to reuse the event local.
+             */
+            newEvent.context = tpCtx->channelCtx;
+            newEvent.id = TBX_MB_EVENT_ID_PDU_TRANSMITTED;
+            TbxMbEventPost(&newEvent, TBX_FALSE);
+          }
+        }
+        /* Come back at the end of the 3.5 character time gap. */
+        else
+        {
+          result = txDoneTimeCopy + tpCtx->t3_5Ticks;
         }
       }
       break;
@@ -450,13 +475,18 @@ static void TbxMbRtuPoll(tTbxMbTp transport)
           tTbxMbEvent newEvent;
           newEvent.context = tpCtx;
           newEvent.id = TBX_MB_EVENT_ID_STOP_POLLING;
-          TbxMbOsalEventPost(&newEvent, TBX_FALSE);
+          TbxMbEventPost(&newEvent, TBX_FALSE);
           /* Give the semaphore to sync the transmit function to this event. This is 
            * needed for an RTU client, when transmit it called before being in the INIt
            * state.
            */
           TbxMbOsalSemGive(tpCtx->initStateExitSem, TBX_FALSE);
         }
+        /* Come back at the end of the 3.5 character time gap. */
+        else
+        {
+          result = rxTimeCopy + tpCtx->t3_5Ticks;
+        }
       }
       break;
 
@@ -467,6 +497,8 @@ static void TbxMbRtuPoll(tTbxMbTp transport)
       break;
     }
   }
+  /* Give the result back to the caller. */
+  return result;
 } /*** end of TbxMbRtuPoll ***/
 
 
@@ -563,6 +595,7 @@ static uint8_t TbxMbRtuTransmit(tTbxMbTp transport)
          * completion of the transmission.
          */
         tpCtx->state = TBX_MB_RTU_STATE_TRANSMISSION;
+        tpCtx->txDone = TBX_FALSE;
       }
     }
     TbxCriticalSectionExit();
@@ -586,7 +619,7 @@ static uint8_t TbxMbRtuTransmit(tTbxMbTp transport)
        */
       aduPtr[0] = (tpCtx->isClient == TBX_TRUE) ? tpCtx->txPacket.node : tpCtx->nodeAddr;
       /* Populate the ADU tail. For RTU it is the CRC16 right after the PDU's data. */
-      uint16_t adu_crc = TbxMbRtuCalculatCrc(aduPtr, aduLen - 2U);
+      uint16_t adu_crc = TbxMbCrcUpdate(TBX_MB_CRC_INIT, aduPtr, aduLen - 2U);
       aduPtr[aduLen - 2U] = (uint8_t)adu_crc;                         /* CRC16 low.  */
       aduPtr[aduLen - 1U] = (uint8_t)(adu_crc >> 8U);                 /* CRC16 high. */
       /* Pass ADU transmit request on to the UART module. */
@@ -774,25 +807,14 @@ static uint8_t TbxMbRtuValidate(tTbxMbTp transport)
        * CRC.
        */
       tpCtx->diagInfo.busMsgCnt++;
-      /* The ADU for an RTU packet starts at one byte before the PDU, which is the last
-       * byte of head[]. Get the pointer of where the ADU starts in the rxPacket.
-       */
-      uint8_t * aduPtr = &tpCtx->rxPacket.head[TBX_MB_TP_ADU_HEAD_LEN_MAX-1U];
-      /* The CRC16 is stored in the 2 bytes after the PDU data bytes:
-       * - Node address (1 byte)
-       * - Function code (1 byte)
-       * - Packet data (dataLen bytes)
-       * - CRC16 (2 bytes)
-       */
-      uint8_t const * crcPtr = &aduPtr[2U + tpCtx->rxPacket.dataLen];
-      /* Read out the CRC16 stored in the ADU packet. */
-      uint16_t packetCrc = crcPtr[0] | (uint16_t)(crcPtr[1] << 8U);
-      /* Calculate the CRC16 based on the packet contents. It's calculated over the
-       * entire ADU data, just excluding the last two byte with the CRC16.
+      /* The CRC16 was already updated with each chunk of received data, while the ADU
+       * was being received. This running CRC16 includes the two CRC16 bytes at the end
+       * of the ADU. Because the CRC16 is stored low byte first, the running CRC16 of
+       * a correctly received ADU always ends up at zero. So there is no need to walk
+       * over the ADU again here. Also make sure the ADU holds at least the node
+       * address, function code and CRC16.
        */
-      uint16_t calcCrc = TbxMbRtuCalculatCrc(aduPtr, tpCtx->rxPacket.dataLen + 2U);
-      /* Are the two CRC16s a mismatch? */
-      if (packetCrc != calcCrc)
+      if ((tpCtx->rxAduWrIdx < 4U) || (tpCtx->rxCrc != 0U))
       {
         /* Increment the total number of received packets with an incorrect CRC. */
         tpCtx->diagInfo.busCommErrCnt++;
@@ -887,6 +909,7 @@ static void TbxMbRtuTransmitComplete(tTbxMbUartPort port)
         /* Store the time that the transmission completed. */
         TbxCriticalSectionEnter();
         tpCtx->txDoneTime = TbxMbPortTimerCount();
+        tpCtx->txDone = TBX_TRUE;
         TbxCriticalSectionExit();
         /* Instruct the event task to start calling our polling function. Needed to
          * detect the 3.5 character timeout, after which we can transition back to the
@@ -895,7 +918,7 @@ static void TbxMbRtuTransmitComplete(tTbxMbUartPort port)
         tTbxMbEvent newEvent;
         newEvent.context = (void *)tpCtx;
         newEvent.id = TBX_MB_EVENT_ID_START_POLLING;
-        TbxMbOsalEventPost(&newEvent, TBX_TRUE);
+        TbxMbEventPostFromIsr(&newEvent, TBX_MB_OSAL_ISR_SOURCE_UART_TX(port));
       }
     }
   }
@@ -955,6 +978,21 @@ static void TbxMbRtuDataReceived(tTbxMbUartPort         port,
        * byte of head[]. Get the pointer of where the ADU starts in the rxPacket.
        */
       uint8_t volatile * aduPtr = &tpCtx->rxPacket.head[TBX_MB_TP_ADU_HEAD_LEN_MAX-1U];
+      /* Did the 3.5 character time gap after a transmission already elapse, but the
+       * polling function did not yet get the chance to transition back to the IDLE
+       * state? This happens when the event task processes a batch of events before it
+       * calls the polling functions, for example when a server on the same event loop
+       * responds right away. Complete the transmission here, such that the first byte
+       * of the next packet does not get dropped.
+       */
+      uint8_t txCompleted = TBX_FALSE;
+      if ( (tpCtx->state == TBX_MB_RTU_STATE_TRANSMISSION) &&
+           (tpCtx->txDone == TBX_TRUE) &&
+           ((uint16_t)(currentTime - tpCtx->txDoneTime) >= tpCtx->t3_5Ticks) )
+      {
+        tpCtx->state = TBX_MB_RTU_STATE_IDLE;
+        txCompleted = TBX_TRUE;
+      }
       /* Get copy of the state so the we can exit the critical section. */
       uint8_t stateCopy = tpCtx->state;
       TbxCriticalSectionExit();
@@ -1001,6 +1039,8 @@ static void TbxMbRtuDataReceived(tTbxMbUartPort         port,
           }
           /* Update the write indexer into the ADU reception packet. */
           tpCtx->rxAduWrIdx += len;
+          /* Update the running CRC16 with the newly received data. */
+          tpCtx->rxCrc = TbxMbCrcUpdate(tpCtx->rxCrc, data, len);
         }
         TbxCriticalSectionExit();
       }
@@ -1022,16 +1062,31 @@ static void TbxMbRtuDataReceived(tTbxMbUartPort         port,
          * account the bytes that were just written.
          */
         tpCtx->rxAduWrIdx = len;
+        /* Start the running CRC16 with the data that was just written. */
+        tpCtx->rxCrc = TbxMbCrcUpdate(TBX_MB_CRC_INIT, data, len);
         /* Initialize frame OK/NOK flag to okay so far. */
         tpCtx->rxAduOkay = TBX_TRUE;
         TbxCriticalSectionExit();
-        /* Instruct the event task to call our polling function to be able to determine
-         * when the 3.5 character idle time occurred, which marks the end of the packet.
-         */
         tTbxMbEvent newEvent;
-        newEvent.context = (void *)tpCtx;
-        newEvent.id = TBX_MB_EVENT_ID_START_POLLING;
-        TbxMbOsalEventPost(&newEvent, TBX_TRUE);
+        /* Inform the linked channel that the PDU transmission completed, if this
+         * happened here. The event task still calls our polling function, because it
+         * only stops doing so after the poll function completed the transmission.
+         */
+        if (txCompleted == TBX_TRUE)
+        {
+          newEvent.context = tpCtx->channelCtx;
+          newEvent.id = TBX_MB_EVENT_ID_PDU_TRANSMITTED;
+        }
+        /* Otherwise instruct the event task to call our polling function to be able to
+         * determine when the 3.5 character idle time occurred, which marks the end of
+         * the packet.
+         */
+        else
+        {
+          newEvent.context = (void *)tpCtx;
+          newEvent.id = TBX_MB_EVENT_ID_START_POLLING;
+        }
+        TbxMbEventPostFromIsr(&newEvent, TBX_MB_OSAL_ISR_SOURCE_UART_RX(port));
       }
       else
       {
@@ -1042,69 +1097,4 @@ static void TbxMbRtuDataReceived(tTbxMbUartPort         port,
 } /*** end of TbxMbRtuDataReceived ***/
 
 
-/************************************************************************************//**
-** \brief     Calculates the Modbus RTU defined CRC16 checksum over the bytes in the
-**            specified data array.
-** \param     data Pointer to the byte array with data.
-** \param     len Number of data bytes to include in the CRC16 calculation.
-** \return    The calculated CRC16 checksum value.
-**
-****************************************************************************************/
-static uint16_t TbxMbRtuCalculatCrc(uint8_t  const * data, 
-                                    uint16_t         len)
-{
-  /* Lookup table for fast CRC16 calculation. Made static to lower the stack load. */
-  static const uint16_t tbxMbRtuCrcTable[] =
-  {
-    0x0000, 0xC0C1, 0xC181, 0x0140, 0xC301, 0x03C0, 0x0280, 0xC241,
-    0xC601, 0x06C0, 0x0780, 0xC741, 0x0500, 0xC5C1, 0xC481, 0x0440,
-    0xCC01, 0x0CC0, 0x0D80, 0xCD41, 0x0F00, 0xCFC1, 0xCE81, 0x0E40,
-    0x0A00, 0xCAC1, 0xCB81, 0x0B40, 0xC901, 0x09C0, 0x0880, 0xC841,
-    0xD801, 0x18C0, 0x1980, 0xD941, 0x1B00, 0xDBC1, 0xDA81, 0x1A40,
-    0x1E00, 0xDEC1, 0xDF81, 0x1F40, 0xDD01, 0x1DC0, 0x1C80, 0xDC41,
-    0x1400, 0xD4C1, 0xD581, 0x1540, 0xD701, 0x17C0, 0x1680, 0xD641,
-    0xD201, 0x12C0, 0x1380, 0xD341, 0x1100, 0xD1C1, 0xD081, 0x1040,
-    0xF001, 0x30C0, 0x3180, 0xF141, 0x3300, 0xF3C1, 0xF281, 0x3240,
-    0x3600, 0xF6C1, 0xF781, 0x3740, 0xF501, 0x35C0, 0x3480, 0xF441,
-    0x3C00, 0xFCC1, 0xFD81, 0x3D40, 0xFF01, 0x3FC0, 0x3E80, 0xFE41,
-    0xFA01, 0x3AC0, 0x3B80, 0xFB41, 0x3900, 0xF9C1, 0xF881, 0x3840,
-    0x2800, 0xE8C1, 0xE981, 0x2940, 0xEB01, 0x2BC0, 0x2A80, 0xEA41,
-    0xEE01, 0x2EC0, 0x2F80, 0xEF41, 0x2D00, 0xEDC1, 0xEC81, 0x2C40,
-    0xE401, 0x24C0, 0x2580, 0xE541, 0x2700, 0xE7C1, 0xE681, 0x2640,
-    0x2200, 0xE2C1, 0xE381, 0x2340, 0xE101, 0x21C0, 0x2080, 0xE041,
-    0xA001, 0x60C0, 0x6180, 0xA141, 0x6300, 0xA3C1, 0xA281, 0x6240,
-    0x6600, 0xA6C1, 0xA781, 0x6740, 0xA501, 0x65C0, 0x6480, 0xA441,
-    0x6C00, 0xACC1, 0xAD81, 0x6D40, 0xAF01, 0x6FC0, 0x6E80, 0xAE41,
-    0xAA01, 0x6AC0, 0x6B80, 0xAB41, 0x6900, 0xA9C1, 0xA881, 0x6840,
-    0x7800, 0xB8C1, 0xB981, 0x7940, 0xBB01, 0x7BC0, 0x7A80, 0xBA41,
-    0xBE01, 0x7EC0, 0x7F80, 0xBF41, 0x7D00, 0xBDC1, 0xBC81, 0x7C40,
-    0xB401, 0x74C0, 0x7580, 0xB541, 0x7700, 0xB7C1, 0xB681, 0x7640,
-    0x7200, 0xB2C1, 0xB381, 0x7340, 0xB101, 0x71C0, 0x7080, 0xB041,
-    0x5000, 0x90C1, 0x9181, 0x5140, 0x9301, 0x53C0, 0x5280, 0x9241,
-    0x9601, 0x56C0, 0x5780, 0x9741, 0x5500, 0x95C1, 0x9481, 0x5440,
-    0x9C01, 0x5CC0, 0x5D80, 0x9D41, 0x5F00, 0x9FC1, 0x9E81, 0x5E40,
-    0x5A00, 0x9AC1, 0x9B81, 0x5B40, 0x9901, 0x59C0, 0x5880, 0x9841,
-    0x8801, 0x48C0, 0x4980, 0x8941, 0x4B00, 0x8BC1, 0x8A81, 0x4A40,
-    0x4E00, 0x8EC1, 0x8F81, 0x4F40, 0x8D01, 0x4DC0, 0x4C80, 0x8C41,
-    0x4400, 0x84C1, 0x8581, 0x4540, 0x8701, 0x47C0, 0x4680, 0x8641,
-    0x8201, 0x42C0, 0x4380, 0x8341, 0x4100, 0x81C1, 0x8081, 0x4040
-  };
-  uint16_t result = 0U;
-  uint16_t crc = 0xFFFFU;
-
-  /* Loop over all the data bytes. */
-  for (uint16_t byteIdx = 0; byteIdx < len; byteIdx++)
-  {
-    /* Calculate the index into the CRC lookup table. */
-    uint8_t tableIdx = data[byteIdx] ^ crc;
-    crc >>= 8;
-    crc ^= tbxMbRtuCrcTable[tableIdx];
-  }
-  /* Update the result. */
-  result = crc;
-  /* Give the result back to the caller. */
-  return result;
-} /*** end of TbxMbRtuCalculatCrc ***/
-
-
 /*********************************** end of tbxmb_rtu.c ********************************/
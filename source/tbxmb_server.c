@@ -35,6 +35,7 @@
 #include "microtbxmodbus.h"                      /* MicroTBX-Modbus module             */
 #include "tbxmb_event_private.h"                 /* MicroTBX-Modbus event private      */
 #include "tbxmb_osal_private.h"                  /* MicroTBX-Modbus OSAL private       */
+#include "tbxmb_timer_private.h"                 /* MicroTBX-Modbus timer private      */
 #include "tbxmb_tp_private.h"                    /* MicroTBX-Modbus TP private         */
 #include "tbxmb_server_private.h"                /* MicroTBX-Modbus server private     */
 
@@ -45,47 +46,345 @@
 /** \brief Unique context type to identify a context as being a server channel. */
 #define TBX_MB_SERVER_CONTEXT_TYPE     (37U)
 
+/** \brief Maximum number of registers that a single request can access. It determines
+ *         the size of the buffer that the register range callbacks operate on.
+ */
+#define TBX_MB_SERVER_REG_BUF_LEN      (125U)
+
+/** \brief Number of entries in the function code handler table of a server channel,
+ *         with handlers registered by the application. Function codes with the most
+ *         significant bit set are reserved for exception responses, so these never
+ *         need to be dispatched.
+ */
+#define TBX_MB_SERVER_FC_TABLE_LEN     (128U)
+
+/** \brief Number of entries in the table with the built-in function code handlers. It
+ *         only needs to cover up to the highest supported function code.
+ */
+#define TBX_MB_SERVER_FC_HANDLERS_LEN  (TBX_MB_FC43_ENCAPSULATED_INTERFACE + 1U)
+
+#ifndef TBX_MB_SERVER_FC01_ENABLE
+/** \brief Enable (1) or disable (0) the built-in support for function code 01 -
+ *         Read Coils. Disabling a function code that your server does not need,
+ *         removes its handler from the binary. To override this default
+ *         configuration, add a macro with the same name, but with a value of 0, to
+ *         "tbx_conf.h". The same applies to the other function code macros below.
+ */
+#define TBX_MB_SERVER_FC01_ENABLE       (1U)
+#endif
+
+#ifndef TBX_MB_SERVER_FC02_ENABLE
+/** \brief Enable (1) or disable (0) the built-in support for function code 02 -
+ *         Read Discrete Inputs.
+ */
+#define TBX_MB_SERVER_FC02_ENABLE       (1U)
+#endif
+
+#ifndef TBX_MB_SERVER_FC03_ENABLE
+/** \brief Enable (1) or disable (0) the built-in support for function code 03 -
+ *         Read Holding Registers.
+ */
+#define TBX_MB_SERVER_FC03_ENABLE       (1U)
+#endif
+
+#ifndef TBX_MB_SERVER_FC04_ENABLE
+/** \brief Enable (1) or disable (0) the built-in support for function code 04 -
+ *         Read Input Registers.
+ */
+#define TBX_MB_SERVER_FC04_ENABLE       (1U)
+#endif
+
+#ifndef TBX_MB_SERVER_FC05_ENABLE
+/** \brief Enable (1) or disable (0) the built-in support for function code 05 -
+ *         Write Single Coil.
+ */
+#define TBX_MB_SERVER_FC05_ENABLE       (1U)
+#endif
+
+#ifndef TBX_MB_SERVER_FC06_ENABLE
+/** \brief Enable (1) or disable (0) the built-in support for function code 06 -
+ *         Write Single Register.
+ */
+#define TBX_MB_SERVER_FC06_ENABLE       (1U)
+#endif
+
+#ifndef TBX_MB_SERVER_FC08_ENABLE
+/** \brief Enable (1) or disable (0) the built-in support for function code 08 -
+ *         Diagnostics.
+ */
+#define TBX_MB_SERVER_FC08_ENABLE       (1U)
+#endif
+
+#ifndef TBX_MB_SERVER_FC15_ENABLE
+/** \brief Enable (1) or disable (0) the built-in support for function code 15 -
+ *         Write Multiple Coils.
+ */
+#define TBX_MB_SERVER_FC15_ENABLE       (1U)
+#endif
+
+#ifndef TBX_MB_SERVER_FC16_ENABLE
+/** \brief Enable (1) or disable (0) the built-in support for function code 16 -
+ *         Write Multiple Registers.
+ */
+#define TBX_MB_SERVER_FC16_ENABLE       (1U)
+#endif
+
+#ifndef TBX_MB_SERVER_FC20_ENABLE
+/** \brief Enable (1) or disable (0) the built-in support for function code 20 -
+ *         Read File Record.
+ */
+#define TBX_MB_SERVER_FC20_ENABLE       (1U)
+#endif
+
+#ifndef TBX_MB_SERVER_FC21_ENABLE
+/** \brief Enable (1) or disable (0) the built-in support for function code 21 -
+ *         Write File Record.
+ */
+#define TBX_MB_SERVER_FC21_ENABLE       (1U)
+#endif
+
+#ifndef TBX_MB_SERVER_FC22_ENABLE
+/** \brief Enable (1) or disable (0) the built-in support for function code 22 -
+ *         Mask Write Register.
+ */
+#define TBX_MB_SERVER_FC22_ENABLE       (1U)
+#endif
+
+#ifndef TBX_MB_SERVER_FC23_ENABLE
+/** \brief Enable (1) or disable (0) the built-in support for function code 23 -
+ *         Read/Write Multiple Registers.
+ */
+#define TBX_MB_SERVER_FC23_ENABLE       (1U)
+#endif
+
+#ifndef TBX_MB_SERVER_FC24_ENABLE
+/** \brief Enable (1) or disable (0) the built-in support for function code 24 -
+ *         Read FIFO Queue.
+ */
+#define TBX_MB_SERVER_FC24_ENABLE       (1U)
+#endif
+
+#ifndef TBX_MB_SERVER_FC43_ENABLE
+/** \brief Enable (1) or disable (0) the built-in support for function code 43 -
+ *         Encapsulated Interface Transport, with MEI type 14 - Read Device
+ *         Identification.
+ */
+#define TBX_MB_SERVER_FC43_ENABLE       (1U)
+#endif
+
+
+/****************************************************************************************
+* Type definitions
+****************************************************************************************/
+/** \brief Function pointer type for a built-in function code handler. */
+typedef void (* tTbxMbServerFcHandler)(tTbxMbServerCtx       * context,
+                                       tTbxMbTpPacket  const * rxPacket,
+                                       tTbxMbTpPacket        * txPacket);
+
 
 /****************************************************************************************
 * Function prototypes
 ****************************************************************************************/
 static void TbxMbServerProcessEvent          (tTbxMbEvent           * event);
 
+static uint8_t TbxMbServerRegBufAlloc        (tTbxMbServerCtx       * context);
+
+static uint8_t TbxMbServerCallCustom         (tTbxMbServerCtx            * context,
+                                              tTbxMbServerCustomFunction   handler,
+                                              tTbxMbTpPacket       const * rxPacket,
+                                              tTbxMbTpPacket             * txPacket);
+
+static uint8_t TbxMbServerTableContains      (tTbxMbServerTableCtx const * table,
+                                              uint16_t                     addr,
+                                              uint16_t                     num);
+
+static uint8_t TbxMbServerMapIsValid         (tTbxMbServerRegMapEntry const * map,
+                                              uint16_t                        len);
+
+static uint16_t TbxMbServerMapFind           (tTbxMbServerMapCtx const * map,
+                                              uint16_t                   addr);
+
+static uint8_t TbxMbServerMapCovers          (tTbxMbServerMapCtx const * map,
+                                              uint16_t                   addr,
+                                              uint16_t                   num,
+                                              uint8_t                    write);
+
+static tTbxMbServerResult TbxMbServerMapRead (tTbxMbServerCtx          * context,
+                                              tTbxMbServerMapCtx const * map,
+                                              uint16_t                   addr,
+                                              uint8_t                    num,
+                                              uint16_t                 * values);
+
+static tTbxMbServerResult TbxMbServerMapWrite(tTbxMbServerCtx          * context,
+                                              tTbxMbServerMapCtx const * map,
+                                              uint16_t                   addr,
+                                              uint8_t                    num,
+                                              uint16_t           const * values);
+
+static uint8_t TbxMbServerDevIdIsValid       (tTbxMbServerDeviceIdObject const * objects,
+                                              uint16_t                           len);
+
+#if (TBX_MB_SERVER_FC03_ENABLE > 0U) || (TBX_MB_SERVER_FC22_ENABLE > 0U) || \
+    (TBX_MB_SERVER_FC23_ENABLE > 0U)
+static tTbxMbServerResult TbxMbServerHoldingRegsRead(tTbxMbServerCtx       * context,
+                                                     uint16_t                addr,
+                                                     uint8_t                 num,
+                                                     uint8_t               * data);
+#endif
+
+#if (TBX_MB_SERVER_FC16_ENABLE > 0U) || (TBX_MB_SERVER_FC22_ENABLE > 0U) || \
+    (TBX_MB_SERVER_FC23_ENABLE > 0U)
+static tTbxMbServerResult TbxMbServerHoldingRegsWrite(tTbxMbServerCtx       * context,
+                                                      uint16_t                addr,
+                                                      uint8_t                 num,
+                                                      uint8_t         const * data);
+#endif
+
+#if (TBX_MB_SERVER_FC01_ENABLE > 0U)
 static void TbxMbServerFC01ReadCoils         (tTbxMbServerCtx       * context,
                                               tTbxMbTpPacket  const * rxPacket,
                                               tTbxMbTpPacket        * txPacket);
+#endif
 
+#if (TBX_MB_SERVER_FC02_ENABLE > 0U)
 static void TbxMbServerFC02ReadInputs        (tTbxMbServerCtx       * context,
                                               tTbxMbTpPacket  const * rxPacket,
                                               tTbxMbTpPacket        * txPacket);
+#endif
 
+#if (TBX_MB_SERVER_FC03_ENABLE > 0U)
 static void TbxMbServerFC03ReadHoldingRegs   (tTbxMbServerCtx       * context,
                                               tTbxMbTpPacket  const * rxPacket,
                                               tTbxMbTpPacket        * txPacket);
+#endif
 
+#if (TBX_MB_SERVER_FC04_ENABLE > 0U)
 static void TbxMbServerFC04ReadInputRegs     (tTbxMbServerCtx       * context,
                                               tTbxMbTpPacket  const * rxPacket,
                                               tTbxMbTpPacket        * txPacket);
+#endif
 
+#if (TBX_MB_SERVER_FC05_ENABLE > 0U)
 static void TbxMbServerFC05WriteSingleCoil   (tTbxMbServerCtx       * context,
                                               tTbxMbTpPacket  const * rxPacket,
                                               tTbxMbTpPacket        * txPacket);
+#endif
 
+#if (TBX_MB_SERVER_FC06_ENABLE > 0U)
 static void TbxMbServerFC06WriteSingleReg    (tTbxMbServerCtx       * context,
                                               tTbxMbTpPacket  const * rxPacket,
                                               tTbxMbTpPacket        * txPacket);
+#endif
 
+#if (TBX_MB_SERVER_FC08_ENABLE > 0U)
 static void TbxMbServerFC08Diagnostics       (tTbxMbServerCtx       * context,
                                               tTbxMbTpPacket  const * rxPacket,
                                               tTbxMbTpPacket        * txPacket);
+#endif
 
+#if (TBX_MB_SERVER_FC15_ENABLE > 0U)
 static void TbxMbServerFC15WriteMultipleCoils(tTbxMbServerCtx       * context,
                                               tTbxMbTpPacket  const * rxPacket,
                                               tTbxMbTpPacket        * txPacket);
+#endif
 
+#if (TBX_MB_SERVER_FC16_ENABLE > 0U)
 static void TbxMbServerFC16WriteMultipleRegs (tTbxMbServerCtx       * context,
                                               tTbxMbTpPacket  const * rxPacket,
                                               tTbxMbTpPacket        * txPacket);
+#endif
+
+#if (TBX_MB_SERVER_FC20_ENABLE > 0U)
+static void TbxMbServerFC20ReadFileRecord    (tTbxMbServerCtx       * context,
+                                              tTbxMbTpPacket  const * rxPacket,
+                                              tTbxMbTpPacket        * txPacket);
+#endif
+
+#if (TBX_MB_SERVER_FC21_ENABLE > 0U)
+static void TbxMbServerFC21WriteFileRecord   (tTbxMbServerCtx       * context,
+                                              tTbxMbTpPacket  const * rxPacket,
+                                              tTbxMbTpPacket        * txPacket);
+#endif
+
+#if (TBX_MB_SERVER_FC22_ENABLE > 0U)
+static void TbxMbServerFC22MaskWriteReg      (tTbxMbServerCtx       * context,
+                                              tTbxMbTpPacket  const * rxPacket,
+                                              tTbxMbTpPacket        * txPacket);
+#endif
+
+#if (TBX_MB_SERVER_FC23_ENABLE > 0U)
+static void TbxMbServerFC23ReadWriteMultipleRegs(tTbxMbServerCtx       * context,
+                                                 tTbxMbTpPacket  const * rxPacket,
+                                                 tTbxMbTpPacket        * txPacket);
+#endif
+
+#if (TBX_MB_SERVER_FC24_ENABLE > 0U)
+static void TbxMbServerFC24ReadFifoQueue     (tTbxMbServerCtx       * context,
+                                              tTbxMbTpPacket  const * rxPacket,
+                                              tTbxMbTpPacket        * txPacket);
+#endif
+
+#if (TBX_MB_SERVER_FC43_ENABLE > 0U)
+static void TbxMbServerFC43EncapsulatedIf    (tTbxMbServerCtx       * context,
+                                              tTbxMbTpPacket  const * rxPacket,
+                                              tTbxMbTpPacket        * txPacket);
+#endif
+
+
+/****************************************************************************************
+* Local constant declarations
+****************************************************************************************/
+/** \brief Table with the built-in function code handlers, indexed by function code.
+ *         Dispatching a received PDU is a single table lookup.
+ */
+static const tTbxMbServerFcHandler tbxMbServerFcHandlers[TBX_MB_SERVER_FC_HANDLERS_LEN] =
+{
+#if (TBX_MB_SERVER_FC01_ENABLE > 0U)
+  [TBX_MB_FC01_READ_COILS] = TbxMbServerFC01ReadCoils,
+#endif
+#if (TBX_MB_SERVER_FC02_ENABLE > 0U)
+  [TBX_MB_FC02_READ_DISCRETE_INPUTS] = TbxMbServerFC02ReadInputs,
+#endif
+#if (TBX_MB_SERVER_FC03_ENABLE > 0U)
+  [TBX_MB_FC03_READ_HOLDING_REGISTERS] = TbxMbServerFC03ReadHoldingRegs,
+#endif
+#if (TBX_MB_SERVER_FC04_ENABLE > 0U)
+  [TBX_MB_FC04_READ_INPUT_REGISTERS] = TbxMbServerFC04ReadInputRegs,
+#endif
+#if (TBX_MB_SERVER_FC05_ENABLE > 0U)
+  [TBX_MB_FC05_WRITE_SINGLE_COIL] = TbxMbServerFC05WriteSingleCoil,
+#endif
+#if (TBX_MB_SERVER_FC06_ENABLE > 0U)
+  [TBX_MB_FC06_WRITE_SINGLE_REGISTER] = TbxMbServerFC06WriteSingleReg,
+#endif
+#if (TBX_MB_SERVER_FC08_ENABLE > 0U)
+  [TBX_MB_FC08_DIAGNOSTICS] = TbxMbServerFC08Diagnostics,
+#endif
+#if (TBX_MB_SERVER_FC15_ENABLE > 0U)
+  [TBX_MB_FC15_WRITE_MULTIPLE_COILS] = TbxMbServerFC15WriteMultipleCoils,
+#endif
+#if (TBX_MB_SERVER_FC16_ENABLE > 0U)
+  [TBX_MB_FC16_WRITE_MULTIPLE_REGISTERS] = TbxMbServerFC16WriteMultipleRegs,
+#endif
+#if (TBX_MB_SERVER_FC20_ENABLE > 0U)
+  [TBX_MB_FC20_READ_FILE_RECORD] = TbxMbServerFC20ReadFileRecord,
+#endif
+#if (TBX_MB_SERVER_FC21_ENABLE > 0U)
+  [TBX_MB_FC21_WRITE_FILE_RECORD] = TbxMbServerFC21WriteFileRecord,
+#endif
+#if (TBX_MB_SERVER_FC22_ENABLE > 0U)
+  [TBX_MB_FC22_MASK_WRITE_REGISTER] = TbxMbServerFC22MaskWriteReg,
+#endif
+#if (TBX_MB_SERVER_FC23_ENABLE > 0U)
+  [TBX_MB_FC23_READ_WRITE_MULTIPLE_REGISTERS] = TbxMbServerFC23ReadWriteMultipleRegs,
+#endif
+#if (TBX_MB_SERVER_FC24_ENABLE > 0U)
+  [TBX_MB_FC24_READ_FIFO_QUEUE] = TbxMbServerFC24ReadFifoQueue,
+#endif
+#if (TBX_MB_SERVER_FC43_ENABLE > 0U)
+  [TBX_MB_FC43_ENCAPSULATED_INTERFACE] = TbxMbServerFC43EncapsulatedIf,
+#endif
+};
 
 
 /************************************************************************************//**
@@ -125,6 +424,8 @@ tTbxMbServer TbxMbServerCreate(tTbxMbTp transport)
     {
       /* Convert the TP channel pointer to the context structure. */
       tTbxMbTpCtx * tpCtx = (tTbxMbTpCtx *)transport;
+      /* Data table context without a registered data table. */
+      tTbxMbServerTableCtx const emptyTable = { NULL, NULL, 0U, 0U };
       /* Sanity check on the transport layer's interface function. That way there is 
        * no need to do it later on, making it more run-time efficient. Also check that
        * it's not already linked to another channel.
@@ -137,6 +438,8 @@ tTbxMbServer TbxMbServerCreate(tTbxMbTp transport)
       newServerCtx->instancePtr = NULL;
       newServerCtx->pollFcn = NULL;
       newServerCtx->processFcn = TbxMbServerProcessEvent;
+      TbxMbTimerInit(&newServerCtx->pollTimer, newServerCtx);
+      newServerCtx->eventLoop = tpCtx->eventLoop;
       newServerCtx->readInputFcn = NULL;
       newServerCtx->readCoilFcn = NULL;
       newServerCtx->writeCoilFcn = NULL;
@@ -144,6 +447,32 @@ tTbxMbServer TbxMbServerCreate(tTbxMbTp transport)
       newServerCtx->readHoldingRegFcn = NULL;
       newServerCtx->writeHoldingRegFcn = NULL;
       newServerCtx->customFunctionFcn = NULL;
+      newServerCtx->readInputRegsFcn = NULL;
+      newServerCtx->readHoldingRegsFcn = NULL;
+      newServerCtx->writeHoldingRegsFcn = NULL;
+      newServerCtx->readInputsFcn = NULL;
+      newServerCtx->readCoilsFcn = NULL;
+      newServerCtx->writeCoilsFcn = NULL;
+      newServerCtx->regBuf = NULL;
+      newServerCtx->inputTbl = emptyTable;
+      newServerCtx->coilTbl = emptyTable;
+      newServerCtx->inputRegTbl = emptyTable;
+      newServerCtx->holdingRegTbl = emptyTable;
+      newServerCtx->tableWrittenFcn = NULL;
+      newServerCtx->inputRegMap.entries = NULL;
+      newServerCtx->inputRegMap.len = 0U;
+      newServerCtx->holdingRegMap.entries = NULL;
+      newServerCtx->holdingRegMap.len = 0U;
+      newServerCtx->fcTable = NULL;
+      newServerCtx->devId.objects = NULL;
+      newServerCtx->devId.len = 0U;
+      newServerCtx->readFileRecordFcn = NULL;
+      newServerCtx->writeFileRecordFcn = NULL;
+      newServerCtx->fifo.buffer = NULL;
+      newServerCtx->fifo.size = 0U;
+      newServerCtx->fifo.addr = 0U;
+      newServerCtx->fifo.head = 0U;
+      newServerCtx->fifo.tail = 0U;
       newServerCtx->tpCtx = tpCtx;
       newServerCtx->tpCtx->channelCtx = newServerCtx;
       newServerCtx->tpCtx->isClient = TBX_FALSE;
@@ -183,6 +512,18 @@ void TbxMbServerFree(tTbxMbServer channel)
     serverCtx->pollFcn = NULL;
     serverCtx->processFcn = NULL;
     TbxCriticalSectionExit();
+    /* Give the register range buffer back to the memory pool, if allocated. */
+    if (serverCtx->regBuf != NULL)
+    {
+      TbxMemPoolRelease(serverCtx->regBuf);
+      serverCtx->regBuf = NULL;
+    }
+    /* Give the function code handler table back to the memory pool, if allocated. */
+    if (serverCtx->fcTable != NULL)
+    {
+      TbxMemPoolRelease(serverCtx->fcTable);
+      serverCtx->fcTable = NULL;
+    }
     /* Give the channel context back to the memory pool. */
     TbxMemPoolRelease(serverCtx);
   }
@@ -388,336 +729,1917 @@ void TbxMbServerSetCallbackCustomFunction(tTbxMbServer               channel,
 
 
 /************************************************************************************//**
-** \brief     Event processing function that is automatically called when an event for
-**            this server channel object was received in TbxMbEventTask().
-** \param     event Pointer to the event to process. Note that the event->context points
-**            to the handle of the Modbus server channel object.
+** \brief     Registers the callback function that this server calls, whenever a client
+**            requests the reading of a range of input registers. Optional alternative
+**            to TbxMbServerSetCallbackReadInputReg(). When registered, the server
+**            prefers this callback, which results in just one callback call per request.
+** \param     channel Handle to the Modbus server channel object.
+** \param     callback Pointer to the callback function.
 **
 ****************************************************************************************/
-static void TbxMbServerProcessEvent(tTbxMbEvent * event)
+void TbxMbServerSetCallbackReadInputRegs(tTbxMbServer              channel,
+                                         tTbxMbServerReadInputRegs callback)
 {
   /* Verify parameters. */
-  TBX_ASSERT(event != NULL);
+  TBX_ASSERT((channel != NULL) && (callback != NULL));
 
   /* Only continue with valid parameters. */
-  if (event != NULL)
+  if ((channel != NULL) && (callback != NULL))
   {
-    /* Sanity check the context. */
-    TBX_ASSERT(event->context != NULL);
-    /* Convert the event context to the server channel context structure. */
-    tTbxMbServerCtx * serverCtx = (tTbxMbServerCtx *)event->context;
-    /* Make sure the context is valid. */
-    TBX_ASSERT(serverCtx != NULL);
-    /* Only continue with a valid context. */
-    if (serverCtx != NULL)
+    /* Convert the server channel pointer to the context structure. */
+    tTbxMbServerCtx * serverCtx = (tTbxMbServerCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(serverCtx->type == TBX_MB_SERVER_CONTEXT_TYPE);
+    /* Only continue if the buffer for the register values is available. */
+    if (TbxMbServerRegBufAlloc(serverCtx) == TBX_OK)
     {
-      /* Sanity check on the context type. */
-      TBX_ASSERT(serverCtx->type == TBX_MB_SERVER_CONTEXT_TYPE);
-      /* Filter on the event identifier. */
-      switch (event->id)
-      {
-        case TBX_MB_EVENT_ID_PDU_RECEIVED:
-        {
-          uint8_t okayToSendResponse = TBX_FALSE;
-          /* Obtain read access to the newly received packet and write access to the
-           * response packet. 
-           */
-          tTbxMbTpPacket * rxPacket = serverCtx->tpCtx->getRxPacketFcn(serverCtx->tpCtx);
-          tTbxMbTpPacket * txPacket = serverCtx->tpCtx->getTxPacketFcn(serverCtx->tpCtx);
-          /* Since we're requested to process a newly received PDU, these packet accesses
-           * should always succeed. Sanity check anyways, just in case.
-           */
-          TBX_ASSERT((rxPacket != NULL) && (txPacket != NULL));
-          /* Only continue with packet access. */
-          if ((rxPacket != NULL) && (txPacket != NULL))
-          {
-            /* Update flag that we can actually send a response, now that we know we 
-             * have access to txPacket.
-             */
-            okayToSendResponse = TBX_TRUE;
-            /* Prepare the response packet function code. */
-            txPacket->pdu.code = rxPacket->pdu.code;
-            /* Filter on the function code. */
-            switch (rxPacket->pdu.code)
-            {
-              /* ---------------- FC01 - Read Coils ---------------------------------- */
-              case TBX_MB_FC01_READ_COILS:
-              {
-                TbxMbServerFC01ReadCoils(serverCtx, rxPacket, txPacket);
-              }
-              break;
-
-              /* ---------------- FC02 - Read Discrete Inputs ------------------------ */
-              case TBX_MB_FC02_READ_DISCRETE_INPUTS:
-              {
-                TbxMbServerFC02ReadInputs(serverCtx, rxPacket, txPacket);
-              }
-              break;
-
-              /* ---------------- FC03 - Read Holding Registers ---------------------- */
-              case TBX_MB_FC03_READ_HOLDING_REGISTERS:
-              {
-                TbxMbServerFC03ReadHoldingRegs(serverCtx, rxPacket, txPacket);
-              }
-              break;
-
-              /* ---------------- FC04 - Read Input Registers ------------------------ */
-              case TBX_MB_FC04_READ_INPUT_REGISTERS:
-              {
-                TbxMbServerFC04ReadInputRegs(serverCtx, rxPacket, txPacket);
-              }
-              break;
-
-              /* ---------------- FC05 - Write Single Coil --------------------------- */
-              case TBX_MB_FC05_WRITE_SINGLE_COIL:
-              {
-                TbxMbServerFC05WriteSingleCoil(serverCtx, rxPacket, txPacket);
-              }
-              break;
-
-              /* ---------------- FC06 - Write Single Register ----------------------- */
-              case TBX_MB_FC06_WRITE_SINGLE_REGISTER:
-              {
-                TbxMbServerFC06WriteSingleReg(serverCtx, rxPacket, txPacket);
-              }
-              break;
-
-              /* ---------------- FC08 - Diagnostics --------------------------------- */
-              case TBX_MB_FC08_DIAGNOSTICS:
-              {
-                TbxMbServerFC08Diagnostics(serverCtx, rxPacket, txPacket);
-              }
-              break;
-
-              /* ---------------- FC15 - Write Multiple Coils ------------------------ */
-              case TBX_MB_FC15_WRITE_MULTIPLE_COILS:
-              {
-                TbxMbServerFC15WriteMultipleCoils(serverCtx, rxPacket, txPacket);
-              }
-              break;
-
-              /* ---------------- FC16 - Write Multiple Registers -------------------- */
-              case TBX_MB_FC16_WRITE_MULTIPLE_REGISTERS:
-              {
-                TbxMbServerFC16WriteMultipleRegs(serverCtx, rxPacket, txPacket);
-              }
-              break;
-
-              /* ---------------- Unsupported function code -------------------------- */
-              default:
-              {
-                uint8_t handled = TBX_FALSE;
-
-                /* Is a custom function code callback configured? */
-                if (serverCtx->customFunctionFcn != NULL)
-                {
-                  /* Prepare callback parameters. */
-                  uint8_t const * rxPdu  = &rxPacket->pdu.code;
-                  uint8_t       * txPdu  = &txPacket->pdu.code;
-                  uint8_t         pduLen = rxPacket->dataLen + 1U;
-                  /* Call the custom function code callback. */
-                  handled = serverCtx->customFunctionFcn(serverCtx, rxPdu, txPdu, 
-                                                         &pduLen);
-                  /* Did the callback process the PDU and prepare a response? */
-                  if (handled == TBX_TRUE)
-                  {
-                    /* Set the response data length. */
-                    txPacket->dataLen = pduLen - 1U;
-                  }
-                }
-                /* Did the custom function code callback not handle the PDU? */
-                if (handled == TBX_FALSE)
-                {
-                  /* This function code is currently not supported. */
-                  txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-                  txPacket->pdu.data[0] = TBX_MB_EC01_ILLEGAL_FUNCTION;
-                  txPacket->dataLen = 1U;
-                }
-              }
-              break;
-            }
-          }
-          /* Inform the transport layer that were done with the rx packet and no longer
-           * need access to it.
-           */
-          serverCtx->tpCtx->receptionDoneFcn(serverCtx->tpCtx);
-          /* Request the transport layer to transmit the response. Note that
-           * transmitFcn() should only be called after calling receptionDoneFcn().
-           */
-          if (okayToSendResponse == TBX_TRUE)
-          {
-            (void)serverCtx->tpCtx->transmitFcn(serverCtx->tpCtx);
-          }
-        }
-        break;
-      
-        case TBX_MB_EVENT_ID_PDU_TRANSMITTED:
-        {
-          /* At this point no additional event handling is needed on this channel upon
-           * PDU transmission completion.
-           */
-        }
-        break;
-
-        default:
-        {
-          /* An unsupported event was dispatched to us. Should not happen. */
-          TBX_ASSERT(TBX_FALSE);
-        }
-        break;
-      }
+      /* Store the callback function pointer. */
+      TbxCriticalSectionEnter();
+      serverCtx->readInputRegsFcn = callback;
+      TbxCriticalSectionExit();
     }
   }
-} /*** end of TbxMbServerProcessEvent ***/
+} /*** end of TbxMbServerSetCallbackReadInputRegs ***/
 
 
 /************************************************************************************//**
-** \brief     Handles a newly received PDU for function code 1 - Read Coils.
-** \details   Note that this function is called at a time that txPacket->code is already
-**            prepared. Also note that txPacket->node should not be touched here.
-** \param     context Pointer to the Modbus server channel context.
-** \param     rxPacket Received PDU packet with MUX access.
-** \param     txPacket Storage for the PDU response packet with MUX access.
+** \brief     Registers the callback function that this server calls, whenever a client
+**            requests the reading of a range of holding registers. Optional alternative
+**            to TbxMbServerSetCallbackReadHoldingReg(). When registered, the server
+**            prefers this callback, which results in just one callback call per request.
+** \param     channel Handle to the Modbus server channel object.
+** \param     callback Pointer to the callback function.
 **
 ****************************************************************************************/
-static void TbxMbServerFC01ReadCoils(tTbxMbServerCtx       * context,
-                                     tTbxMbTpPacket  const * rxPacket,
-                                     tTbxMbTpPacket        * txPacket)
+void TbxMbServerSetCallbackReadHoldingRegs(tTbxMbServer                channel,
+                                           tTbxMbServerReadHoldingRegs callback)
 {
   /* Verify parameters. */
-  TBX_ASSERT((context != NULL) && (rxPacket != NULL) && (txPacket != NULL));
+  TBX_ASSERT((channel != NULL) && (callback != NULL));
 
   /* Only continue with valid parameters. */
-  if ((context != NULL) && (rxPacket != NULL) && (txPacket != NULL))
+  if ((channel != NULL) && (callback != NULL))
   {
-    /* Read out request packet parameters. */
-    uint16_t startAddr = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]);
-    uint16_t numCoils  = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[2]);
-
-    /* Check if a callback function was registered. */
-    if (context->readCoilFcn == NULL)
-    {
-      /* Prepare exception response. */
-      txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-      txPacket->pdu.data[0] = TBX_MB_EC01_ILLEGAL_FUNCTION;
-      txPacket->dataLen = 1U;
-    }
-    /* Check if the quantity of coils is invalid. */
-    else if ((numCoils < 1U) || (numCoils > 2000U))
-    {
-      /* Prepare exception response. */
-      txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-      txPacket->pdu.data[0] = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
-      txPacket->dataLen = 1U;
-    }
-    /* All is good for further processing. */
-    else
+    /* Convert the server channel pointer to the context structure. */
+    tTbxMbServerCtx * serverCtx = (tTbxMbServerCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(serverCtx->type == TBX_MB_SERVER_CONTEXT_TYPE);
+    /* Only continue if the buffer for the register values is available. */
+    if (TbxMbServerRegBufAlloc(serverCtx) == TBX_OK)
     {
-      /* Determine the number of bytes needed to hold all the coil bits. The cast to
-       * U8 is okay, because we know that numCoils is <= 2000.
-       */
-      uint8_t numBytes = (uint8_t)(numCoils / 8U);
-      if ((numCoils % 8U) != 0U)
-      {
-        numBytes++;
-      }
-      /* Store byte count in the response and prepare the data length. */
-      txPacket->pdu.data[0] = numBytes;
-      txPacket->dataLen = txPacket->pdu.data[0] + 1U;
-      /* Prepare loop indices that aid with storing the coil bits. */
-      uint8_t   bitIdx  = 0U;
-      uint8_t   byteIdx = 0U;
-      /* Initialize byte array pointer for writing the coil bits in the response and
-       * already initialize the first byte to all zero (coils OFF) bits.
-       */
-      uint8_t * coilData = &txPacket->pdu.data[1];
-      coilData[0] = 0U;
-      /* Loop through all the coils. */
-      for (uint16_t idx = 0U; idx < numCoils; idx++)
-      {
-        uint8_t            coilValue = TBX_OFF;
-        tTbxMbServerResult srvResult;
-        /* Obtain coil value. */
-        srvResult = context->readCoilFcn(context, startAddr + idx, &coilValue);
-        /* No exception reported? */
-        if (srvResult == TBX_MB_SERVER_OK)
-        {
-          /* Store the coil value in the response. Note that the coil bits in a byte are
-           * initialized to all zeroes, so only update if a coil is in the ON state.
-           */
-          if (coilValue != TBX_OFF)
-          {
-            coilData[byteIdx] |= (1U << bitIdx);
-          }
-          /* Update the bit index. */
-          bitIdx++;
-          /* Time to move to the next byte? */
-          if (bitIdx == 8U)
-          {
-            /* Reset the bit index, increment the byte index and initialize the byte to
-             * all zero (coils OFF) bits.
-             */
-            bitIdx = 0U;
-            byteIdx++;
-            coilData[byteIdx] = 0U;
-          }
-        }
-        /* Exception detected. */
-        else
-        {
-          /* Prepare exception response. */
-          txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-          if (srvResult == TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR)
-          {
-            txPacket->pdu.data[0] = TBX_MB_EC02_ILLEGAL_DATA_ADDRESS;
-          }
-          else
-          {
-            txPacket->pdu.data[0] = TBX_MB_EC04_SERVER_DEVICE_FAILURE;
-          }
-          txPacket->dataLen = 1U;
-          /* Stop looping. */
-          break;
-        }
-      }
+      /* Store the callback function pointer. */
+      TbxCriticalSectionEnter();
+      serverCtx->readHoldingRegsFcn = callback;
+      TbxCriticalSectionExit();
     }
   }
-} /*** end of TbxMbServerFC01ReadCoils ***/
+} /*** end of TbxMbServerSetCallbackReadHoldingRegs ***/
 
 
 /************************************************************************************//**
-** \brief     Handles a newly received PDU for function code 2 - Read Discrete Inputs.
-** \details   Note that this function is called at a time that txPacket->code is already
-**            prepared. Also note that txPacket->node should not be touched here.
-** \param     context Pointer to the Modbus server channel context.
-** \param     rxPacket Received PDU packet with MUX access.
-** \param     txPacket Storage for the PDU response packet with MUX access.
+** \brief     Registers the callback function that this server calls, whenever a client
+**            requests the writing of a range of holding registers. Optional alternative
+**            to TbxMbServerSetCallbackWriteHoldingReg(). When registered, the server
+**            prefers this callback, which results in just one callback call per request.
+** \param     channel Handle to the Modbus server channel object.
+** \param     callback Pointer to the callback function.
 **
 ****************************************************************************************/
-static void TbxMbServerFC02ReadInputs(tTbxMbServerCtx       * context,
-                                      tTbxMbTpPacket  const * rxPacket,
-                                      tTbxMbTpPacket        * txPacket)
+void TbxMbServerSetCallbackWriteHoldingRegs(tTbxMbServer                 channel,
+                                            tTbxMbServerWriteHoldingRegs callback)
 {
   /* Verify parameters. */
-  TBX_ASSERT((context != NULL) && (rxPacket != NULL) && (txPacket != NULL));
+  TBX_ASSERT((channel != NULL) && (callback != NULL));
 
   /* Only continue with valid parameters. */
-  if ((context != NULL) && (rxPacket != NULL) && (txPacket != NULL))
+  if ((channel != NULL) && (callback != NULL))
   {
-    /* Read out request packet parameters. */
-    uint16_t startAddr = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]);
-    uint16_t numInputs = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[2]);
-
-    /* Check if a callback function was registered. */
-    if (context->readInputFcn == NULL)
+    /* Convert the server channel pointer to the context structure. */
+    tTbxMbServerCtx * serverCtx = (tTbxMbServerCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(serverCtx->type == TBX_MB_SERVER_CONTEXT_TYPE);
+    /* Only continue if the buffer for the register values is available. */
+    if (TbxMbServerRegBufAlloc(serverCtx) == TBX_OK)
     {
-      /* Prepare exception response. */
-      txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-      txPacket->pdu.data[0] = TBX_MB_EC01_ILLEGAL_FUNCTION;
+      /* Store the callback function pointer. */
+      TbxCriticalSectionEnter();
+      serverCtx->writeHoldingRegsFcn = callback;
+      TbxCriticalSectionExit();
+    }
+  }
+} /*** end of TbxMbServerSetCallbackWriteHoldingRegs ***/
+
+
+/************************************************************************************//**
+** \brief     Registers the callback function that this server calls, whenever a client
+**            requests the reading of a range of discrete inputs. Optional alternative
+**            to TbxMbServerSetCallbackReadInput(). When registered, the server prefers
+**            this callback, which results in just one callback call per request. The
+**            input states are exchanged as a packed bit array, directly in the response
+**            packet.
+** \param     channel Handle to the Modbus server channel object.
+** \param     callback Pointer to the callback function.
+**
+****************************************************************************************/
+void TbxMbServerSetCallbackReadInputs(tTbxMbServer           channel,
+                                      tTbxMbServerReadInputs callback)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((channel != NULL) && (callback != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (callback != NULL))
+  {
+    /* Convert the server channel pointer to the context structure. */
+    tTbxMbServerCtx * serverCtx = (tTbxMbServerCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(serverCtx->type == TBX_MB_SERVER_CONTEXT_TYPE);
+    /* Store the callback function pointer. */
+    TbxCriticalSectionEnter();
+    serverCtx->readInputsFcn = callback;
+    TbxCriticalSectionExit();
+  }
+} /*** end of TbxMbServerSetCallbackReadInputs ***/
+
+
+/************************************************************************************//**
+** \brief     Registers the callback function that this server calls, whenever a client
+**            requests the reading of a range of coils. Optional alternative to
+**            TbxMbServerSetCallbackReadCoil(). When registered, the server prefers this
+**            callback, which results in just one callback call per request. The coil
+**            states are exchanged as a packed bit array, directly in the response
+**            packet.
+** \param     channel Handle to the Modbus server channel object.
+** \param     callback Pointer to the callback function.
+**
+****************************************************************************************/
+void TbxMbServerSetCallbackReadCoils(tTbxMbServer          channel,
+                                     tTbxMbServerReadCoils callback)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((channel != NULL) && (callback != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (callback != NULL))
+  {
+    /* Convert the server channel pointer to the context structure. */
+    tTbxMbServerCtx * serverCtx = (tTbxMbServerCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(serverCtx->type == TBX_MB_SERVER_CONTEXT_TYPE);
+    /* Store the callback function pointer. */
+    TbxCriticalSectionEnter();
+    serverCtx->readCoilsFcn = callback;
+    TbxCriticalSectionExit();
+  }
+} /*** end of TbxMbServerSetCallbackReadCoils ***/
+
+
+/************************************************************************************//**
+** \brief     Registers the callback function that this server calls, whenever a client
+**            requests the writing of a range of coils. Optional alternative to
+**            TbxMbServerSetCallbackWriteCoil(). When registered, the server prefers this
+**            callback, which results in just one callback call per request. The coil
+**            states are exchanged as a packed bit array, directly from the request
+**            packet.
+** \param     channel Handle to the Modbus server channel object.
+** \param     callback Pointer to the callback function.
+**
+****************************************************************************************/
+void TbxMbServerSetCallbackWriteCoils(tTbxMbServer           channel,
+                                      tTbxMbServerWriteCoils callback)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((channel != NULL) && (callback != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (callback != NULL))
+  {
+    /* Convert the server channel pointer to the context structure. */
+    tTbxMbServerCtx * serverCtx = (tTbxMbServerCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(serverCtx->type == TBX_MB_SERVER_CONTEXT_TYPE);
+    /* Store the callback function pointer. */
+    TbxCriticalSectionEnter();
+    serverCtx->writeCoilsFcn = callback;
+    TbxCriticalSectionExit();
+  }
+} /*** end of TbxMbServerSetCallbackWriteCoils ***/
+
+
+/************************************************************************************//**
+** \brief     Registers a data table with discrete inputs. The server serves requests
+**            for discrete inputs within the address range of the data table directly
+**            from the specified bit array, without calling the callback function.
+**            Requests for discrete inputs outside of this address range still go to the
+**            callback function, if registered.
+** \details   The bit array is packed in the same way as in the Modbus packet: bit 0 of
+**            bits[0] holds the discrete input at address "addr", bit 1 of bits[0] the
+**            one at address "addr + 1", and so on. The application owns the bit array
+**            and must keep it valid as long as the server channel exists.
+** \param     channel Handle to the Modbus server channel object.
+** \param     addr Address of the first discrete input in the data table (0..65535).
+** \param     num Number of discrete inputs in the data table.
+** \param     bits Pointer to the bit array with the discrete input values.
+**
+****************************************************************************************/
+void TbxMbServerSetTableInputs(tTbxMbServer          channel,
+                               uint16_t              addr,
+                               uint16_t              num,
+                               uint8_t       const * bits)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((channel != NULL) && (bits != NULL) && (num > 0U) &&
+             (((uint32_t)addr + num) <= 65536UL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (bits != NULL) && (num > 0U) &&
+      (((uint32_t)addr + num) <= 65536UL))
+  {
+    /* Convert the server channel pointer to the context structure. */
+    tTbxMbServerCtx * serverCtx = (tTbxMbServerCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(serverCtx->type == TBX_MB_SERVER_CONTEXT_TYPE);
+    /* Store the data table. */
+    TbxCriticalSectionEnter();
+    serverCtx->inputTbl.rdData = bits;
+    serverCtx->inputTbl.wrData = NULL;
+    serverCtx->inputTbl.addr = addr;
+    serverCtx->inputTbl.num = num;
+    TbxCriticalSectionExit();
+  }
+} /*** end of TbxMbServerSetTableInputs ***/
+
+
+/************************************************************************************//**
+** \brief     Registers a data table with coils. The server serves requests for coils
+**            within the address range of the data table directly from and to the
+**            specified bit array, without calling the callback functions. Requests for
+**            coils outside of this address range still go to the callback functions,
+**            if registered.
+** \details   The bit array is packed in the same way as in the Modbus packet: bit 0 of
+**            bits[0] holds the coil at address "addr", bit 1 of bits[0] the one at
+**            address "addr + 1", and so on. The application owns the bit array and must
+**            keep it valid as long as the server channel exists.
+** \param     channel Handle to the Modbus server channel object.
+** \param     addr Address of the first coil in the data table (0..65535).
+** \param     num Number of coils in the data table.
+** \param     bits Pointer to the bit array with the coil values.
+**
+****************************************************************************************/
+void TbxMbServerSetTableCoils(tTbxMbServer          channel,
+                              uint16_t              addr,
+                              uint16_t              num,
+                              uint8_t             * bits)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((channel != NULL) && (bits != NULL) && (num > 0U) &&
+             (((uint32_t)addr + num) <= 65536UL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (bits != NULL) && (num > 0U) &&
+      (((uint32_t)addr + num) <= 65536UL))
+  {
+    /* Convert the server channel pointer to the context structure. */
+    tTbxMbServerCtx * serverCtx = (tTbxMbServerCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(serverCtx->type == TBX_MB_SERVER_CONTEXT_TYPE);
+    /* Store the data table. */
+    TbxCriticalSectionEnter();
+    serverCtx->coilTbl.rdData = bits;
+    serverCtx->coilTbl.wrData = bits;
+    serverCtx->coilTbl.addr = addr;
+    serverCtx->coilTbl.num = num;
+    TbxCriticalSectionExit();
+  }
+} /*** end of TbxMbServerSetTableCoils ***/
+
+
+/************************************************************************************//**
+** \brief     Registers a data table with input registers. The server serves requests
+**            for input registers within the address range of the data table directly
+**            from the specified array, without calling the callback functions. Requests
+**            for input registers outside of this address range still go to the callback
+**            functions, if registered.
+** \details   The array holds the register values in your CPUs native endianess. The
+**            application owns the array and must keep it valid as long as the server
+**            channel exists.
+** \param     channel Handle to the Modbus server channel object.
+** \param     addr Address of the first input register in the data table (0..65535).
+** \param     num Number of input registers in the data table.
+** \param     regs Pointer to the array with the input register values.
+**
+****************************************************************************************/
+void TbxMbServerSetTableInputRegs(tTbxMbServer          channel,
+                                  uint16_t              addr,
+                                  uint16_t              num,
+                                  uint16_t      const * regs)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((channel != NULL) && (regs != NULL) && (num > 0U) &&
+             (((uint32_t)addr + num) <= 65536UL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (regs != NULL) && (num > 0U) &&
+      (((uint32_t)addr + num) <= 65536UL))
+  {
+    /* Convert the server channel pointer to the context structure. */
+    tTbxMbServerCtx * serverCtx = (tTbxMbServerCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(serverCtx->type == TBX_MB_SERVER_CONTEXT_TYPE);
+    /* Store the data table. */
+    TbxCriticalSectionEnter();
+    serverCtx->inputRegTbl.rdData = regs;
+    serverCtx->inputRegTbl.wrData = NULL;
+    serverCtx->inputRegTbl.addr = addr;
+    serverCtx->inputRegTbl.num = num;
+    TbxCriticalSectionExit();
+  }
+} /*** end of TbxMbServerSetTableInputRegs ***/
+
+
+/************************************************************************************//**
+** \brief     Registers a data table with holding registers. The server serves requests
+**            for holding registers within the address range of the data table directly
+**            from and to the specified array, without calling the callback functions.
+**            Requests for holding registers outside of this address range still go to
+**            the callback functions, if registered.
+** \details   The array holds the register values in your CPUs native endianess. The
+**            application owns the array and must keep it valid as long as the server
+**            channel exists.
+** \param     channel Handle to the Modbus server channel object.
+** \param     addr Address of the first holding register in the data table (0..65535).
+** \param     num Number of holding registers in the data table.
+** \param     regs Pointer to the array with the holding register values.
+**
+****************************************************************************************/
+void TbxMbServerSetTableHoldingRegs(tTbxMbServer          channel,
+                                    uint16_t              addr,
+                                    uint16_t              num,
+                                    uint16_t            * regs)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((channel != NULL) && (regs != NULL) && (num > 0U) &&
+             (((uint32_t)addr + num) <= 65536UL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (regs != NULL) && (num > 0U) &&
+      (((uint32_t)addr + num) <= 65536UL))
+  {
+    /* Convert the server channel pointer to the context structure. */
+    tTbxMbServerCtx * serverCtx = (tTbxMbServerCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(serverCtx->type == TBX_MB_SERVER_CONTEXT_TYPE);
+    /* Store the data table. */
+    TbxCriticalSectionEnter();
+    serverCtx->holdingRegTbl.rdData = regs;
+    serverCtx->holdingRegTbl.wrData = regs;
+    serverCtx->holdingRegTbl.addr = addr;
+    serverCtx->holdingRegTbl.num = num;
+    TbxCriticalSectionExit();
+  }
+} /*** end of TbxMbServerSetTableHoldingRegs ***/
+
+
+/************************************************************************************//**
+** \brief     Registers the callback function that this server calls, right after a
+**            client wrote to one of the registered data tables.
+** \param     channel Handle to the Modbus server channel object.
+** \param     callback Pointer to the callback function.
+**
+****************************************************************************************/
+void TbxMbServerSetCallbackTableWritten(tTbxMbServer             channel,
+                                        tTbxMbServerTableWritten callback)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((channel != NULL) && (callback != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (callback != NULL))
+  {
+    /* Convert the server channel pointer to the context structure. */
+    tTbxMbServerCtx * serverCtx = (tTbxMbServerCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(serverCtx->type == TBX_MB_SERVER_CONTEXT_TYPE);
+    /* Store the callback function pointer. */
+    TbxCriticalSectionEnter();
+    serverCtx->tableWrittenFcn = callback;
+    TbxCriticalSectionExit();
+  }
+} /*** end of TbxMbServerSetCallbackTableWritten ***/
+
+
+/************************************************************************************//**
+** \brief     Registers a register map with input registers. The server looks up the
+**            requested input registers in the map with a binary search and copies
+**            consecutive registers one run at a time. Requests for input registers that
+**            are not in the map still go to the callback functions, if registered.
+** \details   The map is an array of entries, sorted on their address in ascending order
+**            and without overlapping runs. The application owns the map and must keep
+**            it valid as long as the server channel exists.
+** \param     channel Handle to the Modbus server channel object.
+** \param     map Pointer to the array with register map entries.
+** \param     len Number of entries in the register map.
+**
+****************************************************************************************/
+void TbxMbServerSetMapInputRegs(tTbxMbServer                    channel,
+                                tTbxMbServerRegMapEntry const * map,
+                                uint16_t                        len)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((channel != NULL) && (map != NULL) && (len > 0U));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (map != NULL) && (len > 0U))
+  {
+    /* Convert the server channel pointer to the context structure. */
+    tTbxMbServerCtx * serverCtx = (tTbxMbServerCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(serverCtx->type == TBX_MB_SERVER_CONTEXT_TYPE);
+    /* Verify that the map is sorted and that all its entries are valid. */
+    uint8_t mapValid = TbxMbServerMapIsValid(map, len);
+    TBX_ASSERT(mapValid == TBX_TRUE);
+    /* Only continue with a valid map and if the buffer for the register values is
+     * available.
+     */
+    if (mapValid == TBX_TRUE)
+    {
+      if (TbxMbServerRegBufAlloc(serverCtx) == TBX_OK)
+      {
+        /* Store the register map. */
+        TbxCriticalSectionEnter();
+        serverCtx->inputRegMap.entries = map;
+        serverCtx->inputRegMap.len = len;
+        TbxCriticalSectionExit();
+      }
+    }
+  }
+} /*** end of TbxMbServerSetMapInputRegs ***/
+
+
+/************************************************************************************//**
+** \brief     Registers a register map with holding registers. The server looks up the
+**            requested holding registers in the map with a binary search and copies
+**            consecutive registers one run at a time. Requests for holding registers
+**            that are not in the map still go to the callback functions, if registered.
+** \details   The map is an array of entries, sorted on their address in ascending order
+**            and without overlapping runs. The application owns the map and must keep
+**            it valid as long as the server channel exists.
+** \param     channel Handle to the Modbus server channel object.
+** \param     map Pointer to the array with register map entries.
+** \param     len Number of entries in the register map.
+**
+****************************************************************************************/
+void TbxMbServerSetMapHoldingRegs(tTbxMbServer                    channel,
+                                  tTbxMbServerRegMapEntry const * map,
+                                  uint16_t                        len)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((channel != NULL) && (map != NULL) && (len > 0U));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (map != NULL) && (len > 0U))
+  {
+    /* Convert the server channel pointer to the context structure. */
+    tTbxMbServerCtx * serverCtx = (tTbxMbServerCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(serverCtx->type == TBX_MB_SERVER_CONTEXT_TYPE);
+    /* Verify that the map is sorted and that all its entries are valid. */
+    uint8_t mapValid = TbxMbServerMapIsValid(map, len);
+    TBX_ASSERT(mapValid == TBX_TRUE);
+    /* Only continue with a valid map and if the buffer for the register values is
+     * available.
+     */
+    if (mapValid == TBX_TRUE)
+    {
+      if (TbxMbServerRegBufAlloc(serverCtx) == TBX_OK)
+      {
+        /* Store the register map. */
+        TbxCriticalSectionEnter();
+        serverCtx->holdingRegMap.entries = map;
+        serverCtx->holdingRegMap.len = len;
+        TbxCriticalSectionExit();
+      }
+    }
+  }
+} /*** end of TbxMbServerSetMapHoldingRegs ***/
+
+
+/************************************************************************************//**
+** \brief     Registers the callback function that this server calls, whenever a client
+**            requests the reading of file record registers, with function code
+**            20 - Read File Record.
+** \param     channel Handle to the Modbus server channel object.
+** \param     callback Pointer to the callback function.
+**
+****************************************************************************************/
+void TbxMbServerSetCallbackReadFileRecord(tTbxMbServer               channel,
+                                          tTbxMbServerReadFileRecord callback)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((channel != NULL) && (callback != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (callback != NULL))
+  {
+    /* Convert the server channel pointer to the context structure. */
+    tTbxMbServerCtx * serverCtx = (tTbxMbServerCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(serverCtx->type == TBX_MB_SERVER_CONTEXT_TYPE);
+    /* Only continue if the buffer for the register values is available. */
+    if (TbxMbServerRegBufAlloc(serverCtx) == TBX_OK)
+    {
+      /* Store the callback function pointer. */
+      TbxCriticalSectionEnter();
+      serverCtx->readFileRecordFcn = callback;
+      TbxCriticalSectionExit();
+    }
+  }
+} /*** end of TbxMbServerSetCallbackReadFileRecord ***/
+
+
+/************************************************************************************//**
+** \brief     Registers the callback function that this server calls, whenever a client
+**            requests the writing of file record registers, with function code
+**            21 - Write File Record.
+** \param     channel Handle to the Modbus server channel object.
+** \param     callback Pointer to the callback function.
+**
+****************************************************************************************/
+void TbxMbServerSetCallbackWriteFileRecord(tTbxMbServer                channel,
+                                           tTbxMbServerWriteFileRecord callback)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((channel != NULL) && (callback != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (callback != NULL))
+  {
+    /* Convert the server channel pointer to the context structure. */
+    tTbxMbServerCtx * serverCtx = (tTbxMbServerCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(serverCtx->type == TBX_MB_SERVER_CONTEXT_TYPE);
+    /* Only continue if the buffer for the register values is available. */
+    if (TbxMbServerRegBufAlloc(serverCtx) == TBX_OK)
+    {
+      /* Store the callback function pointer. */
+      TbxCriticalSectionEnter();
+      serverCtx->writeFileRecordFcn = callback;
+      TbxCriticalSectionExit();
+    }
+  }
+} /*** end of TbxMbServerSetCallbackWriteFileRecord ***/
+
+
+/************************************************************************************//**
+** \brief     Registers a FIFO queue, that a client reads with function code 24 - Read
+**            FIFO Queue. The application adds values to the queue with
+**            TbxMbServerFifoPush(). The server removes the values that it sends in a
+**            response from the queue, such that a client drains the queue with
+**            consecutive requests. The application owns the buffer and must keep it
+**            valid as long as the server channel exists.
+** \details   The queue holds up to size - 1 values. This function empties the queue.
+** \param     channel Handle to the Modbus server channel object.
+** \param     addr FIFO pointer address (0..65535), that a client specifies in its
+**            request.
+** \param     buffer Pointer to the array for storing the queue values.
+** \param     size Number of elements in the buffer array (2..65535).
+**
+****************************************************************************************/
+void TbxMbServerSetFifo(tTbxMbServer   channel,
+                        uint16_t       addr,
+                        uint16_t     * buffer,
+                        uint16_t       size)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((channel != NULL) && (buffer != NULL) && (size >= 2U));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (buffer != NULL) && (size >= 2U))
+  {
+    /* Convert the server channel pointer to the context structure. */
+    tTbxMbServerCtx * serverCtx = (tTbxMbServerCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(serverCtx->type == TBX_MB_SERVER_CONTEXT_TYPE);
+    /* Store the FIFO queue and start out with an empty queue. */
+    TbxCriticalSectionEnter();
+    serverCtx->fifo.buffer = buffer;
+    serverCtx->fifo.size = size;
+    serverCtx->fifo.addr = addr;
+    serverCtx->fifo.head = 0U;
+    serverCtx->fifo.tail = 0U;
+    TbxCriticalSectionExit();
+  }
+} /*** end of TbxMbServerSetFifo ***/
+
+
+/************************************************************************************//**
+** \brief     Adds a value to the FIFO queue, registered with TbxMbServerSetFifo(). Safe
+**            to call from any context, including an interrupt service routine, without
+**            the need for a critical section. The only requirement is that just one
+**            context at a time adds values to the queue.
+** \param     channel Handle to the Modbus server channel object.
+** \param     value The value to add to the queue.
+** \return    TBX_OK if successful, TBX_ERROR if the queue is full or not registered.
+**
+****************************************************************************************/
+uint8_t TbxMbServerFifoPush(tTbxMbServer channel,
+                            uint16_t     value)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify parameters. */
+  TBX_ASSERT(channel != NULL);
+
+  /* Only continue with valid parameters. */
+  if (channel != NULL)
+  {
+    /* Convert the server channel pointer to the context structure. */
+    tTbxMbServerCtx * serverCtx = (tTbxMbServerCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(serverCtx->type == TBX_MB_SERVER_CONTEXT_TYPE);
+    /* Only continue if a FIFO queue was registered. */
+    if (serverCtx->fifo.buffer != NULL)
+    {
+      /* Determine where the head moves to, after adding the value. */
+      uint16_t head = serverCtx->fifo.head;
+      uint16_t next = head + 1U;
+      if (next == serverCtx->fifo.size)
+      {
+        next = 0U;
+      }
+      /* Only add the value if the queue is not full. */
+      if (next != serverCtx->fifo.tail)
+      {
+        /* Store the value before moving the head, such that the server never reads a
+         * value that is not yet stored.
+         */
+        serverCtx->fifo.buffer[head] = value;
+        serverCtx->fifo.head = next;
+        result = TBX_OK;
+      }
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbServerFifoPush ***/
+
+
+/************************************************************************************//**
+** \brief     Registers the objects of the device identification. A client reads these
+**            with function code 43 / MEI type 14 - Read Device Identification. The
+**            server splits the objects over multiple responses, if they do not fit in a
+**            single one. The application owns the array and must keep it valid as long
+**            as the server channel exists.
+** \details   Objects 0x00..0x02 form the basic device identification and the Modbus
+**            protocol specifies them as mandatory. Objects 0x03..0x7F form the regular
+**            and objects 0x80..0xFF the extended device identification.
+** \param     channel Handle to the Modbus server channel object.
+** \param     objects Array with device identification objects, sorted on their id in
+**            ascending order.
+** \param     len Number of objects in the array.
+**
+****************************************************************************************/
+void TbxMbServerSetDeviceIdObjects(tTbxMbServer                       channel,
+                                   tTbxMbServerDeviceIdObject const * objects,
+                                   uint16_t                           len)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((channel != NULL) && (objects != NULL) && (len > 0U) && (len <= 256U));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (objects != NULL) && (len > 0U) && (len <= 256U))
+  {
+    /* Convert the server channel pointer to the context structure. */
+    tTbxMbServerCtx * serverCtx = (tTbxMbServerCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(serverCtx->type == TBX_MB_SERVER_CONTEXT_TYPE);
+    /* Verify that the objects are sorted and that they all fit in a response. */
+    uint8_t objectsValid = TbxMbServerDevIdIsValid(objects, len);
+    TBX_ASSERT(objectsValid == TBX_TRUE);
+    /* Only continue with valid objects. */
+    if (objectsValid == TBX_TRUE)
+    {
+      /* Store the device identification objects. */
+      TbxCriticalSectionEnter();
+      serverCtx->devId.objects = objects;
+      serverCtx->devId.len = len;
+      TbxCriticalSectionExit();
+    }
+  }
+} /*** end of TbxMbServerSetDeviceIdObjects ***/
+
+
+/************************************************************************************//**
+** \brief     Registers a handler for a specific function code. Once registered, the
+**            server dispatches PDUs with this function code directly to the handler,
+**            with a single table lookup. This works both for function codes that are
+**            not supported by the server itself and for overriding the built-in handling
+**            of a supported function code. Specify NULL as the handler, to remove a
+**            previously registered handler.
+** \details   The handler has the same format as the custom function code callback. The
+**            first call to this function allocates the server channel's handler table
+**            from the memory pool.
+** \param     channel Handle to the Modbus server channel object.
+** \param     code Function code (1..127).
+** \param     handler Pointer to the handler function or NULL.
+**
+****************************************************************************************/
+void TbxMbServerSetFunctionHandler(tTbxMbServer               channel,
+                                   uint8_t                    code,
+                                   tTbxMbServerCustomFunction handler)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((channel != NULL) && (code > 0U) && (code < TBX_MB_SERVER_FC_TABLE_LEN));
+
+  /* Only continue with valid parameters. */
+  if ((channel != NULL) && (code > 0U) && (code < TBX_MB_SERVER_FC_TABLE_LEN))
+  {
+    /* Convert the server channel pointer to the context structure. */
+    tTbxMbServerCtx * serverCtx = (tTbxMbServerCtx *)channel;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(serverCtx->type == TBX_MB_SERVER_CONTEXT_TYPE);
+    /* Handler table not yet allocated? */
+    if (serverCtx->fcTable == NULL)
+    {
+      size_t tableSize = sizeof(tTbxMbServerCustomFunction) * TBX_MB_SERVER_FC_TABLE_LEN;
+      /* Allocate memory for the handler table. */
+      tTbxMbServerCustomFunction * newFcTable = TbxMemPoolAllocate(tableSize);
+      /* Automatically increase the memory pool, if it was too small. */
+      if (newFcTable == NULL)
+      {
+        /* No need to check the return value, because if it failed, the following
+         * allocation fails too, which is verified later on.
+         */
+        (void)TbxMemPoolCreate(1U, tableSize);
+        newFcTable = TbxMemPoolAllocate(tableSize);
+      }
+      /* Verify memory allocation of the handler table. */
+      TBX_ASSERT(newFcTable != NULL);
+      /* Only continue if the memory allocation succeeded. */
+      if (newFcTable != NULL)
+      {
+        /* Initialize the table without any registered handlers. */
+        for (uint8_t idx = 0U; idx < TBX_MB_SERVER_FC_TABLE_LEN; idx++)
+        {
+          newFcTable[idx] = NULL;
+        }
+        /* Store the handler table. */
+        TbxCriticalSectionEnter();
+        serverCtx->fcTable = newFcTable;
+        TbxCriticalSectionExit();
+      }
+    }
+    /* Only continue if the handler table is available. */
+    if (serverCtx->fcTable != NULL)
+    {
+      /* Store the handler function pointer. */
+      TbxCriticalSectionEnter();
+      serverCtx->fcTable[code] = handler;
+      TbxCriticalSectionExit();
+    }
+  }
+} /*** end of TbxMbServerSetFunctionHandler ***/
+
+
+/************************************************************************************//**
+** \brief     Allocates the buffer that the register range callbacks operate on, if not
+**            already done so. The buffer is only allocated once a register range
+**            callback is registered, to keep the RAM requirements of a server that only
+**            uses the per-register callbacks low.
+** \param     context Pointer to the Modbus server channel context.
+** \return    TBX_OK if the buffer is available, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+static uint8_t TbxMbServerRegBufAlloc(tTbxMbServerCtx * context)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify parameters. */
+  TBX_ASSERT(context != NULL);
+
+  /* Only continue with valid parameters. */
+  if (context != NULL)
+  {
+    /* Not yet allocated? */
+    if (context->regBuf == NULL)
+    {
+      /* Allocate memory for the buffer. */
+      uint16_t * newRegBuf = TbxMemPoolAllocate(sizeof(uint16_t) *
+                                                TBX_MB_SERVER_REG_BUF_LEN);
+      /* Automatically increase the memory pool, if it was too small. */
+      if (newRegBuf == NULL)
+      {
+        /* No need to check the return value, because if it failed, the following
+         * allocation fails too, which is verified later on.
+         */
+        (void)TbxMemPoolCreate(1U, sizeof(uint16_t) * TBX_MB_SERVER_REG_BUF_LEN);
+        newRegBuf = TbxMemPoolAllocate(sizeof(uint16_t) * TBX_MB_SERVER_REG_BUF_LEN);
+      }
+      /* Verify memory allocation of the buffer. */
+      TBX_ASSERT(newRegBuf != NULL);
+      /* Store the buffer. */
+      TbxCriticalSectionEnter();
+      context->regBuf = newRegBuf;
+      TbxCriticalSectionExit();
+    }
+    /* Update the result. */
+    if (context->regBuf != NULL)
+    {
+      result = TBX_OK;
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbServerRegBufAlloc ***/
+
+
+/************************************************************************************//**
+** \brief     Determines if a range of data elements is completely located inside the
+**            address range of the data table.
+** \param     table Pointer to the data table context.
+** \param     addr Address of the first data element in the range.
+** \param     num Number of data elements in the range.
+** \return    TBX_TRUE if the data table is registered and holds all data elements of
+**            the range, TBX_FALSE otherwise.
+**
+****************************************************************************************/
+static uint8_t TbxMbServerTableContains(tTbxMbServerTableCtx const * table,
+                                        uint16_t                     addr,
+                                        uint16_t                     num)
+{
+  uint8_t result = TBX_FALSE;
+
+  /* Verify parameters. */
+  TBX_ASSERT(table != NULL);
+
+  /* Only continue with valid parameters and a registered data table. */
+  if (table != NULL)
+  {
+    if (table->rdData != NULL)
+    {
+      /* Range located inside the data table? */
+      if ( (addr >= table->addr) &&
+           (((uint32_t)addr + num) <= ((uint32_t)table->addr + table->num)) )
+      {
+        /* Update the result. */
+        result = TBX_TRUE;
+      }
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbServerTableContains ***/
+
+
+/************************************************************************************//**
+** \brief     Verifies that the register map is sorted on address in ascending order,
+**            that its runs do not overlap and that each run is accessible.
+** \param     map Pointer to the array with register map entries.
+** \param     len Number of entries in the register map.
+** \return    TBX_TRUE if the register map is valid, TBX_FALSE otherwise.
+**
+****************************************************************************************/
+static uint8_t TbxMbServerMapIsValid(tTbxMbServerRegMapEntry const * map,
+                                     uint16_t                        len)
+{
+  uint8_t result = TBX_FALSE;
+
+  /* Verify parameters. */
+  TBX_ASSERT(map != NULL);
+
+  /* Only continue with valid parameters. */
+  if (map != NULL)
+  {
+    /* Assume valid until proven otherwise. */
+    result = TBX_TRUE;
+    /* Loop through all the entries, until an invalid one is found. */
+    for (uint16_t idx = 0U; (idx < len) && (result == TBX_TRUE); idx++)
+    {
+      uint32_t runEnd = (uint32_t)map[idx].addr + map[idx].num;
+      /* Run must not be empty, must fit in the address space and needs either storage
+       * or a read handler.
+       */
+      if ( (map[idx].num == 0U) || (runEnd > 65536UL) ||
+           ((map[idx].regs == NULL) && (map[idx].readFcn == NULL)) )
+      {
+        result = TBX_FALSE;
+      }
+      /* Next run, if any, must start after the end of this run. */
+      else if ((idx + 1U) < len)
+      {
+        if (map[idx + 1U].addr < runEnd)
+        {
+          result = TBX_FALSE;
+        }
+      }
+      else
+      {
+        /* Last run in the map and it's valid. */
+      }
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbServerMapIsValid ***/
+
+
+/************************************************************************************//**
+** \brief     Finds the register map entry whose run holds the specified address, using a
+**            binary search.
+** \param     map Pointer to the register map context.
+** \param     addr Register address to look up.
+** \return    Index of the register map entry if found, map->len otherwise.
+**
+****************************************************************************************/
+static uint16_t TbxMbServerMapFind(tTbxMbServerMapCtx const * map,
+                                   uint16_t                   addr)
+{
+  uint16_t result;
+
+  /* Verify parameters. */
+  TBX_ASSERT(map != NULL);
+
+  /* Default to not found. */
+  result = map->len;
+  /* Prepare the search boundaries. The entry, if present, has an index >= lowIdx and
+   * < highIdx.
+   */
+  uint16_t lowIdx  = 0U;
+  uint16_t highIdx = map->len;
+  /* Keep halving the search range until the entry is found or the range is empty. */
+  while (lowIdx < highIdx)
+  {
+    uint16_t                        midIdx = lowIdx + ((highIdx - lowIdx) / 2U);
+    tTbxMbServerRegMapEntry const * entry  = &map->entries[midIdx];
+    /* Address located before this run? */
+    if (addr < entry->addr)
+    {
+      highIdx = midIdx;
+    }
+    /* Address located after this run? */
+    else if (((uint32_t)addr) >= ((uint32_t)entry->addr + entry->num))
+    {
+      lowIdx = midIdx + 1U;
+    }
+    /* Address located inside this run. */
+    else
+    {
+      result = midIdx;
+      /* Stop searching. */
+      highIdx = lowIdx;
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbServerMapFind ***/
+
+
+/************************************************************************************//**
+** \brief     Determines if a range of registers is completely covered by the register
+**            map. This is the case if the first register is located in a run and all
+**            next runs until the end of the range directly follow up on each other.
+** \param     map Pointer to the register map context.
+** \param     addr Address of the first register in the range.
+** \param     num Number of registers in the range.
+** \param     write TBX_TRUE to also check that all runs in the range are writable.
+** \return    TBX_TRUE if the register map is registered and covers all registers of
+**            the range, TBX_FALSE otherwise.
+**
+****************************************************************************************/
+static uint8_t TbxMbServerMapCovers(tTbxMbServerMapCtx const * map,
+                                    uint16_t                   addr,
+                                    uint16_t                   num,
+                                    uint8_t                    write)
+{
+  uint8_t result = TBX_FALSE;
+
+  /* Verify parameters. */
+  TBX_ASSERT(map != NULL);
+
+  /* Only continue with valid parameters and a registered register map. */
+  if (map != NULL)
+  {
+    if (map->entries != NULL)
+    {
+      uint32_t rangeEnd = (uint32_t)addr + num;
+      uint32_t nextAddr = addr;
+      /* Look up the run that holds the first register. */
+      uint16_t idx = TbxMbServerMapFind(map, addr);
+      /* Walk through the consecutive runs, until the end of the range is reached or a
+       * gap is detected.
+       */
+      while ((idx < map->len) && (nextAddr < rangeEnd))
+      {
+        tTbxMbServerRegMapEntry const * entry = &map->entries[idx];
+        /* Gap between this run and the previous one? Note that the first run is
+         * allowed to start before the range.
+         */
+        if ( (nextAddr != addr) && (entry->addr != nextAddr) )
+        {
+          /* Stop walking, the range is not covered. */
+          idx = map->len;
+        }
+        /* Run not writable, while writing? */
+        else if ( (write == TBX_TRUE) && (entry->regs == NULL) &&
+                  (entry->writeFcn == NULL) )
+        {
+          /* Stop walking, the range is not covered. */
+          idx = map->len;
+        }
+        /* Continue with the next run. */
+        else
+        {
+          nextAddr = (uint32_t)entry->addr + entry->num;
+          idx++;
+        }
+      }
+      /* Covered if the end of the range was reached. */
+      if (nextAddr >= rangeEnd)
+      {
+        result = TBX_TRUE;
+      }
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbServerMapCovers ***/
+
+
+/************************************************************************************//**
+** \brief     Reads a range of registers, that is completely covered by the register
+**            map. Each run is handled at once, either by copying directly from its
+**            storage or with one call to its read handler.
+** \param     context Pointer to the Modbus server channel context.
+** \param     map Pointer to the register map context.
+** \param     addr Address of the first register in the range.
+** \param     num Number of registers in the range.
+** \param     values Array to write the values of the registers to.
+** \return    TBX_MB_SERVER_OK if successful, otherwise the error reported by the read
+**            handler.
+**
+****************************************************************************************/
+static tTbxMbServerResult TbxMbServerMapRead(tTbxMbServerCtx          * context,
+                                             tTbxMbServerMapCtx const * map,
+                                             uint16_t                   addr,
+                                             uint8_t                    num,
+                                             uint16_t                 * values)
+{
+  tTbxMbServerResult result = TBX_MB_SERVER_OK;
+  uint16_t           curAddr = addr;
+  uint8_t            remain  = num;
+  uint8_t            valIdx  = 0U;
+  /* Look up the run that holds the first register. */
+  uint16_t           idx     = TbxMbServerMapFind(map, addr);
+
+  /* Process one run at a time, until all registers are read or an error occurred. */
+  while ((remain > 0U) && (result == TBX_MB_SERVER_OK) && (idx < map->len))
+  {
+    tTbxMbServerRegMapEntry const * entry = &map->entries[idx];
+    /* Determine how many registers to read from this run. */
+    uint16_t offset = curAddr - entry->addr;
+    uint8_t  cnt    = remain;
+    if ((entry->num - offset) < cnt)
+    {
+      cnt = (uint8_t)(entry->num - offset);
+    }
+    /* Copy directly from the storage, if available. */
+    if (entry->regs != NULL)
+    {
+      for (uint8_t cntIdx = 0U; cntIdx < cnt; cntIdx++)
+      {
+        values[valIdx + cntIdx] = entry->regs[offset + cntIdx];
+      }
+    }
+    /* Call the read handler for this part of the run. */
+    else
+    {
+      result = entry->readFcn(context, curAddr, cnt, &values[valIdx]);
+    }
+    /* Continue with the next run. */
+    curAddr += cnt;
+    valIdx += cnt;
+    remain -= cnt;
+    idx++;
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbServerMapRead ***/
+
+
+/************************************************************************************//**
+** \brief     Writes a range of registers, that is completely covered by the register
+**            map. Each run is handled at once, either by copying directly to its
+**            storage or with one call to its write handler.
+** \param     context Pointer to the Modbus server channel context.
+** \param     map Pointer to the register map context.
+** \param     addr Address of the first register in the range.
+** \param     num Number of registers in the range.
+** \param     values Array with the values of the registers.
+** \return    TBX_MB_SERVER_OK if successful, otherwise the error reported by the write
+**            handler.
+**
+****************************************************************************************/
+static tTbxMbServerResult TbxMbServerMapWrite(tTbxMbServerCtx          * context,
+                                              tTbxMbServerMapCtx const * map,
+                                              uint16_t                   addr,
+                                              uint8_t                    num,
+                                              uint16_t           const * values)
+{
+  tTbxMbServerResult result = TBX_MB_SERVER_OK;
+  uint16_t           curAddr = addr;
+  uint8_t            remain  = num;
+  uint8_t            valIdx  = 0U;
+  /* Look up the run that holds the first register. */
+  uint16_t           idx     = TbxMbServerMapFind(map, addr);
+
+  /* Process one run at a time, until all registers are written or an error occurred. */
+  while ((remain > 0U) && (result == TBX_MB_SERVER_OK) && (idx < map->len))
+  {
+    tTbxMbServerRegMapEntry const * entry = &map->entries[idx];
+    /* Determine how many registers to write to this run. */
+    uint16_t offset = curAddr - entry->addr;
+    uint8_t  cnt    = remain;
+    if ((entry->num - offset) < cnt)
+    {
+      cnt = (uint8_t)(entry->num - offset);
+    }
+    /* Copy directly to the storage, if available. */
+    if (entry->regs != NULL)
+    {
+      for (uint8_t cntIdx = 0U; cntIdx < cnt; cntIdx++)
+      {
+        entry->regs[offset + cntIdx] = values[valIdx + cntIdx];
+      }
+      /* Notify the application about the write, if requested. */
+      if (context->tableWrittenFcn != NULL)
+      {
+        context->tableWrittenFcn(context, TBX_MB_SERVER_TABLE_HOLDING_REGS, curAddr,
+                                 cnt);
+      }
+    }
+    /* Call the write handler for this part of the run. */
+    else
+    {
+      result = entry->writeFcn(context, curAddr, cnt, &values[valIdx]);
+    }
+    /* Continue with the next run. */
+    curAddr += cnt;
+    valIdx += cnt;
+    remain -= cnt;
+    idx++;
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbServerMapWrite ***/
+
+
+/************************************************************************************//**
+** \brief     Event processing function that is automatically called when an event for
+**            this server channel object was received in TbxMbEventTask().
+** \param     event Pointer to the event to process. Note that the event->context points
+**            to the handle of the Modbus server channel object.
+**
+****************************************************************************************/
+static void TbxMbServerProcessEvent(tTbxMbEvent * event)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(event != NULL);
+
+  /* Only continue with valid parameters. */
+  if (event != NULL)
+  {
+    /* Sanity check the context. */
+    TBX_ASSERT(event->context != NULL);
+    /* Convert the event context to the server channel context structure. */
+    tTbxMbServerCtx * serverCtx = (tTbxMbServerCtx *)event->context;
+    /* Make sure the context is valid. */
+    TBX_ASSERT(serverCtx != NULL);
+    /* Only continue with a valid context. */
+    if (serverCtx != NULL)
+    {
+      /* Sanity check on the context type. */
+      TBX_ASSERT(serverCtx->type == TBX_MB_SERVER_CONTEXT_TYPE);
+      /* Filter on the event identifier. */
+      switch (event->id)
+      {
+        case TBX_MB_EVENT_ID_PDU_RECEIVED:
+        {
+          uint8_t okayToSendResponse = TBX_FALSE;
+          /* Obtain read access to the newly received packet and write access to the
+           * response packet. 
+           */
+          tTbxMbTpPacket * rxPacket = serverCtx->tpCtx->getRxPacketFcn(serverCtx->tpCtx);
+          tTbxMbTpPacket * txPacket = serverCtx->tpCtx->getTxPacketFcn(serverCtx->tpCtx);
+          /* Since we're requested to process a newly received PDU, these packet accesses
+           * should always succeed. Sanity check anyways, just in case.
+           */
+          TBX_ASSERT((rxPacket != NULL) && (txPacket != NULL));
+          /* Only continue with packet access. */
+          if ((rxPacket != NULL) && (txPacket != NULL))
+          {
+            /* Update flag that we can actually send a response, now that we know we 
+             * have access to txPacket.
+             */
+            okayToSendResponse = TBX_TRUE;
+            /* Prepare the response packet function code. */
+            txPacket->pdu.code = rxPacket->pdu.code;
+            /* Look up the handler that the application registered for this function
+             * code, if any.
+             */
+            uint8_t                    code       = rxPacket->pdu.code;
+            tTbxMbServerCustomFunction appHandler = NULL;
+            if ((serverCtx->fcTable != NULL) && (code < TBX_MB_SERVER_FC_TABLE_LEN))
+            {
+              appHandler = serverCtx->fcTable[code];
+            }
+            /* Application registered handler takes precedence. */
+            if (appHandler != NULL)
+            {
+              (void)TbxMbServerCallCustom(serverCtx, appHandler, rxPacket, txPacket);
+            }
+            /* Built-in handler available for this function code? */
+            else if ((code < TBX_MB_SERVER_FC_HANDLERS_LEN) &&
+                     (tbxMbServerFcHandlers[code] != NULL))
+            {
+              tbxMbServerFcHandlers[code](serverCtx, rxPacket, txPacket);
+            }
+            /* Unsupported function code. Pass it on to the custom function code
+             * callback, if configured.
+             */
+            else
+            {
+              (void)TbxMbServerCallCustom(serverCtx, serverCtx->customFunctionFcn,
+                                          rxPacket, txPacket);
+            }
+          }
+          /* Inform the transport layer that were done with the rx packet and no longer
+           * need access to it.
+           */
+          serverCtx->tpCtx->receptionDoneFcn(serverCtx->tpCtx);
+          /* Request the transport layer to transmit the response. Note that
+           * transmitFcn() should only be called after calling receptionDoneFcn().
+           */
+          if (okayToSendResponse == TBX_TRUE)
+          {
+            (void)serverCtx->tpCtx->transmitFcn(serverCtx->tpCtx);
+          }
+        }
+        break;
+      
+        case TBX_MB_EVENT_ID_PDU_TRANSMITTED:
+        {
+          /* At this point no additional event handling is needed on this channel upon
+           * PDU transmission completion.
+           */
+        }
+        break;
+
+        default:
+        {
+          /* An unsupported event was dispatched to us. Should not happen. */
+          TBX_ASSERT(TBX_FALSE);
+        }
+        break;
+      }
+    }
+  }
+} /*** end of TbxMbServerProcessEvent ***/
+
+
+/************************************************************************************//**
+** \brief     Calls a handler in the format of the custom function code callback, for
+**            handling the received PDU. If the handler did not handle the PDU, or if no
+**            handler is specified, an exception response for an illegal function is
+**            prepared.
+** \param     context Pointer to the Modbus server channel context.
+** \param     handler Pointer to the handler function or NULL.
+** \param     rxPacket Received PDU packet with MUX access.
+** \param     txPacket Storage for the PDU response packet with MUX access.
+** \return    TBX_TRUE if the handler handled the PDU, TBX_FALSE otherwise.
+**
+****************************************************************************************/
+static uint8_t TbxMbServerCallCustom(tTbxMbServerCtx            * context,
+                                     tTbxMbServerCustomFunction   handler,
+                                     tTbxMbTpPacket       const * rxPacket,
+                                     tTbxMbTpPacket             * txPacket)
+{
+  uint8_t handled = TBX_FALSE;
+
+  /* Verify parameters. */
+  TBX_ASSERT((context != NULL) && (rxPacket != NULL) && (txPacket != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((context != NULL) && (rxPacket != NULL) && (txPacket != NULL))
+  {
+    /* Is a handler specified? */
+    if (handler != NULL)
+    {
+      /* Prepare handler parameters. */
+      uint8_t const * rxPdu  = &rxPacket->pdu.code;
+      uint8_t       * txPdu  = &txPacket->pdu.code;
+      uint8_t         pduLen = rxPacket->dataLen + 1U;
+      /* Call the handler. */
+      handled = handler(context, rxPdu, txPdu, &pduLen);
+      /* Did the handler process the PDU and prepare a response? */
+      if (handled == TBX_TRUE)
+      {
+        /* Set the response data length. */
+        txPacket->dataLen = pduLen - 1U;
+      }
+    }
+    /* Was the PDU not handled? */
+    if (handled == TBX_FALSE)
+    {
+      /* This function code is currently not supported. */
+      txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
+      txPacket->pdu.data[0] = TBX_MB_EC01_ILLEGAL_FUNCTION;
+      txPacket->dataLen = 1U;
+    }
+  }
+  /* Give the result back to the caller. */
+  return handled;
+} /*** end of TbxMbServerCallCustom ***/
+
+
+/************************************************************************************//**
+** \brief     Verifies that the device identification objects are sorted on their id in
+**            ascending order, without duplicates, and that the value of each object fits
+**            in a response.
+** \param     objects Array with device identification objects.
+** \param     len Number of objects in the array.
+** \return    TBX_TRUE if the objects are valid, TBX_FALSE otherwise.
+**
+****************************************************************************************/
+static uint8_t TbxMbServerDevIdIsValid(tTbxMbServerDeviceIdObject const * objects,
+                                       uint16_t                           len)
+{
+  uint8_t result = TBX_FALSE;
+
+  /* Verify parameters. */
+  TBX_ASSERT(objects != NULL);
+
+  /* Only continue with valid parameters. */
+  if (objects != NULL)
+  {
+    /* Assume valid until proven otherwise. */
+    result = TBX_TRUE;
+    /* Loop through all the objects, until an invalid one is found. */
+    for (uint16_t idx = 0U; (idx < len) && (result == TBX_TRUE); idx++)
+    {
+      /* Object value must fit in a response and needs storage, unless it is empty. */
+      if ( (objects[idx].len > TBX_MB_SERVER_DEVID_OBJ_LEN_MAX) ||
+           ((objects[idx].len > 0U) && (objects[idx].value == NULL)) )
+      {
+        result = TBX_FALSE;
+      }
+      /* Next object, if any, must have a higher id. */
+      else if ((idx + 1U) < len)
+      {
+        if (objects[idx + 1U].id <= objects[idx].id)
+        {
+          result = TBX_FALSE;
+        }
+      }
+      else
+      {
+        /* Last object and it's valid. */
+      }
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbServerDevIdIsValid ***/
+
+
+#if (TBX_MB_SERVER_FC03_ENABLE > 0U) || (TBX_MB_SERVER_FC22_ENABLE > 0U) || \
+    (TBX_MB_SERVER_FC23_ENABLE > 0U)
+/************************************************************************************//**
+** \brief     Reads a range of holding registers and stores their values in the big
+**            endian format, as needed for a response packet. The registers are read from
+**            the data table, the register map or the callback functions. This is the
+**            same order of precedence as for all other holding register accesses.
+** \param     context Pointer to the Modbus server channel context.
+** \param     addr Starting register address (0..65535).
+** \param     num Number of registers to read (1..125).
+** \param     data Byte array where to store the register values in the big endian
+**            format.
+** \return    TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if one
+**            or more of the registers are not supported by this server,
+**            TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+**
+****************************************************************************************/
+static tTbxMbServerResult TbxMbServerHoldingRegsRead(tTbxMbServerCtx * context,
+                                                     uint16_t          addr,
+                                                     uint8_t           num,
+                                                     uint8_t         * data)
+{
+  tTbxMbServerResult result = TBX_MB_SERVER_ERR_DEVICE_FAILURE;
+
+  /* Verify parameters. */
+  TBX_ASSERT((context != NULL) && (num > 0U) && (data != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((context != NULL) && (num > 0U) && (data != NULL))
+  {
+    /* Reset the result, now that the parameters are verified. */
+    result = TBX_MB_SERVER_OK;
+    /* Are all the requested registers located in the data table? */
+    if (TbxMbServerTableContains(&context->holdingRegTbl, addr, num) == TBX_TRUE)
+    {
+      /* Point to the first requested register in the data table. */
+      uint16_t const * regs = context->holdingRegTbl.rdData;
+      regs = &regs[addr - context->holdingRegTbl.addr];
+      /* Copy the register values in the big endian format. */
+      for (uint8_t idx = 0U; idx < num; idx++)
+      {
+        TbxMbCommonStoreUInt16BE(regs[idx], &data[idx * 2U]);
+      }
+    }
+    /* Are all the requested registers covered by the register map? */
+    else if (TbxMbServerMapCovers(&context->holdingRegMap, addr, num, TBX_FALSE) ==
+             TBX_TRUE)
+    {
+      /* Obtain the register values, one run at a time. */
+      result = TbxMbServerMapRead(context, &context->holdingRegMap, addr, num,
+                                  context->regBuf);
+      /* No exception reported? */
+      if (result == TBX_MB_SERVER_OK)
+      {
+        /* Store the register values in the big endian format. */
+        for (uint8_t idx = 0U; idx < num; idx++)
+        {
+          TbxMbCommonStoreUInt16BE(context->regBuf[idx], &data[idx * 2U]);
+        }
+      }
+    }
+    /* Prefer the register range callback, if registered. */
+    else if (context->readHoldingRegsFcn != NULL)
+    {
+      /* Obtain all register values at once. */
+      result = context->readHoldingRegsFcn(context, addr, num, context->regBuf);
+      /* No exception reported? */
+      if (result == TBX_MB_SERVER_OK)
+      {
+        /* Store the register values in the big endian format. */
+        for (uint8_t idx = 0U; idx < num; idx++)
+        {
+          TbxMbCommonStoreUInt16BE(context->regBuf[idx], &data[idx * 2U]);
+        }
+      }
+    }
+    /* Without a callback, the requested registers are not supported. */
+    else if (context->readHoldingRegFcn == NULL)
+    {
+      result = TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR;
+    }
+    /* Fall back to the per-register callback. */
+    else
+    {
+      /* Loop through all the registers, until an exception is reported. */
+      for (uint8_t idx = 0U; (idx < num) && (result == TBX_MB_SERVER_OK); idx++)
+      {
+        uint16_t regValue = 0U;
+        /* Obtain register value. */
+        result = context->readHoldingRegFcn(context, addr + idx, &regValue);
+        /* No exception reported? */
+        if (result == TBX_MB_SERVER_OK)
+        {
+          /* Store the register value in the big endian format. */
+          TbxMbCommonStoreUInt16BE(regValue, &data[idx * 2U]);
+        }
+      }
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbServerHoldingRegsRead ***/
+#endif
+
+
+#if (TBX_MB_SERVER_FC16_ENABLE > 0U) || (TBX_MB_SERVER_FC22_ENABLE > 0U) || \
+    (TBX_MB_SERVER_FC23_ENABLE > 0U)
+/************************************************************************************//**
+** \brief     Writes a range of holding registers, with their values stored in the big
+**            endian format, as found in a request packet. The registers are written to
+**            the data table, the register map or the callback functions. This is the
+**            same order of precedence as for all other holding register accesses.
+** \param     context Pointer to the Modbus server channel context.
+** \param     addr Starting register address (0..65535).
+** \param     num Number of registers to write (1..123).
+** \param     data Byte array with the register values in the big endian format.
+** \return    TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if one
+**            or more of the registers are not supported by this server,
+**            TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+**
+****************************************************************************************/
+static tTbxMbServerResult TbxMbServerHoldingRegsWrite(tTbxMbServerCtx       * context,
+                                                      uint16_t                addr,
+                                                      uint8_t                 num,
+                                                      uint8_t         const * data)
+{
+  tTbxMbServerResult result = TBX_MB_SERVER_ERR_DEVICE_FAILURE;
+
+  /* Verify parameters. */
+  TBX_ASSERT((context != NULL) && (num > 0U) && (data != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((context != NULL) && (num > 0U) && (data != NULL))
+  {
+    /* Reset the result, now that the parameters are verified. */
+    result = TBX_MB_SERVER_OK;
+    /* Are all the requested registers located in the data table? */
+    if (TbxMbServerTableContains(&context->holdingRegTbl, addr, num) == TBX_TRUE)
+    {
+      /* Point to the first requested register in the data table. */
+      uint16_t * regs = context->holdingRegTbl.wrData;
+      regs = &regs[addr - context->holdingRegTbl.addr];
+      /* Copy the register values from the big endian format to the data table. */
+      for (uint8_t idx = 0U; idx < num; idx++)
+      {
+        regs[idx] = TbxMbCommonExtractUInt16BE(&data[idx * 2U]);
+      }
+      /* Notify the application about the write, if requested. */
+      if (context->tableWrittenFcn != NULL)
+      {
+        context->tableWrittenFcn(context, TBX_MB_SERVER_TABLE_HOLDING_REGS, addr, num);
+      }
+    }
+    /* Are all the requested registers covered by the register map? */
+    else if (TbxMbServerMapCovers(&context->holdingRegMap, addr, num, TBX_TRUE) ==
+             TBX_TRUE)
+    {
+      /* Extract all the requested register values. */
+      for (uint8_t idx = 0U; idx < num; idx++)
+      {
+        context->regBuf[idx] = TbxMbCommonExtractUInt16BE(&data[idx * 2U]);
+      }
+      /* Write the register values, one run at a time. */
+      result = TbxMbServerMapWrite(context, &context->holdingRegMap, addr, num,
+                                   context->regBuf);
+    }
+    /* Prefer the register range callback, if registered. */
+    else if (context->writeHoldingRegsFcn != NULL)
+    {
+      /* Extract all the requested register values. */
+      for (uint8_t idx = 0U; idx < num; idx++)
+      {
+        context->regBuf[idx] = TbxMbCommonExtractUInt16BE(&data[idx * 2U]);
+      }
+      /* Write all register values at once. */
+      result = context->writeHoldingRegsFcn(context, addr, num, context->regBuf);
+    }
+    /* Without a callback, the requested registers are not supported. */
+    else if (context->writeHoldingRegFcn == NULL)
+    {
+      result = TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR;
+    }
+    /* Fall back to the per-register callback. */
+    else
+    {
+      /* Loop through all the registers, until an exception is reported. */
+      for (uint8_t idx = 0U; (idx < num) && (result == TBX_MB_SERVER_OK); idx++)
+      {
+        /* Extract the requested register value. */
+        uint16_t regValue = TbxMbCommonExtractUInt16BE(&data[idx * 2U]);
+        /* Write the register value. */
+        result = context->writeHoldingRegFcn(context, addr + idx, regValue);
+      }
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbServerHoldingRegsWrite ***/
+#endif
+
+
+#if (TBX_MB_SERVER_FC01_ENABLE > 0U)
+/************************************************************************************//**
+** \brief     Handles a newly received PDU for function code 1 - Read Coils.
+** \details   Note that this function is called at a time that txPacket->code is already
+**            prepared. Also note that txPacket->node should not be touched here.
+** \param     context Pointer to the Modbus server channel context.
+** \param     rxPacket Received PDU packet with MUX access.
+** \param     txPacket Storage for the PDU response packet with MUX access.
+**
+****************************************************************************************/
+static void TbxMbServerFC01ReadCoils(tTbxMbServerCtx       * context,
+                                     tTbxMbTpPacket  const * rxPacket,
+                                     tTbxMbTpPacket        * txPacket)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((context != NULL) && (rxPacket != NULL) && (txPacket != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((context != NULL) && (rxPacket != NULL) && (txPacket != NULL))
+  {
+    /* Read out request packet parameters. */
+    uint16_t startAddr = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]);
+    uint16_t numCoils  = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[2]);
+
+    /* Check if a callback function or data table was registered. */
+    if ((context->readCoilFcn == NULL) && (context->readCoilsFcn == NULL) &&
+        (context->coilTbl.rdData == NULL))
+    {
+      /* Prepare exception response. */
+      txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
+      txPacket->pdu.data[0] = TBX_MB_EC01_ILLEGAL_FUNCTION;
+      txPacket->dataLen = 1U;
+    }
+    /* Check if the quantity of coils is invalid. */
+    else if ((numCoils < 1U) || (numCoils > 2000U))
+    {
+      /* Prepare exception response. */
+      txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
+      txPacket->pdu.data[0] = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
+      txPacket->dataLen = 1U;
+    }
+    /* All is good for further processing. */
+    else
+    {
+      tTbxMbServerResult srvResult = TBX_MB_SERVER_OK;
+      /* Determine the number of bytes needed to hold all the coil bits. The cast to
+       * U8 is okay, because we know that numCoils is <= 2000.
+       */
+      uint8_t numBytes = (uint8_t)(numCoils / 8U);
+      if ((numCoils % 8U) != 0U)
+      {
+        numBytes++;
+      }
+      /* Store byte count in the response and prepare the data length. */
+      txPacket->pdu.data[0] = numBytes;
+      txPacket->dataLen = txPacket->pdu.data[0] + 1U;
+      /* Initialize byte array pointer for writing the coil bits in the response. */
+      uint8_t * coilData = &txPacket->pdu.data[1];
+      /* Are all the requested coils located in the data table? */
+      if (TbxMbServerTableContains(&context->coilTbl, startAddr, numCoils) == TBX_TRUE)
+      {
+        /* The bit copy leaves the unused bits in the last byte untouched. Make sure
+         * these are all zero (OFF).
+         */
+        coilData[numBytes - 1U] = 0U;
+        /* Copy the coil bits from the data table to the response at once. */
+        TbxMbCommonCopyBits(coilData, 0U, context->coilTbl.rdData,
+                            (uint32_t)startAddr - context->coilTbl.addr, numCoils);
+      }
+      /* Read the coil bits directly into the response, with the range callback. */
+      else if (context->readCoilsFcn != NULL)
+      {
+        srvResult = context->readCoilsFcn(context, startAddr, numCoils, coilData);
+        /* Make sure the unused bits in the last byte are all zero (OFF). */
+        if ((numCoils % 8U) != 0U)
+        {
+          coilData[numBytes - 1U] &= (uint8_t)((1U << (numCoils % 8U)) - 1U);
+        }
+      }
+      /* Without a callback, the requested coils are not supported. */
+      else if (context->readCoilFcn == NULL)
+      {
+        srvResult = TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR;
+      }
+      /* Fall back to the per-coil callback. */
+      else
+      {
+        /* Prepare loop indices that aid with storing the coil bits. */
+        uint8_t bitIdx  = 0U;
+        uint8_t byteIdx = 0U;
+        /* Initialize the first byte to all zero (coils OFF) bits. */
+        coilData[0] = 0U;
+        /* Loop through all the coils, until an exception is reported. */
+        for (uint16_t idx = 0U; (idx < numCoils) && (srvResult == TBX_MB_SERVER_OK);
+             idx++)
+        {
+          uint8_t coilValue = TBX_OFF;
+          /* Obtain coil value. */
+          srvResult = context->readCoilFcn(context, startAddr + idx, &coilValue);
+          /* No exception reported? */
+          if (srvResult == TBX_MB_SERVER_OK)
+          {
+            /* Store the coil value in the response. Note that the coil bits in a
+             * byte are initialized to all zeroes, so only update if a coil is in the
+             * ON state.
+             */
+            if (coilValue != TBX_OFF)
+            {
+              coilData[byteIdx] |= (1U << bitIdx);
+            }
+            /* Update the bit index. */
+            bitIdx++;
+            /* Time to move to the next byte? */
+            if (bitIdx == 8U)
+            {
+              /* Reset the bit index, increment the byte index and initialize the byte
+               * to all zero (coils OFF) bits.
+               */
+              bitIdx = 0U;
+              byteIdx++;
+              coilData[byteIdx] = 0U;
+            }
+          }
+        }
+      }
+      /* Exception detected? */
+      if (srvResult != TBX_MB_SERVER_OK)
+      {
+        /* Prepare exception response. */
+        txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
+        if (srvResult == TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR)
+        {
+          txPacket->pdu.data[0] = TBX_MB_EC02_ILLEGAL_DATA_ADDRESS;
+        }
+        else
+        {
+          txPacket->pdu.data[0] = TBX_MB_EC04_SERVER_DEVICE_FAILURE;
+        }
+        txPacket->dataLen = 1U;
+      }
+    }
+  }
+} /*** end of TbxMbServerFC01ReadCoils ***/
+#endif
+
+
+#if (TBX_MB_SERVER_FC02_ENABLE > 0U)
+/************************************************************************************//**
+** \brief     Handles a newly received PDU for function code 2 - Read Discrete Inputs.
+** \details   Note that this function is called at a time that txPacket->code is already
+**            prepared. Also note that txPacket->node should not be touched here.
+** \param     context Pointer to the Modbus server channel context.
+** \param     rxPacket Received PDU packet with MUX access.
+** \param     txPacket Storage for the PDU response packet with MUX access.
+**
+****************************************************************************************/
+static void TbxMbServerFC02ReadInputs(tTbxMbServerCtx       * context,
+                                      tTbxMbTpPacket  const * rxPacket,
+                                      tTbxMbTpPacket        * txPacket)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((context != NULL) && (rxPacket != NULL) && (txPacket != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((context != NULL) && (rxPacket != NULL) && (txPacket != NULL))
+  {
+    /* Read out request packet parameters. */
+    uint16_t startAddr = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]);
+    uint16_t numInputs = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[2]);
+
+    /* Check if a callback function or data table was registered. */
+    if ((context->readInputFcn == NULL) && (context->readInputsFcn == NULL) &&
+        (context->inputTbl.rdData == NULL))
+    {
+      /* Prepare exception response. */
+      txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
+      txPacket->pdu.data[0] = TBX_MB_EC01_ILLEGAL_FUNCTION;
+      txPacket->dataLen = 1U;
+    }
+    /* Check if the quantity of inputs is invalid. */
+    else if ((numInputs < 1U) || (numInputs > 2000U))
+    {
+      /* Prepare exception response. */
+      txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
+      txPacket->pdu.data[0] = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
+      txPacket->dataLen = 1U;
+    }
+    /* All is good for further processing. */
+    else
+    {
+      tTbxMbServerResult srvResult = TBX_MB_SERVER_OK;
+      /* Determine the number of bytes needed to hold all the input bits. The cast to
+       * U8 is okay, because we know that numInputs is <= 2000.
+       */
+      uint8_t numBytes = (uint8_t)(numInputs / 8U);
+      if ((numInputs % 8U) != 0U)
+      {
+        numBytes++;
+      }
+      /* Store byte count in the response and prepare the data length. */
+      txPacket->pdu.data[0] = numBytes;
+      txPacket->dataLen = txPacket->pdu.data[0] + 1U;
+      /* Initialize byte array pointer for writing the input bits in the response. */
+      uint8_t * inputData = &txPacket->pdu.data[1];
+      /* Are all the requested inputs located in the data table? */
+      if (TbxMbServerTableContains(&context->inputTbl, startAddr, numInputs) == TBX_TRUE)
+      {
+        /* The bit copy leaves the unused bits in the last byte untouched. Make sure
+         * these are all zero (OFF).
+         */
+        inputData[numBytes - 1U] = 0U;
+        /* Copy the input bits from the data table to the response at once. */
+        TbxMbCommonCopyBits(inputData, 0U, context->inputTbl.rdData,
+                            (uint32_t)startAddr - context->inputTbl.addr, numInputs);
+      }
+      /* Read the input bits directly into the response, with the range callback. */
+      else if (context->readInputsFcn != NULL)
+      {
+        srvResult = context->readInputsFcn(context, startAddr, numInputs, inputData);
+        /* Make sure the unused bits in the last byte are all zero (OFF). */
+        if ((numInputs % 8U) != 0U)
+        {
+          inputData[numBytes - 1U] &= (uint8_t)((1U << (numInputs % 8U)) - 1U);
+        }
+      }
+      /* Without a callback, the requested inputs are not supported. */
+      else if (context->readInputFcn == NULL)
+      {
+        srvResult = TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR;
+      }
+      /* Fall back to the per-input callback. */
+      else
+      {
+        /* Prepare loop indices that aid with storing the input bits. */
+        uint8_t bitIdx  = 0U;
+        uint8_t byteIdx = 0U;
+        /* Initialize the first byte to all zero (input OFF) bits. */
+        inputData[0] = 0U;
+        /* Loop through all the inputs, until an exception is reported. */
+        for (uint16_t idx = 0U; (idx < numInputs) && (srvResult == TBX_MB_SERVER_OK);
+             idx++)
+        {
+          uint8_t inputValue = TBX_OFF;
+          /* Obtain input value. */
+          srvResult = context->readInputFcn(context, startAddr + idx, &inputValue);
+          /* No exception reported? */
+          if (srvResult == TBX_MB_SERVER_OK)
+          {
+            /* Store the input value in the response. Note that the input bits in a
+             * byte are initialized to all zeroes, so only update if an input is in the
+             * ON state.
+             */
+            if (inputValue != TBX_OFF)
+            {
+              inputData[byteIdx] |= (1U << bitIdx);
+            }
+            /* Update the bit index. */
+            bitIdx++;
+            /* Time to move to the next byte? */
+            if (bitIdx == 8U)
+            {
+              /* Reset the bit index, increment the byte index and initialize the byte
+               * to all zero (input OFF) bits.
+               */
+              bitIdx = 0U;
+              byteIdx++;
+              inputData[byteIdx] = 0U;
+            }
+          }
+        }
+      }
+      /* Exception detected? */
+      if (srvResult != TBX_MB_SERVER_OK)
+      {
+        /* Prepare exception response. */
+        txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
+        if (srvResult == TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR)
+        {
+          txPacket->pdu.data[0] = TBX_MB_EC02_ILLEGAL_DATA_ADDRESS;
+        }
+        else
+        {
+          txPacket->pdu.data[0] = TBX_MB_EC04_SERVER_DEVICE_FAILURE;
+        }
+        txPacket->dataLen = 1U;
+      }
+    }
+  }
+} /*** end of TbxMbServerFC02ReadInputs ***/
+#endif
+
+
+#if (TBX_MB_SERVER_FC03_ENABLE > 0U)
+/************************************************************************************//**
+** \brief     Handles a newly received PDU for function code 3 - Read Holding Registers.
+** \details   Note that this function is called at a time that txPacket->code is already
+**            prepared. Also note that txPacket->node should not be touched here.
+** \param     context Pointer to the Modbus server channel context.
+** \param     rxPacket Received PDU packet with MUX access.
+** \param     txPacket Storage for the PDU response packet with MUX access.
+**
+****************************************************************************************/
+static void TbxMbServerFC03ReadHoldingRegs(tTbxMbServerCtx       * context,
+                                           tTbxMbTpPacket  const * rxPacket,
+                                           tTbxMbTpPacket        * txPacket)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((context != NULL) && (rxPacket != NULL) && (txPacket != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((context != NULL) && (rxPacket != NULL) && (txPacket != NULL))
+  {
+    /* Read out request packet parameters. */
+    uint16_t startAddr = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]);
+    uint16_t numRegs   = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[2]);
+
+    /* Check if a callback function, data table or register map was registered. */
+    if ((context->readHoldingRegFcn == NULL) && (context->readHoldingRegsFcn == NULL) &&
+        (context->holdingRegTbl.rdData == NULL) &&
+        (context->holdingRegMap.entries == NULL))
+    {
+      /* Prepare exception response. */
+      txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
+      txPacket->pdu.data[0] = TBX_MB_EC01_ILLEGAL_FUNCTION;
       txPacket->dataLen = 1U;
     }
-    /* Check if the quantity of inputs is invalid. */
-    else if ((numInputs < 1U) || (numInputs > 2000U))
+    /* Check if the quantity of registers is invalid. */
+    else if ((numRegs < 1U) || (numRegs > 125U))
     {
       /* Prepare exception response. */
       txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
@@ -727,81 +2649,389 @@ static void TbxMbServerFC02ReadInputs(tTbxMbServerCtx       * context,
     /* All is good for further processing. */
     else
     {
-      /* Determine the number of bytes needed to hold all the input bits. The cast to
-       * U8 is okay, because we know that numInputs is <= 2000.
-       */
-      uint8_t numBytes = (uint8_t)(numInputs / 8U);
-      if ((numInputs % 8U) != 0U)
+      tTbxMbServerResult srvResult = TBX_MB_SERVER_OK;
+      /* Store byte count in the response and prepare the data length. */
+      txPacket->pdu.data[0] = 2U * numRegs;
+      txPacket->dataLen = txPacket->pdu.data[0] + 1U;
+      /* Obtain the register values and store them in the response. */
+      srvResult = TbxMbServerHoldingRegsRead(context, startAddr, (uint8_t)numRegs,
+                                             &txPacket->pdu.data[1]);
+      /* Exception detected? */
+      if (srvResult != TBX_MB_SERVER_OK)
       {
-        numBytes++;
+        /* Prepare exception response. */
+        txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
+        if (srvResult == TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR)
+        {
+          txPacket->pdu.data[0] = TBX_MB_EC02_ILLEGAL_DATA_ADDRESS;
+        }
+        else
+        {
+          txPacket->pdu.data[0] = TBX_MB_EC04_SERVER_DEVICE_FAILURE;
+        }
+        txPacket->dataLen = 1U;
       }
+    }
+  }
+} /*** end of TbxMbServerFC03ReadHoldingRegs ***/
+#endif
+
+
+#if (TBX_MB_SERVER_FC04_ENABLE > 0U)
+/************************************************************************************//**
+** \brief     Handles a newly received PDU for function code 4 - Read Input Registers.
+** \details   Note that this function is called at a time that txPacket->code is already
+**            prepared. Also note that txPacket->node should not be touched here.
+** \param     context Pointer to the Modbus server channel context.
+** \param     rxPacket Received PDU packet with MUX access.
+** \param     txPacket Storage for the PDU response packet with MUX access.
+**
+****************************************************************************************/
+static void TbxMbServerFC04ReadInputRegs(tTbxMbServerCtx       * context,
+                                        tTbxMbTpPacket  const * rxPacket,
+                                        tTbxMbTpPacket        * txPacket)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((context != NULL) && (rxPacket != NULL) && (txPacket != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((context != NULL) && (rxPacket != NULL) && (txPacket != NULL))
+  {
+    /* Read out request packet parameters. */
+    uint16_t startAddr = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]);
+    uint16_t numRegs   = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[2]);
+
+    /* Check if a callback function, data table or register map was registered. */
+    if ((context->readInputRegFcn == NULL) && (context->readInputRegsFcn == NULL) &&
+        (context->inputRegTbl.rdData == NULL) && (context->inputRegMap.entries == NULL))
+    {
+      /* Prepare exception response. */
+      txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
+      txPacket->pdu.data[0] = TBX_MB_EC01_ILLEGAL_FUNCTION;
+      txPacket->dataLen = 1U;
+    }
+    /* Check if the quantity of registers is invalid. */
+    else if ((numRegs < 1U) || (numRegs > 125U))
+    {
+      /* Prepare exception response. */
+      txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
+      txPacket->pdu.data[0] = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
+      txPacket->dataLen = 1U;
+    }
+    /* All is good for further processing. */
+    else
+    {
+      tTbxMbServerResult srvResult = TBX_MB_SERVER_OK;
       /* Store byte count in the response and prepare the data length. */
-      txPacket->pdu.data[0] = numBytes;
+      txPacket->pdu.data[0] = 2U * numRegs;
       txPacket->dataLen = txPacket->pdu.data[0] + 1U;
-      /* Prepare loop indices that aid with storing the input bits. */
-      uint8_t   bitIdx  = 0U;
-      uint8_t   byteIdx = 0U;
-      /* Initialize byte array pointer for writing the input bits in the response and
-       * already initialize the first byte to all zero (input OFF) bits.
-       */
-      uint8_t * inputData = &txPacket->pdu.data[1];
-      inputData[0] = 0U;
-      /* Loop through all the inputs. */
-      for (uint16_t idx = 0U; idx < numInputs; idx++)
+      /* Are all the requested registers located in the data table? */
+      if (TbxMbServerTableContains(&context->inputRegTbl, startAddr, numRegs) ==
+          TBX_TRUE)
+      {
+        /* Point to the first requested register in the data table. */
+        uint16_t const * regs = context->inputRegTbl.rdData;
+        regs = &regs[startAddr - context->inputRegTbl.addr];
+        /* Copy the register values in the big endian format to the response. */
+        for (uint8_t idx = 0U; idx < numRegs; idx++)
+        {
+          TbxMbCommonStoreUInt16BE(regs[idx], &txPacket->pdu.data[1U + (idx * 2U)]);
+        }
+      }
+      /* Are all the requested registers covered by the register map? */
+      else if (TbxMbServerMapCovers(&context->inputRegMap, startAddr, numRegs,
+                                    TBX_FALSE) == TBX_TRUE)
+      {
+        /* Obtain the register values, one run at a time. */
+        srvResult = TbxMbServerMapRead(context, &context->inputRegMap, startAddr,
+                                       (uint8_t)numRegs, context->regBuf);
+        /* No exception reported? */
+        if (srvResult == TBX_MB_SERVER_OK)
+        {
+          /* Store the register values in the response. */
+          for (uint8_t idx = 0U; idx < numRegs; idx++)
+          {
+            TbxMbCommonStoreUInt16BE(context->regBuf[idx],
+                                     &txPacket->pdu.data[1U + (idx * 2U)]);
+          }
+        }
+      }
+      /* Prefer the register range callback, if registered. */
+      else if (context->readInputRegsFcn != NULL)
+      {
+        /* Obtain all register values at once. */
+        srvResult = context->readInputRegsFcn(context, startAddr, (uint8_t)numRegs,
+                                              context->regBuf);
+        /* No exception reported? */
+        if (srvResult == TBX_MB_SERVER_OK)
+        {
+          /* Store the register values in the response. */
+          for (uint8_t idx = 0U; idx < numRegs; idx++)
+          {
+            TbxMbCommonStoreUInt16BE(context->regBuf[idx],
+                                     &txPacket->pdu.data[1U + (idx * 2U)]);
+          }
+        }
+      }
+      /* Without a callback, the requested registers are not supported. */
+      else if (context->readInputRegFcn == NULL)
+      {
+        srvResult = TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR;
+      }
+      /* Fall back to the per-register callback. */
+      else
+      {
+        /* Loop through all the registers, until an exception is reported. */
+        for (uint8_t idx = 0U; (idx < numRegs) && (srvResult == TBX_MB_SERVER_OK); idx++)
+        {
+          uint16_t regValue = 0U;
+          /* Obtain register value. */
+          srvResult = context->readInputRegFcn(context, startAddr + idx, &regValue);
+          /* No exception reported? */
+          if (srvResult == TBX_MB_SERVER_OK)
+          {
+            /* Store the register value in the response. */
+            TbxMbCommonStoreUInt16BE(regValue, &txPacket->pdu.data[1U + (idx * 2U)]);
+          }
+        }
+      }
+      /* Exception detected? */
+      if (srvResult != TBX_MB_SERVER_OK)
+      {
+        /* Prepare exception response. */
+        txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
+        if (srvResult == TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR)
+        {
+          txPacket->pdu.data[0] = TBX_MB_EC02_ILLEGAL_DATA_ADDRESS;
+        }
+        else
+        {
+          txPacket->pdu.data[0] = TBX_MB_EC04_SERVER_DEVICE_FAILURE;
+        }
+        txPacket->dataLen = 1U;
+      }
+    }
+  }
+} /*** end of TbxMbServerFC04ReadInputRegs ***/
+#endif
+
+
+#if (TBX_MB_SERVER_FC05_ENABLE > 0U)
+/************************************************************************************//**
+** \brief     Handles a newly received PDU for function code 5 - Write Single Coil.
+** \details   Note that this function is called at a time that txPacket->code is already
+**            prepared. Also note that txPacket->node should not be touched here.
+** \param     context Pointer to the Modbus server channel context.
+** \param     rxPacket Received PDU packet with MUX access.
+** \param     txPacket Storage for the PDU response packet with MUX access.
+**
+****************************************************************************************/
+static void TbxMbServerFC05WriteSingleCoil(tTbxMbServerCtx       * context,
+                                           tTbxMbTpPacket  const * rxPacket,
+                                           tTbxMbTpPacket        * txPacket)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((context != NULL) && (rxPacket != NULL) && (txPacket != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((context != NULL) && (rxPacket != NULL) && (txPacket != NULL))
+  {
+    /* Read out request packet parameters. */
+    uint16_t startAddr   = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]);
+    uint16_t outputValue = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[2]);
+
+    /* Check if a callback function or data table was registered. */
+    if ((context->writeCoilFcn == NULL) && (context->writeCoilsFcn == NULL) &&
+        (context->coilTbl.wrData == NULL))
+    {
+      /* Prepare exception response. */
+      txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
+      txPacket->pdu.data[0] = TBX_MB_EC01_ILLEGAL_FUNCTION;
+      txPacket->dataLen = 1U;
+    }
+    /* Check if the output value is invalid. */
+    else if ((outputValue != 0x0000U) && (outputValue != 0xFF00U))
+    {
+      /* Prepare exception response. */
+      txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
+      txPacket->pdu.data[0] = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
+      txPacket->dataLen = 1U;
+    }
+    /* All is good for further processing. */
+    else
+    {
+      /* Prepare the response and its data length. It's the same as the request. */
+      txPacket->pdu.data[0U] = rxPacket->pdu.data[0U];
+      txPacket->pdu.data[1U] = rxPacket->pdu.data[1U];
+      txPacket->pdu.data[2U] = rxPacket->pdu.data[2U];
+      txPacket->pdu.data[3U] = rxPacket->pdu.data[3U];
+      txPacket->dataLen = 4U;
+      tTbxMbServerResult srvResult = TBX_MB_SERVER_OK;
+      uint8_t            coilValue = (outputValue == 0x0000U) ? TBX_OFF : TBX_ON;
+      /* Is the coil located in the data table? */
+      if (TbxMbServerTableContains(&context->coilTbl, startAddr, 1U) == TBX_TRUE)
+      {
+        /* Determine the location of the coil bit in the data table. */
+        uint8_t  * coils  = context->coilTbl.wrData;
+        uint16_t   bitIdx = startAddr - context->coilTbl.addr;
+        uint8_t    mask   = (uint8_t)(1U << (bitIdx % 8U));
+        /* Write the coil value. */
+        if (coilValue == TBX_ON)
+        {
+          coils[bitIdx / 8U] |= mask;
+        }
+        else
+        {
+          coils[bitIdx / 8U] &= (uint8_t)~mask;
+        }
+        /* Notify the application about the write, if requested. */
+        if (context->tableWrittenFcn != NULL)
+        {
+          context->tableWrittenFcn(context, TBX_MB_SERVER_TABLE_COILS, startAddr, 1U);
+        }
+      }
+      /* Write the coil value. Use the per-coil callback, if registered. */
+      else if (context->writeCoilFcn != NULL)
+      {
+        srvResult = context->writeCoilFcn(context, startAddr, coilValue);
+      }
+      /* Otherwise the coil range callback with just one coil, if registered. */
+      else if (context->writeCoilsFcn != NULL)
+      {
+        uint8_t coilBits = (coilValue == TBX_ON) ? 0x01U : 0x00U;
+        srvResult = context->writeCoilsFcn(context, startAddr, 1U, &coilBits);
+      }
+      /* Without a callback, the requested coil is not supported. */
+      else
+      {
+        srvResult = TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR;
+      }
+      /* Exception reported? */
+      if (srvResult != TBX_MB_SERVER_OK)
+      {
+        /* Prepare exception response. */
+        txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
+        if (srvResult == TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR)
+        {
+          txPacket->pdu.data[0] = TBX_MB_EC02_ILLEGAL_DATA_ADDRESS;
+        }
+        else
+        {
+          txPacket->pdu.data[0] = TBX_MB_EC04_SERVER_DEVICE_FAILURE;
+        }
+        txPacket->dataLen = 1U;
+      }
+    }
+  }
+} /*** end of TbxMbServerFC05WriteSingleCoil ***/
+#endif
+
+
+#if (TBX_MB_SERVER_FC06_ENABLE > 0U)
+/************************************************************************************//**
+** \brief     Handles a newly received PDU for function code 6 - Write Single Register.
+** \details   Note that this function is called at a time that txPacket->code is already
+**            prepared. Also note that txPacket->node should not be touched here.
+** \param     context Pointer to the Modbus server channel context.
+** \param     rxPacket Received PDU packet with MUX access.
+** \param     txPacket Storage for the PDU response packet with MUX access.
+**
+****************************************************************************************/
+static void TbxMbServerFC06WriteSingleReg(tTbxMbServerCtx       * context,
+                                          tTbxMbTpPacket  const * rxPacket,
+                                          tTbxMbTpPacket        * txPacket)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((context != NULL) && (rxPacket != NULL) && (txPacket != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((context != NULL) && (rxPacket != NULL) && (txPacket != NULL))
+  {
+    /* Read out request packet parameters. */
+    uint16_t regAddr  = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]);
+    uint16_t regValue = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[2]);
+
+    /* Check if a callback function, data table or register map was registered. */
+    if ((context->writeHoldingRegFcn == NULL) &&
+        (context->writeHoldingRegsFcn == NULL) &&
+        (context->holdingRegTbl.wrData == NULL) &&
+        (context->holdingRegMap.entries == NULL))
+    {
+      /* Prepare exception response. */
+      txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
+      txPacket->pdu.data[0] = TBX_MB_EC01_ILLEGAL_FUNCTION;
+      txPacket->dataLen = 1U;
+    }
+    /* All is good for further processing. */
+    else
+    {
+      /* Prepare the response and its data length. It's the same as the request. */
+      txPacket->pdu.data[0U] = rxPacket->pdu.data[0U];
+      txPacket->pdu.data[1U] = rxPacket->pdu.data[1U];
+      txPacket->pdu.data[2U] = rxPacket->pdu.data[2U];
+      txPacket->pdu.data[3U] = rxPacket->pdu.data[3U];
+      txPacket->dataLen = 4U;
+      tTbxMbServerResult srvResult = TBX_MB_SERVER_OK;
+      /* Is the register located in the data table? */
+      if (TbxMbServerTableContains(&context->holdingRegTbl, regAddr, 1U) == TBX_TRUE)
+      {
+        /* Write the register value. */
+        uint16_t * regs = context->holdingRegTbl.wrData;
+        regs[regAddr - context->holdingRegTbl.addr] = regValue;
+        /* Notify the application about the write, if requested. */
+        if (context->tableWrittenFcn != NULL)
+        {
+          context->tableWrittenFcn(context, TBX_MB_SERVER_TABLE_HOLDING_REGS, regAddr,
+                                   1U);
+        }
+      }
+      /* Is the register covered by the register map? */
+      else if (TbxMbServerMapCovers(&context->holdingRegMap, regAddr, 1U, TBX_TRUE) ==
+               TBX_TRUE)
+      {
+        /* Write the register value. */
+        srvResult = TbxMbServerMapWrite(context, &context->holdingRegMap, regAddr, 1U,
+                                        &regValue);
+      }
+      /* Write the register value. Use the per-register callback, if registered. */
+      else if (context->writeHoldingRegFcn != NULL)
+      {
+        srvResult = context->writeHoldingRegFcn(context, regAddr, regValue);
+      }
+      /* Otherwise the register range callback with just one register, if registered. */
+      else if (context->writeHoldingRegsFcn != NULL)
+      {
+        srvResult = context->writeHoldingRegsFcn(context, regAddr, 1U, &regValue);
+      }
+      /* Without a callback, the requested register is not supported. */
+      else
+      {
+        srvResult = TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR;
+      }
+      /* Exception reported? */
+      if (srvResult != TBX_MB_SERVER_OK)
       {
-        uint8_t            inputValue = TBX_OFF;
-        tTbxMbServerResult srvResult;
-        /* Obtain input value. */
-        srvResult = context->readInputFcn(context, startAddr + idx, &inputValue);
-        /* No exception reported? */
-        if (srvResult == TBX_MB_SERVER_OK)
+        /* Prepare exception response. */
+        txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
+        if (srvResult == TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR)
         {
-          /* Store the input value in the response. Note that the input bits in a byte
-           * are initialized to all zeroes, so only update if an input is in the ON
-           * state.
-           */
-          if (inputValue != TBX_OFF)
-          {
-            inputData[byteIdx] |= (1U << bitIdx);
-          }
-          /* Update the bit index. */
-          bitIdx++;
-          /* Time to move to the next byte? */
-          if (bitIdx == 8U)
-          {
-            /* Reset the bit index, increment the byte index and initialize the byte to
-             * all zero (input OFF) bits.
-             */
-            bitIdx = 0U;
-            byteIdx++;
-            inputData[byteIdx] = 0U;
-          }
+          txPacket->pdu.data[0] = TBX_MB_EC02_ILLEGAL_DATA_ADDRESS;
         }
-        /* Exception detected. */
         else
         {
-          /* Prepare exception response. */
-          txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-          if (srvResult == TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR)
-          {
-            txPacket->pdu.data[0] = TBX_MB_EC02_ILLEGAL_DATA_ADDRESS;
-          }
-          else
-          {
-            txPacket->pdu.data[0] = TBX_MB_EC04_SERVER_DEVICE_FAILURE;
-          }
-          txPacket->dataLen = 1U;
-          /* Stop looping. */
-          break;
+          txPacket->pdu.data[0] = TBX_MB_EC04_SERVER_DEVICE_FAILURE;
         }
+        txPacket->dataLen = 1U;
       }
     }
   }
-} /*** end of TbxMbServerFC02ReadInputs ***/
+} /*** end of TbxMbServerFC06WriteSingleReg ***/
+#endif
 
 
+#if (TBX_MB_SERVER_FC08_ENABLE > 0U)
 /************************************************************************************//**
-** \brief     Handles a newly received PDU for function code 3 - Read Holding Registers.
+** \brief     Handles a newly received PDU for function code 8 - Diagnostics.
 ** \details   Note that this function is called at a time that txPacket->code is already
 **            prepared. Also note that txPacket->node should not be touched here.
 ** \param     context Pointer to the Modbus server channel context.
@@ -809,9 +3039,9 @@ static void TbxMbServerFC02ReadInputs(tTbxMbServerCtx       * context,
 ** \param     txPacket Storage for the PDU response packet with MUX access.
 **
 ****************************************************************************************/
-static void TbxMbServerFC03ReadHoldingRegs(tTbxMbServerCtx       * context,
-                                           tTbxMbTpPacket  const * rxPacket,
-                                           tTbxMbTpPacket        * txPacket)
+static void TbxMbServerFC08Diagnostics(tTbxMbServerCtx       * context,
+                                       tTbxMbTpPacket  const * rxPacket,
+                                       tTbxMbTpPacket        * txPacket)
 {
   /* Verify parameters. */
   TBX_ASSERT((context != NULL) && (rxPacket != NULL) && (txPacket != NULL));
@@ -820,69 +3050,171 @@ static void TbxMbServerFC03ReadHoldingRegs(tTbxMbServerCtx       * context,
   if ((context != NULL) && (rxPacket != NULL) && (txPacket != NULL))
   {
     /* Read out request packet parameters. */
-    uint16_t startAddr = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]);
-    uint16_t numRegs   = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[2]);
+    uint16_t subCode   = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]);
+    uint16_t dataField = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[2]);
+    /* Prepare the most common response. It's typically the sub-function code echoed,
+     * together with a 16-bit unsigned value.
+     */
+    txPacket->pdu.data[0U] = rxPacket->pdu.data[0U];
+    txPacket->pdu.data[1U] = rxPacket->pdu.data[1U];
+    txPacket->dataLen = 4U;
 
-    /* Check if a callback function was registered. */
-    if (context->readHoldingRegFcn == NULL)
-    {
-      /* Prepare exception response. */
-      txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-      txPacket->pdu.data[0] = TBX_MB_EC01_ILLEGAL_FUNCTION;
-      txPacket->dataLen = 1U;
-    }
-    /* Check if the quantity of registers is invalid. */
-    else if ((numRegs < 1U) || (numRegs > 125U))
-    {
-      /* Prepare exception response. */
-      txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-      txPacket->pdu.data[0] = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
-      txPacket->dataLen = 1U;
-    }
-    /* All is good for further processing. */
-    else
+    /* Filter on the received sub-function code. */
+    switch (subCode)
     {
-      /* Store byte count in the response and prepare the data length. */
-      txPacket->pdu.data[0] = 2U * numRegs;
-      txPacket->dataLen = txPacket->pdu.data[0] + 1U;
-      /* Loop through all the registers. */
-      for (uint8_t idx = 0U; idx < numRegs; idx++)
+      case TBX_MB_DIAG_SC_QUERY_DATA:
       {
-        uint16_t           regValue = 0U;
-        tTbxMbServerResult srvResult;
-        /* Obtain register value. */
-        srvResult = context->readHoldingRegFcn(context, startAddr + idx, &regValue);
-        /* No exception reported? */
-        if (srvResult == TBX_MB_SERVER_OK)
+        /* Echo the received data back. */
+        for (uint8_t idx = 0U; idx < rxPacket->dataLen; idx++)
+        {
+         txPacket->pdu.data[idx] = rxPacket->pdu.data[idx];
+        }
+        txPacket->dataLen = rxPacket->dataLen;
+      }
+      break;
+
+      case TBX_MB_DIAG_SC_CLEAR_COUNTERS:
+      {
+        /* Data field not valid? */
+        if (dataField != 0x0000U)
         {
-          /* Store the register value in the response. */
-          TbxMbCommonStoreUInt16BE(regValue, &txPacket->pdu.data[1U + (idx * 2U)]);
+          /* Prepare exception response. */
+          txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
+          txPacket->pdu.data[0] = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
+          txPacket->dataLen = 1U;
         }
-        /* Exception detected. */
+        /* All is good for further processing. */        
         else
+        {
+          /* Clear the diagnostic counters. */
+          context->tpCtx->diagInfo.busMsgCnt     = 0U;
+          context->tpCtx->diagInfo.busCommErrCnt = 0U;
+          context->tpCtx->diagInfo.busExcpErrCnt = 0U;
+          context->tpCtx->diagInfo.srvMsgCnt     = 0U;
+          context->tpCtx->diagInfo.srvNoRespCnt  = 0U;
+          /* Echo the request data field. */
+          TbxMbCommonStoreUInt16BE(dataField, &txPacket->pdu.data[2U]);
+        }
+      }
+      break;
+
+      case TBX_MB_DIAG_SC_BUS_MESSAGE_COUNT:
+      {
+        /* Data field not valid? */
+        if (dataField != 0x0000U)
         {
           /* Prepare exception response. */
           txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-          if (srvResult == TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR)
-          {
-            txPacket->pdu.data[0] = TBX_MB_EC02_ILLEGAL_DATA_ADDRESS;
-          }
-          else
-          {
-            txPacket->pdu.data[0] = TBX_MB_EC04_SERVER_DEVICE_FAILURE;
-          }
+          txPacket->pdu.data[0] = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
+          txPacket->dataLen = 1U;
+        }
+        /* All is good for further processing. */        
+        else
+        {
+          /* Store he bus message count. */
+          TbxMbCommonStoreUInt16BE(context->tpCtx->diagInfo.busMsgCnt, 
+                                   &txPacket->pdu.data[2U]);
+        }
+      }
+      break;
+
+      case TBX_MB_DIAG_SC_BUS_COMM_ERROR_COUNT:
+      {
+        /* Data field not valid? */
+        if (dataField != 0x0000U)
+        {
+          /* Prepare exception response. */
+          txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
+          txPacket->pdu.data[0] = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
+          txPacket->dataLen = 1U;
+        }
+        /* All is good for further processing. */        
+        else
+        {
+          /* Store he bus message count. */
+          TbxMbCommonStoreUInt16BE(context->tpCtx->diagInfo.busCommErrCnt, 
+                                   &txPacket->pdu.data[2U]);
+        }
+      }
+      break;
+
+      case TBX_MB_DIAG_SC_BUS_EXCEPTION_ERROR_COUNT:
+      {
+        /* Data field not valid? */
+        if (dataField != 0x0000U)
+        {
+          /* Prepare exception response. */
+          txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
+          txPacket->pdu.data[0] = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
+          txPacket->dataLen = 1U;
+        }
+        /* All is good for further processing. */        
+        else
+        {
+          /* Store he bus message count. */
+          TbxMbCommonStoreUInt16BE(context->tpCtx->diagInfo.busExcpErrCnt, 
+                                   &txPacket->pdu.data[2U]);
+        }
+      }
+      break;
+
+      case TBX_MB_DIAG_SC_SERVER_MESSAGE_COUNT:
+      {
+        /* Data field not valid? */
+        if (dataField != 0x0000U)
+        {
+          /* Prepare exception response. */
+          txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
+          txPacket->pdu.data[0] = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
+          txPacket->dataLen = 1U;
+        }
+        /* All is good for further processing. */        
+        else
+        {
+          /* Store he bus message count. */
+          TbxMbCommonStoreUInt16BE(context->tpCtx->diagInfo.srvMsgCnt, 
+                                   &txPacket->pdu.data[2U]);
+        }
+      }
+      break;
+
+      case TBX_MB_DIAG_SC_SERVER_NO_RESPONSE_COUNT:
+      {
+        /* Data field not valid? */
+        if (dataField != 0x0000U)
+        {
+          /* Prepare exception response. */
+          txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
+          txPacket->pdu.data[0] = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
           txPacket->dataLen = 1U;
-          /* Stop looping. */
-          break;
+        }
+        /* All is good for further processing. */        
+        else
+        {
+          /* Store he bus message count. */
+          TbxMbCommonStoreUInt16BE(context->tpCtx->diagInfo.srvNoRespCnt, 
+                                   &txPacket->pdu.data[2U]);
         }
       }
+      break;
+
+      default:
+      {
+        /* Unsupported sub-function code. Prepare exception response. */
+        txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
+        txPacket->pdu.data[0] = TBX_MB_EC01_ILLEGAL_FUNCTION;
+        txPacket->dataLen = 1U;
+      }
+      break;
     }
   }
-} /*** end of TbxMbServerFC03ReadHoldingRegs ***/
+} /*** end of TbxMbServerFC08Diagnostics ***/
+#endif
 
 
+#if (TBX_MB_SERVER_FC15_ENABLE > 0U)
 /************************************************************************************//**
-** \brief     Handles a newly received PDU for function code 4 - Read Input Registers.
+** \brief     Handles a newly received PDU for function code 15 - Write Multiple Coils.
 ** \details   Note that this function is called at a time that txPacket->code is already
 **            prepared. Also note that txPacket->node should not be touched here.
 ** \param     context Pointer to the Modbus server channel context.
@@ -890,9 +3222,9 @@ static void TbxMbServerFC03ReadHoldingRegs(tTbxMbServerCtx       * context,
 ** \param     txPacket Storage for the PDU response packet with MUX access.
 **
 ****************************************************************************************/
-static void TbxMbServerFC04ReadInputRegs(tTbxMbServerCtx       * context,
-                                        tTbxMbTpPacket  const * rxPacket,
-                                        tTbxMbTpPacket        * txPacket)
+static void TbxMbServerFC15WriteMultipleCoils(tTbxMbServerCtx       * context,
+                                              tTbxMbTpPacket  const * rxPacket,
+                                              tTbxMbTpPacket        * txPacket)
 {
   /* Verify parameters. */
   TBX_ASSERT((context != NULL) && (rxPacket != NULL) && (txPacket != NULL));
@@ -902,18 +3234,35 @@ static void TbxMbServerFC04ReadInputRegs(tTbxMbServerCtx       * context,
   {
     /* Read out request packet parameters. */
     uint16_t startAddr = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]);
-    uint16_t numRegs   = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[2]);
-
-    /* Check if a callback function was registered. */
-    if (context->readInputRegFcn == NULL)
+    uint16_t numCoils  = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[2]);
+    uint8_t  byteCnt   = rxPacket->pdu.data[4];
+    /* Determine the number of bytes needed to hold all the coil bits. Make it U16 
+     * because the range validity of numCoils is not yet checked.
+     */
+    uint16_t numBytes = (uint16_t)(numCoils / 8U);
+    if ((numCoils % 8U) != 0U)
+    {
+      numBytes++;
+    }
+    /* Check if a callback function or data table was registered. */
+    if ((context->writeCoilFcn == NULL) && (context->writeCoilsFcn == NULL) &&
+        (context->coilTbl.wrData == NULL))
     {
       /* Prepare exception response. */
       txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
       txPacket->pdu.data[0] = TBX_MB_EC01_ILLEGAL_FUNCTION;
       txPacket->dataLen = 1U;
     }
-    /* Check if the quantity of registers is invalid. */
-    else if ((numRegs < 1U) || (numRegs > 125U))
+    /* Check if the quantity of coils is invalid. */
+    else if (((numCoils < 1U) || (numCoils > 1968U)))
+    {
+      /* Prepare exception response. */
+      txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
+      txPacket->pdu.data[0] = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
+      txPacket->dataLen = 1U;
+    }
+    /* Check if the quantity of bytes is invalid. */
+    else if (numBytes != byteCnt)
     {
       /* Prepare exception response. */
       txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
@@ -923,47 +3272,93 @@ static void TbxMbServerFC04ReadInputRegs(tTbxMbServerCtx       * context,
     /* All is good for further processing. */
     else
     {
-      /* Store byte count in the response and prepare the data length. */
-      txPacket->pdu.data[0] = 2U * numRegs;
-      txPacket->dataLen = txPacket->pdu.data[0] + 1U;
-      /* Loop through all the registers. */
-      for (uint8_t idx = 0U; idx < numRegs; idx++)
+      /* Prepare the response and its data length. It's mostly the same as the request.*/
+      txPacket->pdu.data[0U] = rxPacket->pdu.data[0U];
+      txPacket->pdu.data[1U] = rxPacket->pdu.data[1U];
+      txPacket->pdu.data[2U] = rxPacket->pdu.data[2U];
+      txPacket->pdu.data[3U] = rxPacket->pdu.data[3U];
+      txPacket->dataLen = 4U;
+      tTbxMbServerResult srvResult = TBX_MB_SERVER_OK;
+      /* Initialize byte array pointer for reading the coil bits from the request. */
+      uint8_t const * coilData = &rxPacket->pdu.data[5];
+      /* Are all the requested coils located in the data table? */
+      if (TbxMbServerTableContains(&context->coilTbl, startAddr, numCoils) == TBX_TRUE)
       {
-        uint16_t           regValue = 0U;
-        tTbxMbServerResult srvResult;
-        /* Obtain register value. */
-        srvResult = context->readInputRegFcn(context, startAddr + idx, &regValue);
-        /* No exception reported? */
-        if (srvResult == TBX_MB_SERVER_OK)
+        /* Copy the coil bits from the request to the data table at once. */
+        TbxMbCommonCopyBits(context->coilTbl.wrData,
+                            (uint32_t)startAddr - context->coilTbl.addr, coilData, 0U,
+                            numCoils);
+        /* Notify the application about the write, if requested. */
+        if (context->tableWrittenFcn != NULL)
         {
-          /* Store the register value in the response. */
-          TbxMbCommonStoreUInt16BE(regValue, &txPacket->pdu.data[1U + (idx * 2U)]);
+          context->tableWrittenFcn(context, TBX_MB_SERVER_TABLE_COILS, startAddr,
+                                   numCoils);
         }
-        /* Exception detected. */
-        else
+      }
+      /* Write the coil bits directly from the request, with the range callback. */
+      else if (context->writeCoilsFcn != NULL)
+      {
+        srvResult = context->writeCoilsFcn(context, startAddr, numCoils, coilData);
+      }
+      /* Without a callback, the requested coils are not supported. */
+      else if (context->writeCoilFcn == NULL)
+      {
+        srvResult = TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR;
+      }
+      /* Fall back to the per-coil callback. */
+      else
+      {
+        /* Prepare loop indices that aid with writing the coil bits. */
+        uint8_t bitIdx  = 0U;
+        uint8_t byteIdx = 0U;
+        /* Loop through all the coils, until an exception is reported. */
+        for (uint16_t idx = 0U; (idx < numCoils) && (srvResult == TBX_MB_SERVER_OK);
+             idx++)
         {
-          /* Prepare exception response. */
-          txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-          if (srvResult == TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR)
+          uint8_t coilValue = TBX_OFF;
+          /* Extract the requested coil value. */
+          if ((coilData[byteIdx] & (1U << bitIdx)) != 0U)
           {
-            txPacket->pdu.data[0] = TBX_MB_EC02_ILLEGAL_DATA_ADDRESS;
+            coilValue = TBX_ON;
           }
-          else
+          /* Write the coil value. */
+          srvResult = context->writeCoilFcn(context, startAddr + idx, coilValue);
+          /* Update the bit index. */
+          bitIdx++;
+          /* Time to move to the next byte? */
+          if (bitIdx == 8U)
           {
-            txPacket->pdu.data[0] = TBX_MB_EC04_SERVER_DEVICE_FAILURE;
+            /* Reset the bit index and increment the byte index. */
+            bitIdx = 0U;
+            byteIdx++;
           }
-          txPacket->dataLen = 1U;
-          /* Stop looping. */
-          break;
         }
       }
+      /* Exception reported? */
+      if (srvResult != TBX_MB_SERVER_OK)
+      {
+        /* Prepare exception response. */
+        txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
+        if (srvResult == TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR)
+        {
+          txPacket->pdu.data[0] = TBX_MB_EC02_ILLEGAL_DATA_ADDRESS;
+        }
+        else
+        {
+          txPacket->pdu.data[0] = TBX_MB_EC04_SERVER_DEVICE_FAILURE;
+        }
+        txPacket->dataLen = 1U;
+      }
     }
   }
-} /*** end of TbxMbServerFC04ReadInputRegs ***/
+} /*** end of TbxMbServerFC15WriteMultipleCoils ***/
+#endif
 
 
+#if (TBX_MB_SERVER_FC16_ENABLE > 0U)
 /************************************************************************************//**
-** \brief     Handles a newly received PDU for function code 5 - Write Single Coil.
+** \brief     Handles a newly received PDU for function code 16 - Write Multiple
+**            Registers.
 ** \details   Note that this function is called at a time that txPacket->code is already
 **            prepared. Also note that txPacket->node should not be touched here.
 ** \param     context Pointer to the Modbus server channel context.
@@ -971,9 +3366,9 @@ static void TbxMbServerFC04ReadInputRegs(tTbxMbServerCtx       * context,
 ** \param     txPacket Storage for the PDU response packet with MUX access.
 **
 ****************************************************************************************/
-static void TbxMbServerFC05WriteSingleCoil(tTbxMbServerCtx       * context,
-                                           tTbxMbTpPacket  const * rxPacket,
-                                           tTbxMbTpPacket        * txPacket)
+static void TbxMbServerFC16WriteMultipleRegs(tTbxMbServerCtx       * context,
+                                             tTbxMbTpPacket  const * rxPacket,
+                                             tTbxMbTpPacket        * txPacket)
 {
   /* Verify parameters. */
   TBX_ASSERT((context != NULL) && (rxPacket != NULL) && (txPacket != NULL));
@@ -982,19 +3377,23 @@ static void TbxMbServerFC05WriteSingleCoil(tTbxMbServerCtx       * context,
   if ((context != NULL) && (rxPacket != NULL) && (txPacket != NULL))
   {
     /* Read out request packet parameters. */
-    uint16_t startAddr   = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]);
-    uint16_t outputValue = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[2]);
+    uint16_t startAddr = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]);
+    uint16_t numRegs   = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[2]);
+    uint8_t  byteCnt   = rxPacket->pdu.data[4];
 
-    /* Check if a callback function was registered. */
-    if (context->writeCoilFcn == NULL)
+    /* Check if a callback function, data table or register map was registered. */
+    if ((context->writeHoldingRegFcn == NULL) &&
+        (context->writeHoldingRegsFcn == NULL) &&
+        (context->holdingRegTbl.wrData == NULL) &&
+        (context->holdingRegMap.entries == NULL))
     {
       /* Prepare exception response. */
       txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
       txPacket->pdu.data[0] = TBX_MB_EC01_ILLEGAL_FUNCTION;
       txPacket->dataLen = 1U;
     }
-    /* Check if the output value is invalid. */
-    else if ((outputValue != 0x0000U) && (outputValue != 0xFF00U))
+    /* Check if the quantity of registers is invalid. */
+    else if (((numRegs < 1U) || (numRegs > 123U)) || (byteCnt != (numRegs * 2U)))
     {
       /* Prepare exception response. */
       txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
@@ -1004,16 +3403,16 @@ static void TbxMbServerFC05WriteSingleCoil(tTbxMbServerCtx       * context,
     /* All is good for further processing. */
     else
     {
-      /* Prepare the response and its data length. It's the same as the request. */
+      /* Prepare the response and its data length. It's mostly the same as the request.*/
       txPacket->pdu.data[0U] = rxPacket->pdu.data[0U];
       txPacket->pdu.data[1U] = rxPacket->pdu.data[1U];
       txPacket->pdu.data[2U] = rxPacket->pdu.data[2U];
       txPacket->pdu.data[3U] = rxPacket->pdu.data[3U];
       txPacket->dataLen = 4U;
-      /* Write the coil value. */
-      tTbxMbServerResult srvResult;
-      uint8_t            coilValue = (outputValue == 0x0000U) ? TBX_OFF : TBX_ON;
-      srvResult = context->writeCoilFcn(context, startAddr, coilValue);
+      tTbxMbServerResult srvResult = TBX_MB_SERVER_OK;
+      /* Write the register values from the request. */
+      srvResult = TbxMbServerHoldingRegsWrite(context, startAddr, (uint8_t)numRegs,
+                                              &rxPacket->pdu.data[5]);
       /* Exception reported? */
       if (srvResult != TBX_MB_SERVER_OK)
       {
@@ -1031,11 +3430,16 @@ static void TbxMbServerFC05WriteSingleCoil(tTbxMbServerCtx       * context,
       }
     }
   }
-} /*** end of TbxMbServerFC05WriteSingleCoil ***/
+} /*** end of TbxMbServerFC16WriteMultipleRegs ***/
+#endif
 
 
+#if (TBX_MB_SERVER_FC20_ENABLE > 0U)
 /************************************************************************************//**
-** \brief     Handles a newly received PDU for function code 6 - Write Single Register.
+** \brief     Handles a newly received PDU for function code 20 - Read File Record. The
+**            request holds one or more sub-requests, each one for reading a range of
+**            records from a file. The server calls the read file record callback once
+**            for each sub-request and packs all sub-responses in a single response.
 ** \details   Note that this function is called at a time that txPacket->code is already
 **            prepared. Also note that txPacket->node should not be touched here.
 ** \param     context Pointer to the Modbus server channel context.
@@ -1043,7 +3447,7 @@ static void TbxMbServerFC05WriteSingleCoil(tTbxMbServerCtx       * context,
 ** \param     txPacket Storage for the PDU response packet with MUX access.
 **
 ****************************************************************************************/
-static void TbxMbServerFC06WriteSingleReg(tTbxMbServerCtx       * context,
+static void TbxMbServerFC20ReadFileRecord(tTbxMbServerCtx       * context,
                                           tTbxMbTpPacket  const * rxPacket,
                                           tTbxMbTpPacket        * txPacket)
 {
@@ -1054,51 +3458,113 @@ static void TbxMbServerFC06WriteSingleReg(tTbxMbServerCtx       * context,
   if ((context != NULL) && (rxPacket != NULL) && (txPacket != NULL))
   {
     /* Read out request packet parameters. */
-    uint16_t regAddr  = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]);
-    uint16_t regValue = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[2]);
+    uint8_t byteCnt = rxPacket->pdu.data[0];
 
     /* Check if a callback function was registered. */
-    if (context->writeHoldingRegFcn == NULL)
+    if (context->readFileRecordFcn == NULL)
     {
       /* Prepare exception response. */
       txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
       txPacket->pdu.data[0] = TBX_MB_EC01_ILLEGAL_FUNCTION;
       txPacket->dataLen = 1U;
     }
+    /* Check if the byte count is invalid. Each sub-request is 7 bytes. */
+    else if ((byteCnt < 7U) || (byteCnt > 245U) || ((byteCnt % 7U) != 0U) ||
+             (rxPacket->dataLen != (byteCnt + 1U)))
+    {
+      /* Prepare exception response. */
+      txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
+      txPacket->pdu.data[0] = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
+      txPacket->dataLen = 1U;
+    }
     /* All is good for further processing. */
     else
     {
-      /* Prepare the response and its data length. It's the same as the request. */
-      txPacket->pdu.data[0U] = rxPacket->pdu.data[0U];
-      txPacket->pdu.data[1U] = rxPacket->pdu.data[1U];
-      txPacket->pdu.data[2U] = rxPacket->pdu.data[2U];
-      txPacket->pdu.data[3U] = rxPacket->pdu.data[3U];
-      txPacket->dataLen = 4U;
-      /* Write the register value. */
-      tTbxMbServerResult srvResult;
-      srvResult = context->writeHoldingRegFcn(context, regAddr, regValue);
-      /* Exception reported? */
-      if (srvResult != TBX_MB_SERVER_OK)
+      uint8_t  excCode = 0U;
+      uint8_t  reqIdx  = 0U;
+      uint16_t respLen = 0U;
+
+      /* Process the sub-requests one at a time, until all are done or one failed. */
+      while ((reqIdx < byteCnt) && (excCode == 0U))
       {
-        /* Prepare exception response. */
-        txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-        if (srvResult == TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR)
+        /* Read out the sub-request parameters. */
+        uint8_t  const * subReq = &rxPacket->pdu.data[1U + reqIdx];
+        uint16_t         file   = TbxMbCommonExtractUInt16BE(&subReq[1]);
+        uint16_t         record = TbxMbCommonExtractUInt16BE(&subReq[3]);
+        uint16_t         num    = TbxMbCommonExtractUInt16BE(&subReq[5]);
+        /* Check if the sub-request does not address a valid range of records. */
+        if ((subReq[0] != TBX_MB_FILE_REF_TYPE) || (file == 0U) ||
+            (record > TBX_MB_FILE_RECORD_NUM_MAX) ||
+            (num > ((TBX_MB_FILE_RECORD_NUM_MAX + 1U) - record)))
         {
-          txPacket->pdu.data[0] = TBX_MB_EC02_ILLEGAL_DATA_ADDRESS;
+          excCode = TBX_MB_EC02_ILLEGAL_DATA_ADDRESS;
+        }
+        /* Check if the sub-response would not fit in the response. */
+        else if ((num == 0U) || ((respLen + 2U + (2U * num)) > 245U))
+        {
+          excCode = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
         }
         else
         {
-          txPacket->pdu.data[0] = TBX_MB_EC04_SERVER_DEVICE_FAILURE;
+          /* Obtain the record values from the application. */
+          tTbxMbServerResult srvResult;
+          srvResult = context->readFileRecordFcn(context, file, record, (uint8_t)num,
+                                                 context->regBuf);
+          /* Exception reported? */
+          if (srvResult != TBX_MB_SERVER_OK)
+          {
+            if (srvResult == TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR)
+            {
+              excCode = TBX_MB_EC02_ILLEGAL_DATA_ADDRESS;
+            }
+            else
+            {
+              excCode = TBX_MB_EC04_SERVER_DEVICE_FAILURE;
+            }
+          }
+          else
+          {
+            /* Store the sub-response length, reference type and record values. */
+            uint8_t * subResp = &txPacket->pdu.data[1U + respLen];
+            subResp[0] = (uint8_t)((2U * num) + 1U);
+            subResp[1] = TBX_MB_FILE_REF_TYPE;
+            for (uint8_t idx = 0U; idx < num; idx++)
+            {
+              TbxMbCommonStoreUInt16BE(context->regBuf[idx], &subResp[2U + (idx * 2U)]);
+            }
+            /* Update the response length. */
+            respLen += (uint16_t)(2U + (2U * num));
+          }
         }
+        /* Continue with the next sub-request. */
+        reqIdx += 7U;
+      }
+      /* Exception reported? */
+      if (excCode != 0U)
+      {
+        /* Prepare exception response. */
+        txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
+        txPacket->pdu.data[0] = excCode;
         txPacket->dataLen = 1U;
       }
+      else
+      {
+        /* Store the response data length and prepare the packet's data length. */
+        txPacket->pdu.data[0] = (uint8_t)respLen;
+        txPacket->dataLen = txPacket->pdu.data[0] + 1U;
+      }
     }
   }
-} /*** end of TbxMbServerFC06WriteSingleReg ***/
+} /*** end of TbxMbServerFC20ReadFileRecord ***/
+#endif
 
 
+#if (TBX_MB_SERVER_FC21_ENABLE > 0U)
 /************************************************************************************//**
-** \brief     Handles a newly received PDU for function code 8 - Diagnostics.
+** \brief     Handles a newly received PDU for function code 21 - Write File Record. The
+**            request holds one or more sub-requests, each one for writing a range of
+**            records to a file. The server first validates all sub-requests, before
+**            calling the write file record callback once for each sub-request.
 ** \details   Note that this function is called at a time that txPacket->code is already
 **            prepared. Also note that txPacket->node should not be touched here.
 ** \param     context Pointer to the Modbus server channel context.
@@ -1106,9 +3572,9 @@ static void TbxMbServerFC06WriteSingleReg(tTbxMbServerCtx       * context,
 ** \param     txPacket Storage for the PDU response packet with MUX access.
 **
 ****************************************************************************************/
-static void TbxMbServerFC08Diagnostics(tTbxMbServerCtx       * context,
-                                       tTbxMbTpPacket  const * rxPacket,
-                                       tTbxMbTpPacket        * txPacket)
+static void TbxMbServerFC21WriteFileRecord(tTbxMbServerCtx       * context,
+                                           tTbxMbTpPacket  const * rxPacket,
+                                           tTbxMbTpPacket        * txPacket)
 {
   /* Verify parameters. */
   TBX_ASSERT((context != NULL) && (rxPacket != NULL) && (txPacket != NULL));
@@ -1117,169 +3583,128 @@ static void TbxMbServerFC08Diagnostics(tTbxMbServerCtx       * context,
   if ((context != NULL) && (rxPacket != NULL) && (txPacket != NULL))
   {
     /* Read out request packet parameters. */
-    uint16_t subCode   = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]);
-    uint16_t dataField = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[2]);
-    /* Prepare the most common response. It's typically the sub-function code echoed,
-     * together with a 16-bit unsigned value.
-     */
-    txPacket->pdu.data[0U] = rxPacket->pdu.data[0U];
-    txPacket->pdu.data[1U] = rxPacket->pdu.data[1U];
-    txPacket->dataLen = 4U;
+    uint8_t byteCnt = rxPacket->pdu.data[0];
 
-    /* Filter on the received sub-function code. */
-    switch (subCode)
+    /* Check if a callback function was registered. */
+    if (context->writeFileRecordFcn == NULL)
     {
-      case TBX_MB_DIAG_SC_QUERY_DATA:
-      {
-        /* Echo the received data back. */
-        for (uint8_t idx = 0U; idx < rxPacket->dataLen; idx++)
-        {
-         txPacket->pdu.data[idx] = rxPacket->pdu.data[idx];
-        }
-        txPacket->dataLen = rxPacket->dataLen;
-      }
-      break;
-
-      case TBX_MB_DIAG_SC_CLEAR_COUNTERS:
-      {
-        /* Data field not valid? */
-        if (dataField != 0x0000U)
-        {
-          /* Prepare exception response. */
-          txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-          txPacket->pdu.data[0] = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
-          txPacket->dataLen = 1U;
-        }
-        /* All is good for further processing. */        
-        else
-        {
-          /* Clear the diagnostic counters. */
-          context->tpCtx->diagInfo.busMsgCnt     = 0U;
-          context->tpCtx->diagInfo.busCommErrCnt = 0U;
-          context->tpCtx->diagInfo.busExcpErrCnt = 0U;
-          context->tpCtx->diagInfo.srvMsgCnt     = 0U;
-          context->tpCtx->diagInfo.srvNoRespCnt  = 0U;
-          /* Echo the request data field. */
-          TbxMbCommonStoreUInt16BE(dataField, &txPacket->pdu.data[2U]);
-        }
-      }
-      break;
-
-      case TBX_MB_DIAG_SC_BUS_MESSAGE_COUNT:
-      {
-        /* Data field not valid? */
-        if (dataField != 0x0000U)
-        {
-          /* Prepare exception response. */
-          txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-          txPacket->pdu.data[0] = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
-          txPacket->dataLen = 1U;
-        }
-        /* All is good for further processing. */        
-        else
-        {
-          /* Store he bus message count. */
-          TbxMbCommonStoreUInt16BE(context->tpCtx->diagInfo.busMsgCnt, 
-                                   &txPacket->pdu.data[2U]);
-        }
-      }
-      break;
-
-      case TBX_MB_DIAG_SC_BUS_COMM_ERROR_COUNT:
-      {
-        /* Data field not valid? */
-        if (dataField != 0x0000U)
-        {
-          /* Prepare exception response. */
-          txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-          txPacket->pdu.data[0] = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
-          txPacket->dataLen = 1U;
-        }
-        /* All is good for further processing. */        
-        else
-        {
-          /* Store he bus message count. */
-          TbxMbCommonStoreUInt16BE(context->tpCtx->diagInfo.busCommErrCnt, 
-                                   &txPacket->pdu.data[2U]);
-        }
-      }
-      break;
-
-      case TBX_MB_DIAG_SC_BUS_EXCEPTION_ERROR_COUNT:
-      {
-        /* Data field not valid? */
-        if (dataField != 0x0000U)
-        {
-          /* Prepare exception response. */
-          txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-          txPacket->pdu.data[0] = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
-          txPacket->dataLen = 1U;
-        }
-        /* All is good for further processing. */        
-        else
-        {
-          /* Store he bus message count. */
-          TbxMbCommonStoreUInt16BE(context->tpCtx->diagInfo.busExcpErrCnt, 
-                                   &txPacket->pdu.data[2U]);
-        }
-      }
-      break;
+      /* Prepare exception response. */
+      txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
+      txPacket->pdu.data[0] = TBX_MB_EC01_ILLEGAL_FUNCTION;
+      txPacket->dataLen = 1U;
+    }
+    /* Check if the byte count is invalid. The smallest sub-request is 9 bytes. */
+    else if ((byteCnt < 9U) || (byteCnt > 251U) || (rxPacket->dataLen != (byteCnt + 1U)))
+    {
+      /* Prepare exception response. */
+      txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
+      txPacket->pdu.data[0] = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
+      txPacket->dataLen = 1U;
+    }
+    /* All is good for further processing. */
+    else
+    {
+      uint8_t  excCode = 0U;
+      uint16_t reqIdx  = 0U;
 
-      case TBX_MB_DIAG_SC_SERVER_MESSAGE_COUNT:
+      /* Validate all sub-requests first, such that a malformed request does not
+       * result in a partial write.
+       */
+      while ((reqIdx < byteCnt) && (excCode == 0U))
       {
-        /* Data field not valid? */
-        if (dataField != 0x0000U)
+        /* Check if the sub-request header does not fit in the request. */
+        if ((reqIdx + 7U) > byteCnt)
         {
-          /* Prepare exception response. */
-          txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-          txPacket->pdu.data[0] = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
-          txPacket->dataLen = 1U;
+          excCode = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
         }
-        /* All is good for further processing. */        
         else
         {
-          /* Store he bus message count. */
-          TbxMbCommonStoreUInt16BE(context->tpCtx->diagInfo.srvMsgCnt, 
-                                   &txPacket->pdu.data[2U]);
+          /* Read out the sub-request parameters. */
+          uint8_t  const * subReq = &rxPacket->pdu.data[1U + reqIdx];
+          uint16_t         file   = TbxMbCommonExtractUInt16BE(&subReq[1]);
+          uint16_t         record = TbxMbCommonExtractUInt16BE(&subReq[3]);
+          uint16_t         num    = TbxMbCommonExtractUInt16BE(&subReq[5]);
+          /* Check if the sub-request does not address a valid range of records. */
+          if ((subReq[0] != TBX_MB_FILE_REF_TYPE) || (file == 0U) ||
+              (record > TBX_MB_FILE_RECORD_NUM_MAX) ||
+              (num > ((TBX_MB_FILE_RECORD_NUM_MAX + 1U) - record)))
+          {
+            excCode = TBX_MB_EC02_ILLEGAL_DATA_ADDRESS;
+          }
+          /* Check if the record values do not fit in the request. */
+          else if ((num == 0U) || ((reqIdx + 7U + (2U * num)) > byteCnt))
+          {
+            excCode = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
+          }
+          else
+          {
+            /* Continue with the next sub-request. */
+            reqIdx += (uint16_t)(7U + (2U * num));
+          }
         }
       }
-      break;
-
-      case TBX_MB_DIAG_SC_SERVER_NO_RESPONSE_COUNT:
+      /* Write the records of each sub-request, until all are done or one failed. */
+      reqIdx = 0U;
+      while ((reqIdx < byteCnt) && (excCode == 0U))
       {
-        /* Data field not valid? */
-        if (dataField != 0x0000U)
+        /* Read out the sub-request parameters. */
+        uint8_t  const * subReq = &rxPacket->pdu.data[1U + reqIdx];
+        uint16_t         file   = TbxMbCommonExtractUInt16BE(&subReq[1]);
+        uint16_t         record = TbxMbCommonExtractUInt16BE(&subReq[3]);
+        uint8_t          num    = subReq[6];
+        /* Convert the record values to the CPUs native endianess. */
+        for (uint8_t idx = 0U; idx < num; idx++)
         {
-          /* Prepare exception response. */
-          txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-          txPacket->pdu.data[0] = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
-          txPacket->dataLen = 1U;
+          context->regBuf[idx] = TbxMbCommonExtractUInt16BE(&subReq[7U + (idx * 2U)]);
         }
-        /* All is good for further processing. */        
-        else
+        /* Pass the record values on to the application. */
+        tTbxMbServerResult srvResult;
+        srvResult = context->writeFileRecordFcn(context, file, record, num,
+                                                context->regBuf);
+        /* Exception reported? */
+        if (srvResult != TBX_MB_SERVER_OK)
         {
-          /* Store he bus message count. */
-          TbxMbCommonStoreUInt16BE(context->tpCtx->diagInfo.srvNoRespCnt, 
-                                   &txPacket->pdu.data[2U]);
+          if (srvResult == TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR)
+          {
+            excCode = TBX_MB_EC02_ILLEGAL_DATA_ADDRESS;
+          }
+          else
+          {
+            excCode = TBX_MB_EC04_SERVER_DEVICE_FAILURE;
+          }
         }
+        /* Continue with the next sub-request. */
+        reqIdx += (uint16_t)(7U + (2U * num));
       }
-      break;
-
-      default:
+      /* Exception reported? */
+      if (excCode != 0U)
       {
-        /* Unsupported sub-function code. Prepare exception response. */
+        /* Prepare exception response. */
         txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-        txPacket->pdu.data[0] = TBX_MB_EC01_ILLEGAL_FUNCTION;
+        txPacket->pdu.data[0] = excCode;
         txPacket->dataLen = 1U;
       }
-      break;
+      else
+      {
+        /* Prepare the response and its data length. It's the same as the request. */
+        for (uint16_t idx = 0U; idx <= byteCnt; idx++)
+        {
+          txPacket->pdu.data[idx] = rxPacket->pdu.data[idx];
+        }
+        txPacket->dataLen = byteCnt + 1U;
+      }
     }
   }
-} /*** end of TbxMbServerFC08Diagnostics ***/
+} /*** end of TbxMbServerFC21WriteFileRecord ***/
+#endif
 
 
+#if (TBX_MB_SERVER_FC22_ENABLE > 0U)
 /************************************************************************************//**
-** \brief     Handles a newly received PDU for function code 15 - Write Multiple Coils.
+** \brief     Handles a newly received PDU for function code 22 - Mask Write Register.
+**            It reads the current register value, applies the AND and OR masks and
+**            writes the result back, such that a client can modify individual bits with
+**            a single request.
 ** \details   Note that this function is called at a time that txPacket->code is already
 **            prepared. Also note that txPacket->node should not be touched here.
 ** \param     context Pointer to the Modbus server channel context.
@@ -1287,9 +3712,9 @@ static void TbxMbServerFC08Diagnostics(tTbxMbServerCtx       * context,
 ** \param     txPacket Storage for the PDU response packet with MUX access.
 **
 ****************************************************************************************/
-static void TbxMbServerFC15WriteMultipleCoils(tTbxMbServerCtx       * context,
-                                              tTbxMbTpPacket  const * rxPacket,
-                                              tTbxMbTpPacket        * txPacket)
+static void TbxMbServerFC22MaskWriteReg(tTbxMbServerCtx       * context,
+                                        tTbxMbTpPacket  const * rxPacket,
+                                        tTbxMbTpPacket        * txPacket)
 {
   /* Verify parameters. */
   TBX_ASSERT((context != NULL) && (rxPacket != NULL) && (txPacket != NULL));
@@ -1298,35 +3723,117 @@ static void TbxMbServerFC15WriteMultipleCoils(tTbxMbServerCtx       * context,
   if ((context != NULL) && (rxPacket != NULL) && (txPacket != NULL))
   {
     /* Read out request packet parameters. */
-    uint16_t startAddr = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]);
-    uint16_t numCoils  = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[2]);
-    uint8_t  byteCnt   = rxPacket->pdu.data[4];
-    /* Determine the number of bytes needed to hold all the coil bits. Make it U16 
-     * because the range validity of numCoils is not yet checked.
+    uint16_t regAddr = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]);
+    uint16_t andMask = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[2]);
+    uint16_t orMask  = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[4]);
+
+    /* Check if callback functions, a data table or a register map were registered,
+     * for both reading and writing holding registers.
      */
-    uint16_t numBytes = (uint16_t)(numCoils / 8U);
-    if ((numCoils % 8U) != 0U)
-    {
-      numBytes++;
-    }
-    /* Check if a callback function was registered. */
-    if (context->writeCoilFcn == NULL)
+    if (((context->readHoldingRegFcn == NULL) && (context->readHoldingRegsFcn == NULL) &&
+         (context->holdingRegTbl.rdData == NULL) &&
+         (context->holdingRegMap.entries == NULL)) ||
+        ((context->writeHoldingRegFcn == NULL) &&
+         (context->writeHoldingRegsFcn == NULL) &&
+         (context->holdingRegTbl.wrData == NULL) &&
+         (context->holdingRegMap.entries == NULL)))
     {
       /* Prepare exception response. */
       txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
       txPacket->pdu.data[0] = TBX_MB_EC01_ILLEGAL_FUNCTION;
       txPacket->dataLen = 1U;
     }
-    /* Check if the quantity of coils is invalid. */
-    else if (((numCoils < 1U) || (numCoils > 1968U)))
+    /* All is good for further processing. */
+    else
+    {
+      uint8_t regData[2];
+      /* Prepare the response and its data length. It's the same as the request. */
+      for (uint8_t idx = 0U; idx < 6U; idx++)
+      {
+        txPacket->pdu.data[idx] = rxPacket->pdu.data[idx];
+      }
+      txPacket->dataLen = 6U;
+      /* Obtain the current register value. */
+      tTbxMbServerResult srvResult;
+      srvResult = TbxMbServerHoldingRegsRead(context, regAddr, 1U, regData);
+      /* No exception reported? */
+      if (srvResult == TBX_MB_SERVER_OK)
+      {
+        /* Apply the masks, as specified by the Modbus protocol. */
+        uint16_t regValue = TbxMbCommonExtractUInt16BE(regData);
+        regValue = (regValue & andMask) | (orMask & (uint16_t)~andMask);
+        TbxMbCommonStoreUInt16BE(regValue, regData);
+        /* Write the new register value. */
+        srvResult = TbxMbServerHoldingRegsWrite(context, regAddr, 1U, regData);
+      }
+      /* Exception reported? */
+      if (srvResult != TBX_MB_SERVER_OK)
+      {
+        /* Prepare exception response. */
+        txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
+        if (srvResult == TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR)
+        {
+          txPacket->pdu.data[0] = TBX_MB_EC02_ILLEGAL_DATA_ADDRESS;
+        }
+        else
+        {
+          txPacket->pdu.data[0] = TBX_MB_EC04_SERVER_DEVICE_FAILURE;
+        }
+        txPacket->dataLen = 1U;
+      }
+    }
+  }
+} /*** end of TbxMbServerFC22MaskWriteReg ***/
+#endif
+
+
+#if (TBX_MB_SERVER_FC23_ENABLE > 0U)
+/************************************************************************************//**
+** \brief     Handles a newly received PDU for function code 23 - Read/Write Multiple
+**            Registers. The write operation is performed before the read operation.
+** \details   Note that this function is called at a time that txPacket->code is already
+**            prepared. Also note that txPacket->node should not be touched here.
+** \param     context Pointer to the Modbus server channel context.
+** \param     rxPacket Received PDU packet with MUX access.
+** \param     txPacket Storage for the PDU response packet with MUX access.
+**
+****************************************************************************************/
+static void TbxMbServerFC23ReadWriteMultipleRegs(tTbxMbServerCtx       * context,
+                                                 tTbxMbTpPacket  const * rxPacket,
+                                                 tTbxMbTpPacket        * txPacket)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((context != NULL) && (rxPacket != NULL) && (txPacket != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((context != NULL) && (rxPacket != NULL) && (txPacket != NULL))
+  {
+    /* Read out request packet parameters. */
+    uint16_t readAddr  = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]);
+    uint16_t numRead   = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[2]);
+    uint16_t writeAddr = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[4]);
+    uint16_t numWrite  = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[6]);
+    uint8_t  byteCnt   = rxPacket->pdu.data[8];
+
+    /* Check if callback functions, a data table or a register map were registered,
+     * for both reading and writing holding registers.
+     */
+    if (((context->readHoldingRegFcn == NULL) && (context->readHoldingRegsFcn == NULL) &&
+         (context->holdingRegTbl.rdData == NULL) &&
+         (context->holdingRegMap.entries == NULL)) ||
+        ((context->writeHoldingRegFcn == NULL) &&
+         (context->writeHoldingRegsFcn == NULL) &&
+         (context->holdingRegTbl.wrData == NULL) &&
+         (context->holdingRegMap.entries == NULL)))
     {
       /* Prepare exception response. */
       txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-      txPacket->pdu.data[0] = TBX_MB_EC03_ILLEGAL_DATA_VALUE;
+      txPacket->pdu.data[0] = TBX_MB_EC01_ILLEGAL_FUNCTION;
       txPacket->dataLen = 1U;
     }
-    /* Check if the quantity of bytes is invalid. */
-    else if (numBytes != byteCnt)
+    /* Check if the quantity of registers is invalid. */
+    else if (((numRead < 1U) || (numRead > 125U)) ||
+             ((numWrite < 1U) || (numWrite > 121U)) || (byteCnt != (numWrite * 2U)))
     {
       /* Prepare exception response. */
       txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
@@ -1336,64 +3843,47 @@ static void TbxMbServerFC15WriteMultipleCoils(tTbxMbServerCtx       * context,
     /* All is good for further processing. */
     else
     {
-      /* Prepare the response and its data length. It's mostly the same as the request.*/
-      txPacket->pdu.data[0U] = rxPacket->pdu.data[0U];
-      txPacket->pdu.data[1U] = rxPacket->pdu.data[1U];
-      txPacket->pdu.data[2U] = rxPacket->pdu.data[2U];
-      txPacket->pdu.data[3U] = rxPacket->pdu.data[3U];
-      txPacket->dataLen = 4U;
-      /* Prepare loop indices that aid with writing the coil bits. */
-      uint8_t         bitIdx  = 0U;
-      uint8_t         byteIdx = 0U;
-      /* Initialize byte array pointer for reading the coil bits from the request. */
-      uint8_t const * coilData = &rxPacket->pdu.data[5];
-      /* Loop through all the coils. */
-      for (uint16_t idx = 0U; idx < numCoils; idx++)
+      /* Write the register values from the request. */
+      tTbxMbServerResult srvResult;
+      srvResult = TbxMbServerHoldingRegsWrite(context, writeAddr, (uint8_t)numWrite,
+                                              &rxPacket->pdu.data[9]);
+      /* No exception reported? */
+      if (srvResult == TBX_MB_SERVER_OK)
       {
-        uint8_t            coilValue = TBX_OFF;
-        tTbxMbServerResult srvResult;
-        /* Extract the requested coil value. */
-        if ((coilData[byteIdx] & (1U << bitIdx)) != 0U)
-        {
-          coilValue = TBX_ON;
-        }
-        /* Write the coil value. */
-        srvResult = context->writeCoilFcn(context, startAddr + idx, coilValue);
-        /* Exception reported? */
-        if (srvResult != TBX_MB_SERVER_OK)
+        /* Store byte count in the response and prepare the data length. */
+        txPacket->pdu.data[0] = 2U * numRead;
+        txPacket->dataLen = txPacket->pdu.data[0] + 1U;
+        /* Obtain the register values and store them in the response. */
+        srvResult = TbxMbServerHoldingRegsRead(context, readAddr, (uint8_t)numRead,
+                                               &txPacket->pdu.data[1]);
+      }
+      /* Exception reported? */
+      if (srvResult != TBX_MB_SERVER_OK)
+      {
+        /* Prepare exception response. */
+        txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
+        if (srvResult == TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR)
         {
-          /* Prepare exception response. */
-          txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-          if (srvResult == TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR)
-          {
-            txPacket->pdu.data[0] = TBX_MB_EC02_ILLEGAL_DATA_ADDRESS;
-          }
-          else
-          {
-            txPacket->pdu.data[0] = TBX_MB_EC04_SERVER_DEVICE_FAILURE;
-          }
-          txPacket->dataLen = 1U;
-          /* Stop looping. */
-          break;
+          txPacket->pdu.data[0] = TBX_MB_EC02_ILLEGAL_DATA_ADDRESS;
         }
-        /* Update the bit index. */
-        bitIdx++;
-        /* Time to move to the next byte? */
-        if (bitIdx == 8U)
+        else
         {
-          /* Reset the bit index and increment the byte index. */
-          bitIdx = 0U;
-          byteIdx++;
+          txPacket->pdu.data[0] = TBX_MB_EC04_SERVER_DEVICE_FAILURE;
         }
+        txPacket->dataLen = 1U;
       }
     }
   }
-} /*** end of TbxMbServerFC15WriteMultipleCoils ***/
+} /*** end of TbxMbServerFC23ReadWriteMultipleRegs ***/
+#endif
 
 
+#if (TBX_MB_SERVER_FC24_ENABLE > 0U)
 /************************************************************************************//**
-** \brief     Handles a newly received PDU for function code 16 - Write Multiple
-**            Registers.
+** \brief     Handles a newly received PDU for function code 24 - Read FIFO Queue. The
+**            response holds the values that are currently in the FIFO queue, up to
+**            TBX_MB_FIFO_COUNT_MAX of them. The server removes these values from the
+**            queue, such that the next request continues with the values after them.
 ** \details   Note that this function is called at a time that txPacket->code is already
 **            prepared. Also note that txPacket->node should not be touched here.
 ** \param     context Pointer to the Modbus server channel context.
@@ -1401,9 +3891,9 @@ static void TbxMbServerFC15WriteMultipleCoils(tTbxMbServerCtx       * context,
 ** \param     txPacket Storage for the PDU response packet with MUX access.
 **
 ****************************************************************************************/
-static void TbxMbServerFC16WriteMultipleRegs(tTbxMbServerCtx       * context,
-                                             tTbxMbTpPacket  const * rxPacket,
-                                             tTbxMbTpPacket        * txPacket)
+static void TbxMbServerFC24ReadFifoQueue(tTbxMbServerCtx       * context,
+                                         tTbxMbTpPacket  const * rxPacket,
+                                         tTbxMbTpPacket        * txPacket)
 {
   /* Verify parameters. */
   TBX_ASSERT((context != NULL) && (rxPacket != NULL) && (txPacket != NULL));
@@ -1412,20 +3902,111 @@ static void TbxMbServerFC16WriteMultipleRegs(tTbxMbServerCtx       * context,
   if ((context != NULL) && (rxPacket != NULL) && (txPacket != NULL))
   {
     /* Read out request packet parameters. */
-    uint16_t startAddr = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]);
-    uint16_t numRegs   = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[2]);
-    uint8_t  byteCnt   = rxPacket->pdu.data[4];
+    uint16_t fifoAddr = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[0]);
 
-    /* Check if a callback function was registered. */
-    if (context->writeHoldingRegFcn == NULL)
+    /* Check if a FIFO queue was registered. */
+    if (context->fifo.buffer == NULL)
     {
       /* Prepare exception response. */
       txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
       txPacket->pdu.data[0] = TBX_MB_EC01_ILLEGAL_FUNCTION;
       txPacket->dataLen = 1U;
     }
-    /* Check if the quantity of registers is invalid. */
-    else if (((numRegs < 1U) || (numRegs > 123U)) || (byteCnt != (numRegs * 2U)))
+    /* Check if the FIFO pointer address is not the one of the FIFO queue. */
+    else if (fifoAddr != context->fifo.addr)
+    {
+      /* Prepare exception response. */
+      txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
+      txPacket->pdu.data[0] = TBX_MB_EC02_ILLEGAL_DATA_ADDRESS;
+      txPacket->dataLen = 1U;
+    }
+    /* All is good for further processing. */
+    else
+    {
+      /* Take a snapshot of the head. The application might add values in the meantime,
+       * which are then simply left for the next request.
+       */
+      uint16_t head = context->fifo.head;
+      uint16_t tail = context->fifo.tail;
+      uint16_t count;
+      /* Determine the number of values in the queue. */
+      if (head >= tail)
+      {
+        count = head - tail;
+      }
+      else
+      {
+        count = (context->fifo.size - tail) + head;
+      }
+      /* Limit the number of values to what fits in a single response. */
+      if (count > TBX_MB_FIFO_COUNT_MAX)
+      {
+        count = TBX_MB_FIFO_COUNT_MAX;
+      }
+      /* Store the byte count and the FIFO count in the response. */
+      TbxMbCommonStoreUInt16BE((count * 2U) + 2U, &txPacket->pdu.data[0]);
+      TbxMbCommonStoreUInt16BE(count, &txPacket->pdu.data[2]);
+      /* Copy the values from the queue to the response. */
+      for (uint8_t idx = 0U; idx < count; idx++)
+      {
+        TbxMbCommonStoreUInt16BE(context->fifo.buffer[tail],
+                                 &txPacket->pdu.data[4U + (idx * 2U)]);
+        tail++;
+        if (tail == context->fifo.size)
+        {
+          tail = 0U;
+        }
+      }
+      /* Remove the values from the queue, now that they are copied. */
+      context->fifo.tail = tail;
+      /* Prepare the data length of the response. */
+      txPacket->dataLen = (count * 2U) + 4U;
+    }
+  }
+} /*** end of TbxMbServerFC24ReadFifoQueue ***/
+#endif
+
+
+#if (TBX_MB_SERVER_FC43_ENABLE > 0U)
+/************************************************************************************//**
+** \brief     Handles a newly received PDU for function code 43 - Encapsulated Interface
+**            Transport. The server itself implements MEI type 14 - Read Device
+**            Identification, once the application registered the device identification
+**            objects. All other requests are passed on to the custom function code
+**            callback.
+** \details   Note that this function is called at a time that txPacket->code is already
+**            prepared. Also note that txPacket->node should not be touched here.
+** \param     context Pointer to the Modbus server channel context.
+** \param     rxPacket Received PDU packet with MUX access.
+** \param     txPacket Storage for the PDU response packet with MUX access.
+**
+****************************************************************************************/
+static void TbxMbServerFC43EncapsulatedIf(tTbxMbServerCtx       * context,
+                                          tTbxMbTpPacket  const * rxPacket,
+                                          tTbxMbTpPacket        * txPacket)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((context != NULL) && (rxPacket != NULL) && (txPacket != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((context != NULL) && (rxPacket != NULL) && (txPacket != NULL))
+  {
+    /* Read out request packet parameters. */
+    uint8_t                            meiType   = rxPacket->pdu.data[0];
+    uint8_t                            devIdCode = rxPacket->pdu.data[1];
+    uint8_t                            objectId  = rxPacket->pdu.data[2];
+    tTbxMbServerDeviceIdObject const * objects   = context->devId.objects;
+
+    /* Not a read device identification request or no objects registered? */
+    if ((meiType != TBX_MB_MEI_READ_DEVICE_ID) || (objects == NULL))
+    {
+      /* Pass it on to the custom function code callback, if configured. */
+      (void)TbxMbServerCallCustom(context, context->customFunctionFcn, rxPacket,
+                                  txPacket);
+    }
+    /* Check if the read device identification code is invalid. */
+    else if ((devIdCode < TBX_MB_DEVID_CODE_BASIC) ||
+             (devIdCode > TBX_MB_DEVID_CODE_SPECIFIC))
     {
       /* Prepare exception response. */
       txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
@@ -1435,42 +4016,129 @@ static void TbxMbServerFC16WriteMultipleRegs(tTbxMbServerCtx       * context,
     /* All is good for further processing. */
     else
     {
-      /* Prepare the response and its data length. It's mostly the same as the request.*/
-      txPacket->pdu.data[0U] = rxPacket->pdu.data[0U];
-      txPacket->pdu.data[1U] = rxPacket->pdu.data[1U];
-      txPacket->pdu.data[2U] = rxPacket->pdu.data[2U];
-      txPacket->pdu.data[3U] = rxPacket->pdu.data[3U];
-      txPacket->dataLen = 4U;
-      /* Loop through all the registers. */
-      for (uint8_t idx = 0U; idx < numRegs; idx++)
+      uint16_t idx = 0U;
+      /* Locate the requested object. The objects are sorted, so stop searching as soon
+       * as the id is no longer lower.
+       */
+      while ((idx < context->devId.len) && (objects[idx].id < objectId))
       {
-        uint16_t           regValue;
-        tTbxMbServerResult srvResult;
-        /* Extract the requested register value. */
-        regValue = TbxMbCommonExtractUInt16BE(&rxPacket->pdu.data[5U + (idx * 2U)]);
-        /* Write the register value. */
-        srvResult = context->writeHoldingRegFcn(context, startAddr + idx, regValue);
-        /* Exception reported? */
-        if (srvResult != TBX_MB_SERVER_OK)
+        idx++;
+      }
+      uint8_t objectFound = TBX_FALSE;
+      if (idx < context->devId.len)
+      {
+        if (objects[idx].id == objectId)
         {
-          /* Prepare exception response. */
-          txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
-          if (srvResult == TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR)
+          objectFound = TBX_TRUE;
+        }
+      }
+      /* Determine the highest object id that the request accesses. */
+      uint8_t maxObjectId = objectId;
+      if (devIdCode == TBX_MB_DEVID_CODE_BASIC)
+      {
+        maxObjectId = TBX_MB_DEVID_OBJ_MAJOR_MINOR_REVISION;
+      }
+      else if (devIdCode == TBX_MB_DEVID_CODE_REGULAR)
+      {
+        maxObjectId = 0x7FU;
+      }
+      else if (devIdCode == TBX_MB_DEVID_CODE_EXTENDED)
+      {
+        maxObjectId = 0xFFU;
+      }
+      else
+      {
+        /* Access to one specific object. */
+      }
+      /* Request to access one specific object that does not exist? */
+      if ((devIdCode == TBX_MB_DEVID_CODE_SPECIFIC) && (objectFound == TBX_FALSE))
+      {
+        /* Prepare exception response. */
+        txPacket->pdu.code |= TBX_MB_FC_EXCEPTION_MASK;
+        txPacket->pdu.data[0] = TBX_MB_EC02_ILLEGAL_DATA_ADDRESS;
+        txPacket->dataLen = 1U;
+      }
+      else
+      {
+        /* For stream access, the Modbus protocol specifies that the server restarts at
+         * the first object, if the requested object does not exist or does not belong
+         * to the requested category.
+         */
+        if ((objectFound == TBX_FALSE) || (objectId > maxObjectId))
+        {
+          idx = 0U;
+        }
+        /* Determine the conformity level from the highest object id. Individual access
+         * is always supported.
+         */
+        uint8_t conformity = 0x81U;
+        uint8_t lastObjectId = objects[context->devId.len - 1U].id;
+        if (lastObjectId > 0x7FU)
+        {
+          conformity = 0x83U;
+        }
+        else if (lastObjectId > TBX_MB_DEVID_OBJ_MAJOR_MINOR_REVISION)
+        {
+          conformity = 0x82U;
+        }
+        else
+        {
+          /* Only basic objects. */
+        }
+        /* Prepare the response header. Start without more follows. */
+        txPacket->pdu.data[0] = TBX_MB_MEI_READ_DEVICE_ID;
+        txPacket->pdu.data[1] = devIdCode;
+        txPacket->pdu.data[2] = conformity;
+        txPacket->pdu.data[3] = 0x00U;
+        txPacket->pdu.data[4] = 0x00U;
+        txPacket->pdu.data[5] = 0U;
+        txPacket->dataLen = 6U;
+        /* Add objects in the requested category, as long as they fit in the response.
+         * The objects were validated upon registration, so the first one always fits.
+         */
+        uint8_t done = TBX_FALSE;
+        while ((idx < context->devId.len) && (done == TBX_FALSE))
+        {
+          tTbxMbServerDeviceIdObject const * object = &objects[idx];
+          /* Object outside of the requested category? */
+          if (object->id > maxObjectId)
           {
-            txPacket->pdu.data[0] = TBX_MB_EC02_ILLEGAL_DATA_ADDRESS;
+            done = TBX_TRUE;
+          }
+          /* Object does not fit in this response anymore? */
+          else if ((txPacket->dataLen + 2U + object->len) > TBX_MB_TP_PDU_DATA_LEN_MAX)
+          {
+            /* Flag that more follows and where the client should continue. */
+            txPacket->pdu.data[3] = 0xFFU;
+            txPacket->pdu.data[4] = object->id;
+            done = TBX_TRUE;
           }
           else
           {
-            txPacket->pdu.data[0] = TBX_MB_EC04_SERVER_DEVICE_FAILURE;
+            /* Add the object. */
+            uint8_t * objectData = &txPacket->pdu.data[txPacket->dataLen];
+            objectData[0] = object->id;
+            objectData[1] = object->len;
+            for (uint8_t byteIdx = 0U; byteIdx < object->len; byteIdx++)
+            {
+              objectData[2U + byteIdx] = object->value[byteIdx];
+            }
+            txPacket->dataLen += 2U + object->len;
+            txPacket->pdu.data[5]++;
+            /* Individual access only returns the one object. */
+            if (devIdCode == TBX_MB_DEVID_CODE_SPECIFIC)
+            {
+              done = TBX_TRUE;
+            }
+            /* Continue with the next object. */
+            idx++;
           }
-          txPacket->dataLen = 1U;
-          /* Stop looping. */
-          break;
         }
       }
     }
   }
-} /*** end of TbxMbServerFC16WriteMultipleRegs ***/
+} /*** end of TbxMbServerFC43EncapsulatedIf ***/
+#endif
 
 
 /*********************************** end of tbxmb_server.c *****************************/
@@ -34,6 +34,15 @@
 extern "C" {
 #endif
 
+/****************************************************************************************
+* Macro definitions
+****************************************************************************************/
+/** \brief Maximum length of the value of a device identification object. It makes sure
+ *         that each object fits in a response, together with the response header.
+ */
+#define TBX_MB_SERVER_DEVID_OBJ_LEN_MAX     (TBX_MB_TP_PDU_DATA_LEN_MAX - 8U)
+
+
 /****************************************************************************************
 * Type definitions
 ****************************************************************************************/
@@ -57,6 +66,16 @@ typedef enum
 } tTbxMbServerResult;
 
 
+/** \brief Enumerated type with the data tables that a client can write to. */
+typedef enum
+{
+  /* Data table with the coils. */
+  TBX_MB_SERVER_TABLE_COILS = 0U,
+  /* Data table with the holding registers. */
+  TBX_MB_SERVER_TABLE_HOLDING_REGS
+} tTbxMbServerTable;
+
+
 /** \brief   Modbus server callback function for reading a discrete input.
  *  \details Note that the element is specified by its zero-based address in the range
  *           0 - 65535, not its element number (1 - 65536).
@@ -162,6 +181,254 @@ typedef tTbxMbServerResult (* tTbxMbServerWriteHoldingReg) (tTbxMbServer    chan
                                                             uint16_t        value);
 
 
+/** \brief   Modbus server callback function for reading a range of input registers.
+ *  \details Optional alternative to tTbxMbServerReadInputReg. When registered, the
+ *           server prefers it over the per-register callback, such that a request
+ *           for multiple input registers results in just one callback call. Write the
+ *           values of the input registers in your CPUs native endianess. The
+ *           MicroTBX-Modbus stack will automatically convert them to the big endianess
+ *           that the Modbus protocol requires.
+ *           Note that the elements are specified by their zero-based address in the
+ *           range 0 - 65535, not their element number (1 - 65536).
+ *  \param   channel Handle to the Modbus server channel object that triggered the 
+ *           callback.
+ *  \param   addr Address of the first element (0..65535).
+ *  \param   num Number of elements to read.
+ *  \param   values Array to write the values of the input registers to.
+ *  \return  TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if one
+ *           or more of the data element addresses are not supported by this server, 
+ *           TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+ */
+typedef tTbxMbServerResult (* tTbxMbServerReadInputRegs)   (tTbxMbServer     channel, 
+                                                            uint16_t         addr, 
+                                                            uint8_t          num,
+                                                            uint16_t       * values);
+
+
+/** \brief   Modbus server callback function for reading a range of holding registers.
+ *  \details Optional alternative to tTbxMbServerReadHoldingReg. When registered, the
+ *           server prefers it over the per-register callback, such that a request
+ *           for multiple holding registers results in just one callback call. Write the
+ *           values of the holding registers in your CPUs native endianess. The
+ *           MicroTBX-Modbus stack will automatically convert them to the big endianess
+ *           that the Modbus protocol requires.
+ *           Note that the elements are specified by their zero-based address in the
+ *           range 0 - 65535, not their element number (1 - 65536).
+ *  \param   channel Handle to the Modbus server channel object that triggered the 
+ *           callback.
+ *  \param   addr Address of the first element (0..65535).
+ *  \param   num Number of elements to read.
+ *  \param   values Array to write the values of the holding registers to.
+ *  \return  TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if one
+ *           or more of the data element addresses are not supported by this server, 
+ *           TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+ */
+typedef tTbxMbServerResult (* tTbxMbServerReadHoldingRegs) (tTbxMbServer     channel, 
+                                                            uint16_t         addr, 
+                                                            uint8_t          num,
+                                                            uint16_t       * values);
+
+
+/** \brief   Modbus server callback function for writing a range of holding registers.
+ *  \details Optional alternative to tTbxMbServerWriteHoldingReg. When registered, the
+ *           server prefers it over the per-register callback, such that a request
+ *           for multiple holding registers results in just one callback call.
+ *           Note that the elements are specified by their zero-based address in the
+ *           range 0 - 65535, not their element number (1 - 65536).
+ *           The values of the holding registers are already in your CPUs native
+ *           endianess.
+ *  \param   channel Handle to the Modbus server channel object that triggered the 
+ *           callback.
+ *  \param   addr Address of the first element (0..65535).
+ *  \param   num Number of elements to write.
+ *  \param   values Array with the values of the holding registers.
+ *  \return  TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if one
+ *           or more of the data element addresses are not supported by this server, 
+ *           TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+ */
+typedef tTbxMbServerResult (* tTbxMbServerWriteHoldingRegs)(tTbxMbServer     channel, 
+                                                            uint16_t         addr, 
+                                                            uint8_t          num,
+                                                            uint16_t const * values);
+
+
+/** \brief   Modbus server callback function for reading a range of discrete inputs.
+ *  \details Optional alternative to tTbxMbServerReadInput. When registered, the server
+ *           prefers it over the per-input callback, such that a request for multiple
+ *           discrete inputs results in just one callback call. The input states are
+ *           packed eight to a byte, in the same way as the Modbus protocol stores them:
+ *           bit 0 of bits[0] holds the input at address addr, bit 1 of bits[0] the
+ *           one at address addr + 1, and so on. The array directly points into the
+ *           response packet. To copy from an application bit array that does not start
+ *           at a byte boundary, TbxMbCommonCopyBits() is available.
+ *           Note that the elements are specified by their zero-based address in the
+ *           range 0 - 65535, not their element number (1 - 65536).
+ *  \param   channel Handle to the Modbus server channel object that triggered the
+ *           callback.
+ *  \param   addr Address of the first element (0..65535).
+ *  \param   num Number of elements to read (1..2000).
+ *  \param   bits Packed bit array to write the states of the discrete inputs to.
+ *  \return  TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if one
+ *           or more of the data element addresses are not supported by this server,
+ *           TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+ */
+typedef tTbxMbServerResult (* tTbxMbServerReadInputs)      (tTbxMbServer     channel,
+                                                            uint16_t         addr,
+                                                            uint16_t         num,
+                                                            uint8_t        * bits);
+
+
+/** \brief   Modbus server callback function for reading a range of coils.
+ *  \details Optional alternative to tTbxMbServerReadCoil. When registered, the server
+ *           prefers it over the per-coil callback, such that a request for multiple
+ *           coils results in just one callback call. The coil states are packed eight
+ *           to a byte, in the same way as the Modbus protocol stores them: bit 0 of
+ *           bits[0] holds the coil at address addr, bit 1 of bits[0] the one at
+ *           address addr + 1, and so on. The array directly points into the response
+ *           packet.
+ *           Note that the elements are specified by their zero-based address in the
+ *           range 0 - 65535, not their element number (1 - 65536).
+ *  \param   channel Handle to the Modbus server channel object that triggered the
+ *           callback.
+ *  \param   addr Address of the first element (0..65535).
+ *  \param   num Number of elements to read (1..2000).
+ *  \param   bits Packed bit array to write the states of the coils to.
+ *  \return  TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if one
+ *           or more of the data element addresses are not supported by this server,
+ *           TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+ */
+typedef tTbxMbServerResult (* tTbxMbServerReadCoils)       (tTbxMbServer     channel,
+                                                            uint16_t         addr,
+                                                            uint16_t         num,
+                                                            uint8_t        * bits);
+
+
+/** \brief   Modbus server callback function for writing a range of coils.
+ *  \details Optional alternative to tTbxMbServerWriteCoil. When registered, the server
+ *           prefers it over the per-coil callback, such that a request for one or more
+ *           coils results in just one callback call. The coil states are packed eight
+ *           to a byte, in the same way as the Modbus protocol stores them: bit 0 of
+ *           bits[0] holds the coil at address addr, bit 1 of bits[0] the one at
+ *           address addr + 1, and so on. The array directly points into the request
+ *           packet. Unused bits in the last byte are don't care.
+ *           Note that the elements are specified by their zero-based address in the
+ *           range 0 - 65535, not their element number (1 - 65536).
+ *  \param   channel Handle to the Modbus server channel object that triggered the
+ *           callback.
+ *  \param   addr Address of the first element (0..65535).
+ *  \param   num Number of elements to write (1..1968).
+ *  \param   bits Packed bit array with the states of the coils.
+ *  \return  TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if one
+ *           or more of the data element addresses are not supported by this server,
+ *           TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+ */
+typedef tTbxMbServerResult (* tTbxMbServerWriteCoils)      (tTbxMbServer     channel,
+                                                            uint16_t         addr,
+                                                            uint16_t         num,
+                                                            uint8_t  const * bits);
+
+
+/** \brief   Modbus server callback function for reading a range of registers from a
+ *           file record, with function code 20 - Read File Record.
+ *  \details A file is a collection of records, each being a 16-bit register. The
+ *           values of the registers should be stored in your CPUs native endianess.
+ *           The server calls this function once for each sub-request in a received
+ *           read file record request.
+ *  \param   channel Handle to the Modbus server channel object that triggered the
+ *           callback.
+ *  \param   file Number of the file (1..65535).
+ *  \param   record Number of the first record in the file (0..9999).
+ *  \param   num Number of records to read.
+ *  \param   values Array where to store the values of the records.
+ *  \return  TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if the
+ *           file or one or more of its records are not supported by this server,
+ *           TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+ */
+typedef tTbxMbServerResult (* tTbxMbServerReadFileRecord) (tTbxMbServer     channel,
+                                                            uint16_t         file,
+                                                            uint16_t         record,
+                                                            uint8_t          num,
+                                                            uint16_t       * values);
+
+
+/** \brief   Modbus server callback function for writing a range of registers to a
+ *           file record, with function code 21 - Write File Record.
+ *  \details A file is a collection of records, each being a 16-bit register. The
+ *           values of the registers are already in your CPUs native endianess. The
+ *           server calls this function once for each sub-request in a received write
+ *           file record request.
+ *  \param   channel Handle to the Modbus server channel object that triggered the
+ *           callback.
+ *  \param   file Number of the file (1..65535).
+ *  \param   record Number of the first record in the file (0..9999).
+ *  \param   num Number of records to write.
+ *  \param   values Array with the values of the records.
+ *  \return  TBX_MB_SERVER_OK if successful, TBX_MB_SERVER_ERR_ILLEGAL_DATA_ADDR if the
+ *           file or one or more of its records are not supported by this server,
+ *           TBX_MB_SERVER_ERR_DEVICE_FAILURE otherwise.
+ */
+typedef tTbxMbServerResult (* tTbxMbServerWriteFileRecord)(tTbxMbServer     channel,
+                                                            uint16_t         file,
+                                                            uint16_t         record,
+                                                            uint8_t          num,
+                                                            uint16_t const * values);
+
+
+/** \brief   Modbus server callback function for getting notified about a client that
+ *           wrote to one of the registered data tables.
+ *  \details The server calls this function after it stored the new values in the data
+ *           table. Typical usage is to trigger the application to act upon the new
+ *           values, for example to update an output.
+ *           Note that the elements are specified by their zero-based address in the
+ *           range 0 - 65535, not their element number (1 - 65536).
+ *  \param   channel Handle to the Modbus server channel object that triggered the
+ *           callback.
+ *  \param   table The data table that was written to.
+ *  \param   addr Address of the first element that was written (0..65535).
+ *  \param   num Number of elements that were written.
+ */
+typedef void               (* tTbxMbServerTableWritten)    (tTbxMbServer      channel,
+                                                            tTbxMbServerTable table,
+                                                            uint16_t          addr,
+                                                            uint16_t          num);
+
+
+/** \brief   Entry of a register map. It describes a run of consecutive registers, that
+ *           either map onto an array owned by the application or onto handler
+ *           functions. A register map is an array of these entries, sorted on their
+ *           address in ascending order and without overlapping runs.
+ *  \details When regs is not NULL, the server reads and writes the register values
+ *           directly from and to this array, in your CPUs native endianess. Otherwise
+ *           it calls readFcn and writeFcn for the part of the run that a request
+ *           accesses. Set writeFcn to NULL for read-only runs. Note that the server
+ *           never writes to the runs of an input register map.
+ */
+typedef struct
+{
+  uint16_t                     addr;     /**< Address of the first register.   */
+  uint16_t                     num;      /**< Number of registers in the run.  */
+  uint16_t                   * regs;     /**< Register storage or NULL.        */
+  tTbxMbServerReadHoldingRegs  readFcn;  /**< Read handler, if regs is NULL.   */
+  tTbxMbServerWriteHoldingRegs writeFcn; /**< Write handler, if regs is NULL.  */
+} tTbxMbServerRegMapEntry;
+
+
+/** \brief   Object of the device identification, which a client reads with function
+ *           code 43 / MEI type 14 - Read Device Identification. The device
+ *           identification is an array of these objects, sorted on their id in ascending
+ *           order. The object ids TBX_MB_DEVID_OBJ_xxx are defined by the Modbus
+ *           protocol. Ids 0x80..0xFF are available for extended, device specific
+ *           objects.
+ *  \details The value is typically an ASCII string without zero terminator. Its length
+ *           can be up to TBX_MB_SERVER_DEVID_OBJ_LEN_MAX bytes.
+ */
+typedef struct
+{
+  uint8_t         id;                /**< Object id.                               */
+  uint8_t         len;               /**< Length of the object value in bytes.     */
+  uint8_t const * value;             /**< Object value.                            */
+} tTbxMbServerDeviceIdObject;
+
 /** \brief   Modbus server callback function for implementing custom function code
  *           handling. Thanks to this functionality, the user can support Modbus function
  *           codes that are either currently not supported or user defined extensions.
@@ -212,6 +479,83 @@ void         TbxMbServerSetCallbackWriteHoldingReg(tTbxMbServer                c
 void         TbxMbServerSetCallbackCustomFunction (tTbxMbServer                channel,
                                                    tTbxMbServerCustomFunction  callback);
 
+void         TbxMbServerSetFunctionHandler        (tTbxMbServer                channel,
+                                                   uint8_t                     code,
+                                                   tTbxMbServerCustomFunction  handler);
+
+/* Optional register range callbacks. */
+void TbxMbServerSetCallbackReadInputRegs   (tTbxMbServer                 channel,
+                                            tTbxMbServerReadInputRegs    callback);
+
+void TbxMbServerSetCallbackReadHoldingRegs (tTbxMbServer                 channel,
+                                            tTbxMbServerReadHoldingRegs  callback);
+
+void TbxMbServerSetCallbackWriteHoldingRegs(tTbxMbServer                 channel,
+                                            tTbxMbServerWriteHoldingRegs callback);
+
+void TbxMbServerSetCallbackReadInputs      (tTbxMbServer                 channel,
+                                            tTbxMbServerReadInputs       callback);
+
+void TbxMbServerSetCallbackReadCoils       (tTbxMbServer                 channel,
+                                            tTbxMbServerReadCoils        callback);
+
+void TbxMbServerSetCallbackWriteCoils      (tTbxMbServer                 channel,
+                                            tTbxMbServerWriteCoils       callback);
+
+/* Optional data tables. */
+void TbxMbServerSetTableInputs             (tTbxMbServer                 channel,
+                                            uint16_t                     addr,
+                                            uint16_t                     num,
+                                            uint8_t              const * bits);
+
+void TbxMbServerSetTableCoils              (tTbxMbServer                 channel,
+                                            uint16_t                     addr,
+                                            uint16_t                     num,
+                                            uint8_t                    * bits);
+
+void TbxMbServerSetTableInputRegs          (tTbxMbServer                 channel,
+                                            uint16_t                     addr,
+                                            uint16_t                     num,
+                                            uint16_t             const * regs);
+
+void TbxMbServerSetTableHoldingRegs        (tTbxMbServer                 channel,
+                                            uint16_t                     addr,
+                                            uint16_t                     num,
+                                            uint16_t                   * regs);
+
+void TbxMbServerSetCallbackTableWritten    (tTbxMbServer                 channel,
+                                            tTbxMbServerTableWritten     callback);
+
+/* Optional register maps. */
+void TbxMbServerSetMapInputRegs            (tTbxMbServer                    channel,
+                                            tTbxMbServerRegMapEntry const * map,
+                                            uint16_t                        len);
+
+void TbxMbServerSetMapHoldingRegs          (tTbxMbServer                    channel,
+                                            tTbxMbServerRegMapEntry const * map,
+                                            uint16_t                        len);
+
+/* Optional file record access. */
+void TbxMbServerSetCallbackReadFileRecord  (tTbxMbServer                 channel,
+                                            tTbxMbServerReadFileRecord   callback);
+
+void TbxMbServerSetCallbackWriteFileRecord (tTbxMbServer                 channel,
+                                            tTbxMbServerWriteFileRecord  callback);
+
+/* Optional FIFO queue. */
+void    TbxMbServerSetFifo                 (tTbxMbServer                 channel,
+                                            uint16_t                     addr,
+                                            uint16_t                   * buffer,
+                                            uint16_t                     size);
+
+uint8_t TbxMbServerFifoPush                (tTbxMbServer                 channel,
+                                            uint16_t                     value);
+
+/* Optional device identification. */
+void TbxMbServerSetDeviceIdObjects         (tTbxMbServer                       channel,
+                                            tTbxMbServerDeviceIdObject const * objects,
+                                            uint16_t                           len);
+
 
 #ifdef __cplusplus
 }
@@ -38,13 +38,59 @@ extern "C" {
 * Type definitions
 ****************************************************************************************/
 /** \brief Modbus server channel interface function to detect events in a polling
- *         manner.
+ *         manner. It returns the free running timer tick count at which it wants to be
+ *         called again.
  */
-typedef void (* tTbxMbServerPoll)   (void        * context);
+typedef uint16_t (* tTbxMbServerPoll)   (void        * context);
 
 
 /** \brief Modbus server channel  interface function for processing events. */
-typedef void (* tTbxMbServerProcess)(tTbxMbEvent * event);
+typedef void     (* tTbxMbServerProcess)(tTbxMbEvent * event);
+
+
+/** \brief Data table that maps a range of data element addresses directly onto an
+ *         array owned by the application. For the read-only data types, the wrData
+ *         element is NULL.
+ */
+typedef struct
+{
+  void                 const * rdData;              /**< Array for reading elements.   */
+  void                       * wrData;              /**< Array for writing elements.   */
+  uint16_t                      addr;               /**< Address of the first element. */
+  uint16_t                      num;                /**< Number of elements.           */
+} tTbxMbServerTableCtx;
+
+
+/** \brief Register map, registered by the application. */
+typedef struct
+{
+  tTbxMbServerRegMapEntry const * entries;          /**< Sorted array of map entries.  */
+  uint16_t                        len;              /**< Number of map entries.        */
+} tTbxMbServerMapCtx;
+
+
+/** \brief Device identification objects, registered by the application. */
+typedef struct
+{
+  tTbxMbServerDeviceIdObject const * objects;       /**< Sorted array of objects.      */
+  uint16_t                           len;           /**< Number of objects.            */
+} tTbxMbServerDevIdCtx;
+
+
+/** \brief FIFO queue, registered by the application. It's a lock-free single producer,
+ *         single consumer ring buffer. The application is the producer and only changes
+ *         the head. The server is the consumer and only changes the tail. One element
+ *         of the buffer always stays empty, to tell a full queue apart from an empty
+ *         one.
+ */
+typedef struct
+{
+  uint16_t           volatile * buffer;             /**< Storage of the queue values.  */
+  uint16_t                      size;               /**< Number of elements in buffer. */
+  uint16_t                      addr;               /**< FIFO pointer address.         */
+  uint16_t           volatile   head;               /**< Index to write the next value.*/
+  uint16_t           volatile   tail;               /**< Index to read the next value. */
+} tTbxMbServerFifoCtx;
 
 
 /** \brief Modbus server channel layer context that groups all channel specific data. 
@@ -52,13 +98,15 @@ typedef void (* tTbxMbServerProcess)(tTbxMbEvent * event);
  */
 typedef struct
 {
-  /* Event interface methods. The following three entries must always be at the start
+  /* Event interface methods. The following five entries must always be at the start
    * and exactly match those in tTbxMbEventCtx. Think of it as the base that this struct
    * derives from. 
    */
   void                       * instancePtr;         /**< Reserved for C++ wrapper.     */
   tTbxMbServerPoll              pollFcn;            /**< Event poll function.          */
   tTbxMbServerProcess           processFcn;         /**< Event process function.       */
+  tTbxMbTimer                   pollTimer;          /**< Event poll function timer.    */
+  tTbxMbEventLoop               eventLoop;          /**< Event loop it is bound to.    */
   /* Private members. */
   uint8_t                       type;               /**< Context type.                 */
   tTbxMbTpCtx                 * tpCtx;              /**< Assigned transport layer ctx. */
@@ -69,6 +117,25 @@ typedef struct
   tTbxMbServerReadHoldingReg    readHoldingRegFcn;  /**< Read holding register cb.     */
   tTbxMbServerWriteHoldingReg   writeHoldingRegFcn; /**< Write holding register cb.    */
   tTbxMbServerCustomFunction    customFunctionFcn;  /**< Custom function code callback.*/  
+  tTbxMbServerReadInputRegs     readInputRegsFcn;   /**< Read input registers cb.      */
+  tTbxMbServerReadHoldingRegs   readHoldingRegsFcn; /**< Read holding registers cb.    */
+  tTbxMbServerWriteHoldingRegs  writeHoldingRegsFcn;/**< Write holding registers cb.   */
+  tTbxMbServerReadInputs        readInputsFcn;      /**< Read discrete inputs cb.      */
+  tTbxMbServerReadCoils         readCoilsFcn;       /**< Read coils callback.          */
+  tTbxMbServerWriteCoils        writeCoilsFcn;      /**< Write coils callback.         */
+  uint16_t                    * regBuf;             /**< Buffer for register ranges.   */
+  tTbxMbServerTableCtx          inputTbl;           /**< Discrete inputs data table.   */
+  tTbxMbServerTableCtx          coilTbl;            /**< Coils data table.             */
+  tTbxMbServerTableCtx          inputRegTbl;        /**< Input registers data table.   */
+  tTbxMbServerTableCtx          holdingRegTbl;      /**< Holding registers data table. */
+  tTbxMbServerTableWritten      tableWrittenFcn;    /**< Data table written callback.  */
+  tTbxMbServerMapCtx            inputRegMap;        /**< Input registers map.          */
+  tTbxMbServerMapCtx            holdingRegMap;      /**< Holding registers map.        */
+  tTbxMbServerCustomFunction  * fcTable;            /**< Function code handler table.  */
+  tTbxMbServerDevIdCtx          devId;              /**< Device identification objects.*/
+  tTbxMbServerReadFileRecord    readFileRecordFcn;  /**< Read file record callback.    */
+  tTbxMbServerWriteFileRecord   writeFileRecordFcn; /**< Write file record callback.   */
+  tTbxMbServerFifoCtx           fifo;               /**< FIFO queue.                   */
 } tTbxMbServerCtx;
 
 
@@ -0,0 +1,2155 @@
+/************************************************************************************//**
+* \file         tbxmb_tcp.c
+* \brief        Modbus TCP transport layer source file.
+* \internal
+*----------------------------------------------------------------------------------------
+*                          C O P Y R I G H T
+*----------------------------------------------------------------------------------------
+*   Copyright (c) 2023 by Feaser     www.feaser.com     All rights reserved
+*
+*----------------------------------------------------------------------------------------
+*                            L I C E N S E
+*----------------------------------------------------------------------------------------
+*
+* SPDX-License-Identifier: GPL-3.0-or-later
+*
+* This file is part of MicroTBX-Modbus. MicroTBX-Modbus is free software: you can
+* redistribute it and/or modify it under the terms of the GNU General Public License as
+* published by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* MicroTBX-Modbus is distributed in the hope that it will be useful, but WITHOUT ANY
+* WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+* PARTICULAR PURPOSE. See the GNU General Public License for more details.
+*
+* You have received a copy of the GNU General Public License along with MicroTBX-Modbus.
+* If not, see www.gnu.org/licenses/.
+*
+* \endinternal
+****************************************************************************************/
+
+/****************************************************************************************
+* Include files
+****************************************************************************************/
+#include "microtbx.h"                            /* MicroTBX module                    */
+#include "microtbxmodbus.h"                      /* MicroTBX-Modbus module             */
+#include "tbxmb_event_private.h"                 /* MicroTBX-Modbus event private      */
+#include "tbxmb_osal_private.h"                  /* MicroTBX-Modbus OSAL private       */
+#include "tbxmb_timer_private.h"                 /* MicroTBX-Modbus timer private      */
+#include "tbxmb_tp_private.h"                    /* MicroTBX-Modbus TP private         */
+#include <errno.h>                               /* Error numbers                      */
+#include <fcntl.h>                               /* File control options               */
+#include <poll.h>                                /* Wait for events on descriptors     */
+#include <unistd.h>                              /* POSIX standard definitions         */
+#include <arpa/inet.h>                           /* Internet address conversions       */
+#include <netinet/in.h>                          /* Internet address family            */
+#include <netinet/tcp.h>                         /* TCP protocol definitions           */
+#include <pthread.h>                             /* POSIX threads                      */
+#include <sys/epoll.h>                           /* I/O event notification facility    */
+#include <sys/eventfd.h>                         /* Event notification file descriptor */
+#include <sys/socket.h>                          /* BSD sockets                        */
+
+
+/****************************************************************************************
+* Macro definitions
+****************************************************************************************/
+#ifndef TBX_MB_TCP_TIMEOUT_MS
+/** \brief Maximum time in milliseconds that a client waits for the connection with a
+ *         server to be established and that a client or server waits for a packet to
+ *         be handed over to the TCP/IP stack. The default configuration works fine for
+ *         pretty much all networks. If for some reason a different timeout is desired,
+ *         you can override this configuration by adding a macro with the same name, but
+ *         a different value, to "tbx_conf.h".
+ */
+#define TBX_MB_TCP_TIMEOUT_MS               (1000U)
+#endif
+
+#ifndef TBX_MB_TCP_SERVER_MAX_CONNS
+/** \brief Maximum number of clients that can be connected at the same time to a TCP
+ *         transport layer that operates as a server. Connection requests beyond this
+ *         limit are accepted and then closed right away. An idle connection only takes
+ *         up a few bytes of RAM. A packet buffer is borrowed from a memory pool only
+ *         while a request is in flight. If your server needs to handle more concurrent
+ *         connections, you can override this configuration by adding a macro with the
+ *         same name, but a different value, to "tbx_conf.h".
+ */
+#define TBX_MB_TCP_SERVER_MAX_CONNS         (64U)
+#endif
+
+/** \brief Unique context type to identify a context as being a TCP transport layer. */
+#define TBX_MB_TCP_CONTEXT_TYPE             (62U)
+
+/** \brief Idle state. Ready to receive or transmit. */
+#define TBX_MB_TCP_STATE_IDLE               (0U)
+
+/** \brief Validating a newly received PDU state. */
+#define TBX_MB_TCP_STATE_VALIDATION         (1U)
+
+/** \brief Length of the MBAP header, which includes the unit identifier. */
+#define TBX_MB_TCP_MBAP_LEN                 (7U)
+
+/** \brief Value of the protocol identifier field in the MBAP header for Modbus. */
+#define TBX_MB_TCP_PROTOCOL_ID              (0U)
+
+/** \brief Value of an invalid socket or file descriptor. */
+#define TBX_MB_TCP_INVALID_SOCKET           (-1)
+
+/** \brief Maximum number of I/O events that the server reads from its epoll instance
+ *         during one poll.
+ */
+#define TBX_MB_TCP_SERVER_EVENTS_MAX        (16U)
+
+/** \brief Time in milliseconds after which a server makes a new attempt to start
+ *         listening for connection requests, if the previous attempt failed. For
+ *         example because another process still used the port.
+ */
+#define TBX_MB_TCP_LISTEN_RETRY_MS          (100U)
+
+/** \brief Flags for the send() function call. Suppress the SIGPIPE signal on platforms
+ *         that support it, to prevent a closed connection from terminating the process.
+ */
+#ifdef MSG_NOSIGNAL
+#define TBX_MB_TCP_SEND_FLAGS               (MSG_NOSIGNAL)
+#else
+#define TBX_MB_TCP_SEND_FLAGS               (0)
+#endif
+
+
+/****************************************************************************************
+* Type definitions
+****************************************************************************************/
+/** \brief Connection with a client, as managed by a TCP transport layer that operates as
+ *         a server. An idle connection only holds its socket and the MBAP header of the
+ *         request that is being received. Once the MBAP header is complete, a packet
+ *         buffer is borrowed from a memory pool to receive the PDU into. It's given back
+ *         after the response was transmitted.
+ */
+typedef struct
+{
+  int32_t          socket;                       /**< Connection socket.               */
+  uint8_t          head[TBX_MB_TCP_MBAP_LEN];    /**< MBAP header reception buffer.    */
+  uint16_t         rxAduWrIdx;                   /**< ADU Rx packet write index.       */
+  tTbxMbTpPacket * rxPacket;                     /**< Borrowed reception packet.       */
+  uint8_t          busy;                         /**< Request queued or in processing. */
+  uint8_t          closed;                       /**< Closed while busy.               */
+} tTbxMbTcpConn;
+
+
+/** \brief Reactor thread of a TCP transport layer that owns its connection. The thread
+ *         sleeps until one of the sockets, registered with the epoll instance of the
+ *         transport layer, has an I/O event. It then posts an event to have the event
+ *         task call the poll function. Afterwards, it sleeps until the poll function is
+ *         done with the sockets, signaled via the wake-up event file descriptor. This
+ *         way the event task only calls the poll function, when there is actually
+ *         something to do.
+ */
+typedef struct
+{
+  pthread_t        thread;                       /**< Handle of the reactor thread.    */
+  int32_t          wakeFd;                       /**< Wake-up event file descriptor.   */
+  uint8_t          stop;                         /**< Request to stop the thread.      */
+} tTbxMbTcpReactor;
+
+
+/****************************************************************************************
+* Function prototypes
+****************************************************************************************/
+static uint16_t         TbxMbTcpPoll            (tTbxMbTp               transport);
+
+static uint8_t          TbxMbTcpTransmit        (tTbxMbTp               transport);
+
+static void             TbxMbTcpReceptionDone   (tTbxMbTp               transport);
+
+static tTbxMbTpPacket * TbxMbTcpGetRxPacket     (tTbxMbTp               transport);
+
+static tTbxMbTpPacket * TbxMbTcpGetTxPacket     (tTbxMbTp               transport);
+
+static tTbxMbTpCtx    * TbxMbTcpCtxCreate       (uint32_t               ipAddr,
+                                                 uint16_t               port,
+                                                 tTbxMbTpCtx          * primaryCtx);
+
+static void             TbxMbTcpReceive         (tTbxMbTpCtx          * tpCtx);
+
+static tTbxMbTpCtx    * TbxMbTcpMatchResponse   (tTbxMbTpCtx          * tpCtx,
+                                                 uint16_t               transId);
+
+static uint8_t          TbxMbTcpConnect         (tTbxMbTpCtx          * tpCtx);
+
+static void             TbxMbTcpDisconnect      (tTbxMbTpCtx          * tpCtx);
+
+static void             TbxMbTcpServerPoll      (tTbxMbTpCtx          * tpCtx);
+
+static void             TbxMbTcpServerListen    (tTbxMbTpCtx          * tpCtx);
+
+static void             TbxMbTcpServerAccept    (tTbxMbTpCtx          * tpCtx);
+
+static void             TbxMbTcpServerReceive   (tTbxMbTpCtx          * tpCtx,
+                                                 tTbxMbTcpConn        * conn);
+
+static void             TbxMbTcpServerDispatch  (tTbxMbTpCtx          * tpCtx);
+
+static void             TbxMbTcpServerClose     (tTbxMbTpCtx          * tpCtx,
+                                                 tTbxMbTcpConn        * conn);
+
+static uint8_t          TbxMbTcpSend            (int32_t                socketFd,
+                                                 uint8_t        const * data,
+                                                 uint16_t               len);
+
+static void             TbxMbTcpConfigureSocket (int32_t                socketFd);
+
+static uint8_t          TbxMbTcpReactorStart    (tTbxMbTpCtx          * tpCtx);
+
+static void             TbxMbTcpReactorStop     (tTbxMbTpCtx          * tpCtx);
+
+static void             TbxMbTcpReactorRearm    (tTbxMbTpCtx          * tpCtx);
+
+static void           * TbxMbTcpReactorThread   (void                 * arg);
+
+
+/************************************************************************************//**
+** \brief     Creates a Modbus TCP transport layer object. Whether it operates as a TCP
+**            server or as a TCP client, is determined by the type of channel that it is
+**            linked to:
+**            - When linked to a Modbus server channel, it listens for incoming
+**              connections on the specified local IP address and port. It serves
+**              multiple connected clients at the same time, with a maximum of
+**              TBX_MB_TCP_SERVER_MAX_CONNS.
+**            - When linked to a Modbus client channel, it connects to the Modbus server
+**              at the specified IP address and port, once the first request is sent.
+**              Use TbxMbTcpCreateShared() to create additional transport layer objects
+**              for more client channels that send their requests over the same
+**              connection.
+** \param     ipAddress IPv4 address in dotted decimal notation (e.g. "192.168.1.10").
+**            For a server this is the local address to listen on. Set it to NULL to
+**            listen on all local network interfaces. For a client this is the address
+**            of the server to connect to.
+** \param     port TCP port number. Typically TBX_MB_TCP_PORT_DEFAULT (502).
+** \return    Handle to the newly created TCP transport layer object if successful, NULL
+**            otherwise. Also NULL if the OSAL does not support posting events from the
+**            reactor thread, as is the case with the superloop OSAL.
+**
+****************************************************************************************/
+tTbxMbTp TbxMbTcpCreate(char     const * ipAddress,
+                        uint16_t         port)
+{
+  tTbxMbTp       result = NULL;
+  struct in_addr ipAddr = { .s_addr = htonl(INADDR_ANY) };
+  uint8_t        ipAddrOkay = TBX_TRUE;
+
+  /* Convert the IP address from text to binary form, if one was specified. */
+  if (ipAddress != NULL)
+  {
+    if (inet_pton(AF_INET, ipAddress, &ipAddr) != 1)
+    {
+      ipAddrOkay = TBX_FALSE;
+    }
+  }
+
+  /* Verify parameters. */
+  TBX_ASSERT((ipAddrOkay == TBX_TRUE) && (port > 0U));
+  /* The reactor thread posts events to the event task. This requires an OSAL with
+   * thread-safe event posting, such as the POSIX one. The superloop OSAL for example
+   * does not qualify.
+   */
+  TBX_ASSERT(TbxMbOsalEventPostIsThreadSafe() == TBX_TRUE);
+
+  /* Only continue with valid parameters and a suitable OSAL. */
+  if ((ipAddrOkay == TBX_TRUE) && (port > 0U) &&
+      (TbxMbOsalEventPostIsThreadSafe() == TBX_TRUE))
+  {
+    /* Create the transport context. It owns the connection. */
+    tTbxMbTpCtx * newTpCtx = TbxMbTcpCtxCreate(ipAddr.s_addr, port, NULL);
+    /* Only continue if the transport context was created. */
+    if (newTpCtx != NULL)
+    {
+      /* Instruct the event task to call our polling function. It continues to do so
+       * until a channel is linked. From then on, the reactor thread has the event task
+       * call it, each time new connections or newly received data are pending.
+       */
+      TbxMbEventStartPolling(newTpCtx);
+      /* Update the result. */
+      result = newTpCtx;
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbTcpCreate ***/
+
+
+/************************************************************************************//**
+** \brief     Creates a Modbus TCP transport layer object that shares the connection of
+**            an existing TCP transport layer object, created with TbxMbTcpCreate(). Only
+**            meant for linking to a Modbus client channel.
+** \details   A Modbus client channel has at most one request outstanding. To keep
+**            multiple requests in flight on one TCP connection, create one client
+**            channel for each task that sends requests and link each one to its own
+**            TCP transport layer object that shares the same connection. Each request
+**            gets a unique MBAP transaction identifier. A response is matched to its
+**            request via this transaction identifier, so responses can complete in any
+**            order.
+** \param     transport Handle to the TCP transport layer object that owns the
+**            connection.
+** \return    Handle to the newly created TCP transport layer object if successful, NULL
+**            otherwise.
+**
+****************************************************************************************/
+tTbxMbTp TbxMbTcpCreateShared(tTbxMbTp transport)
+{
+  tTbxMbTp result = NULL;
+
+  /* Verify parameters. */
+  TBX_ASSERT(transport != NULL);
+
+  /* Only continue with valid parameters. */
+  if (transport != NULL)
+  {
+    /* Convert the TP channel pointer to the context structure. */
+    tTbxMbTpCtx * primaryCtx = (tTbxMbTpCtx *)transport;
+    /* Sanity check on the context type and that it actually owns the connection. */
+    TBX_ASSERT((primaryCtx->type == TBX_MB_TCP_CONTEXT_TYPE) &&
+               (primaryCtx->tcpPrimary == primaryCtx));
+    /* Only continue with a transport context that owns the connection. */
+    if ((primaryCtx->type == TBX_MB_TCP_CONTEXT_TYPE) &&
+        (primaryCtx->tcpPrimary == primaryCtx))
+    {
+      /* Create the transport context. Note that it does not need to be polled. The
+       * transport context that owns the connection takes care of the reception.
+       */
+      result = TbxMbTcpCtxCreate(primaryCtx->tcpIpAddr, primaryCtx->tcpPort,
+                                 primaryCtx);
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbTcpCreateShared ***/
+
+
+/************************************************************************************//**
+** \brief     Releases a Modbus TCP transport layer object, previously created with
+**            TbxMbTcpCreate() or TbxMbTcpCreateShared(). Note that the transport layer
+**            objects that share its connection should be released first.
+** \param     transport Handle to TCP transport layer object to release.
+**
+****************************************************************************************/
+void TbxMbTcpFree(tTbxMbTp transport)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(transport != NULL);
+
+  /* Only continue with valid parameters. */
+  if (transport != NULL)
+  {
+    /* Convert the TP channel pointer to the context structure. */
+    tTbxMbTpCtx * tpCtx = (tTbxMbTpCtx *)transport;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(tpCtx->type == TBX_MB_TCP_CONTEXT_TYPE);
+    /* Does this transport context share the connection of another one? */
+    if (tpCtx->tcpPrimary != tpCtx)
+    {
+      /* Stop sharing the connection. */
+      tTbxMbTpCtx * primaryCtx = tpCtx->tcpPrimary;
+      TbxCriticalSectionEnter();
+      TbxListRemoveItem(primaryCtx->tcpShareList, tpCtx);
+      if (primaryCtx->tcpRxTarget == tpCtx)
+      {
+        primaryCtx->tcpRxTarget = NULL;
+      }
+      TbxCriticalSectionExit();
+    }
+    /* This transport context owns the connection. */
+    else
+    {
+      /* Sanity check that no other transport contexts still share the connection. */
+      TBX_ASSERT(TbxListGetSize(tpCtx->tcpShareList) == 1U);
+      /* Stop the reactor thread first, because it waits on the epoll instance. */
+      TbxMbTcpReactorStop(tpCtx);
+      /* Close the connection with the server, if one is established. */
+      TbxMbTcpDisconnect(tpCtx);
+      /* Close all connections with clients and give their memory back to the pools. */
+      tTbxMbTcpConn * conn = TbxListGetFirstItem(tpCtx->tcpConnList);
+      while (conn != NULL)
+      {
+        /* Obtain the next connection first, because this one is about to be released. */
+        tTbxMbTcpConn * nextConn = TbxListGetNextItem(tpCtx->tcpConnList, conn);
+        if (conn->socket != TBX_MB_TCP_INVALID_SOCKET)
+        {
+          (void)close(conn->socket);
+        }
+        if (conn->rxPacket != NULL)
+        {
+          TbxMemPoolRelease(conn->rxPacket);
+        }
+        TbxMemPoolRelease(conn);
+        conn = nextConn;
+      }
+      TbxCriticalSectionEnter();
+      /* Close the listen socket and epoll instance, if they were opened. */
+      if (tpCtx->tcpListenSocket != TBX_MB_TCP_INVALID_SOCKET)
+      {
+        (void)close(tpCtx->tcpListenSocket);
+        tpCtx->tcpListenSocket = TBX_MB_TCP_INVALID_SOCKET;
+      }
+      if (tpCtx->tcpEpollFd != TBX_MB_TCP_INVALID_SOCKET)
+      {
+        (void)close(tpCtx->tcpEpollFd);
+        tpCtx->tcpEpollFd = TBX_MB_TCP_INVALID_SOCKET;
+      }
+      /* Release the connection management lists. */
+      TbxListDelete(tpCtx->tcpConnList);
+      TbxListDelete(tpCtx->tcpReadyList);
+      TbxListDelete(tpCtx->tcpShareList);
+      tpCtx->tcpConnList = NULL;
+      tpCtx->tcpReadyList = NULL;
+      tpCtx->tcpShareList = NULL;
+      tpCtx->tcpTxConn = NULL;
+      tpCtx->tcpRxTarget = NULL;
+      TbxCriticalSectionExit();
+    }
+    /* Release the connection lock. */
+    TbxMbOsalSemFree(tpCtx->tcpConnSem);
+    /* Make sure the event task no longer calls our polling function. */
+    TbxMbEventCancelPolling(tpCtx);
+    TbxCriticalSectionEnter();
+    tpCtx->tcpConnSem = NULL;
+    tpCtx->tcpPrimary = NULL;
+    /* Invalidate the context to protect it from accidentally being used afterwards. */
+    tpCtx->type = 0U;
+    tpCtx->pollFcn = NULL;
+    tpCtx->processFcn = NULL;
+    TbxCriticalSectionExit();
+    /* Give the transport layer context back to the memory pool. */
+    TbxMemPoolRelease(tpCtx);
+  }
+} /*** end of TbxMbTcpFree ***/
+
+
+/************************************************************************************//**
+** \brief     Allocates and initializes a TCP transport layer context.
+** \param     ipAddr IPv4 address in network byte order.
+** \param     port TCP port number.
+** \param     primaryCtx Pointer to the TCP transport layer context whose connection
+**            should be shared. NULL if the new context owns its connection.
+** \return    Pointer to the newly created context if successful, NULL otherwise.
+**
+****************************************************************************************/
+static tTbxMbTpCtx * TbxMbTcpCtxCreate(uint32_t              ipAddr,
+                                       uint16_t              port,
+                                       tTbxMbTpCtx         * primaryCtx)
+{
+  tTbxMbTpCtx * result = NULL;
+  uint8_t       okay = TBX_TRUE;
+
+  /* Allocate memory for the new transport context. */
+  tTbxMbTpCtx * newTpCtx = TbxMemPoolAllocate(sizeof(tTbxMbTpCtx));
+  /* Automatically increase the memory pool, if it was too small. */
+  if (newTpCtx == NULL)
+  {
+    /* No need to check the return value, because if it failed, the following
+     * allocation fails too, which is verified later on.
+     */
+    (void)TbxMemPoolCreate(1U, sizeof(tTbxMbTpCtx));
+    newTpCtx = TbxMemPoolAllocate(sizeof(tTbxMbTpCtx));
+  }
+  /* Verify memory allocation of the transport context. */
+  TBX_ASSERT(newTpCtx != NULL);
+  /* Only continue if the memory allocation succeeded. */
+  if (newTpCtx != NULL)
+  {
+    /* Initialize the transport context. Note that the UART port and the RTU specific
+     * character timings are not used by this transport layer.
+     */
+    newTpCtx->type = TBX_MB_TCP_CONTEXT_TYPE;
+    newTpCtx->instancePtr = NULL;
+    newTpCtx->pollFcn = TbxMbTcpPoll;
+    newTpCtx->processFcn = NULL;
+    TbxMbTimerInit(&newTpCtx->pollTimer, newTpCtx);
+    newTpCtx->eventLoop = TbxMbEventLoopDefault();
+    newTpCtx->transmitFcn = TbxMbTcpTransmit;
+    newTpCtx->receptionDoneFcn = TbxMbTcpReceptionDone;
+    newTpCtx->getRxPacketFcn = TbxMbTcpGetRxPacket;
+    newTpCtx->getTxPacketFcn = TbxMbTcpGetTxPacket;
+    newTpCtx->channelCtx = NULL;
+    newTpCtx->nodeAddr = TBX_MB_TP_NODE_ADDR_BROADCAST;
+    newTpCtx->state = TBX_MB_TCP_STATE_IDLE;
+    newTpCtx->rxAduWrIdx = 0U;
+    newTpCtx->initStateExitSem = NULL;
+    newTpCtx->tcpListenSocket = TBX_MB_TCP_INVALID_SOCKET;
+    newTpCtx->tcpSocket = TBX_MB_TCP_INVALID_SOCKET;
+    newTpCtx->tcpEpollFd = TBX_MB_TCP_INVALID_SOCKET;
+    newTpCtx->tcpReactor = NULL;
+    newTpCtx->tcpConnList = NULL;
+    newTpCtx->tcpReadyList = NULL;
+    newTpCtx->tcpTxConn = NULL;
+    newTpCtx->tcpIpAddr = ipAddr;
+    newTpCtx->tcpPort = port;
+    newTpCtx->tcpTransId = 0U;
+    newTpCtx->tcpRespPending = TBX_FALSE;
+    newTpCtx->tcpPrimary = (primaryCtx != NULL) ? primaryCtx : newTpCtx;
+    newTpCtx->tcpShareList = NULL;
+    newTpCtx->tcpNextTransId = 0U;
+    newTpCtx->tcpRxTarget = NULL;
+    newTpCtx->diagInfo.busMsgCnt = 0U;
+    newTpCtx->diagInfo.busCommErrCnt = 0U;
+    newTpCtx->diagInfo.busExcpErrCnt = 0U;
+    newTpCtx->diagInfo.srvMsgCnt = 0U;
+    newTpCtx->diagInfo.srvNoRespCnt = 0U;
+    /* Create the connection lock. It's only used by the context that owns the
+     * connection. The tasks of the client channels that share the connection take it
+     * to transmit a request, which includes connecting and disconnecting. The event
+     * task takes it to receive a response. This way only one of them at a time
+     * accesses the connection socket and its reception state. A binary semaphore
+     * starts out taken, so give it once to make it available.
+     */
+    newTpCtx->tcpConnSem = TbxMbOsalSemCreate();
+    if (newTpCtx->tcpConnSem != NULL)
+    {
+      TbxMbOsalSemGive(newTpCtx->tcpConnSem, TBX_FALSE);
+    }
+    else
+    {
+      okay = TBX_FALSE;
+    }
+    /* Does the new context own the connection? */
+    if ((okay == TBX_TRUE) && (primaryCtx == NULL))
+    {
+      /* Create the lists for managing the connections of a server and for the
+       * contexts that share the connection of a client.
+       */
+      newTpCtx->tcpConnList = TbxListCreate();
+      newTpCtx->tcpReadyList = TbxListCreate();
+      newTpCtx->tcpShareList = TbxListCreate();
+      if ( (newTpCtx->tcpConnList == NULL) || (newTpCtx->tcpReadyList == NULL) ||
+           (newTpCtx->tcpShareList == NULL) )
+      {
+        okay = TBX_FALSE;
+      }
+      /* Create the epoll instance. The sockets of the connection are registered with
+       * it, such that the reactor thread can wait for their I/O events.
+       */
+      if (okay == TBX_TRUE)
+      {
+        newTpCtx->tcpEpollFd = epoll_create1(0);
+        if (newTpCtx->tcpEpollFd < 0)
+        {
+          newTpCtx->tcpEpollFd = TBX_MB_TCP_INVALID_SOCKET;
+          okay = TBX_FALSE;
+        }
+      }
+    }
+    /* Register the new context with the context that owns the connection, such that
+     * responses can be routed to it. The owner is registered with itself.
+     */
+    if (okay == TBX_TRUE)
+    {
+      tTbxMbTpCtx * ownerCtx = newTpCtx->tcpPrimary;
+      TbxCriticalSectionEnter();
+      okay = TbxListInsertItemBack(ownerCtx->tcpShareList, newTpCtx);
+      TbxCriticalSectionExit();
+    }
+    /* Start the reactor thread last, once the context is completely initialized. */
+    if ((okay == TBX_TRUE) && (primaryCtx == NULL))
+    {
+      okay = TbxMbTcpReactorStart(newTpCtx);
+    }
+    /* Verify that all resources were created. */
+    TBX_ASSERT(okay == TBX_TRUE);
+    /* Update the result if all went okay. */
+    if (okay == TBX_TRUE)
+    {
+      result = newTpCtx;
+    }
+    /* Clean up in case of a problem. */
+    else
+    {
+      if (newTpCtx->tcpConnSem != NULL)
+      {
+        TbxMbOsalSemFree(newTpCtx->tcpConnSem);
+      }
+      if (newTpCtx->tcpEpollFd != TBX_MB_TCP_INVALID_SOCKET)
+      {
+        (void)close(newTpCtx->tcpEpollFd);
+      }
+      if (newTpCtx->tcpConnList != NULL)
+      {
+        TbxListDelete(newTpCtx->tcpConnList);
+      }
+      if (newTpCtx->tcpReadyList != NULL)
+      {
+        TbxListDelete(newTpCtx->tcpReadyList);
+      }
+      if (newTpCtx->tcpShareList != NULL)
+      {
+        TbxListDelete(newTpCtx->tcpShareList);
+      }
+      TbxMemPoolRelease(newTpCtx);
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbTcpCtxCreate ***/
+
+
+/************************************************************************************//**
+** \brief     Event polling function that is automatically called during each call of
+**            TbxMbEventTask(), if activated. Use the TBX_MB_EVENT_ID_START_POLLING and
+**            TBX_MB_EVENT_ID_STOP_POLLING events to activate and deactivate.
+** \details   Until a channel is linked, it is not yet known if this transport layer
+**            should operate as a server or as a client. The polling then continues once
+**            per millisecond. Afterwards, this function stops the polling each time it
+**            is done with the sockets. The reactor thread starts it again, as soon as
+**            new connections or newly received data are pending.
+** \param     transport Handle to TCP transport layer object.
+** \return    Free running timer tick count at which this function should be called
+**            again, in case the polling continues.
+**
+****************************************************************************************/
+static uint16_t TbxMbTcpPoll(tTbxMbTp transport)
+{
+  /* Unless a channel is linked, ask to be called again in a millisecond. */
+  uint16_t result = TbxMbPortTimerCount() + TBX_MB_EVENT_TICKS_PER_MS;
+  uint8_t  waitForIo = TBX_FALSE;
+
+  /* Verify parameters. */
+  TBX_ASSERT(transport != NULL);
+
+  /* Only continue with valid parameters. */
+  if (transport != NULL)
+  {
+    /* Convert the TP channel pointer to the context structure. */
+    tTbxMbTpCtx * tpCtx = (tTbxMbTpCtx *)transport;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(tpCtx->type == TBX_MB_TCP_CONTEXT_TYPE);
+    /* Obtain a copy of the linked channel information. */
+    TbxCriticalSectionEnter();
+    void const * channelCtxCopy = tpCtx->channelCtx;
+    uint8_t      isClientCopy = tpCtx->isClient;
+    TbxCriticalSectionExit();
+    /* Only continue once a channel is linked. Before that it is not yet known if this
+     * transport layer should operate as a server or as a client.
+     */
+    if (channelCtxCopy != NULL)
+    {
+      /* Operating as a server? */
+      if (isClientCopy == TBX_FALSE)
+      {
+        TbxMbTcpServerPoll(tpCtx);
+        /* Only wait for I/O events once the server is listening. Otherwise make a new
+         * attempt to start listening a bit later.
+         */
+        if (tpCtx->tcpListenSocket != TBX_MB_TCP_INVALID_SOCKET)
+        {
+          waitForIo = TBX_TRUE;
+        }
+        else
+        {
+          result = TbxMbPortTimerCount() +
+                   (uint16_t)(TBX_MB_TCP_LISTEN_RETRY_MS * TBX_MB_EVENT_TICKS_PER_MS);
+        }
+      }
+      /* Operating as a client. */
+      else
+      {
+        /* Check for newly received data. Note that there is no need to wait for the
+         * channel to be done processing a previously received packet. A response is
+         * only passed on to a channel that waits for it. Take the connection lock
+         * first, because a client task might be connecting or disconnecting. If that
+         * takes too long, the data is simply still pending afterwards. The reactor
+         * thread then starts the polling again.
+         */
+        if (TbxMbOsalSemTake(tpCtx->tcpConnSem, TBX_MB_TCP_TIMEOUT_MS) == TBX_TRUE)
+        {
+          if (tpCtx->tcpSocket != TBX_MB_TCP_INVALID_SOCKET)
+          {
+            TbxMbTcpReceive(tpCtx);
+          }
+          TbxMbOsalSemGive(tpCtx->tcpConnSem, TBX_FALSE);
+        }
+        /* The connection is established on demand by the transmit function, which
+         * registers its socket with the epoll instance.
+         */
+        waitForIo = TBX_TRUE;
+      }
+    }
+    /* Nothing else to do until new I/O events are pending? */
+    if (waitForIo == TBX_TRUE)
+    {
+      /* Instruct the event task to stop calling our polling function. Do this before
+       * waking up the reactor thread, such that the event with which the reactor thread
+       * starts the polling again, is always processed after this one.
+       */
+      tTbxMbEvent newEvent = {.context = tpCtx, .id = TBX_MB_EVENT_ID_STOP_POLLING};
+      TbxMbEventPost(&newEvent, TBX_FALSE);
+      /* Have the reactor thread wait for new I/O events again. */
+      TbxMbTcpReactorRearm(tpCtx);
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbTcpPoll ***/
+
+
+/************************************************************************************//**
+** \brief     Starts the transmission of a communication packet, stored in the transport
+**            layer object.
+** \details   On TCP the transmission is complete, once the packet was handed over to
+**            the TCP/IP stack. The TBX_MB_EVENT_ID_PDU_TRANSMITTED event is therefore
+**            posted directly from this function.
+** \param     transport Handle to TCP transport layer object.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+static uint8_t TbxMbTcpTransmit(tTbxMbTp transport)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify parameters. */
+  TBX_ASSERT(transport != NULL);
+
+  /* Only continue with valid parameters. */
+  if (transport != NULL)
+  {
+    /* Convert the TP channel pointer to the context structure. */
+    tTbxMbTpCtx * tpCtx = (tTbxMbTpCtx *)transport;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(tpCtx->type == TBX_MB_TCP_CONTEXT_TYPE);
+    /* Are we requested to transmit an exception response? */
+    uint8_t codeCopy = tpCtx->txPacket.pdu.code;
+    if ((codeCopy & TBX_MB_FC_EXCEPTION_MASK) == TBX_MB_FC_EXCEPTION_MASK)
+    {
+      /* Increment the total number of exception responses. */
+      tpCtx->diagInfo.busExcpErrCnt++;
+    }
+    /* Determine the socket to transmit on. */
+    int32_t         socketCopy = TBX_MB_TCP_INVALID_SOCKET;
+    tTbxMbTcpConn * txConn = NULL;
+    /* The connection is owned by the primary context. For a server and for a client
+     * that does not share its connection, that's this context itself.
+     */
+    tTbxMbTpCtx * primaryCtx = tpCtx->tcpPrimary;
+    uint8_t       connLocked = TBX_FALSE;
+    /* Operating as a client? */
+    if (tpCtx->isClient == TBX_TRUE)
+    {
+      /* Multiple client channels can share the connection and they might run in
+       * different tasks. Lock the connection for transmission, such that their
+       * requests are not interleaved. This also keeps the event task from receiving
+       * on the socket, while it's being connected or disconnected.
+       */
+      connLocked = TbxMbOsalSemTake(primaryCtx->tcpConnSem, TBX_MB_TCP_TIMEOUT_MS);
+      if (connLocked == TBX_TRUE)
+      {
+        /* A client connects to the server on demand. Attempt to establish the
+         * connection, if this did not yet happen or if the server closed the
+         * connection in the meantime.
+         */
+        TbxCriticalSectionEnter();
+        socketCopy = primaryCtx->tcpSocket;
+        TbxCriticalSectionExit();
+        if (socketCopy == TBX_MB_TCP_INVALID_SOCKET)
+        {
+          if (TbxMbTcpConnect(primaryCtx) == TBX_OK)
+          {
+            TbxCriticalSectionEnter();
+            socketCopy = primaryCtx->tcpSocket;
+            TbxCriticalSectionExit();
+          }
+        }
+        /* A client uses a new transaction identifier for each request, such that the
+         * response can be matched to the request. It's unique among all contexts that
+         * share the connection.
+         */
+        TbxCriticalSectionEnter();
+        primaryCtx->tcpNextTransId++;
+        tpCtx->tcpTransId = primaryCtx->tcpNextTransId;
+        /* No response is expected for a broadcast request. Make sure to ignore one,
+         * in case a server still sends it.
+         */
+        tpCtx->tcpRespPending = (tpCtx->txPacket.node == TBX_MB_TP_NODE_ADDR_BROADCAST) ?
+                                TBX_FALSE : TBX_TRUE;
+        TbxCriticalSectionExit();
+      }
+    }
+    /* Operating as a server. */
+    else
+    {
+      /* The response is for the connection whose request was just processed. The
+       * transaction identifier of its request was already stored in tcpTransId, when
+       * the request was dispatched to the channel.
+       */
+      txConn = tpCtx->tcpTxConn;
+      tpCtx->tcpTxConn = NULL;
+      /* Sanity check that there is a connection that waits for a response. */
+      TBX_ASSERT(txConn != NULL);
+      /* The connection might have been closed by the client in the meantime. */
+      if (txConn != NULL)
+      {
+        socketCopy = txConn->socket;
+      }
+    }
+    /* Only continue with an established connection. */
+    if (socketCopy != TBX_MB_TCP_INVALID_SOCKET)
+    {
+      /* The ADU starts with the MBAP header in head[] and is directly followed by the
+       * PDU. The ADU's length is:
+       * - MBAP header (7 bytes)
+       * - Function code (1 byte)
+       * - Packet data (dataLen bytes)
+       */
+      uint8_t * aduPtr = &tpCtx->txPacket.head[0];
+      uint16_t  aduLen = TBX_MB_TCP_MBAP_LEN + 1U + tpCtx->txPacket.dataLen;
+      TbxCriticalSectionEnter();
+      uint16_t transIdCopy = tpCtx->tcpTransId;
+      TbxCriticalSectionExit();
+      /* Populate the MBAP header. The length field holds the number of bytes that
+       * follow, which is the unit identifier plus the PDU. The unit identifier is the
+       * node address. For client->server transfers it is the one that the client
+       * channel stored in txPacket.node. For server->client transfers it is an echo
+       * of the one in the request, which was also stored in txPacket.node when the
+       * request was dispatched to the channel.
+       */
+      TbxMbCommonStoreUInt16BE(transIdCopy, &aduPtr[0]);
+      TbxMbCommonStoreUInt16BE(TBX_MB_TCP_PROTOCOL_ID, &aduPtr[2]);
+      TbxMbCommonStoreUInt16BE(aduLen - (TBX_MB_TCP_MBAP_LEN - 1U), &aduPtr[4]);
+      aduPtr[6] = tpCtx->txPacket.node;
+      /* Pass the ADU on to the TCP/IP stack. */
+      result = TbxMbTcpSend(socketCopy, aduPtr, aduLen);
+      /* Transmission successful? */
+      if (result == TBX_OK)
+      {
+        /* Post an event to the linked channel to inform it that the PDU transmission
+         * completed.
+         */
+        tTbxMbEvent newEvent;
+        newEvent.context = tpCtx->channelCtx;
+        newEvent.id = TBX_MB_EVENT_ID_PDU_TRANSMITTED;
+        TbxMbEventPost(&newEvent, TBX_FALSE);
+      }
+      /* The connection is no longer usable. Close it. */
+      else
+      {
+        if (tpCtx->isClient == TBX_TRUE)
+        {
+          TbxMbTcpDisconnect(primaryCtx);
+        }
+        else
+        {
+          TbxMbTcpServerClose(tpCtx, txConn);
+        }
+      }
+    }
+    /* Unlock the connection for transmission. */
+    if (connLocked == TBX_TRUE)
+    {
+      TbxMbOsalSemGive(primaryCtx->tcpConnSem, TBX_FALSE);
+    }
+    /* Problem detected that prevented the response from being sent? */
+    if (result == TBX_ERROR)
+    {
+      /* Increment the total number of not sent responses. */
+      tpCtx->diagInfo.srvNoRespCnt++;
+    }
+    /* Finish up the request-response cycle on the server's connection. */
+    if (txConn != NULL)
+    {
+      /* Clear the busy flag, such that the connection can be closed or used again. */
+      txConn->busy = TBX_FALSE;
+      /* Closed while the request was queued or being processed? */
+      if (txConn->closed == TBX_TRUE)
+      {
+        /* Now that it's no longer referenced, its memory can be released. */
+        TbxMbTcpServerClose(tpCtx, txConn);
+      }
+      /* Still connected. */
+      else
+      {
+        /* Resume the reception of requests on this connection. */
+        struct epoll_event epollEvent = { .events = EPOLLIN, .data.ptr = txConn };
+        (void)epoll_ctl(tpCtx->tcpEpollFd, EPOLL_CTL_MOD, txConn->socket, &epollEvent);
+      }
+      /* Pass the next queued request, if any, on to the channel. */
+      TbxMbTcpServerDispatch(tpCtx);
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbTcpTransmit ***/
+
+
+/************************************************************************************//**
+** \brief     Signals that the caller is done with processing a reception PDU. Should be
+**            called by a channel after receiving the TBX_MB_EVENT_ID_PDU_RECEIVED event
+**            and no longer needing access to the PDU stored in the transport layer
+**            context.
+** \param     transport Handle to TCP transport layer object.
+**
+****************************************************************************************/
+static void TbxMbTcpReceptionDone(tTbxMbTp transport)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(transport != NULL);
+
+  /* Only continue with valid parameters. */
+  if (transport != NULL)
+  {
+    /* Convert the TP channel pointer to the context structure. */
+    tTbxMbTpCtx * tpCtx = (tTbxMbTpCtx *)transport;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(tpCtx->type == TBX_MB_TCP_CONTEXT_TYPE);
+    /* This function should only be called in the VALIDATION state. Verify this. */
+    TbxCriticalSectionEnter();
+    uint8_t currentState = tpCtx->state;
+    TbxCriticalSectionExit();
+    TBX_ASSERT(currentState == TBX_MB_TCP_STATE_VALIDATION);
+    /* Only continue in the VALIDATION state. */
+    if (currentState == TBX_MB_TCP_STATE_VALIDATION)
+    {
+      /* Operating as a server? */
+      if (tpCtx->isClient == TBX_FALSE)
+      {
+        /* The request at the front of the queue was just processed. Move it out of
+         * the queue and give its packet buffer back to the memory pool. The
+         * connection itself is remembered, because the response still needs to be
+         * transmitted on it.
+         */
+        tTbxMbTcpConn * conn = TbxListGetFirstItem(tpCtx->tcpReadyList);
+        TBX_ASSERT(conn != NULL);
+        if (conn != NULL)
+        {
+          TbxListRemoveItem(tpCtx->tcpReadyList, conn);
+          TbxMemPoolRelease(conn->rxPacket);
+          conn->rxPacket = NULL;
+          tpCtx->tcpTxConn = conn;
+        }
+      }
+      /* Transistion back to the IDLE state to unlock the data reception path, allowing
+       * the reception of new packets.
+       */
+      TbxCriticalSectionEnter();
+      tpCtx->state = TBX_MB_TCP_STATE_IDLE;
+      TbxCriticalSectionExit();
+    }
+  }
+} /*** end of TbxMbTcpReceptionDone ****/
+
+
+/************************************************************************************//**
+** \brief     Interface function to be called by a channel to obtain read access to the
+**            reception packet. Returns NULL is the packet is currently not accessible.
+**            Can be called when processing the TBX_MB_EVENT_ID_PDU_RECEIVED event.
+** \param     transport Handle to TCP transport layer object.
+** \return    Pointer to the packet or NULL if currently not accessible.
+**
+****************************************************************************************/
+static tTbxMbTpPacket * TbxMbTcpGetRxPacket(tTbxMbTp transport)
+{
+  tTbxMbTpPacket * result = NULL;
+
+  /* Verify parameters. */
+  TBX_ASSERT(transport != NULL);
+
+  /* Only continue with valid parameters. */
+  if (transport != NULL)
+  {
+    /* Convert the TP channel pointer to the context structure. */
+    tTbxMbTpCtx * tpCtx = (tTbxMbTpCtx *)transport;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(tpCtx->type == TBX_MB_TCP_CONTEXT_TYPE);
+    /* Access to the reception packet by a channel is only allowed in the VALIDATION
+     * state. In this state the reception path is locked until a transition back to IDLE
+     * state is made. This happens once the channel called receptionDoneFcn().
+     */
+    TbxCriticalSectionEnter();
+    uint8_t currentState = tpCtx->state;
+    TbxCriticalSectionExit();
+    if (currentState == TBX_MB_TCP_STATE_VALIDATION)
+    {
+      /* Operating as a server? */
+      if (tpCtx->isClient == TBX_FALSE)
+      {
+        /* The request being processed is the one at the front of the queue. */
+        tTbxMbTcpConn * conn = TbxListGetFirstItem(tpCtx->tcpReadyList);
+        if (conn != NULL)
+        {
+          /* Update the result. */
+          result = conn->rxPacket;
+        }
+      }
+      /* Operating as a client. */
+      else
+      {
+        /* Update the result. */
+        result = &tpCtx->rxPacket;
+      }
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbTcpGetRxPacket ***/
+
+
+/************************************************************************************//**
+** \brief     Interface function to be called by a channel to obtain write access to the
+**            transmission packet. Returns NULL is the packet is currently not
+**            accessible. Can by called to prepare the transmit packet before calling the
+**            transport layer's transmitFcn().
+** \details   On TCP the transmission is complete once transmitFcn() returns. This means
+**            that the transmission packet is always accessible. A server only processes
+**            one request at a time, so all its connections can share the same
+**            transmission packet.
+** \param     transport Handle to TCP transport layer object.
+** \return    Pointer to the packet or NULL if currently not accessible.
+**
+****************************************************************************************/
+static tTbxMbTpPacket * TbxMbTcpGetTxPacket(tTbxMbTp transport)
+{
+  tTbxMbTpPacket * result = NULL;
+
+  /* Verify parameters. */
+  TBX_ASSERT(transport != NULL);
+
+  /* Only continue with valid parameters. */
+  if (transport != NULL)
+  {
+    /* Convert the TP channel pointer to the context structure. */
+    tTbxMbTpCtx * tpCtx = (tTbxMbTpCtx *)transport;
+    /* Sanity check on the context type. */
+    TBX_ASSERT(tpCtx->type == TBX_MB_TCP_CONTEXT_TYPE);
+    /* Update the result. */
+    result = &tpCtx->txPacket;
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbTcpGetTxPacket ***/
+
+
+/************************************************************************************//**
+** \brief     Reads newly received data from the client's connection socket. TCP is a
+**            stream oriented protocol, so the data for one ADU could arrive in multiple
+**            chunks. The length field in the MBAP header determines where the ADU ends.
+**            Only the bytes that belong to the current ADU are read, such that the next
+**            one stays in the socket's reception buffer.
+**            The MBAP header is first received into the context that owns the
+**            connection. Once complete, its transaction identifier determines which of
+**            the contexts that share the connection waits for this response. The
+**            remainder of the ADU is received directly into that context's reception
+**            packet, after which it's passed on to the channel linked to that context.
+**            A response that no context waits for, is read and discarded.
+**            Should only be called with the connection lock taken.
+** \param     tpCtx Pointer to the TCP transport layer context that owns the connection.
+**
+****************************************************************************************/
+static void TbxMbTcpReceive(tTbxMbTpCtx * tpCtx)
+{
+  uint8_t keepReading = TBX_TRUE;
+  uint8_t discardBuf[TBX_MB_TP_ADU_MAX_LEN];
+
+  /* Verify parameters. */
+  TBX_ASSERT(tpCtx != NULL);
+
+  /* Only continue with valid parameters. */
+  if (tpCtx != NULL)
+  {
+    /* Keep reading until all currently available data of this ADU is read. */
+    while (keepReading == TBX_TRUE)
+    {
+      /* Determine where to store the data and the total length of the ADU. As long as
+       * the MBAP header is not yet complete, only the header is requested. Afterwards,
+       * its length field tells how many more bytes follow the length field. Note that
+       * the connection lock protects the .tcpSocket, .rxAduWrIdx and .tcpRxXyz
+       * elements against a client task that connects or disconnects at the same time.
+       */
+      uint8_t * aduPtr = &tpCtx->tcpRxHead[0];
+      uint16_t  aduLen = TBX_MB_TCP_MBAP_LEN;
+      if (tpCtx->rxAduWrIdx >= TBX_MB_TCP_MBAP_LEN)
+      {
+        TbxCriticalSectionEnter();
+        tTbxMbTpCtx * targetCtx = tpCtx->tcpRxTarget;
+        TbxCriticalSectionExit();
+        aduPtr = (targetCtx != NULL) ? &targetCtx->rxPacket.head[0] : &discardBuf[0];
+        aduLen = (TBX_MB_TCP_MBAP_LEN - 1U) +
+                 TbxMbCommonExtractUInt16BE(&tpCtx->tcpRxHead[4]);
+      }
+      /* Attempt to read the remaining bytes. Note that the socket was configured for
+       * non-blocking operation.
+       */
+      ssize_t rxCnt = recv(tpCtx->tcpSocket, &aduPtr[tpCtx->rxAduWrIdx],
+                           (size_t)aduLen - tpCtx->rxAduWrIdx, 0);
+      /* Newly received data? */
+      if (rxCnt > 0)
+      {
+        /* Update the write indexer into the ADU. */
+        tpCtx->rxAduWrIdx += (uint16_t)rxCnt;
+        /* Did the MBAP header just become complete? */
+        if ( (tpCtx->rxAduWrIdx == TBX_MB_TCP_MBAP_LEN) &&
+             (aduLen == TBX_MB_TCP_MBAP_LEN) )
+        {
+          /* Check the MBAP header's protocol identifier and the length field. The
+           * length field includes the unit identifier and the function code, so it
+           * must be at least two. The PDU must also fit in the reception packet.
+           */
+          uint16_t protocolId = TbxMbCommonExtractUInt16BE(&tpCtx->tcpRxHead[2]);
+          uint16_t lengthField = TbxMbCommonExtractUInt16BE(&tpCtx->tcpRxHead[4]);
+          if ( (protocolId != TBX_MB_TCP_PROTOCOL_ID) || (lengthField < 2U) ||
+               (lengthField > (TBX_MB_TP_PDU_MAX_LEN + 1U)) )
+          {
+            /* Increment the total number of received packets with a communication
+             * error.
+             */
+            tpCtx->diagInfo.busCommErrCnt++;
+            /* There is no way to find the start of the next ADU in the data stream.
+             * Close the connection, such that the remote node can resynchronize by
+             * reconnecting.
+             */
+            TbxMbTcpDisconnect(tpCtx);
+            keepReading = TBX_FALSE;
+          }
+          /* Valid MBAP header. */
+          else
+          {
+            /* Find the context that waits for this response. */
+            uint16_t      transId = TbxMbCommonExtractUInt16BE(&tpCtx->tcpRxHead[0]);
+            tTbxMbTpCtx * targetCtx = TbxMbTcpMatchResponse(tpCtx, transId);
+            TbxCriticalSectionEnter();
+            tpCtx->tcpRxTarget = targetCtx;
+            TbxCriticalSectionExit();
+          }
+        }
+        /* Did the ADU just become complete? */
+        else if (tpCtx->rxAduWrIdx == aduLen)
+        {
+          /* Reset the write indexer for the next ADU and stop reading. Another
+           * response is processed during the next poll.
+           */
+          tpCtx->rxAduWrIdx = 0U;
+          keepReading = TBX_FALSE;
+          /* Increment the total number of received packets. */
+          tpCtx->diagInfo.busMsgCnt++;
+          /* Obtain the context that waits for this response and reset it for the next
+           * response.
+           */
+          TbxCriticalSectionEnter();
+          tTbxMbTpCtx * targetCtx = tpCtx->tcpRxTarget;
+          tpCtx->tcpRxTarget = NULL;
+          TbxCriticalSectionExit();
+          /* Only continue if a context waits for this response. */
+          if (targetCtx != NULL)
+          {
+            /* Copy the MBAP header right in front of the PDU. */
+            for (uint8_t idx = 0U; idx < TBX_MB_TCP_MBAP_LEN; idx++)
+            {
+              targetCtx->rxPacket.head[idx] = tpCtx->tcpRxHead[idx];
+            }
+            /* Packet reception complete. Set the PDU data length field. This is the
+             * length of the ADU, minus:
+             * - MBAP header (7 bytes)
+             * - Function code (1 byte)
+             */
+            targetCtx->rxPacket.dataLen = (uint8_t)(aduLen - (TBX_MB_TCP_MBAP_LEN + 1U));
+            /* Also store the unit identifier in the packet's node element. That's were
+             * channels expect it. It's in the last byte of the MBAP header.
+             */
+            targetCtx->rxPacket.node = tpCtx->tcpRxHead[TBX_MB_TCP_MBAP_LEN - 1U];
+            /* Transition to the VALIDATION state. This gives the channel access to
+             * the reception packet, until it's done processing it.
+             */
+            TbxCriticalSectionEnter();
+            targetCtx->state = TBX_MB_TCP_STATE_VALIDATION;
+            TbxCriticalSectionExit();
+            /* Post an event to the linked channel for further processing of the PDU.*/
+            tTbxMbEvent pduRxEvent;
+            pduRxEvent.context = targetCtx->channelCtx;
+            pduRxEvent.id = TBX_MB_EVENT_ID_PDU_RECEIVED;
+            TbxMbEventPost(&pduRxEvent, TBX_FALSE);
+          }
+        }
+        else
+        {
+          /* Nothing left to do, but MISRA requires this terminating else statement. */
+        }
+      }
+      /* Connection closed by the remote node? */
+      else if (rxCnt == 0)
+      {
+        TbxMbTcpDisconnect(tpCtx);
+        keepReading = TBX_FALSE;
+      }
+      /* No more data available at this point or an error occurred. */
+      else
+      {
+        keepReading = TBX_FALSE;
+        /* Close the connection, unless it was just a matter of no data being available
+         * yet or an interrupted system call.
+         */
+        if ( (errno != EAGAIN) && (errno != EWOULDBLOCK) && (errno != EINTR) )
+        {
+          TbxMbTcpDisconnect(tpCtx);
+        }
+      }
+    }
+  }
+} /*** end of TbxMbTcpReceive ***/
+
+
+/************************************************************************************//**
+** \brief     Finds the context that waits for the response with the specified
+**            transaction identifier, among the contexts that share the connection.
+** \details   TCP already guarantees data integrity, so there is no checksum to verify.
+**            Responses that arrive after the client already timed out waiting for them,
+**            do not match and are discarded this way. The same applies to responses to
+**            broadcast requests.
+** \param     tpCtx Pointer to the TCP transport layer context that owns the connection.
+** \param     transId Transaction identifier from the MBAP header of the response.
+** \return    Pointer to the context that waits for the response, NULL if none.
+**
+****************************************************************************************/
+static tTbxMbTpCtx * TbxMbTcpMatchResponse(tTbxMbTpCtx * tpCtx,
+                                           uint16_t      transId)
+{
+  tTbxMbTpCtx * result = NULL;
+
+  /* Verify parameters. */
+  TBX_ASSERT(tpCtx != NULL);
+
+  /* Only continue with valid parameters. */
+  if (tpCtx != NULL)
+  {
+    /* Loop through all contexts that share the connection, including the owner. */
+    TbxCriticalSectionEnter();
+    tTbxMbTpCtx * shareCtx = TbxListGetFirstItem(tpCtx->tcpShareList);
+    while ((shareCtx != NULL) && (result == NULL))
+    {
+      /* Does this context wait for a response with this transaction identifier? */
+      if ( (shareCtx->tcpRespPending == TBX_TRUE) && (shareCtx->tcpTransId == transId) )
+      {
+        /* Only one response is expected per request. */
+        shareCtx->tcpRespPending = TBX_FALSE;
+        /* Update the result. */
+        result = shareCtx;
+      }
+      shareCtx = TbxListGetNextItem(tpCtx->tcpShareList, shareCtx);
+    }
+    TbxCriticalSectionExit();
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbTcpMatchResponse ***/
+
+
+/************************************************************************************//**
+** \brief     Establishes the connection of a TCP client with the server. Blocks until
+**            the connection is established or a timeout occurred. Should only be
+**            called with the connection lock taken.
+** \param     tpCtx Pointer to the TCP transport layer context.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+static uint8_t TbxMbTcpConnect(tTbxMbTpCtx * tpCtx)
+{
+  uint8_t result = TBX_ERROR;
+
+  /* Verify parameters. */
+  TBX_ASSERT(tpCtx != NULL);
+
+  /* Only continue with valid parameters. */
+  if (tpCtx != NULL)
+  {
+    /* Create the socket. */
+    int32_t newSocket = socket(AF_INET, SOCK_STREAM, 0);
+    /* Only continue if the socket could be created. */
+    if (newSocket >= 0)
+    {
+      struct sockaddr_in serverAddr = { 0 };
+      /* Configure the socket for Modbus TCP communication. This includes non-blocking
+       * operation, so the connection attempt can be done with a timeout.
+       */
+      TbxMbTcpConfigureSocket(newSocket);
+      /* Start the connection attempt. */
+      serverAddr.sin_family = AF_INET;
+      serverAddr.sin_addr.s_addr = tpCtx->tcpIpAddr;
+      serverAddr.sin_port = htons(tpCtx->tcpPort);
+      if (connect(newSocket, (struct sockaddr *)&serverAddr, sizeof(serverAddr)) == 0)
+      {
+        /* Connection established right away. */
+        result = TBX_OK;
+      }
+      /* Connection attempt is in progress? */
+      else if (errno == EINPROGRESS)
+      {
+        /* Wait for the socket to become writable, which happens when the connection
+         * attempt completed.
+         */
+        struct pollfd pollFd = { .fd = newSocket, .events = POLLOUT, .revents = 0 };
+        if (poll(&pollFd, 1U, (int)TBX_MB_TCP_TIMEOUT_MS) == 1)
+        {
+          /* Check if the connection attempt succeeded. */
+          int       sockErr = 0;
+          socklen_t sockErrLen = sizeof(sockErr);
+          int       sockOptResult = getsockopt(newSocket, SOL_SOCKET, SO_ERROR, &sockErr,
+                                               &sockErrLen);
+          if ((sockOptResult == 0) && (sockErr == 0))
+          {
+            result = TBX_OK;
+          }
+        }
+      }
+      else
+      {
+        /* Nothing left to do, but MISRA requires this terminating else statement. */
+      }
+      /* Register the socket with the epoll instance, such that the reactor thread
+       * detects newly received data. Closing the socket also removes it again.
+       */
+      if (result == TBX_OK)
+      {
+        struct epoll_event epollEvent = { .events = EPOLLIN, .data.ptr = NULL };
+        if (epoll_ctl(tpCtx->tcpEpollFd, EPOLL_CTL_ADD, newSocket, &epollEvent) != 0)
+        {
+          result = TBX_ERROR;
+        }
+      }
+      /* Store the connection socket if all went okay. */
+      if (result == TBX_OK)
+      {
+        TbxCriticalSectionEnter();
+        tpCtx->tcpSocket = newSocket;
+        tpCtx->rxAduWrIdx = 0U;
+        tpCtx->tcpRxTarget = NULL;
+        TbxCriticalSectionExit();
+      }
+      /* Clean up the socket. A new attempt is made during the next transmission. */
+      else
+      {
+        (void)close(newSocket);
+      }
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbTcpConnect ***/
+
+
+/************************************************************************************//**
+** \brief     Closes the connection of a TCP client with the server, if one is
+**            established. Should only be called with the connection lock taken, or when
+**            no other task accesses the context anymore.
+** \param     tpCtx Pointer to the TCP transport layer context.
+**
+****************************************************************************************/
+static void TbxMbTcpDisconnect(tTbxMbTpCtx * tpCtx)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(tpCtx != NULL);
+
+  /* Only continue with valid parameters. */
+  if (tpCtx != NULL)
+  {
+    /* Invalidate the connection socket and reset the ADU reception. Note that the
+     * state is not touched. In case a channel is still processing a received packet,
+     * it will still call receptionDoneFcn(), which transitions back to IDLE. Channels
+     * that still wait for a response simply time out.
+     */
+    TbxCriticalSectionEnter();
+    int32_t socketCopy = tpCtx->tcpSocket;
+    tpCtx->tcpSocket = TBX_MB_TCP_INVALID_SOCKET;
+    tpCtx->rxAduWrIdx = 0U;
+    tpCtx->tcpRxTarget = NULL;
+    TbxCriticalSectionExit();
+    /* Close the socket, if it was open. */
+    if (socketCopy != TBX_MB_TCP_INVALID_SOCKET)
+    {
+      (void)close(socketCopy);
+    }
+  }
+} /*** end of TbxMbTcpDisconnect ***/
+
+
+/************************************************************************************//**
+** \brief     Polls the sockets of a TCP server. It reads the I/O events of its epoll
+**            instance to detect new connection requests and newly received data on all
+**            connections.
+**            Completely received requests are queued and passed on to the linked
+**            server channel one at a time.
+** \param     tpCtx Pointer to the TCP transport layer context.
+**
+****************************************************************************************/
+static void TbxMbTcpServerPoll(tTbxMbTpCtx * tpCtx)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(tpCtx != NULL);
+
+  /* Only continue with valid parameters. */
+  if (tpCtx != NULL)
+  {
+    /* Start listening for connection requests, if not yet done. */
+    if (tpCtx->tcpListenSocket == TBX_MB_TCP_INVALID_SOCKET)
+    {
+      TbxMbTcpServerListen(tpCtx);
+    }
+    /* Only continue if the server is listening. */
+    if (tpCtx->tcpListenSocket != TBX_MB_TCP_INVALID_SOCKET)
+    {
+      struct epoll_event epollEvents[TBX_MB_TCP_SERVER_EVENTS_MAX];
+      /* Collect the I/O events that are currently pending, without waiting. The reactor
+       * thread already takes care of the waiting in between polls.
+       */
+      int eventCnt = epoll_wait(tpCtx->tcpEpollFd, epollEvents,
+                                (int)TBX_MB_TCP_SERVER_EVENTS_MAX, 0);
+      /* Process the I/O events. */
+      for (int idx = 0; idx < eventCnt; idx++)
+      {
+        tTbxMbTcpConn * conn = epollEvents[idx].data.ptr;
+        /* The listen socket was registered without a connection. */
+        if (conn == NULL)
+        {
+          TbxMbTcpServerAccept(tpCtx);
+        }
+        /* Newly received data or a connection that was closed by the client. In the
+         * latter case recv() reports it, after which the connection is closed.
+         */
+        else if ((epollEvents[idx].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) != 0U)
+        {
+          /* A connection with a queued request is not read from, until the response
+           * is transmitted. Only errors and hang-ups are reported for such a
+           * connection.
+           */
+          if (conn->busy == TBX_FALSE)
+          {
+            TbxMbTcpServerReceive(tpCtx, conn);
+          }
+          else
+          {
+            TbxMbTcpServerClose(tpCtx, conn);
+          }
+        }
+        else
+        {
+          /* Nothing left to do, but MISRA requires this terminating else statement. */
+        }
+      }
+      /* Pass the next queued request, if any, on to the channel. */
+      TbxMbTcpServerDispatch(tpCtx);
+    }
+  }
+} /*** end of TbxMbTcpServerPoll ***/
+
+
+/************************************************************************************//**
+** \brief     Opens the listen socket of a TCP server and registers it with the epoll
+**            instance, such that clients can connect.
+** \param     tpCtx Pointer to the TCP transport layer context.
+**
+****************************************************************************************/
+static void TbxMbTcpServerListen(tTbxMbTpCtx * tpCtx)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(tpCtx != NULL);
+
+  /* Only continue with valid parameters. */
+  if (tpCtx != NULL)
+  {
+    /* Create the socket. */
+    int32_t listenSocket = socket(AF_INET, SOCK_STREAM, 0);
+    /* Only continue if the socket could be created. */
+    if (listenSocket >= 0)
+    {
+      uint8_t            okay = TBX_TRUE;
+      int                optValue = 1;
+      struct sockaddr_in localAddr = { 0 };
+      /* Allow the server to be restarted right away, even if the local address is
+       * still in the TIME_WAIT state of an earlier connection.
+       */
+      (void)setsockopt(listenSocket, SOL_SOCKET, SO_REUSEADDR, &optValue,
+                       sizeof(optValue));
+      /* Bind the socket to the local address and port. */
+      localAddr.sin_family = AF_INET;
+      localAddr.sin_addr.s_addr = tpCtx->tcpIpAddr;
+      localAddr.sin_port = htons(tpCtx->tcpPort);
+      if (bind(listenSocket, (struct sockaddr *)&localAddr, sizeof(localAddr)) != 0)
+      {
+        okay = TBX_FALSE;
+      }
+      /* Start listening for connection requests. */
+      if (okay == TBX_TRUE)
+      {
+        if (listen(listenSocket, SOMAXCONN) != 0)
+        {
+          okay = TBX_FALSE;
+        }
+      }
+      /* Configure the socket for non-blocking operation, such that accept() does not
+       * block the event task.
+       */
+      if (okay == TBX_TRUE)
+      {
+        if (fcntl(listenSocket, F_SETFL, fcntl(listenSocket, F_GETFL, 0) | O_NONBLOCK)
+            != 0)
+        {
+          okay = TBX_FALSE;
+        }
+      }
+      /* Register the listen socket with the epoll instance. It's the only one without
+       * a connection in the event's data pointer.
+       */
+      if (okay == TBX_TRUE)
+      {
+        struct epoll_event epollEvent = { .events = EPOLLIN, .data.ptr = NULL };
+        if (epoll_ctl(tpCtx->tcpEpollFd, EPOLL_CTL_ADD, listenSocket, &epollEvent) != 0)
+        {
+          okay = TBX_FALSE;
+        }
+      }
+      /* Store the listen socket if all went okay. */
+      if (okay == TBX_TRUE)
+      {
+        tpCtx->tcpListenSocket = listenSocket;
+      }
+      /* Clean up in case of a problem. A new attempt is made during a later poll. */
+      else
+      {
+        (void)close(listenSocket);
+      }
+    }
+  }
+} /*** end of TbxMbTcpServerListen ***/
+
+
+/************************************************************************************//**
+** \brief     Accepts all pending connection requests of clients.
+** \param     tpCtx Pointer to the TCP transport layer context.
+**
+****************************************************************************************/
+static void TbxMbTcpServerAccept(tTbxMbTpCtx * tpCtx)
+{
+  uint8_t keepAccepting = TBX_TRUE;
+
+  /* Verify parameters. */
+  TBX_ASSERT(tpCtx != NULL);
+
+  /* Only continue with valid parameters. */
+  if (tpCtx != NULL)
+  {
+    /* Keep accepting until there are no more pending connection requests. */
+    while (keepAccepting == TBX_TRUE)
+    {
+      /* Accept a pending connection request. Note that this does not block, because
+       * the listen socket was configured for non-blocking operation.
+       */
+      int32_t newSocket = accept(tpCtx->tcpListenSocket, NULL, NULL);
+      /* No more pending connection requests? */
+      if (newSocket < 0)
+      {
+        keepAccepting = TBX_FALSE;
+      }
+      /* Maximum number of connections reached? */
+      else if (TbxListGetSize(tpCtx->tcpConnList) >= TBX_MB_TCP_SERVER_MAX_CONNS)
+      {
+        /* Refuse the connection by closing it right away. */
+        (void)close(newSocket);
+      }
+      /* Register the new connection. */
+      else
+      {
+        /* Allocate memory for the new connection. */
+        tTbxMbTcpConn * newConn = TbxMemPoolAllocate(sizeof(tTbxMbTcpConn));
+        /* Automatically increase the memory pool, if it was too small. */
+        if (newConn == NULL)
+        {
+          /* No need to check the return value, because if it failed, the following
+           * allocation fails too, which is verified later on.
+           */
+          (void)TbxMemPoolCreate(1U, sizeof(tTbxMbTcpConn));
+          newConn = TbxMemPoolAllocate(sizeof(tTbxMbTcpConn));
+        }
+        uint8_t okay = (newConn != NULL) ? TBX_TRUE : TBX_FALSE;
+        /* Initialize the connection and register it with the epoll instance. */
+        if (okay == TBX_TRUE)
+        {
+          newConn->socket = newSocket;
+          newConn->rxAduWrIdx = 0U;
+          newConn->rxPacket = NULL;
+          newConn->busy = TBX_FALSE;
+          newConn->closed = TBX_FALSE;
+          /* Configure the socket for Modbus TCP communication. */
+          TbxMbTcpConfigureSocket(newSocket);
+          struct epoll_event epollEvent = { .events = EPOLLIN, .data.ptr = newConn };
+          if (epoll_ctl(tpCtx->tcpEpollFd, EPOLL_CTL_ADD, newSocket, &epollEvent) != 0)
+          {
+            okay = TBX_FALSE;
+          }
+        }
+        /* Add it to the list with connections. */
+        if (okay == TBX_TRUE)
+        {
+          if (TbxListInsertItemBack(tpCtx->tcpConnList, newConn) != TBX_OK)
+          {
+            (void)epoll_ctl(tpCtx->tcpEpollFd, EPOLL_CTL_DEL, newSocket, NULL);
+            okay = TBX_FALSE;
+          }
+        }
+        /* Clean up in case of a problem. */
+        if (okay == TBX_FALSE)
+        {
+          (void)close(newSocket);
+          if (newConn != NULL)
+          {
+            TbxMemPoolRelease(newConn);
+          }
+        }
+      }
+    }
+  }
+} /*** end of TbxMbTcpServerAccept ***/
+
+
+/************************************************************************************//**
+** \brief     Reads newly received data from a client's connection socket. The MBAP
+**            header is first received into the connection itself. Once complete, a
+**            packet buffer is borrowed from a memory pool to receive the remainder of
+**            the ADU into. Once the ADU is complete, the request is queued for
+**            processing by the linked channel and the reception on this connection is
+**            paused until its response was transmitted.
+** \param     tpCtx Pointer to the TCP transport layer context.
+** \param     conn Pointer to the connection.
+**
+****************************************************************************************/
+static void TbxMbTcpServerReceive(tTbxMbTpCtx   * tpCtx,
+                                  tTbxMbTcpConn * conn)
+{
+  uint8_t keepReading = TBX_TRUE;
+
+  /* Verify parameters. */
+  TBX_ASSERT((tpCtx != NULL) && (conn != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((tpCtx != NULL) && (conn != NULL))
+  {
+    /* Keep reading until all currently available data of this ADU is read. */
+    while (keepReading == TBX_TRUE)
+    {
+      /* Determine where to store the data and the total length of the ADU. As long as
+       * the MBAP header is not yet complete, only the header is requested.
+       * Afterwards, its length field tells how many more bytes follow the length field.
+       */
+      uint8_t * aduPtr = &conn->head[0];
+      uint16_t  aduLen = TBX_MB_TCP_MBAP_LEN;
+      if (conn->rxPacket != NULL)
+      {
+        aduPtr = &conn->rxPacket->head[0];
+        aduLen = (TBX_MB_TCP_MBAP_LEN - 1U) + TbxMbCommonExtractUInt16BE(&conn->head[4]);
+      }
+      /* Attempt to read the remaining bytes. Note that the socket was configured for
+       * non-blocking operation.
+       */
+      ssize_t rxCnt = recv(conn->socket, &aduPtr[conn->rxAduWrIdx],
+                           (size_t)aduLen - conn->rxAduWrIdx, 0);
+      /* Newly received data? */
+      if (rxCnt > 0)
+      {
+        /* Update the write indexer into the ADU. */
+        conn->rxAduWrIdx += (uint16_t)rxCnt;
+        /* Did the MBAP header just become complete? */
+        if ( (conn->rxAduWrIdx == TBX_MB_TCP_MBAP_LEN) && (conn->rxPacket == NULL) )
+        {
+          /* Check the MBAP header's protocol identifier and the length field. The
+           * length field includes the unit identifier and the function code, so it
+           * must be at least two. The PDU must also fit in the reception packet.
+           */
+          uint16_t protocolId = TbxMbCommonExtractUInt16BE(&conn->head[2]);
+          uint16_t lengthField = TbxMbCommonExtractUInt16BE(&conn->head[4]);
+          if ( (protocolId != TBX_MB_TCP_PROTOCOL_ID) || (lengthField < 2U) ||
+               (lengthField > (TBX_MB_TP_PDU_MAX_LEN + 1U)) )
+          {
+            /* Increment the total number of received packets with a communication
+             * error.
+             */
+            tpCtx->diagInfo.busCommErrCnt++;
+            /* There is no way to find the start of the next ADU in the data stream.
+             * Close the connection, such that the client can resynchronize by
+             * reconnecting.
+             */
+            TbxMbTcpServerClose(tpCtx, conn);
+            keepReading = TBX_FALSE;
+          }
+          /* Valid MBAP header. */
+          else
+          {
+            /* Borrow a packet buffer to receive the PDU into. */
+            conn->rxPacket = TbxMemPoolAllocate(sizeof(tTbxMbTpPacket));
+            /* Automatically increase the memory pool, if it was too small. */
+            if (conn->rxPacket == NULL)
+            {
+              /* No need to check the return value, because if it failed, the
+               * following allocation fails too, which is verified later on.
+               */
+              (void)TbxMemPoolCreate(1U, sizeof(tTbxMbTpPacket));
+              conn->rxPacket = TbxMemPoolAllocate(sizeof(tTbxMbTpPacket));
+            }
+            /* Verify memory allocation of the packet buffer. */
+            TBX_ASSERT(conn->rxPacket != NULL);
+            /* Only continue if the memory allocation succeeded. */
+            if (conn->rxPacket != NULL)
+            {
+              /* Copy the MBAP header right in front of the PDU. */
+              for (uint8_t idx = 0U; idx < TBX_MB_TCP_MBAP_LEN; idx++)
+              {
+                conn->rxPacket->head[idx] = conn->head[idx];
+              }
+            }
+            /* Not possible to receive the request. Drop the connection. */
+            else
+            {
+              TbxMbTcpServerClose(tpCtx, conn);
+              keepReading = TBX_FALSE;
+            }
+          }
+        }
+        /* Did the ADU just become complete? */
+        else if (conn->rxAduWrIdx == aduLen)
+        {
+          /* Reset the write indexer for the next ADU and stop reading, because the
+           * request is about to be queued.
+           */
+          conn->rxAduWrIdx = 0U;
+          keepReading = TBX_FALSE;
+          /* Packet reception complete. Set the PDU data length field. This is the
+           * length of the ADU, minus:
+           * - MBAP header (7 bytes)
+           * - Function code (1 byte)
+           */
+          conn->rxPacket->dataLen = (uint8_t)(aduLen - (TBX_MB_TCP_MBAP_LEN + 1U));
+          /* Also store the unit identifier in the packet's node element. That's were
+           * channels expect it. It's in the last byte of the MBAP header.
+           */
+          conn->rxPacket->node = conn->head[TBX_MB_TCP_MBAP_LEN - 1U];
+          /* Increment the total number of received packets. A server processes all
+           * requests, regardless of the unit identifier, so these also count as
+           * received packets that were addressed to us.
+           */
+          tpCtx->diagInfo.busMsgCnt++;
+          tpCtx->diagInfo.srvMsgCnt++;
+          /* Pause the reception on this connection, until its response was
+           * transmitted. Only hang-ups and errors are still reported.
+           */
+          struct epoll_event epollEvent = { .events = 0U, .data.ptr = conn };
+          (void)epoll_ctl(tpCtx->tcpEpollFd, EPOLL_CTL_MOD, conn->socket, &epollEvent);
+          /* Queue the request for processing by the channel. */
+          conn->busy = TBX_TRUE;
+          if (TbxListInsertItemBack(tpCtx->tcpReadyList, conn) != TBX_OK)
+          {
+            /* Not possible to queue the request. Drop the connection. */
+            conn->busy = TBX_FALSE;
+            tpCtx->diagInfo.srvNoRespCnt++;
+            TbxMbTcpServerClose(tpCtx, conn);
+          }
+        }
+        else
+        {
+          /* Nothing left to do, but MISRA requires this terminating else statement. */
+        }
+      }
+      /* Connection closed by the client? */
+      else if (rxCnt == 0)
+      {
+        TbxMbTcpServerClose(tpCtx, conn);
+        keepReading = TBX_FALSE;
+      }
+      /* No more data available at this point or an error occurred. */
+      else
+      {
+        keepReading = TBX_FALSE;
+        /* Close the connection, unless it was just a matter of no data being available
+         * yet or an interrupted system call.
+         */
+        if ( (errno != EAGAIN) && (errno != EWOULDBLOCK) && (errno != EINTR) )
+        {
+          TbxMbTcpServerClose(tpCtx, conn);
+        }
+      }
+    }
+  }
+} /*** end of TbxMbTcpServerReceive ***/
+
+
+/************************************************************************************//**
+** \brief     Passes the request at the front of the queue on to the linked server
+**            channel for processing, if the channel is not busy processing another one.
+** \param     tpCtx Pointer to the TCP transport layer context.
+**
+****************************************************************************************/
+static void TbxMbTcpServerDispatch(tTbxMbTpCtx * tpCtx)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(tpCtx != NULL);
+
+  /* Only continue with valid parameters. */
+  if (tpCtx != NULL)
+  {
+    /* The channel processes one request at a time. It's done once its response was
+     * transmitted.
+     */
+    TbxCriticalSectionEnter();
+    uint8_t stateCopy = tpCtx->state;
+    TbxCriticalSectionExit();
+    tTbxMbTcpConn * conn = TbxListGetFirstItem(tpCtx->tcpReadyList);
+    if ( (stateCopy == TBX_MB_TCP_STATE_IDLE) && (tpCtx->tcpTxConn == NULL) &&
+         (conn != NULL) )
+    {
+      /* Store the transaction identifier and unit identifier, such that they can be
+       * echoed in the response.
+       */
+      tpCtx->tcpTransId = TbxMbCommonExtractUInt16BE(&conn->head[0]);
+      tpCtx->txPacket.node = conn->rxPacket->node;
+      /* Transition to the VALIDATION state. This gives the channel access to the
+       * request at the front of the queue.
+       */
+      TbxCriticalSectionEnter();
+      tpCtx->state = TBX_MB_TCP_STATE_VALIDATION;
+      TbxCriticalSectionExit();
+      /* Post an event to the linked channel for further processing of the PDU.*/
+      tTbxMbEvent pduRxEvent;
+      pduRxEvent.context = tpCtx->channelCtx;
+      pduRxEvent.id = TBX_MB_EVENT_ID_PDU_RECEIVED;
+      TbxMbEventPost(&pduRxEvent, TBX_FALSE);
+    }
+  }
+} /*** end of TbxMbTcpServerDispatch ***/
+
+
+/************************************************************************************//**
+** \brief     Closes a client's connection. If the connection has a request that is
+**            queued or being processed, only its socket is closed. The connection itself
+**            is then released after the response cycle completed.
+** \param     tpCtx Pointer to the TCP transport layer context.
+** \param     conn Pointer to the connection.
+**
+****************************************************************************************/
+static void TbxMbTcpServerClose(tTbxMbTpCtx   * tpCtx,
+                                tTbxMbTcpConn * conn)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((tpCtx != NULL) && (conn != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((tpCtx != NULL) && (conn != NULL))
+  {
+    /* Close the socket, if not yet done. Closing it also removes it from the epoll
+     * instance.
+     */
+    if (conn->socket != TBX_MB_TCP_INVALID_SOCKET)
+    {
+      (void)epoll_ctl(tpCtx->tcpEpollFd, EPOLL_CTL_DEL, conn->socket, NULL);
+      (void)close(conn->socket);
+      conn->socket = TBX_MB_TCP_INVALID_SOCKET;
+    }
+    /* Still referenced by the request queue or the response transmission? */
+    if (conn->busy == TBX_TRUE)
+    {
+      /* Flag it, such that it's released after the response cycle completed. */
+      conn->closed = TBX_TRUE;
+    }
+    /* Not referenced, so it can be released right away. */
+    else
+    {
+      TbxListRemoveItem(tpCtx->tcpConnList, conn);
+      if (conn->rxPacket != NULL)
+      {
+        TbxMemPoolRelease(conn->rxPacket);
+      }
+      TbxMemPoolRelease(conn);
+    }
+  }
+} /*** end of TbxMbTcpServerClose ***/
+
+
+/************************************************************************************//**
+** \brief     Hands the data over to the TCP/IP stack for transmission on the specified
+**            socket. The socket operates in non-blocking mode, so it might not accept
+**            all data at once. In this case it waits, with a timeout, for the socket to
+**            accept more data.
+** \param     socketFd Socket descriptor of the connection.
+** \param     data Byte array with data to transmit.
+** \param     len Number of bytes to transmit.
+** \return    TBX_OK if successful, TBX_ERROR otherwise.
+**
+****************************************************************************************/
+static uint8_t TbxMbTcpSend(int32_t                socketFd,
+                            uint8_t        const * data,
+                            uint16_t               len)
+{
+  uint8_t  result = TBX_OK;
+  uint16_t txIdx = 0U;
+
+  /* Verify parameters. */
+  TBX_ASSERT((socketFd >= 0) && (data != NULL) && (len > 0U));
+
+  /* Only continue with valid parameters. */
+  if ((socketFd >= 0) && (data != NULL) && (len > 0U))
+  {
+    /* Keep sending until all data is handed over or an error occurred. */
+    while ((txIdx < len) && (result == TBX_OK))
+    {
+      ssize_t txCnt = send(socketFd, &data[txIdx], (size_t)len - txIdx,
+                           TBX_MB_TCP_SEND_FLAGS);
+      /* Data accepted by the TCP/IP stack? */
+      if (txCnt > 0)
+      {
+        txIdx += (uint16_t)txCnt;
+      }
+      /* Transmit buffer of the socket currently full? */
+      else if ( (txCnt < 0) && ((errno == EAGAIN) || (errno == EWOULDBLOCK)) )
+      {
+        /* Wait for the socket to become writable again. */
+        struct pollfd pollFd = { .fd = socketFd, .events = POLLOUT, .revents = 0 };
+        if (poll(&pollFd, 1U, (int)TBX_MB_TCP_TIMEOUT_MS) != 1)
+        {
+          result = TBX_ERROR;
+        }
+      }
+      /* Interrupted system call? */
+      else if ( (txCnt < 0) && (errno == EINTR) )
+      {
+        /* Just try again. */
+      }
+      /* Unrecoverable error. */
+      else
+      {
+        result = TBX_ERROR;
+      }
+    }
+  }
+  /* Invalid parameters. */
+  else
+  {
+    result = TBX_ERROR;
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbTcpSend ***/
+
+
+/************************************************************************************//**
+** \brief     Configures a newly created connection socket for non-blocking operation
+**            and disables the Nagle algorithm. Modbus TCP communication consists of
+**            small request and response packets, where delaying the transmission to
+**            combine them into larger TCP segments only adds latency.
+** \param     socketFd Socket descriptor of the connection.
+**
+****************************************************************************************/
+static void TbxMbTcpConfigureSocket(int32_t socketFd)
+{
+  int optValue = 1;
+
+  /* Verify parameters. */
+  TBX_ASSERT(socketFd >= 0);
+
+  /* Only continue with valid parameters. */
+  if (socketFd >= 0)
+  {
+    /* Configure the socket for non-blocking operation. */
+    (void)fcntl(socketFd, F_SETFL, fcntl(socketFd, F_GETFL, 0) | O_NONBLOCK);
+    /* Disable the Nagle algorithm. */
+    (void)setsockopt(socketFd, IPPROTO_TCP, TCP_NODELAY, &optValue, sizeof(optValue));
+  }
+} /*** end of TbxMbTcpConfigureSocket ***/
+
+
+/************************************************************************************//**
+** \brief     Creates the wake-up event file descriptor and starts the reactor thread of
+**            a TCP transport layer that owns its connection. The reactor thread starts
+**            out armed, so it immediately waits for I/O events on the sockets.
+** \param     tpCtx Pointer to the TCP transport layer context.
+** \return    TBX_TRUE if the reactor thread is running, TBX_FALSE otherwise.
+**
+****************************************************************************************/
+static uint8_t TbxMbTcpReactorStart(tTbxMbTpCtx * tpCtx)
+{
+  uint8_t result = TBX_FALSE;
+
+  /* Verify parameters. */
+  TBX_ASSERT(tpCtx != NULL);
+
+  /* Only continue with valid parameters. */
+  if (tpCtx != NULL)
+  {
+    /* Allocate memory for the reactor. */
+    tTbxMbTcpReactor * newReactor = TbxMemPoolAllocate(sizeof(tTbxMbTcpReactor));
+    /* Automatically increase the memory pool, if it was too small. */
+    if (newReactor == NULL)
+    {
+      /* No need to check the return value, because if it failed, the following
+       * allocation fails too, which is verified later on.
+       */
+      (void)TbxMemPoolCreate(1U, sizeof(tTbxMbTcpReactor));
+      newReactor = TbxMemPoolAllocate(sizeof(tTbxMbTcpReactor));
+    }
+    /* Only continue if the memory allocation succeeded. */
+    if (newReactor != NULL)
+    {
+      /* Initialize the reactor and create its wake-up event file descriptor. */
+      newReactor->stop = TBX_FALSE;
+      newReactor->wakeFd = eventfd(0U, 0);
+      if (newReactor->wakeFd >= 0)
+      {
+        /* Store it before starting the thread, because the thread accesses it. */
+        tpCtx->tcpReactor = newReactor;
+        if (pthread_create(&newReactor->thread, NULL, TbxMbTcpReactorThread,
+                           tpCtx) == 0)
+        {
+          result = TBX_TRUE;
+        }
+        /* Clean up in case of a problem. */
+        else
+        {
+          tpCtx->tcpReactor = NULL;
+          (void)close(newReactor->wakeFd);
+        }
+      }
+      /* Give the memory back to the pool in case of a problem. */
+      if (result == TBX_FALSE)
+      {
+        TbxMemPoolRelease(newReactor);
+      }
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbTcpReactorStart ***/
+
+
+/************************************************************************************//**
+** \brief     Stops the reactor thread of a TCP transport layer, if it has one, and
+**            releases its resources. Should be called before closing the epoll
+**            instance that the reactor thread waits on.
+** \param     tpCtx Pointer to the TCP transport layer context.
+**
+****************************************************************************************/
+static void TbxMbTcpReactorStop(tTbxMbTpCtx * tpCtx)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(tpCtx != NULL);
+
+  /* Only continue with valid parameters. */
+  if (tpCtx != NULL)
+  {
+    tTbxMbTcpReactor * reactor = tpCtx->tcpReactor;
+    /* Only continue if the transport layer has a reactor thread. */
+    if (reactor != NULL)
+    {
+      uint64_t wakeCnt = 1U;
+      /* Request the reactor thread to stop and wake it up. */
+      TbxCriticalSectionEnter();
+      reactor->stop = TBX_TRUE;
+      TbxCriticalSectionExit();
+      (void)write(reactor->wakeFd, &wakeCnt, sizeof(wakeCnt));
+      /* Wait for the reactor thread to terminate. */
+      (void)pthread_join(reactor->thread, NULL);
+      /* Release its resources. */
+      (void)close(reactor->wakeFd);
+      tpCtx->tcpReactor = NULL;
+      TbxMemPoolRelease(reactor);
+    }
+  }
+} /*** end of TbxMbTcpReactorStop ***/
+
+
+/************************************************************************************//**
+** \brief     Signals the reactor thread that the poll function is done with the
+**            sockets. The reactor thread then waits for new I/O events on the sockets
+**            again.
+** \param     tpCtx Pointer to the TCP transport layer context.
+**
+****************************************************************************************/
+static void TbxMbTcpReactorRearm(tTbxMbTpCtx * tpCtx)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(tpCtx != NULL);
+
+  /* Only continue with valid parameters. */
+  if (tpCtx != NULL)
+  {
+    tTbxMbTcpReactor * reactor = tpCtx->tcpReactor;
+    /* Only continue if the transport layer has a reactor thread. */
+    if (reactor != NULL)
+    {
+      uint64_t wakeCnt = 1U;
+      /* Wake up the reactor thread. */
+      (void)write(reactor->wakeFd, &wakeCnt, sizeof(wakeCnt));
+    }
+  }
+} /*** end of TbxMbTcpReactorRearm ***/
+
+
+/************************************************************************************//**
+** \brief     Reactor thread of a TCP transport layer that owns its connection. While
+**            armed, it sleeps until either an I/O event is pending on one of the
+**            sockets, registered with the epoll instance, or until it's woken up. Upon
+**            an I/O event, it disarms itself and posts an event to have the event task
+**            start calling the poll function. The poll function stops the polling again
+**            once it's done with the sockets and then wakes up the reactor thread to
+**            rearm it. While disarmed, it only sleeps until it's woken up. This prevents
+**            the pending I/O events from waking up the reactor thread over and over
+**            again, before the poll function got a chance to process them.
+** \param     arg Pointer to the TCP transport layer context.
+** \return    Always NULL.
+**
+****************************************************************************************/
+static void * TbxMbTcpReactorThread(void * arg)
+{
+  tTbxMbTpCtx      * tpCtx = (tTbxMbTpCtx *)arg;
+  tTbxMbTcpReactor * reactor = tpCtx->tcpReactor;
+  uint8_t            armed = TBX_TRUE;
+  uint8_t            running = TBX_TRUE;
+
+  /* Keep running until requested to stop. */
+  while (running == TBX_TRUE)
+  {
+    /* Always wait for a wake-up. Only wait for I/O events on the sockets while armed.
+     * Note that an epoll instance itself becomes readable when I/O events are pending.
+     */
+    struct pollfd pollFds[2] =
+    {
+      { .fd = reactor->wakeFd, .events = POLLIN, .revents = 0 },
+      { .fd = tpCtx->tcpEpollFd, .events = POLLIN, .revents = 0 }
+    };
+    nfds_t pollFdCnt = (armed == TBX_TRUE) ? 2U : 1U;
+    int pollResult = poll(pollFds, pollFdCnt, -1);
+    /* Woken up? */
+    if ( (pollResult > 0) && ((pollFds[0].revents & POLLIN) != 0) )
+    {
+      uint64_t wakeCnt;
+      /* Reset the wake-up event file descriptor and rearm. */
+      (void)read(reactor->wakeFd, &wakeCnt, sizeof(wakeCnt));
+      armed = TBX_TRUE;
+      /* Check if the thread should stop. */
+      TbxCriticalSectionEnter();
+      if (reactor->stop == TBX_TRUE)
+      {
+        running = TBX_FALSE;
+      }
+      TbxCriticalSectionExit();
+    }
+    /* I/O events pending on one of the sockets? */
+    else if ( (pollResult > 0) && ((pollFds[1].revents & POLLIN) != 0) )
+    {
+      /* Disarm until the poll function is done with the sockets. */
+      armed = TBX_FALSE;
+      /* Instruct the event task to start calling the poll function. */
+      tTbxMbEvent newEvent = {.context = tpCtx, .id = TBX_MB_EVENT_ID_START_POLLING};
+      TbxMbEventPost(&newEvent, TBX_FALSE);
+    }
+    /* Unrecoverable error? An interrupted system call is simply tried again. */
+    else if ( (pollResult < 0) && (errno != EINTR) )
+    {
+      running = TBX_FALSE;
+    }
+    else
+    {
+      /* Nothing left to do, but MISRA requires this terminating else statement. */
+    }
+  }
+  /* The thread's return value is not used. */
+  return NULL;
+} /*** end of TbxMbTcpReactorThread ***/
+
+
+/*********************************** end of tbxmb_tcp.c ********************************/
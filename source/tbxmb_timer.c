@@ -0,0 +1,631 @@
+/************************************************************************************//**
+* \file         tbxmb_timer.c
+* \brief        Modbus timer wheel source file.
+* \internal
+*----------------------------------------------------------------------------------------
+*                          C O P Y R I G H T
+*----------------------------------------------------------------------------------------
+*   Copyright (c) 2023 by Feaser     www.feaser.com     All rights reserved
+*
+*----------------------------------------------------------------------------------------
+*                            L I C E N S E
+*----------------------------------------------------------------------------------------
+*
+* SPDX-License-Identifier: GPL-3.0-or-later
+*
+* This file is part of MicroTBX-Modbus. MicroTBX-Modbus is free software: you can
+* redistribute it and/or modify it under the terms of the GNU General Public License as
+* published by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* MicroTBX-Modbus is distributed in the hope that it will be useful, but WITHOUT ANY
+* WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+* PARTICULAR PURPOSE. See the GNU General Public License for more details.
+*
+* You have received a copy of the GNU General Public License along with MicroTBX-Modbus.
+* If not, see www.gnu.org/licenses/.
+*
+* \endinternal
+****************************************************************************************/
+
+/****************************************************************************************
+* Include files
+****************************************************************************************/
+#include "microtbx.h"                            /* MicroTBX module                    */
+#include "microtbxmodbus.h"                      /* MicroTBX-Modbus module             */
+#include "tbxmb_timer_private.h"                 /* MicroTBX-Modbus timer private      */
+
+
+/****************************************************************************************
+* Macro definitions
+****************************************************************************************/
+/** \brief Bit mask to obtain the slot index from the shifted timer tick count. */
+#define TBX_MB_TIMER_SLOT_MASK         (TBX_MB_TIMER_LEVEL_SLOTS - 1U)
+
+/** \brief Number of ticks covered by one slot of the second level. */
+#define TBX_MB_TIMER_LEVEL1_TICKS      (1U << TBX_MB_TIMER_LEVEL_BITS)
+
+/** \brief Number of ticks covered by one slot of the third level. */
+#define TBX_MB_TIMER_LEVEL2_TICKS      (1U << (2U * TBX_MB_TIMER_LEVEL_BITS))
+
+/** \brief Level value of a timer that sits in the list with expired timers. */
+#define TBX_MB_TIMER_LEVEL_EXPIRED     (TBX_MB_TIMER_LEVELS)
+
+/** \brief Maximum number of ticks that the wheel time can be ahead of the current time.
+ *         It is ahead, when a timer was armed after the caller of TbxMbTimerExpired()
+ *         read the current time. A wheel time that is further ahead, actually lags
+ *         behind by more than the 32767 ticks that a signed 16-bit calculation can
+ *         represent. Only a lag of up to 49151 ticks can be detected like this.
+ *         A longer one wraps around and looks like a regular lag.
+ */
+#define TBX_MB_TIMER_LEAD_MAX          (16384U)
+
+
+/****************************************************************************************
+* Function prototypes
+****************************************************************************************/
+static void     TbxMbTimerInsert (tTbxMbTimerWheel       * wheel,
+                                  tTbxMbTimer            * timer);
+
+static void     TbxMbTimerCascade(tTbxMbTimerWheel       * wheel,
+                                  uint8_t                  level);
+
+static uint16_t TbxMbTimerSkipTo (tTbxMbTimerWheel const * wheel,
+                                  uint16_t                 now);
+
+static void     TbxMbTimerResync (tTbxMbTimerWheel       * wheel,
+                                  uint16_t                 now);
+
+
+/************************************************************************************//**
+** \brief     Initializes the timer wheel, such that it holds no timers.
+** \param     wheel Pointer to the timer wheel.
+**
+****************************************************************************************/
+void TbxMbTimerWheelInit(tTbxMbTimerWheel * wheel)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(wheel != NULL);
+
+  /* Only continue with valid parameters. */
+  if (wheel != NULL)
+  {
+    /* Empty all the slots of all the levels. */
+    for (uint8_t level = 0U; level < TBX_MB_TIMER_LEVELS; level++)
+    {
+      for (uint8_t slot = 0U; slot < TBX_MB_TIMER_LEVEL_SLOTS; slot++)
+      {
+        wheel->slots[level][slot] = NULL;
+      }
+      wheel->levelCnt[level] = 0U;
+    }
+    /* Reset the other members. */
+    wheel->expired = NULL;
+    wheel->count = 0U;
+    wheel->time = 0U;
+  }
+} /*** end of TbxMbTimerWheelInit ***/
+
+
+/************************************************************************************//**
+** \brief     Initializes a timer, such that it can be armed in a timer wheel. Call this
+**            function once, before the timer is used for the first time.
+** \param     timer Pointer to the timer.
+** \param     context Opaque pointer to the owner of the timer. The timer wheel does not
+**            use it. It is meant for the one that handles the expired timer.
+**
+****************************************************************************************/
+void TbxMbTimerInit(tTbxMbTimer * timer,
+                    void        * context)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(timer != NULL);
+
+  /* Only continue with valid parameters. */
+  if (timer != NULL)
+  {
+    /* Initialize the timer as not armed. */
+    timer->next = NULL;
+    timer->prevNext = NULL;
+    timer->context = context;
+    timer->deadline = 0U;
+    timer->level = 0U;
+  }
+} /*** end of TbxMbTimerInit ***/
+
+
+/************************************************************************************//**
+** \brief     Arms the timer, such that it expires at the specified deadline. If the
+**            timer was already armed, its old deadline no longer applies. This
+**            operation takes constant time, regardless of the number of armed timers.
+** \param     wheel Pointer to the timer wheel.
+** \param     timer Pointer to the timer.
+** \param     deadline Free running timer tick count at which the timer expires. A
+**            deadline that already passed, expires during the next timer tick. The
+**            deadline can be at most 32767 ticks ahead of the current time.
+**
+****************************************************************************************/
+void TbxMbTimerArm(tTbxMbTimerWheel * wheel,
+                   tTbxMbTimer      * timer,
+                   uint16_t           deadline)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((wheel != NULL) && (timer != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((wheel != NULL) && (timer != NULL))
+  {
+    /* Remove the timer from the wheel, in case it is already armed. */
+    TbxMbTimerCancel(wheel, timer);
+    /* When the wheel holds no timers, its time is only up-to-date right after a call
+     * to TbxMbTimerExpired(). Otherwise synchronize it to the current timer tick.
+     */
+    if (wheel->count == 0U)
+    {
+      uint16_t now = TbxMbPortTimerCount();
+      if (wheel->time != (uint16_t)(now + 1U))
+      {
+        wheel->time = now;
+      }
+    }
+    /* Store the deadline and add the timer to the slot that matches it. */
+    timer->deadline = deadline;
+    TbxMbTimerInsert(wheel, timer);
+    wheel->count++;
+  }
+} /*** end of TbxMbTimerArm ***/
+
+
+/************************************************************************************//**
+** \brief     Cancels the timer, such that it does not expire. Nothing happens if the
+**            timer is not armed. This operation takes constant time, regardless of the
+**            number of armed timers.
+** \param     wheel Pointer to the timer wheel.
+** \param     timer Pointer to the timer.
+**
+****************************************************************************************/
+void TbxMbTimerCancel(tTbxMbTimerWheel * wheel,
+                      tTbxMbTimer      * timer)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((wheel != NULL) && (timer != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((wheel != NULL) && (timer != NULL))
+  {
+    /* Only an armed timer links back to the list it is in. */
+    if (timer->prevNext != NULL)
+    {
+      /* Unlink the timer from its list. */
+      *(timer->prevNext) = timer->next;
+      if (timer->next != NULL)
+      {
+        timer->next->prevNext = timer->prevNext;
+      }
+      timer->next = NULL;
+      timer->prevNext = NULL;
+      /* Update the timer counters. */
+      if (timer->level < TBX_MB_TIMER_LEVELS)
+      {
+        wheel->levelCnt[timer->level]--;
+      }
+      wheel->count--;
+    }
+  }
+} /*** end of TbxMbTimerCancel ***/
+
+
+/************************************************************************************//**
+** \brief     Determines if the timer is armed. Note that a timer that expired, but was
+**            not yet handed out by TbxMbTimerExpired(), still counts as armed.
+** \param     timer Pointer to the timer.
+** \return    TBX_TRUE if the timer is armed, TBX_FALSE otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbTimerIsArmed(tTbxMbTimer const * timer)
+{
+  uint8_t result = TBX_FALSE;
+
+  /* Verify parameters. */
+  TBX_ASSERT(timer != NULL);
+
+  /* Only continue with valid parameters. */
+  if (timer != NULL)
+  {
+    /* Only an armed timer links back to the list it is in. */
+    if (timer->prevNext != NULL)
+    {
+      result = TBX_TRUE;
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbTimerIsArmed ***/
+
+
+/************************************************************************************//**
+** \brief     Advances the time of the timer wheel up to and including the specified
+**            timer tick and hands out the next timer that expired. Call this function
+**            repeatedly until it returns NULL, to obtain all expired timers. A handed
+**            out timer is no longer armed. It's okay to arm it again right away. Even
+**            with a deadline that already passed, it is not handed out again before
+**            the next timer tick.
+** \attention While timers are armed, call this function at least once every 32767
+**            ticks. The wheel time can otherwise no longer be compared with the current
+**            time. Should it happen anyway, all armed timers are overdue. They are then
+**            handed out right away and the wheel time is resynchronized.
+** \param     wheel Pointer to the timer wheel.
+** \param     now Current free running timer tick count.
+** \return    Pointer to the expired timer or NULL if no timer expired.
+**
+****************************************************************************************/
+tTbxMbTimer * TbxMbTimerExpired(tTbxMbTimerWheel * wheel,
+                                uint16_t           now)
+{
+  tTbxMbTimer * result = NULL;
+
+  /* Verify parameters. */
+  TBX_ASSERT(wheel != NULL);
+
+  /* Only continue with valid parameters. */
+  if (wheel != NULL)
+  {
+    /* Determine how far the wheel time lags behind the current time. If it seems to be
+     * too far ahead, it actually lags behind by more than 32767 ticks. This means that
+     * this function was not called for too long.
+     */
+    int16_t lagTicks = (int16_t)(uint16_t)(now - wheel->time);
+    TBX_ASSERT((wheel->count == 0U) || (lagTicks >= -(int16_t)TBX_MB_TIMER_LEAD_MAX));
+    /* Recover by resynchronizing the wheel time, if needed. */
+    if ((wheel->count > 0U) && (lagTicks < -(int16_t)TBX_MB_TIMER_LEAD_MAX))
+    {
+      TbxMbTimerResync(wheel, now);
+    }
+    /* Process the timer ticks one by one, until one of them has expired timers or the
+     * wheel time passed the current time. Note that the signed calculation works, even
+     * if the timer counter overflowed.
+     */
+    while ( (wheel->expired == NULL) && (wheel->count > 0U) &&
+            ((int16_t)(uint16_t)(now - wheel->time) >= 0) )
+    {
+      /* Is this a slot boundary of the third level? If so, its timers move down. */
+      if ((wheel->time & (TBX_MB_TIMER_LEVEL2_TICKS - 1U)) == 0U)
+      {
+        TbxMbTimerCascade(wheel, 2U);
+      }
+      /* Is this a slot boundary of the second level? If so, its timers move down. */
+      if ((wheel->time & (TBX_MB_TIMER_LEVEL1_TICKS - 1U)) == 0U)
+      {
+        TbxMbTimerCascade(wheel, 1U);
+      }
+      /* The timers in the first level slot of this tick expired. Move the entire list
+       * over to the expired list, which is empty at this point.
+       */
+      uint8_t slot = (uint8_t)(wheel->time & TBX_MB_TIMER_SLOT_MASK);
+      tTbxMbTimer * timer = wheel->slots[0U][slot];
+      if (timer != NULL)
+      {
+        wheel->slots[0U][slot] = NULL;
+        wheel->expired = timer;
+        timer->prevNext = &wheel->expired;
+        /* Update the level of the moved timers. */
+        while (timer != NULL)
+        {
+          timer->level = TBX_MB_TIMER_LEVEL_EXPIRED;
+          wheel->levelCnt[0U]--;
+          timer = timer->next;
+        }
+      }
+      /* Continue with the next timer tick. Skip the ticks that can't have expired
+       * timers, to not spend time on them.
+       */
+      wheel->time = TbxMbTimerSkipTo(wheel, now);
+    }
+    /* Hand out the first timer from the list with expired timers, if any. */
+    result = wheel->expired;
+    if (result != NULL)
+    {
+      TbxMbTimerCancel(wheel, result);
+    }
+    /* Without armed timers, the wheel time is not advanced. Keep it up-to-date, such
+     * that the timers armed after this, don't expire at the current tick.
+     */
+    else if (wheel->count == 0U)
+    {
+      wheel->time = now + 1U;
+    }
+    else
+    {
+      /* Nothing left to do, but MISRA requires this terminating else statement. */
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbTimerExpired ***/
+
+
+/************************************************************************************//**
+** \brief     Determines the timer tick at which TbxMbTimerExpired() needs to be called
+**            next, which is the earliest deadline of all armed timers. For the higher
+**            levels, only the timers in the first non-empty slot need to be looked at
+**            and only if that slot starts before the earliest deadline found so far.
+** \param     wheel Pointer to the timer wheel.
+** \param     deadline Pointer to where the timer tick is stored.
+** \return    TBX_TRUE if the timer wheel holds armed timers and the deadline is valid,
+**            TBX_FALSE otherwise.
+**
+****************************************************************************************/
+uint8_t TbxMbTimerNext(tTbxMbTimerWheel const * wheel,
+                       uint16_t               * deadline)
+{
+  uint8_t result = TBX_FALSE;
+
+  /* Verify parameters. */
+  TBX_ASSERT((wheel != NULL) && (deadline != NULL));
+
+  /* Only continue with valid parameters and when there are armed timers. */
+  if ((wheel != NULL) && (deadline != NULL) && (wheel->count > 0U))
+  {
+    /* Update the result. */
+    result = TBX_TRUE;
+    /* Timers that already expired, are due right away. */
+    if (wheel->expired != NULL)
+    {
+      *deadline = (uint16_t)(wheel->time - 1U);
+    }
+    /* Find the earliest one of the first level deadline and the deadlines in the
+     * higher levels. The latter matter, because their timers cascade down and can
+     * expire before the ones that are already in the first level.
+     */
+    else
+    {
+      uint16_t earliest = 0U;
+      uint8_t  found = TBX_FALSE;
+      /* Timers in the first level? Find the first non-empty slot from the current
+       * one, while wrapping around.
+       */
+      if (wheel->levelCnt[0U] > 0U)
+      {
+        uint16_t ticks = 0U;
+        while (wheel->slots[0U][(wheel->time + ticks) & TBX_MB_TIMER_SLOT_MASK] == NULL)
+        {
+          ticks++;
+        }
+        earliest = wheel->time + ticks;
+        found = TBX_TRUE;
+      }
+      /* Find the first non-empty slot in each one of the higher levels. */
+      for (uint8_t level = 1U; level < TBX_MB_TIMER_LEVELS; level++)
+      {
+        uint8_t  shift = (uint8_t)(level * TBX_MB_TIMER_LEVEL_BITS);
+        uint16_t slotTicks = (uint16_t)(1U << shift);
+        /* Determine the first slot boundary at or after the current wheel time. */
+        uint16_t boundary = (uint16_t)((wheel->time + (slotTicks - 1U)) &
+                                       (uint16_t)(~(slotTicks - 1U)));
+        /* Only look at this level, if it holds timers. */
+        if (wheel->levelCnt[level] > 0U)
+        {
+          /* Find the first non-empty slot. */
+          while (wheel->slots[level][(boundary >> shift) & TBX_MB_TIMER_SLOT_MASK] ==
+                 NULL)
+          {
+            boundary += slotTicks;
+          }
+          /* Its timers expire before the ones in the other slots of this level, but not
+           * before the slot boundary. So only if the boundary comes before the earliest
+           * deadline found so far, its timers need to be looked at.
+           */
+          if ( (found == TBX_FALSE) ||
+               ((int16_t)(uint16_t)(boundary - earliest) < 0) )
+          {
+            /* Keep track of the earliest deadline. */
+            tTbxMbTimer const * timer =
+              wheel->slots[level][(boundary >> shift) & TBX_MB_TIMER_SLOT_MASK];
+            while (timer != NULL)
+            {
+              if ( (found == TBX_FALSE) ||
+                   ((int16_t)(uint16_t)(timer->deadline - earliest) < 0) )
+              {
+                earliest = timer->deadline;
+                found = TBX_TRUE;
+              }
+              timer = timer->next;
+            }
+          }
+        }
+      }
+      *deadline = earliest;
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbTimerNext ***/
+
+
+/************************************************************************************//**
+** \brief     Adds the timer to the slot that matches its deadline. The lowest level
+**            that covers the deadline, as seen from the current wheel time, holds it.
+** \param     wheel Pointer to the timer wheel.
+** \param     timer Pointer to the timer.
+**
+****************************************************************************************/
+static void TbxMbTimerInsert(tTbxMbTimerWheel * wheel,
+                             tTbxMbTimer      * timer)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((wheel != NULL) && (timer != NULL));
+
+  /* Only continue with valid parameters. */
+  if ((wheel != NULL) && (timer != NULL))
+  {
+    /* Calculate the number of ticks until the deadline. Note that this calculation
+     * works, even if the timer counter overflowed. A deadline that already passed, is
+     * handled as one for the current tick.
+     */
+    int16_t  deltaTicks = (int16_t)(uint16_t)(timer->deadline - wheel->time);
+    uint16_t expires = timer->deadline;
+    if (deltaTicks < 0)
+    {
+      deltaTicks = 0;
+      expires = wheel->time;
+    }
+    /* Select the level and the slot in that level. */
+    uint8_t level;
+    uint8_t slot;
+    if ((uint16_t)deltaTicks < TBX_MB_TIMER_LEVEL1_TICKS)
+    {
+      level = 0U;
+      slot = (uint8_t)(expires & TBX_MB_TIMER_SLOT_MASK);
+    }
+    else if ((uint16_t)deltaTicks < TBX_MB_TIMER_LEVEL2_TICKS)
+    {
+      level = 1U;
+      slot = (uint8_t)((expires >> TBX_MB_TIMER_LEVEL_BITS) & TBX_MB_TIMER_SLOT_MASK);
+    }
+    else
+    {
+      level = 2U;
+      slot = (uint8_t)((expires >> (2U * TBX_MB_TIMER_LEVEL_BITS)) &
+                       TBX_MB_TIMER_SLOT_MASK);
+    }
+    /* Add the timer to the front of the slot's list. */
+    timer->next = wheel->slots[level][slot];
+    if (timer->next != NULL)
+    {
+      timer->next->prevNext = &timer->next;
+    }
+    wheel->slots[level][slot] = timer;
+    timer->prevNext = &wheel->slots[level][slot];
+    timer->level = level;
+    wheel->levelCnt[level]++;
+  }
+} /*** end of TbxMbTimerInsert ***/
+
+
+/************************************************************************************//**
+** \brief     Moves the timers from the slot of the specified level, that belongs to the
+**            current wheel time, to the lower levels.
+** \param     wheel Pointer to the timer wheel.
+** \param     level Level of the slot to cascade.
+**
+****************************************************************************************/
+static void TbxMbTimerCascade(tTbxMbTimerWheel * wheel,
+                              uint8_t            level)
+{
+  /* Verify parameters. */
+  TBX_ASSERT((wheel != NULL) && (level > 0U) && (level < TBX_MB_TIMER_LEVELS));
+
+  /* Only continue with valid parameters. */
+  if ((wheel != NULL) && (level > 0U) && (level < TBX_MB_TIMER_LEVELS))
+  {
+    /* Detach the list from the slot. */
+    uint8_t slot = (uint8_t)((wheel->time >> (level * TBX_MB_TIMER_LEVEL_BITS)) &
+                             TBX_MB_TIMER_SLOT_MASK);
+    tTbxMbTimer * timer = wheel->slots[level][slot];
+    wheel->slots[level][slot] = NULL;
+    /* Add each timer again. Now that the wheel time is closer to its deadline, it ends
+     * up in a lower level.
+     */
+    while (timer != NULL)
+    {
+      tTbxMbTimer * nextTimer = timer->next;
+      wheel->levelCnt[level]--;
+      TbxMbTimerInsert(wheel, timer);
+      timer = nextTimer;
+    }
+  }
+} /*** end of TbxMbTimerCascade ***/
+
+
+/************************************************************************************//**
+** \brief     Determines the next timer tick that the timer wheel should process. Ticks
+**            without timers in their first level slot and without a slot boundary of a
+**            non-empty higher level, can be skipped.
+** \param     wheel Pointer to the timer wheel.
+** \param     now Current free running timer tick count.
+** \return    Next timer tick to process. Never beyond the one after the current tick.
+**
+****************************************************************************************/
+static uint16_t TbxMbTimerSkipTo(tTbxMbTimerWheel const * wheel,
+                                 uint16_t                 now)
+{
+  uint16_t result = 0U;
+
+  /* Verify parameters. */
+  TBX_ASSERT(wheel != NULL);
+
+  /* Only continue with valid parameters. */
+  if (wheel != NULL)
+  {
+    /* By default, continue with the next tick. */
+    result = wheel->time + 1U;
+    /* No timers in the first level? Then the next tick that matters is a slot boundary
+     * of a higher level that holds timers.
+     */
+    if (wheel->levelCnt[0U] == 0U)
+    {
+      uint16_t slotTicks = (wheel->levelCnt[1U] > 0U) ? TBX_MB_TIMER_LEVEL1_TICKS :
+                                                        TBX_MB_TIMER_LEVEL2_TICKS;
+      result = (uint16_t)((result + (slotTicks - 1U)) & (uint16_t)(~(slotTicks - 1U)));
+      /* Do not skip beyond the current tick. The timers that are armed after this,
+       * need the wheel time to be at most one tick ahead.
+       */
+      if ((int16_t)(uint16_t)(result - (uint16_t)(now + 1U)) > 0)
+      {
+        result = now + 1U;
+      }
+    }
+  }
+  /* Give the result back to the caller. */
+  return result;
+} /*** end of TbxMbTimerSkipTo ***/
+
+
+/************************************************************************************//**
+** \brief     Resynchronizes the wheel time to the current time, after it lagged behind
+**            by more than 32767 ticks. All armed timers are overdue at this point, so
+**            they all move to the list with expired timers.
+** \param     wheel Pointer to the timer wheel.
+** \param     now Current free running timer tick count.
+**
+****************************************************************************************/
+static void TbxMbTimerResync(tTbxMbTimerWheel * wheel,
+                             uint16_t           now)
+{
+  /* Verify parameters. */
+  TBX_ASSERT(wheel != NULL);
+
+  /* Only continue with valid parameters. */
+  if (wheel != NULL)
+  {
+    /* Move the timers of all slots of all levels to the list with expired timers. */
+    for (uint8_t level = 0U; level < TBX_MB_TIMER_LEVELS; level++)
+    {
+      for (uint8_t slot = 0U; slot < TBX_MB_TIMER_LEVEL_SLOTS; slot++)
+      {
+        tTbxMbTimer * timer = wheel->slots[level][slot];
+        wheel->slots[level][slot] = NULL;
+        /* Add each timer to the front of the list with expired timers. */
+        while (timer != NULL)
+        {
+          tTbxMbTimer * nextTimer = timer->next;
+          timer->next = wheel->expired;
+          if (timer->next != NULL)
+          {
+            timer->next->prevNext = &timer->next;
+          }
+          wheel->expired = timer;
+          timer->prevNext = &wheel->expired;
+          timer->level = TBX_MB_TIMER_LEVEL_EXPIRED;
+          timer = nextTimer;
+        }
+      }
+      wheel->levelCnt[level] = 0U;
+    }
+    /* The current tick is now processed. */
+    wheel->time = now + 1U;
+  }
+} /*** end of TbxMbTimerResync ***/
+
+
+/*********************************** end of tbxmb_timer.c ******************************/
@@ -0,0 +1,117 @@
+/************************************************************************************//**
+* \file         tbxmb_timer_private.h
+* \brief        Modbus timer wheel private header file.
+* \internal
+*----------------------------------------------------------------------------------------
+*                          C O P Y R I G H T
+*----------------------------------------------------------------------------------------
+*   Copyright (c) 2023 by Feaser     www.feaser.com     All rights reserved
+*
+*----------------------------------------------------------------------------------------
+*                            L I C E N S E
+*----------------------------------------------------------------------------------------
+*
+* SPDX-License-Identifier: GPL-3.0-or-later
+*
+* This file is part of MicroTBX-Modbus. MicroTBX-Modbus is free software: you can
+* redistribute it and/or modify it under the terms of the GNU General Public License as
+* published by the Free Software Foundation, either version 3 of the License, or
+* (at your option) any later version.
+*
+* MicroTBX-Modbus is distributed in the hope that it will be useful, but WITHOUT ANY
+* WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR A
+* PARTICULAR PURPOSE. See the GNU General Public License for more details.
+*
+* You have received a copy of the GNU General Public License along with MicroTBX-Modbus.
+* If not, see www.gnu.org/licenses/.
+*
+* \endinternal
+****************************************************************************************/
+#ifndef TBXMB_TIMER_PRIVATE_H
+#define TBXMB_TIMER_PRIVATE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/****************************************************************************************
+* Macro definitions
+****************************************************************************************/
+/** \brief Number of bits of the timer tick count that each level of the timer wheel
+ *         resolves.
+ */
+#define TBX_MB_TIMER_LEVEL_BITS        (5U)
+
+/** \brief Number of slots in each level of the timer wheel. */
+#define TBX_MB_TIMER_LEVEL_SLOTS       (1U << TBX_MB_TIMER_LEVEL_BITS)
+
+/** \brief Number of levels in the timer wheel. Three levels of five bits cover 15 bits,
+ *         which matches the maximum time span of 32767 ticks that a deadline of the free
+ *         running 16-bit timer can be ahead.
+ */
+#define TBX_MB_TIMER_LEVELS            (3U)
+
+
+/****************************************************************************************
+* Type definitions
+****************************************************************************************/
+/** \brief Timer that can be armed in a timer wheel. Meant to be embedded in the context
+ *         that owns the timer, such that arming and cancelling it needs no memory
+ *         allocation.
+ */
+typedef struct t_tbx_mb_timer
+{
+  struct t_tbx_mb_timer  * next;                 /**< Next timer in the same list.     */
+  struct t_tbx_mb_timer ** prevNext;             /**< Link that points to this timer.  */
+  void                   * context;              /**< Opaque owner of the timer.       */
+  uint16_t                 deadline;             /**< Timer tick at which it expires.  */
+  uint8_t                  level;                /**< Level of the list it is in.      */
+} tTbxMbTimer;
+
+
+/** \brief Hierarchical timer wheel, driven by the free running 20 kHz port timer. The
+ *         first level holds the timers that expire within the next 32 ticks, with one
+ *         slot per tick. The higher levels hold the timers that expire later, with one
+ *         slot per 32 or 1024 ticks. Their timers cascade down to a lower level, once
+ *         the wheel time reaches the slot.
+ */
+typedef struct
+{
+  tTbxMbTimer * slots[TBX_MB_TIMER_LEVELS][TBX_MB_TIMER_LEVEL_SLOTS]; /**< Timer lists.*/
+  tTbxMbTimer * expired;                         /**< Expired timers to hand out.      */
+  uint16_t      levelCnt[TBX_MB_TIMER_LEVELS];   /**< Number of timers per level.      */
+  uint16_t      count;                           /**< Total number of armed timers.    */
+  uint16_t      time;                            /**< Next timer tick to process.      */
+} tTbxMbTimerWheel;
+
+
+/****************************************************************************************
+* Function prototypes
+****************************************************************************************/
+void          TbxMbTimerWheelInit(tTbxMbTimerWheel       * wheel);
+
+void          TbxMbTimerInit     (tTbxMbTimer            * timer,
+                                  void                   * context);
+
+void          TbxMbTimerArm      (tTbxMbTimerWheel       * wheel,
+                                  tTbxMbTimer            * timer,
+                                  uint16_t                 deadline);
+
+void          TbxMbTimerCancel   (tTbxMbTimerWheel       * wheel,
+                                  tTbxMbTimer            * timer);
+
+uint8_t       TbxMbTimerIsArmed  (tTbxMbTimer      const * timer);
+
+tTbxMbTimer * TbxMbTimerExpired  (tTbxMbTimerWheel       * wheel,
+                                  uint16_t                 now);
+
+uint8_t       TbxMbTimerNext     (tTbxMbTimerWheel const * wheel,
+                                  uint16_t               * deadline);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TBXMB_TIMER_PRIVATE_H */
+/*********************************** end of tbxmb_timer_private.h **********************/
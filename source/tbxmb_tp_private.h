@@ -54,6 +54,12 @@ extern "C" {
                                         TBX_MB_TP_PDU_MAX_LEN + \
                                         TBX_MB_TP_ADU_TAIL_LEN_MAX)
 
+/** \brief Size of the character buffer that the ASCII transport layer uses to transmit a
+ *         frame in chunks. A complete ASCII frame takes up to 513 characters. Encoding
+ *         it in chunks avoids the need for a frame sized transmit buffer.
+ */
+#define TBX_MB_TP_ASCII_TX_BUF_LEN     (32U)
+
 
 /****************************************************************************************
 * Type definitions
@@ -93,8 +99,11 @@ typedef struct
 } tTbxMbTpDiagInfo;
 
 
-/** \brief Transport layer interface function to detect events in a polling manner. */
-typedef void (* tTbxMbTpPoll)                   (void        * context);
+/** \brief Transport layer interface function to detect events in a polling manner. It
+ *         returns the free running timer tick count at which it wants to be called
+ *         again.
+ */
+typedef uint16_t (* tTbxMbTpPoll)               (void        * context);
 
 
 /** \brief Transport layer interface function for processing events. */
@@ -148,28 +157,58 @@ typedef tTbxMbTpPacket * (* tTbxMbTpGetTxPacket)(tTbxMbTp      transport);
  */
 typedef struct
 {
-  /* Event interface methods. The following three entries must always be at the start
+  /* Event interface methods. The following five entries must always be at the start
    * and exactly match those in tTbxMbEventCtx. Think of it as the base that this struct
    * derives from. 
    */
   void                  * instancePtr;           /**< Reserved for C++ wrapper.        */
   tTbxMbTpPoll            pollFcn;               /**< Event poll function.             */
   tTbxMbTpProcess         processFcn;            /**< Event process function.          */
+  tTbxMbTimer             pollTimer;             /**< Event poll function timer.       */
+  tTbxMbEventLoop         eventLoop;             /**< Event loop it is bound to.       */
   /* Private members. */
   uint8_t                 type;                  /**< Context type.                    */
   uint8_t                 nodeAddr;              /**< Node address (RTU/ASCII only).   */
   tTbxMbUartPort          port;                  /**< UART port (RTU/ASCII only)     . */
   tTbxMbTpPacket          txPacket;              /**< Transmit packet buffer.          */
   uint16_t                txDoneTime;            /**< Tx packet done timestamp.        */
+  uint8_t                 txDone;                /**< Tx packet done flag (RTU only).  */
   tTbxMbTpPacket          rxPacket;              /**< Reception packet buffer.         */
   uint16_t                rxTime;                /**< Last Rx byte timestamp.          */
   uint16_t                rxAduWrIdx;            /**< ADU Rx packet write index.       */
   uint8_t                 rxAduOkay;             /**< ADU Rx packet OK/NOK flag.       */
+  uint16_t                rxCrc;                 /**< Running Rx CRC16 (RTU only).     */
   uint16_t                t1_5Ticks;             /**< 1.5 character time in 50us ticks.*/
   uint16_t                t3_5Ticks;             /**< 3.5 character time in 50us ticks.*/
   uint8_t                 state;                 /**< Communication state.             */
   uint8_t                 isClient;              /**< Info about the channel context.  */
   tTbxMbOsalSem           initStateExitSem;      /**< Exit INIT state semaphore.       */
+  uint8_t                 asciiRxNibble;         /**< Pending hex nibble (ASCII only). */
+  uint8_t                 asciiRxLrc;            /**< Running Rx LRC (ASCII only).     */
+  uint8_t                 asciiRxEol;            /**< CR received flag (ASCII only).   */
+  uint8_t                 asciiRxPolling;        /**< Rx timeout polling (ASCII only). */
+  uint16_t                asciiTxIdx;            /**< Next Tx ADU byte (ASCII only).   */
+  uint16_t                asciiTxLen;            /**< Tx ADU length (ASCII only).      */
+  /** \brief Transmit character chunk buffer (ASCII only). */
+  uint8_t                 asciiTxBuf[TBX_MB_TP_ASCII_TX_BUF_LEN];
+  int32_t                 tcpListenSocket;       /**< Listen socket (TCP server only). */
+  int32_t                 tcpSocket;             /**< Conn. socket (TCP client only).  */
+  int32_t                 tcpEpollFd;            /**< Epoll instance (TCP only).       */
+  void                  * tcpReactor;            /**< Reactor thread (TCP only).       */
+  tTbxList              * tcpConnList;           /**< Connections (TCP server only).   */
+  tTbxList              * tcpReadyList;          /**< Request queue (TCP server only). */
+  void                  * tcpTxConn;             /**< Responding conn. (TCP server).   */
+  uint32_t                tcpIpAddr;             /**< IPv4 address (TCP only).         */
+  uint16_t                tcpPort;               /**< Port number (TCP only).          */
+  uint16_t                tcpTransId;            /**< MBAP transaction ID (TCP only).  */
+  uint8_t                 tcpRespPending;        /**< Response expected (TCP only).    */
+  void                  * tcpPrimary;            /**< Connection owner (TCP client).   */
+  tTbxList              * tcpShareList;          /**< Conn. sharers (TCP client).      */
+  tTbxMbOsalSem           tcpConnSem;            /**< Connection lock (TCP client).    */
+  uint16_t                tcpNextTransId;        /**< Next transaction ID (TCP client).*/
+  /** \brief MBAP header reception buffer (TCP client only). */
+  uint8_t                 tcpRxHead[TBX_MB_TP_ADU_HEAD_LEN_MAX];
+  void                  * tcpRxTarget;           /**< Response receiver (TCP client).  */
   /* Public methods and members. */
   void                  * channelCtx;            /**< Assigned channel context.        */
   tTbxMbTpDiagInfo        diagInfo;              /**< Diagnostics information.         */ 